@@ -0,0 +1,82 @@
+/**
+ *  @file   benchmark_latest_value_mailbox.cpp
+ *  @brief  quadrotor's lock free latest value exchange between two threads related functionality benchmarks
+ *  @author neo
+ *  @data   06.12.2021
+ */
+#include "quadrotor_common/latest_value_mailbox.h"
+
+// std dependencies
+#include <mutex>
+
+// 3rd party dependencies
+#include <benchmark/benchmark.h>
+
+namespace quadrotor_common {
+
+namespace {
+
+/**
+ *  @brief  Mutex guarded latest value, i.e. the baseline of the mailbox
+ */
+class MutexMailbox {
+ public:
+  void write(const QuadrotorStateEstimate& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    value_ = value;
+  }
+  void read(QuadrotorStateEstimate& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    value = value_;
+  }
+
+ private:
+  std::mutex mutex_;
+  QuadrotorStateEstimate value_;
+};
+
+StateEstimateMailbox state_estimate_mailbox;
+MutexMailbox mutex_mailbox;
+
+}  /* namespace */
+
+/**
+ *  @brief  Write and read latency of the state estimate mailbox, i.e. thread 0 is the producer
+ *          and thread 1 the single consumer reading the latest estimate, the mailbox is single
+ *          producer single consumer, uncontended with 1 thread writing and reading in turn
+ */
+static void BM_StateEstimateMailbox(benchmark::State& state) {
+  QuadrotorStateEstimate state_estimate;
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      state_estimate.position.x() += 1.0;
+      state_estimate_mailbox.write(state_estimate);
+    }
+    if (state.thread_index() != 0 || state.threads() == 1) {
+      benchmark::DoNotOptimize(state_estimate_mailbox.read().position.x());
+    }
+  }
+  state.SetLabel(state.thread_index() == 0 ? "producer" : "consumer");
+}
+BENCHMARK(BM_StateEstimateMailbox)->Threads(1)->Threads(2);
+
+/**
+ *  @brief  The same with a mutex guarded latest value, i.e. the consumer copies out under the lock
+ */
+static void BM_MutexMailbox(benchmark::State& state) {
+  QuadrotorStateEstimate state_estimate;
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      state_estimate.position.x() += 1.0;
+      mutex_mailbox.write(state_estimate);
+    }
+    if (state.thread_index() != 0 || state.threads() == 1) {
+      mutex_mailbox.read(state_estimate);
+      benchmark::DoNotOptimize(state_estimate.position.x());
+    }
+  }
+  state.SetLabel(state.thread_index() == 0 ? "producer" : "consumer");
+}
+BENCHMARK(BM_MutexMailbox)->Threads(1)->Threads(2);
+
+} /* namespace quadrotor_common */
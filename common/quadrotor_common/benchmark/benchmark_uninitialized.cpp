@@ -0,0 +1,55 @@
+/**
+ *  @file   benchmark_uninitialized.cpp
+ *  @brief  uninitialized construction of the quadrotor's states related functionality benchmarks
+ *  @author neo
+ *  @data   03.12.2021
+ */
+#include "quadrotor_common/uninitialized.h"
+
+// std dependencies
+#include <vector>
+
+// 3rd party dependencies
+#include <benchmark/benchmark.h>
+
+// quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_state_estimate.h"
+#include "quadrotor_common/quadrotor_trajectory_point.h"
+
+namespace quadrotor_common {
+
+namespace {
+
+//  @brief  Number of points of the bulk buffer
+constexpr int kPoints = 1 << 20;
+
+}  /* namespace */
+
+/**
+ *  @brief  Allocate and fill a bulk buffer, i.e. the initialization pass of the allocator
+ *          followed by overwriting every point
+ */
+template <typename T, typename Allocator>
+static void BM_BulkBuffer(benchmark::State& state) {
+  for (auto _ : state) {
+    std::vector<T, Allocator> points(kPoints);
+    for (int i = 0; i < kPoints; ++i) {
+      points[i].position = typename T::Vector3(i, i, i);
+      points[i].velocity = T::Vector3::Zero();
+      points[i].orientation = T::Quaternion::Identity();
+    }
+    benchmark::DoNotOptimize(points.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+}
+BENCHMARK_TEMPLATE(BM_BulkBuffer, QuadrotorTrajectoryPoint,
+    Eigen::aligned_allocator<QuadrotorTrajectoryPoint>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BulkBuffer, QuadrotorTrajectoryPoint,
+    UninitializedAllocator<QuadrotorTrajectoryPoint>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BulkBuffer, QuadrotorStateEstimate_<double, SteadyClock>,
+    Eigen::aligned_allocator<QuadrotorStateEstimate_<double, SteadyClock>>)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_BulkBuffer, QuadrotorStateEstimate_<double, SteadyClock>,
+    UninitializedAllocator<QuadrotorStateEstimate_<double, SteadyClock>>)->Unit(benchmark::kMillisecond);
+
+} /* namespace quadrotor_common */
@@ -0,0 +1,58 @@
+/**
+ *  @file   clock.h
+ *  @brief  quadrotor's timestamp clock related functionality declaration & definition
+ *  @author neo
+ *  @data   02.12.2021
+ */
+#ifndef QUADROTOR_COMMON_CLOCK_H
+#define QUADROTOR_COMMON_CLOCK_H
+
+// std dependencies
+#include <chrono>
+
+// 3rd party dependencies
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/time.h>
+#endif
+
+namespace quadrotor_common {
+
+/**
+ *  @brief  Clocks used to stamp the default constructed state estimates and control commands.
+ *  @detail Each clock provides a Time type and a static now(), namely:
+ *            + RosClock    - ros::Time::now(), i.e. requires an initialized ros time source
+ *            + SteadyClock - std::chrono::steady_clock::now()
+ *            + NullClock   - never reads a clock, i.e. now() is the epoch of the steady clock
+ *                            and the timestamps are written by the caller
+ *          The clock of the state estimates and control commands defaults to DefaultClock:
+ *          RosClock, unless built with QUADROTOR_COMMON_WITHOUT_ROS, then NullClock.
+ *          QUADROTOR_COMMON_DEFAULT_CLOCK overrides the default clock, e.g. SteadyClock.
+ */
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+struct RosClock {
+  typedef ros::Time Time;
+  static Time now() { return ros::Time::now(); }
+};  /* struct RosClock */
+#endif
+
+struct SteadyClock {
+  typedef std::chrono::steady_clock::time_point Time;
+  static Time now() { return std::chrono::steady_clock::now(); }
+};  /* struct SteadyClock */
+
+struct NullClock {
+  typedef std::chrono::steady_clock::time_point Time;
+  static Time now() { return Time(); }
+};  /* struct NullClock */
+
+#if defined(QUADROTOR_COMMON_DEFAULT_CLOCK)
+typedef QUADROTOR_COMMON_DEFAULT_CLOCK DefaultClock;
+#elif defined(QUADROTOR_COMMON_WITHOUT_ROS)
+typedef NullClock DefaultClock;
+#else
+typedef RosClock DefaultClock;
+#endif
+
+} /* namespace quadrotor_common */
+
+#endif  /* QUADROTOR_COMMON_CLOCK_H */
@@ -0,0 +1,180 @@
+/**
+ *  @file   latest_value_mailbox.h
+ *  @brief  quadrotor's lock free latest value exchange between two threads related functionality declaration & definition
+ *  @author neo
+ *  @data   06.12.2021
+ */
+#ifndef QUADROTOR_COMMON_LATEST_VALUE_MAILBOX_H
+#define QUADROTOR_COMMON_LATEST_VALUE_MAILBOX_H
+
+// std dependencies
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+// quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_state_estimate.h"
+
+namespace quadrotor_common {
+
+/**
+ *  @brief  LatestValueMailbox class implementation.
+ *  @detail Wait free single producer / single consumer exchange of the latest value (triple buffer),
+ *          e.g. the state estimates of an estimator thread into the control thread, namely:
+ *            + the producer writes into its back slot and publishes it by swapping it with the
+ *              middle slot, i.e. a single atomic exchange and never waits for the consumer
+ *            + the consumer takes the middle slot, if a newer one has been published, by
+ *              swapping it with its front slot, i.e. it always reads the freshest consistent
+ *              value and never waits for the producer
+ *          Neither side takes a mutex or allocates, values the consumer did not read in time
+ *          are overwritten. The three slots and the indices of both sides are kept on separate
+ *          cache lines, so that the producer and the consumer do not share a line while copying.
+ *  @tparam T - value type, default constructible and copy assignable
+ */
+template <typename T>
+class LatestValueMailbox {
+ public:
+
+      ///////////////////////////////////////////////////
+      //////////// Constructors & Destructors ///////////
+      ///////////////////////////////////////////////////
+
+  /**
+   *  @brief  LatestValueMailbox's default constructor, called when an instance is created.
+   *  @detail All slots hold a default constructed value, i.e. read() returns it until the first publish().
+   */
+  LatestValueMailbox() : middle_(1), back_(2), front_(0) {}
+
+  LatestValueMailbox(const LatestValueMailbox&) = delete;
+  LatestValueMailbox& operator=(const LatestValueMailbox&) = delete;
+
+      ///////////////////////////////////////
+      //////////// Class Methods ////////////
+      ///////////////////////////////////////
+
+  /**
+   *  @brief  Producer: the back slot to write the next value into, i.e. in place without a copy.
+   */
+  T& writeSlot() { return slots_[back_.index].value; }
+
+  /**
+   *  @brief  Producer: publish the back slot as the latest value.
+   */
+  void publish() {
+    back_.index = middle_.index.exchange(back_.index | kFresh_, std::memory_order_acq_rel) & kIndexMask_;
+  }
+
+  /**
+   *  @brief  Producer: copy and publish the value.
+   */
+  void write(const T& value) {
+    writeSlot() = value;
+    publish();
+  }
+
+  /**
+   *  @brief  Consumer: take the latest published value, if any newer than the current one.
+   *  @return boolean value where
+   *            + true  - Indicates a newer value has been taken
+   *            + false - Otherwise, i.e. value() is still the latest one
+   */
+  bool poll() {
+    if ((middle_.index.load(std::memory_order_relaxed) & kFresh_) == 0) {
+      return false;
+    } // nothing new
+    front_.index = middle_.index.exchange(front_.index, std::memory_order_acq_rel) & kIndexMask_;
+    return true;
+  }
+
+  /**
+   *  @brief  Consumer: the current value, valid until the next poll() or read().
+   */
+  const T& value() const { return slots_[front_.index].value; }
+
+  /**
+   *  @brief  Consumer: the freshest consistent value, valid until the next poll() or read().
+   */
+  const T& read() {
+    poll();
+    return value();
+  }
+
+      ///////////////////////////////////////
+      //////////// Memory ///////////////////
+      ///////////////////////////////////////
+
+  /**
+   *  @brief  Cache line aligned allocation, i.e. also for C++14 heap allocations.
+   */
+  static void* operator new(const std::size_t size) {
+    void* const raw = ::operator new(size + kCacheLineBytes_);
+    void* aligned = static_cast<char*>(raw) + sizeof(void*);
+    std::size_t space = size + kCacheLineBytes_ - sizeof(void*);
+    aligned = std::align(kCacheLineBytes_, size, aligned, space);
+    static_cast<void**>(aligned)[-1] = raw;
+    return aligned;
+  }
+
+  static void operator delete(void* const pointer) {
+    if (pointer != nullptr) {
+      ::operator delete(static_cast<void**>(pointer)[-1]);
+    }
+  }
+
+ private:
+
+      //////////////////////////////////////
+      //////////// Constants ///////////////
+      //////////////////////////////////////
+
+  //  @brief  The cache line size, i.e. the alignment of the slots and indices
+  static constexpr std::size_t kCacheLineBytes_ = 64;
+
+  //  @brief  The slot index bits and the fresh bit of the middle index
+  static constexpr std::uint8_t kIndexMask_ = 0x3;
+  static constexpr std::uint8_t kFresh_ = 0x4;
+
+      //////////////////////////////////////
+      //////////// Types ///////////////////
+      //////////////////////////////////////
+
+  struct alignas(kCacheLineBytes_) Slot {
+    T value;
+  };  /* struct Slot */
+
+  struct alignas(kCacheLineBytes_) SharedIndex {
+    explicit SharedIndex(const std::uint8_t i) : index(i) {}
+    std::atomic<std::uint8_t> index;
+  };  /* struct SharedIndex */
+
+  struct alignas(kCacheLineBytes_) PrivateIndex {
+    explicit PrivateIndex(const std::uint8_t i) : index(i) {}
+    std::uint8_t index;
+  };  /* struct PrivateIndex */
+
+      //////////////////////////////////////
+      ///////////// Data Members ///////////
+      //////////////////////////////////////
+
+  //  @brief  The three value slots
+  Slot slots_[3];
+
+  //  @brief  The middle slot index and whether it holds a value the consumer did not take yet
+  SharedIndex middle_;
+
+  //  @brief  The producer's back slot index
+  PrivateIndex back_;
+
+  //  @brief  The consumer's front slot index
+  PrivateIndex front_;
+
+};  /* class LatestValueMailbox */
+
+//  @brief  Mailbox of the state estimates, from the estimator into the control thread
+typedef LatestValueMailbox<QuadrotorStateEstimate> StateEstimateMailbox;
+
+} /* namespace quadrotor_common */
+
+#endif  /* QUADROTOR_COMMON_LATEST_VALUE_MAILBOX_H */
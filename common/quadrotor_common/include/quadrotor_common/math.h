@@ -7,20 +7,26 @@
 #ifndef QUADROTOR_COMMON_MATH_H
 #define QUADROTOR_COMMON_MATH_H
 
+//  std dependencies
+#include <cmath>
+
 //  3rd party dependencies
 #include <Eigen/Dense>
 
 namespace quadrotor_common {
 
-bool isAlmostZero(const double value, const double threshold) {
-  return fabs(value) < threshold;
+template <typename Scalar>
+inline bool isAlmostZero(const Scalar& value, const double threshold) {
+  using std::abs;
+  return abs(value) < threshold;
 }
 
-Eigen::Matrix3d skew(const Eigen::Vector3d& v) {
-  Eigen::Matrix3d v_hat;
-  v_hat <<    0.0, -v.z(),  v.y(),
-            v.z(),    0.0, -v.x(),
-           -v.y(),  v.x(),    0.0;
+template <typename Scalar>
+inline Eigen::Matrix<Scalar, 3, 3> skew(const Eigen::Matrix<Scalar, 3, 1>& v) {
+  Eigen::Matrix<Scalar, 3, 3> v_hat;
+  v_hat << Scalar(0.0),      -v.z(),       v.y(),
+                 v.z(), Scalar(0.0),      -v.x(),
+                -v.y(),       v.x(), Scalar(0.0);
   return v_hat;
 }
 
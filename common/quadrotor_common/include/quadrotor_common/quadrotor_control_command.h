@@ -9,7 +9,10 @@
 
 // 3rd party dependencies
 #include <Eigen/Dense>
-#include <ros/time.h>
+
+// quadrotor_common dependencies
+#include "quadrotor_common/clock.h"
+#include "quadrotor_common/uninitialized.h"
 
 namespace quadrotor_common {
 
@@ -17,14 +20,23 @@ namespace quadrotor_common {
  *  @brief  QuadrotorControlCommand struct implementation.
  *  @detail Contains information about the desired quadrotor state as control command, namely:
  *          the orientation, collective thrust, bodyrates, angular acceleration
+ *  @tparam Scalar_ - scalar type, e.g. double, float or an automatic differentiation scalar
+ *  @tparam Clock_  - clock stamping the default constructed instances, see clock.h
  */
-struct QuadrotorControlCommand {
+template <typename Scalar_, typename Clock_ = DefaultClock>
+struct QuadrotorControlCommand_ {
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
       ///////////////////////////////
       //////////// Types ////////////
       ///////////////////////////////
 
+  typedef Scalar_ Scalar;
+  typedef Clock_ Clock;
+  typedef typename Clock::Time Time;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Quaternion<Scalar> Quaternion;
+
   /**
    *  @brief  ControlMode enum implementation.
    *  @detail Different type of high level position control outputs represented with corresponding modes.
@@ -47,37 +59,101 @@ struct QuadrotorControlCommand {
   /**
    *  @brief  QuadrotorControlCommand's default constructor, called when an instance is created.
    */
-  QuadrotorControlCommand();
+  QuadrotorControlCommand_();
+
+  /**
+   *  @brief  QuadrotorControlCommand's uninitialized constructor, for bulk buffers filled right after the allocation.
+   *  @detail All members but the timestamp are left uninitialized, the timestamp is the
+   *          default Time, i.e. the clock is not read.
+   */
+  explicit QuadrotorControlCommand_(UninitializedTag);
 
   /**
    *  @brief  QuadrotorControlCommand's default destructor, called when an instance is destroyed.
    */
-  ~QuadrotorControlCommand();
+  ~QuadrotorControlCommand_();
+
+      ///////////////////////////////////////
+      //////////// Class Methods ////////////
+      ///////////////////////////////////////
+
+  /**
+   *  @brief  Copy of the control command with all members cast to another scalar type.
+   */
+  template <typename NewScalar>
+  QuadrotorControlCommand_<NewScalar, Clock> cast() const;
 
       //////////////////////////////////////
       ///////////// Data Members ///////////
       //////////////////////////////////////
 
   //  @brief  The timestamp of control command output
-  ros::Time timestamp;
+  Time timestamp;
 
   //  @brief  The control command mode
   ControlMode control_mode;
 
   // TODO: w.r.t which coordinate frame the following values are calculated ?
   //  @brief  The desired quaternion orientation of quadrotor.
-  Eigen::Quaterniond orientation;
+  Quaternion orientation;
 
   //  @brief  The desired 3d body rates of quadrotor in body coordinate frame.
-  Eigen::Vector3d bodyrates;
+  Vector3 bodyrates;
 
   //  @brief  The desired angular acceleration [rad/s^2] of quadrotor.
-  Eigen::Vector3d angular_acceleration;
+  Vector3 angular_acceleration;
 
   //  @brief  The desired mass normalized collective thrust [m/s^2] of quadrotor.
-  double collective_thrust;
+  Scalar collective_thrust;
 
-};  /* struct QuadrotorControlCommand */
+};  /* struct QuadrotorControlCommand_ */
+
+/**
+ *  @detail QuadrotorControlCommand's default constructor definition.
+ */
+template <typename Scalar, typename Clock>
+QuadrotorControlCommand_<Scalar, Clock>::QuadrotorControlCommand_()
+    : timestamp(Clock::now()),
+      control_mode(ControlMode::kNone),
+      orientation(Quaternion::Identity()),
+      bodyrates(Vector3::Zero()),
+      angular_acceleration(Vector3::Zero()),
+      collective_thrust(0.0) {}
+
+/**
+ *  @detail QuadrotorControlCommand's uninitialized constructor definition.
+ */
+template <typename Scalar, typename Clock>
+QuadrotorControlCommand_<Scalar, Clock>::QuadrotorControlCommand_(UninitializedTag) {}
+
+/**
+ *  @detail QuadrotorControlCommand's default destructor definition.
+ */
+template <typename Scalar, typename Clock>
+QuadrotorControlCommand_<Scalar, Clock>::~QuadrotorControlCommand_() {}
+
+/**
+ *  @detail The control mode enums of different scalar types share their values.
+ */
+template <typename Scalar, typename Clock>
+template <typename NewScalar>
+QuadrotorControlCommand_<NewScalar, Clock> QuadrotorControlCommand_<Scalar, Clock>::cast() const {
+  QuadrotorControlCommand_<NewScalar, Clock> command;
+  command.timestamp = timestamp;
+  command.control_mode =
+      static_cast<typename QuadrotorControlCommand_<NewScalar, Clock>::ControlMode>(control_mode);
+  command.orientation = orientation.template cast<NewScalar>();
+  command.bodyrates = bodyrates.template cast<NewScalar>();
+  command.angular_acceleration = angular_acceleration.template cast<NewScalar>();
+  command.collective_thrust = NewScalar(collective_thrust);
+  return command;
+}
+
+extern template struct QuadrotorControlCommand_<double>;
+extern template struct QuadrotorControlCommand_<float>;
+
+typedef QuadrotorControlCommand_<double> QuadrotorControlCommand;
+typedef QuadrotorControlCommand_<float> QuadrotorControlCommandf;
 
 } /* namespace quadrotor_common */
 
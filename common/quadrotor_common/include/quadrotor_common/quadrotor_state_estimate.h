@@ -9,7 +9,10 @@
 
 // 3rd party dependencies
 #include <Eigen/Dense>
-#include <ros/time.h>
+
+// quadrotor_common dependencies
+#include "quadrotor_common/clock.h"
+#include "quadrotor_common/uninitialized.h"
 
 namespace quadrotor_common {
 
@@ -17,14 +20,23 @@ namespace quadrotor_common {
  *  @brief  QuadrotorStateEstimate struct implementation.
  *  @detail Contains information about quadrotor's state w.r.t coordinate frame, namely:
  *          the 3d position, 3d velocity, quaternion orientation, 3d bodyrates
+ *  @tparam Scalar_ - scalar type, e.g. double, float or an automatic differentiation scalar
+ *  @tparam Clock_  - clock stamping the default constructed instances, see clock.h
  */
-struct QuadrotorStateEstimate {
+template <typename Scalar_, typename Clock_ = DefaultClock>
+struct QuadrotorStateEstimate_ {
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
       ///////////////////////////////
       //////////// Types ////////////
       ///////////////////////////////
 
+  typedef Scalar_ Scalar;
+  typedef Clock_ Clock;
+  typedef typename Clock::Time Time;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Quaternion<Scalar> Quaternion;
+
   /**
    *  @brief  CoordinateFrame enum implementation.
    *  @detail Different types of coordinate frames w.r.t which the state of quadrotor is estimated.
@@ -43,36 +55,100 @@ struct QuadrotorStateEstimate {
   /**
    *  @brief QuadrotorStateEstimate's default constructor, called when an instance is created.
    */
-  QuadrotorStateEstimate();
+  QuadrotorStateEstimate_();
+
+  /**
+   *  @brief  QuadrotorStateEstimate's uninitialized constructor, for bulk buffers filled right after the allocation.
+   *  @detail All members but the timestamp are left uninitialized, the timestamp is the
+   *          default Time, i.e. the clock is not read.
+   */
+  explicit QuadrotorStateEstimate_(UninitializedTag);
 
   /**
    *  @brief QuadrotorStateEstimate's default destructor, called when an instance is destroyed.
    */
-  ~QuadrotorStateEstimate();
+  ~QuadrotorStateEstimate_();
+
+      ///////////////////////////////////////
+      //////////// Class Methods ////////////
+      ///////////////////////////////////////
+
+  /**
+   *  @brief  Copy of the state estimate with all members cast to another scalar type.
+   */
+  template <typename NewScalar>
+  QuadrotorStateEstimate_<NewScalar, Clock> cast() const;
 
       //////////////////////////////////////
       ///////////// Data Members ///////////
       //////////////////////////////////////
 
   //  @brief  The timestamp of quadrotor's state estimate.
-  ros::Time timestamp;
+  Time timestamp;
 
   //  @brief  The coordinate frame used to estimate the quadrotor's state.
   CoordinateFrame coordinate_frame;
 
   //  @brief  The 3d position [m] of quadrotor in coordinate frame.
-  Eigen::Vector3d position;
+  Vector3 position;
 
   //  @brief  The quaternion orientation of quadrotor in coordinate frame.
-  Eigen::Quaterniond orientation;
+  Quaternion orientation;
 
   //  @brief  The 3d linear time derivative of quadrotor in coordinate frame.
-  Eigen::Vector3d velocity;
+  Vector3 velocity;
 
   //  @brief  The 3d angular time derivative of quadrotor in body coordinate frame.
-  Eigen::Vector3d bodyrates;
+  Vector3 bodyrates;
 
-};  /* struct QuadrotorStateEstimate */
+};  /* struct QuadrotorStateEstimate_ */
+
+/**
+ *  @detail QuadrotorStateEstimate's default constructor definition.
+ */
+template <typename Scalar, typename Clock>
+QuadrotorStateEstimate_<Scalar, Clock>::QuadrotorStateEstimate_()
+    : timestamp(Clock::now()),
+      coordinate_frame(CoordinateFrame::kInvalid),
+      position(Vector3::Zero()),
+      orientation(Quaternion::Identity()),
+      velocity(Vector3::Zero()),
+      bodyrates(Vector3::Zero()) {}
+
+/**
+ *  @detail QuadrotorStateEstimate's uninitialized constructor definition.
+ */
+template <typename Scalar, typename Clock>
+QuadrotorStateEstimate_<Scalar, Clock>::QuadrotorStateEstimate_(UninitializedTag) {}
+
+/**
+ *  @detail QuadrotorStateEstimate's default destructor definition.
+ */
+template <typename Scalar, typename Clock>
+QuadrotorStateEstimate_<Scalar, Clock>::~QuadrotorStateEstimate_() {}
+
+/**
+ *  @detail The coordinate frame enums of different scalar types share their values.
+ */
+template <typename Scalar, typename Clock>
+template <typename NewScalar>
+QuadrotorStateEstimate_<NewScalar, Clock> QuadrotorStateEstimate_<Scalar, Clock>::cast() const {
+  QuadrotorStateEstimate_<NewScalar, Clock> state;
+  state.timestamp = timestamp;
+  state.coordinate_frame =
+      static_cast<typename QuadrotorStateEstimate_<NewScalar, Clock>::CoordinateFrame>(coordinate_frame);
+  state.position = position.template cast<NewScalar>();
+  state.orientation = orientation.template cast<NewScalar>();
+  state.velocity = velocity.template cast<NewScalar>();
+  state.bodyrates = bodyrates.template cast<NewScalar>();
+  return state;
+}
+
+extern template struct QuadrotorStateEstimate_<double>;
+extern template struct QuadrotorStateEstimate_<float>;
+
+typedef QuadrotorStateEstimate_<double> QuadrotorStateEstimate;
+typedef QuadrotorStateEstimate_<float> QuadrotorStateEstimatef;
 
 } /* namespace quadrotor_common */
 
@@ -10,16 +10,29 @@
 // 3rd party dependencies
 #include <Eigen/Dense>
 
+// quadrotor_common dependencies
+#include "quadrotor_common/uninitialized.h"
+
 namespace quadrotor_common {
 
 /**
  *  @brief  QuadrotorTrajectoryPoint struct implementation.
  *  @detail Contains information about quadrotor'state at given instance of a trajectory., namely:
  *          the 3d position, quaternion orientation, heading and respective time derivatives
+ *  @tparam Scalar_ - scalar type, e.g. double, float or an automatic differentiation scalar
  */
-struct QuadrotorTrajectoryPoint {
+template <typename Scalar_>
+struct QuadrotorTrajectoryPoint_ {
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
+      ///////////////////////////////
+      //////////// Types ////////////
+      ///////////////////////////////
+
+  typedef Scalar_ Scalar;
+  typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+  typedef Eigen::Quaternion<Scalar> Quaternion;
+
       ///////////////////////////////////////////////////
       //////////// Constructors & Destructors ///////////
       ///////////////////////////////////////////////////
@@ -27,44 +40,120 @@ struct QuadrotorTrajectoryPoint {
   /**
    *  @brief  QuadrotorTrajectoryPoint's default constructor, called when an instance is created.
    */
-  QuadrotorTrajectoryPoint();
+  QuadrotorTrajectoryPoint_();
+
+  /**
+   *  @brief  QuadrotorTrajectoryPoint's uninitialized constructor, for bulk buffers filled right after the allocation.
+   *  @detail All members are left uninitialized.
+   */
+  explicit QuadrotorTrajectoryPoint_(UninitializedTag);
 
   /**
    *  @brief QuadrotorTrajectoryPoint's default destructor, called when an instance is destroyed-
    */
-  ~QuadrotorTrajectoryPoint();
+  ~QuadrotorTrajectoryPoint_();
+
+      ///////////////////////////////////////
+      //////////// Class Methods ////////////
+      ///////////////////////////////////////
+
+  /**
+   *  @brief  Copy of the trajectory point with all members cast to another scalar type.
+   */
+  template <typename NewScalar>
+  QuadrotorTrajectoryPoint_<NewScalar> cast() const;
 
       //////////////////////////////////////
       ///////////// Data Members ///////////
       //////////////////////////////////////
 
   //  @brief  The 3d position [m] of quadrotor at given instance of a trajectory.
-  Eigen::Vector3d position;
+  Vector3 position;
 
   //  @brief  The quaternion orientation [-] of quadrotor at given instance of a trajectory.
-  Eigen::Quaterniond orientation;
+  Quaternion orientation;
 
   // TODO: w.r.t which coordinate frame the following values are calculated ?
   //  @brief  The quadrotor's heading angle [rad] at given instance of a trajectory w.r.t world frame.
-  double heading;
+  Scalar heading;
 
   //  @brief  The 3d linear time derivatives of quadrotor.
-  Eigen::Vector3d velocity;
-  Eigen::Vector3d acceleration;
-  Eigen::Vector3d jerk;
-  Eigen::Vector3d snap;
+  Vector3 velocity;
+  Vector3 acceleration;
+  Vector3 jerk;
+  Vector3 snap;
 
   //  @brief  The 3d angular time derivatives of quadrotor.
-  Eigen::Vector3d bodyrates;
-  Eigen::Vector3d angular_acceleration;
-  Eigen::Vector3d angular_jerk;
-  Eigen::Vector3d angular_snap;
+  Vector3 bodyrates;
+  Vector3 angular_acceleration;
+  Vector3 angular_jerk;
+  Vector3 angular_snap;
 
   //  @brief  The angle time derivatives of quadrotor's heading.
-  double heading_rate;
-  double heading_acceleration;
+  Scalar heading_rate;
+  Scalar heading_acceleration;
+
+};  /* struct QuadrotorTrajectoryPoint_ */
 
-};  /* struct QuadrotorTrajectoryPoint */
+/**
+ *  @detail QuadrotorTrajectoryPoint's default constructor definition.
+ */
+template <typename Scalar>
+QuadrotorTrajectoryPoint_<Scalar>::QuadrotorTrajectoryPoint_()
+    : position(Vector3::Zero()),
+      orientation(Quaternion::Identity()),
+      heading(0.0),
+      velocity(Vector3::Zero()),
+      acceleration(Vector3::Zero()),
+      jerk(Vector3::Zero()),
+      snap(Vector3::Zero()),
+      bodyrates(Vector3::Zero()),
+      angular_acceleration(Vector3::Zero()),
+      angular_jerk(Vector3::Zero()),
+      angular_snap(Vector3::Zero()),
+      heading_rate(0.0),
+      heading_acceleration(0.0) {}
+
+/**
+ *  @detail QuadrotorTrajectoryPoint's uninitialized constructor definition.
+ */
+template <typename Scalar>
+QuadrotorTrajectoryPoint_<Scalar>::QuadrotorTrajectoryPoint_(UninitializedTag) {}
+
+/**
+ *  @detail QuadrotorTrajectoryPoint's default destructor definition.
+ */
+template <typename Scalar>
+QuadrotorTrajectoryPoint_<Scalar>::~QuadrotorTrajectoryPoint_() {}
+
+/**
+ *  @detail
+ */
+template <typename Scalar>
+template <typename NewScalar>
+QuadrotorTrajectoryPoint_<NewScalar> QuadrotorTrajectoryPoint_<Scalar>::cast() const {
+  QuadrotorTrajectoryPoint_<NewScalar> point;
+  point.position = position.template cast<NewScalar>();
+  point.orientation = orientation.template cast<NewScalar>();
+  point.heading = NewScalar(heading);
+  point.velocity = velocity.template cast<NewScalar>();
+  point.acceleration = acceleration.template cast<NewScalar>();
+  point.jerk = jerk.template cast<NewScalar>();
+  point.snap = snap.template cast<NewScalar>();
+  point.bodyrates = bodyrates.template cast<NewScalar>();
+  point.angular_acceleration = angular_acceleration.template cast<NewScalar>();
+  point.angular_jerk = angular_jerk.template cast<NewScalar>();
+  point.angular_snap = angular_snap.template cast<NewScalar>();
+  point.heading_rate = NewScalar(heading_rate);
+  point.heading_acceleration = NewScalar(heading_acceleration);
+  return point;
+}
+
+extern template struct QuadrotorTrajectoryPoint_<double>;
+extern template struct QuadrotorTrajectoryPoint_<float>;
+
+typedef QuadrotorTrajectoryPoint_<double> QuadrotorTrajectoryPoint;
+typedef QuadrotorTrajectoryPoint_<float> QuadrotorTrajectoryPointf;
 
 } /* namespace quadrotor_common */
 
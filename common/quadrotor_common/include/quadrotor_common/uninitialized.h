@@ -0,0 +1,83 @@
+/**
+ *  @file   uninitialized.h
+ *  @brief  uninitialized construction of the quadrotor's states related functionality declaration & definition
+ *  @author neo
+ *  @data   03.12.2021
+ */
+#ifndef QUADROTOR_COMMON_UNINITIALIZED_H
+#define QUADROTOR_COMMON_UNINITIALIZED_H
+
+// std dependencies
+#include <new>
+#include <utility>
+#include <vector>
+
+// 3rd party dependencies
+#include <Eigen/Dense>
+
+namespace quadrotor_common {
+
+/**
+ *  @brief  UninitializedTag struct implementation.
+ *  @detail Selects the constructors of the state estimates, trajectory points and control commands
+ *          which leave all members uninitialized, i.e. neither zero fill nor read a clock,
+ *          for bulk buffers which are filled right after the allocation.
+ */
+struct UninitializedTag {
+  explicit constexpr UninitializedTag() {}
+};  /* struct UninitializedTag */
+
+//  @brief  The tag to construct uninitialized instances, e.g. QuadrotorTrajectoryPoint point(kUninitialized)
+constexpr UninitializedTag kUninitialized{};
+
+/**
+ *  @brief  UninitializedAllocator class implementation.
+ *  @detail Aligned allocator which default constructs the elements with the UninitializedTag,
+ *          e.g. std::vector<T, UninitializedAllocator<T>>(n) or resize(n) skips the initialization
+ *          pass, all other constructions are forwarded as usual.
+ *  @tparam T - element type, constructible from UninitializedTag
+ */
+template <typename T>
+class UninitializedAllocator : public Eigen::aligned_allocator<T> {
+ public:
+  template <typename U>
+  struct rebind {
+    typedef UninitializedAllocator<U> other;
+  };  /* struct rebind */
+
+  UninitializedAllocator() {}
+
+  template <typename U>
+  UninitializedAllocator(const UninitializedAllocator<U>& other) : Eigen::aligned_allocator<T>(other) {}
+
+  /**
+   *  @brief  Default construction of an element, i.e. uninitialized
+   */
+  template <typename U>
+  void construct(U* pointer) {
+    ::new (static_cast<void*>(pointer)) U(kUninitialized);
+  }
+
+  /**
+   *  @brief  Any other construction of an element, e.g. copy construction
+   */
+  template <typename U, typename... Args>
+  void construct(U* pointer, Args&&... args) {
+    ::new (static_cast<void*>(pointer)) U(std::forward<Args>(args)...);
+  }
+
+};  /* class UninitializedAllocator */
+
+template <typename T, typename U>
+bool operator==(const UninitializedAllocator<T>&, const UninitializedAllocator<U>&) { return true; }
+
+template <typename T, typename U>
+bool operator!=(const UninitializedAllocator<T>&, const UninitializedAllocator<U>&) { return false; }
+
+//  @brief  Vector of uninitialized default constructed elements
+template <typename T>
+using UninitializedVector = std::vector<T, UninitializedAllocator<T>>;
+
+} /* namespace quadrotor_common */
+
+#endif  /* QUADROTOR_COMMON_UNINITIALIZED_H */
@@ -8,24 +8,10 @@
 
 // 3rd party dependencies
 #include <Eigen/Dense>
-#include <ros/time.h>
 
 namespace quadrotor_common {
 
-/**
- *  @detail QuadrotorControlCommand's default constructor definition.
- */
-QuadrotorControlCommand::QuadrotorControlCommand()
-    : timestamp(ros::Time::now()),
-      control_mode(ControlMode::kNone),
-      orientation(Eigen::Quaterniond::Identity()),
-      bodyrates(Eigen::Vector3d::Zero()),
-      angular_acceleration(Eigen::Vector3d::Zero()),
-      collective_thrust(0.0) {}
-
-/**
- *  @detail QuadrotorControlCommand's default destructor definition.
- */
-QuadrotorControlCommand::~QuadrotorControlCommand() {}
+template struct QuadrotorControlCommand_<double>;
+template struct QuadrotorControlCommand_<float>;
 
 } /* namespace quadrotor_common */
@@ -8,24 +8,10 @@
 
 // 3rd party dependencies
 #include <Eigen/Dense>
-#include <ros/time.h>
 
 namespace quadrotor_common {
 
-/**
- *  @detail QuadrotorStateEstimate's default constructor definition.
- */
-QuadrotorStateEstimate::QuadrotorStateEstimate()
-    : timestamp(ros::Time::now()),
-      coordinate_frame(CoordinateFrame::kInvalid),
-      position(Eigen::Vector3d::Zero()),
-      orientation(Eigen::Quaterniond::Identity()),
-      velocity(Eigen::Vector3d::Zero()),
-      bodyrates(Eigen::Vector3d::Zero()) {}
-
-/**
- *  @detail QuadrotorStateEstimate's default destructor definition.
- */
-QuadrotorStateEstimate::~QuadrotorStateEstimate() {}
+template struct QuadrotorStateEstimate_<double>;
+template struct QuadrotorStateEstimate_<float>;
 
 } /* namespace quadrotor_common */
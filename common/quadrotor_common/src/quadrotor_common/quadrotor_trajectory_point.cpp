@@ -11,27 +11,7 @@
 
 namespace quadrotor_common {
 
-/**
- *  @detail QuadrotorTrajectoryPoint's default constructor definition.
- */
-QuadrotorTrajectoryPoint::QuadrotorTrajectoryPoint()
-    : position(Eigen::Vector3d::Zero()),
-      orientation(Eigen::Quaterniond::Identity()),
-      heading(0.0),
-      velocity(Eigen::Vector3d::Zero()),
-      acceleration(Eigen::Vector3d::Zero()),
-      jerk(Eigen::Vector3d::Zero()),
-      snap(Eigen::Vector3d::Zero()),
-      bodyrates(Eigen::Vector3d::Zero()),
-      angular_acceleration(Eigen::Vector3d::Zero()),
-      angular_jerk(Eigen::Vector3d::Zero()),
-      angular_snap(Eigen::Vector3d::Zero()),
-      heading_rate(0.0),
-      heading_acceleration(0.0) {}
-
-/**
- *  @detail QuadrotorTrajectoryPoint's default destructor definition.
- */
-QuadrotorTrajectoryPoint::~QuadrotorTrajectoryPoint() {}
+template struct QuadrotorTrajectoryPoint_<double>;
+template struct QuadrotorTrajectoryPoint_<float>;
 
 } /* namespace quadrotor_common */
@@ -0,0 +1,129 @@
+/**
+ *  @file   test_latest_value_mailbox.cpp
+ *  @brief  quadrotor's lock free latest value exchange between two threads related functionality unit tests
+ *  @author neo
+ *  @data   06.12.2021
+ */
+#include "quadrotor_common/latest_value_mailbox.h"
+
+// std dependencies
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+// 3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+namespace quadrotor_common {
+
+namespace {
+
+/**
+ *  @brief  Value spanning several cache lines, consistent if all words match the sequence number
+ */
+struct Payload {
+  std::uint64_t sequence = 0;
+  std::uint64_t words[31] = {};
+
+  void set(const std::uint64_t value) {
+    sequence = value;
+    for (std::uint64_t& word : words) {
+      word = value;
+    }
+  }
+
+  bool consistent() const {
+    for (const std::uint64_t word : words) {
+      if (word != sequence) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+}  /* namespace */
+
+/**
+ *  @brief  Test case to check the single threaded semantics, i.e. latest value wins
+ */
+TEST(LatestValueMailboxTest, LatestValueTest) {
+  LatestValueMailbox<int> mailbox;
+  EXPECT_FALSE(mailbox.poll());
+  EXPECT_EQ(0, mailbox.read());
+
+  mailbox.write(1);
+  mailbox.write(2);
+  EXPECT_TRUE(mailbox.poll());
+  EXPECT_EQ(2, mailbox.value());
+  EXPECT_FALSE(mailbox.poll());
+  EXPECT_EQ(2, mailbox.read());
+
+  mailbox.writeSlot() = 3;
+  mailbox.publish();
+  EXPECT_EQ(3, mailbox.read());
+  EXPECT_EQ(3, mailbox.read());
+}
+
+/**
+ *  @brief  Test case to check if the state estimate mailbox is cache line aligned on the heap
+ */
+TEST(LatestValueMailboxTest, AlignmentTest) {
+  const std::unique_ptr<StateEstimateMailbox> mailbox(new StateEstimateMailbox());
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(mailbox.get()) % 64);
+
+  QuadrotorStateEstimate state_estimate;
+  state_estimate.position = Eigen::Vector3d(1.0, 2.0, 3.0);
+  mailbox->write(state_estimate);
+  EXPECT_EQ(state_estimate.position, mailbox->read().position);
+}
+
+/**
+ *  @brief  Stress test, i.e. a producer publishing as fast as possible while the consumer
+ *          checks every read value to be consistent and not older than the previous one
+ */
+TEST(LatestValueMailboxTest, StressTest) {
+  constexpr std::uint64_t kWrites = 1000000;
+  const std::unique_ptr<LatestValueMailbox<Payload>> mailbox(new LatestValueMailbox<Payload>());
+
+  std::thread producer([&mailbox]() {
+    for (std::uint64_t i = 1; i <= kWrites; ++i) {
+      mailbox->writeSlot().set(i);
+      mailbox->publish();
+    }
+  });
+
+  std::uint64_t previous = 0, reads = 0, inconsistent = 0, reordered = 0;
+  while (previous < kWrites) {
+    const Payload& payload = mailbox->read();
+    inconsistent += !payload.consistent();
+    reordered += payload.sequence < previous;
+    previous = payload.sequence;
+    ++reads;
+  }
+  producer.join();
+
+  EXPECT_EQ(0u, inconsistent);
+  EXPECT_EQ(0u, reordered);
+  EXPECT_EQ(kWrites, mailbox->read().sequence);
+  EXPECT_GT(reads, 0u);
+}
+
+} /* namespace quadrotor_common */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_latest_value_mailbox");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,76 @@
+/**
+ *  @file   test_uninitialized.cpp
+ *  @brief  uninitialized construction of the quadrotor's states related functionality unit tests
+ *  @author neo
+ *  @data   03.12.2021
+ */
+#include "quadrotor_common/uninitialized.h"
+
+// std dependencies
+#include <cstdint>
+
+// 3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+// quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_control_command.h"
+#include "quadrotor_common/quadrotor_state_estimate.h"
+#include "quadrotor_common/quadrotor_trajectory_point.h"
+
+namespace quadrotor_common {
+
+/**
+ *  @brief  Test case to check if the uninitialized vector keeps the written values
+ *          across reallocations and copies
+ */
+TEST(UninitializedTest, VectorKeepsValuesTest) {
+  UninitializedVector<QuadrotorTrajectoryPoint> points(100);
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    points[i].position = Eigen::Vector3d(i, 2.0*i, 3.0*i);
+    points[i].heading = 0.1*i;
+  }
+  points.resize(1000);
+  points.push_back(points[10]);
+  const UninitializedVector<QuadrotorTrajectoryPoint> copy(points);
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(Eigen::Vector3d(i, 2.0*i, 3.0*i), copy[i].position);
+    EXPECT_EQ(0.1*i, copy[i].heading);
+  }
+  EXPECT_EQ(points[10].position, copy.back().position);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(copy.data()) % EIGEN_MAX_ALIGN_BYTES);
+}
+
+/**
+ *  @brief  Test case to check if the uninitialized constructors do not read the clock
+ */
+TEST(UninitializedTest, TimestampTest) {
+  const QuadrotorStateEstimate_<double, SteadyClock> state_estimate(kUninitialized);
+  const QuadrotorControlCommand_<float, SteadyClock> control_command(kUninitialized);
+  EXPECT_EQ(SteadyClock::Time(), state_estimate.timestamp);
+  EXPECT_EQ(SteadyClock::Time(), control_command.timestamp);
+
+  UninitializedVector<QuadrotorStateEstimate_<double, SteadyClock>> state_estimates(10);
+  for (const auto& estimate : state_estimates) {
+    EXPECT_EQ(SteadyClock::Time(), estimate.timestamp);
+  }
+}
+
+} /* namespace quadrotor_common */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_uninitialized");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
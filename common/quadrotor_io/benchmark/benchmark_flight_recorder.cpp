@@ -0,0 +1,88 @@
+/**
+ *  @file   benchmark_flight_recorder.cpp
+ *  @brief  quadrotor's lock free flight recorder related functionality benchmarks
+ *  @author thor
+ *  @date   13.12.2021
+ */
+#include "quadrotor_io/flight_recorder.h"
+
+//  std dependencies
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+namespace quadrotor_io {
+
+namespace {
+
+/**
+ *  @brief  Path of the benchmark's flight log
+ */
+std::string logPath() {
+  return "/tmp/benchmark_flight_recorder_" + std::to_string(::getpid()) + ".qflr";
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  FlightRecorder::push() of one control tick, the writer draining concurrently
+ */
+static void BM_FlightRecorderPush(benchmark::State& state) {
+  FlightRecorderParameters parameters;
+  parameters.capacity = 1 << 16;
+  parameters.poll_period = 0.001;
+  parameters.measure_push_latency = state.range(0) != 0;
+  FlightRecorder recorder(parameters);
+  recorder.start(logPath());
+  const quadrotor_common::QuadrotorStateEstimate state_estimate;
+  const quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+  const quadrotor_common::QuadrotorControlCommand control_command;
+
+  std::uint64_t tick = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(recorder.push(tick++, state_estimate, reference_state, control_command));
+  }
+  recorder.stop();
+  const FlightRecorderStatistics statistics = recorder.statistics();
+  state.counters["dropped"] = statistics.dropped;
+  state.counters["max_push_ns"] = statistics.max_push_latency;
+  state.SetItemsProcessed(state.iterations());
+  std::remove(logPath().c_str());
+}
+BENCHMARK(BM_FlightRecorderPush)->Arg(0)->Arg(1);
+
+/**
+ *  @brief  Baseline: a mutex guarded vector of records, i.e. the control thread may block on the writer
+ */
+static void BM_MutexRecorderPush(benchmark::State& state) {
+  std::mutex mutex;
+  std::vector<FlightRecord, Eigen::aligned_allocator<FlightRecord>> records;
+  records.reserve(1 << 16);
+  const quadrotor_common::QuadrotorStateEstimate state_estimate;
+  const quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+  const quadrotor_common::QuadrotorControlCommand control_command;
+
+  std::uint64_t tick = 0;
+  for (auto _ : state) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (records.size() == records.capacity()) {
+      records.clear();
+    }
+    records.emplace_back();
+    FlightRecord& record = records.back();
+    record.tick = tick++;
+    record.state_estimate = state_estimate;
+    record.reference_state = reference_state;
+    record.control_command = control_command;
+    benchmark::DoNotOptimize(&record);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MutexRecorderPush);
+
+} /*  namespace quadrotor_io  */
@@ -0,0 +1,115 @@
+/**
+ *  @file   benchmark_trajectory_file.cpp
+ *  @brief  quadrotor's memory mapped binary trajectory file related functionality benchmarks
+ *  @author thor
+ *  @date   12.12.2021
+ */
+#include "quadrotor_io/trajectory_file.h"
+
+//  std dependencies
+#include <cstdio>
+#include <string>
+#include <vector>
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+namespace quadrotor_io {
+
+namespace {
+
+typedef quadrotor_common::QuadrotorTrajectoryPoint TrajectoryPoint;
+typedef std::vector<TrajectoryPoint, Eigen::aligned_allocator<TrajectoryPoint>> TrajectoryPoints;
+
+/**
+ *  @brief  Trajectory file of n points, removed at destruction
+ */
+struct TrajectoryFixture {
+  TrajectoryFixture(const std::size_t n, const std::uint32_t fields)
+      : path("/tmp/benchmark_trajectory_file_" + std::to_string(::getpid()) + ".qtrj") {
+    TrajectoryPoints points(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      points[i].position.setConstant(0.001 * i);
+      points[i].velocity.setConstant(0.002 * i);
+    }
+    writeTrajectoryFile(path, points.data(), n, fields);
+  }
+
+  ~TrajectoryFixture() {
+    std::remove(path.c_str());
+  }
+
+  const std::string path;
+};  /*  struct TrajectoryFixture  */
+
+}  /*  namespace  */
+
+/**
+ *  @brief  Map a file of all members and read the position of every point by view
+ */
+static void BM_TrajectoryFileMap(benchmark::State& state) {
+  const TrajectoryFixture fixture(state.range(0), kAllFields);
+
+  for (auto _ : state) {
+    TrajectoryFile file;
+    file.open(fixture.path);
+    double sum = 0.0;
+    for (std::size_t i = 0; i < file.size(); ++i) {
+      sum += file[i].position().x();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TrajectoryFileMap)->Arg(1 << 10)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+
+/**
+ *  @brief  Map a packed file of the flat members and read the position of every point by view
+ */
+static void BM_TrajectoryFileMapPacked(benchmark::State& state) {
+  const TrajectoryFixture fixture(state.range(0), kFlatFields);
+
+  for (auto _ : state) {
+    TrajectoryFile file;
+    file.open(fixture.path);
+    double sum = 0.0;
+    for (std::size_t i = 0; i < file.size(); ++i) {
+      sum += file[i].position().x();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TrajectoryFileMapPacked)->Arg(1 << 10)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+
+/**
+ *  @brief  Baseline: read the file into constructed trajectory points, i.e. the cost of loading,
+ *          the members are copied by view as the point is not trivially copyable
+ */
+static void BM_TrajectoryFileRead(benchmark::State& state) {
+  const TrajectoryFixture fixture(state.range(0), kAllFields);
+
+  for (auto _ : state) {
+    TrajectoryFileHeader header;
+    std::FILE* const file = std::fopen(fixture.path.c_str(), "rb");
+    std::fread(&header, sizeof(header), 1, file);
+    std::fseek(file, header.data_offset, SEEK_SET);
+    std::vector<char> records(header.num_points * header.record_bytes);
+    std::fread(records.data(), header.record_bytes, header.num_points, file);
+    std::fclose(file);
+    TrajectoryPoints points(header.num_points);
+    for (std::size_t i = 0; i < points.size(); ++i) {
+      TrajectoryPointView(records.data() + i * header.record_bytes, header).copyTo(points[i]);
+    }
+    double sum = 0.0;
+    for (const TrajectoryPoint& point : points) {
+      sum += point.position.x();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_TrajectoryFileRead)->Arg(1 << 10)->Arg(1 << 20)->Unit(benchmark::kMicrosecond);
+
+} /*  namespace quadrotor_io  */
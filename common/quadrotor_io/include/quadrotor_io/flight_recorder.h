@@ -0,0 +1,343 @@
+/**
+ *  @file   flight_recorder.h
+ *  @brief  quadrotor's lock free flight recorder related functionality declaration & definition
+ *  @author thor
+ *  @date   13.12.2021
+ */
+#ifndef QUADROTOR_IO_FLIGHT_RECORDER_H
+#define QUADROTOR_IO_FLIGHT_RECORDER_H
+
+//  std dependencies
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+//  quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_control_command.h"
+#include "quadrotor_common/quadrotor_state_estimate.h"
+#include "quadrotor_common/quadrotor_trajectory_point.h"
+
+namespace quadrotor_io {
+
+/**
+ *  @brief  FlightRecord struct implementation
+ *  @detail The inputs and the output of one control tick, cache line aligned, i.e. a record
+ *          never shares a line with its neighbours in the ring.
+ */
+struct alignas(64) FlightRecord {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /**
+   *  @brief  FlightRecord's default constructor, called when an instance is created, leaves all
+   *          members uninitialized, i.e. does not read a clock
+   */
+  FlightRecord()
+      : tick(0),
+        state_estimate(quadrotor_common::kUninitialized),
+        reference_state(quadrotor_common::kUninitialized),
+        control_command(quadrotor_common::kUninitialized) {}
+
+  //  @brief  The control tick index
+  std::uint64_t tick;
+
+  quadrotor_common::QuadrotorStateEstimate state_estimate;
+  quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+  quadrotor_common::QuadrotorControlCommand control_command;
+};  /*  struct FlightRecord  */
+
+/**
+ *  @brief  FlightLogHeader struct implementation
+ *  @detail The first cache line of a flight log, little endian, followed by the records at
+ *          data_offset, a multiple of the page size so that the records can be written with
+ *          O_DIRECT. The records are the bytes of FlightRecord objects as laid out by the
+ *          recording build, written straight from the ring, and are read back member by member,
+ *          see FlightLog::read(). The number of records follows from the file size, i.e. a log
+ *          cut short by a crash is readable up to its last complete record.
+ */
+struct FlightLogHeader {
+  //  @brief  "QFLR", i.e. 0x524c4651 little endian
+  static constexpr std::uint32_t kMagic = 0x524c4651u;
+  static constexpr std::uint16_t kVersion = 1;
+
+  std::uint32_t magic;
+  std::uint16_t version;
+  std::uint16_t header_bytes;
+  std::uint32_t record_bytes;
+  std::uint32_t state_estimate_offset;
+  std::uint32_t reference_state_offset;
+  std::uint32_t control_command_offset;
+  std::uint64_t data_offset;
+  std::uint8_t reserved[32];
+};  /*  struct FlightLogHeader  */
+
+static_assert(sizeof(FlightLogHeader) == 64, "flight log header of a cache line");
+
+/**
+ *  @brief  Parameters of the FlightRecorder
+ */
+struct FlightRecorderParameters {
+  //  @brief  Records the ring holds, rounded up to a power of two of at least one batch
+  std::size_t capacity = 1 << 14;
+
+  //  @brief  Records per write, rounded up to a power of two of at least 64, i.e. whole pages
+  std::size_t batch_records = 64;
+
+  //  @brief  Period the writer thread polls the ring [s]
+  double poll_period = 0.005;
+
+  //  @brief  Longest time a partial batch waits in the ring before it is written anyway [s],
+  //          ignored with O_DIRECT, which writes whole batches only until stop()
+  double flush_period = 0.5;
+
+  //  @brief  Write with O_DIRECT, i.e. bypass the page cache, if the file system supports it
+  bool direct_io = false;
+
+  //  @brief  Measure the latency of every push(), two reads of the monotonic clock
+  bool measure_push_latency = true;
+};  /*  struct FlightRecorderParameters  */
+
+/**
+ *  @brief  Counters of the FlightRecorder, all durations in nanoseconds
+ */
+struct FlightRecorderStatistics {
+  std::uint64_t pushed = 0;
+  std::uint64_t dropped = 0;
+  std::uint64_t written = 0;
+  std::uint64_t writes = 0;
+  std::uint64_t write_errors = 0;
+  std::int64_t max_push_latency = 0;
+
+  //  @brief  Whether O_DIRECT took effect
+  bool direct_io = false;
+};  /*  struct FlightRecorderStatistics  */
+
+/**
+ *  @brief  FlightRecorder class implementation
+ *  @detail Records the state estimate, reference state and control command of every control
+ *          tick into a flight log, see FlightLogHeader, without ever blocking the control thread:
+ *            + the control thread push()es into a pre-allocated, pre-faulted single producer /
+ *              single consumer ring, i.e. a copy of one record and a release store, no lock,
+ *              no allocation, no system call. A full ring drops the record and counts it.
+ *            + a background writer thread drains the ring in batches straight from the ring
+ *              memory, one writev per batch, optionally with O_DIRECT.
+ *          The worst case push latency is therefore bounded by the copy of one record, which
+ *          the statistics report as measured. The counters may be read from any thread.
+ */
+class FlightRecorder {
+ public:
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  FlightRecorder's default constructor, called when an instance is created,
+     *          allocates and pre-faults the ring
+     */
+    explicit FlightRecorder(const FlightRecorderParameters& parameters = FlightRecorderParameters());
+
+    /**
+     *  @brief  FlightRecorder's default destructor, called when an instance is destroyed,
+     *          stops the recording, if running
+     */
+    ~FlightRecorder();
+
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Create the flight log and start the writer thread, stopping the previous recording
+     *  @return boolean value where
+     *            + true  - Indicates the recording has been started
+     *            + false - Otherwise, i.e. the file could not be created
+     */
+    bool start(const std::string& path);
+
+    /**
+     *  @brief  Write the records left in the ring, join the writer thread and close the log,
+     *          no-op if not recording
+     */
+    void stop();
+
+    /**
+     *  @brief  Whether a recording is running
+     */
+    bool isRecording() const { return recording_.load(std::memory_order_relaxed); }
+
+    /**
+     *  @brief  Producer: record one control tick, wait free, not concurrently with start() or stop()
+     *  @return boolean value where
+     *            + true  - Indicates the record has been queued
+     *            + false - Otherwise, i.e. not recording, or the ring is full and the record is
+     *                      dropped and counted
+     */
+    bool push(
+        const std::uint64_t tick,
+        const quadrotor_common::QuadrotorStateEstimate& state_estimate,
+        const quadrotor_common::QuadrotorTrajectoryPoint& reference_state,
+        const quadrotor_common::QuadrotorControlCommand& control_command);
+
+    /**
+     *  @brief  Snapshot of the counters, each of them consistent on its own
+     */
+    FlightRecorderStatistics statistics() const;
+
+    /**
+     *  @brief  Accessors for the ring dimensions
+     */
+    std::size_t capacity() const { return capacity_; }
+    std::size_t batchRecords() const { return batch_records_; }
+
+ private:
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  The writer thread's loop
+     */
+    void writerLoop();
+
+    /**
+     *  @brief  Write the queued records, whole batches only unless all of them are requested
+     *  @return number of records written
+     */
+    std::size_t drain(const bool all);
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    //  @brief  Ring dimensions and writer setup
+    const FlightRecorderParameters parameters_;
+    const std::size_t batch_records_;
+    const std::size_t capacity_;
+
+    //  @brief  The ring of capacity_ records, page aligned
+    FlightRecord* ring_;
+
+    //  @brief  The flight log, negative if not recording
+    int fd_;
+    std::atomic<bool> recording_;
+
+    //  @brief  The writer thread and whether it shall exit
+    std::thread writer_;
+    std::atomic<bool> stop_;
+
+    //  @brief  Records pushed by the producer, on a cache line of their own
+    alignas(64) std::atomic<std::uint64_t> head_;
+
+    //  @brief  Records released by the writer, on a cache line of their own
+    alignas(64) std::atomic<std::uint64_t> tail_;
+
+    //  @brief  The producer's last seen tail, i.e. it reads tail_ only when the ring seems full
+    alignas(64) std::uint64_t cached_tail_;
+
+    //  @brief  The producer's counters
+    std::atomic<std::uint64_t> pushed_;
+    std::atomic<std::uint64_t> dropped_;
+    std::atomic<std::int64_t> max_push_latency_;
+
+    //  @brief  The writer's counters
+    alignas(64) std::atomic<std::uint64_t> written_;
+    std::atomic<std::uint64_t> writes_;
+    std::atomic<std::uint64_t> write_errors_;
+    std::atomic<bool> direct_io_;
+
+};  /*  class FlightRecorder  */
+
+/**
+ *  @brief  FlightLog class implementation
+ *  @detail Read only memory mapping of a flight log, e.g. for the replay of a flight. The
+ *          records are copied member by member into a FlightRecord reused by the caller, the
+ *          record is not trivially copyable, i.e. the mapped bytes are never reinterpreted as
+ *          one, the same as the trajectory file views.
+ */
+class FlightLog {
+ public:
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  FlightLog's default constructor, called when an instance is created
+     */
+    FlightLog();
+
+    /**
+     *  @brief  FlightLog's default destructor, called when an instance is destroyed, unmaps the log
+     */
+    ~FlightLog();
+
+    FlightLog(const FlightLog&) = delete;
+    FlightLog& operator=(const FlightLog&) = delete;
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Map the flight log, unmapping the previous one
+     *  @return boolean value where
+     *            + true  - Indicates the log has been mapped
+     *            + false - Otherwise, i.e. it could not be mapped, is not a flight log of this
+     *                      version or was recorded by a build of another record layout, see error()
+     */
+    bool open(const std::string& path);
+
+    /**
+     *  @brief  Unmap the log
+     */
+    void close();
+
+    /**
+     *  @brief  Unmap the pages of the records [first, first + n) from the process, e.g. once
+     *          streamed, i.e. the resident memory of the process stays bounded for logs larger
+     *          than the RAM, the records stay readable and are paged in again on access.
+     *          The pages are not evicted from the page cache, the kernel reclaims them as any
+     *          clean file page.
+     */
+    void release(const std::size_t first, const std::size_t n) const;
+
+    /**
+     *  @brief  Copy the i-th record, i < size(), into the given record, e.g. one reused per worker
+     */
+    void read(const std::size_t i, FlightRecord& record) const;
+
+    /**
+     *  @brief  Accessors for the mapped log
+     */
+    bool isOpen() const { return mapping_ != nullptr; }
+    std::size_t size() const { return size_; }
+    const std::string& error() const { return error_; }
+
+ private:
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    //  @brief  The mapping of the whole log
+    void* mapping_;
+    std::size_t mapping_bytes_;
+
+    //  @brief  The complete records in the mapping
+    const char* data_;
+    std::size_t size_;
+
+    //  @brief  The reason the last open() failed
+    std::string error_;
+
+};  /*  class FlightLog  */
+
+} /*  namespace quadrotor_io  */
+
+#endif  /*  QUADROTOR_IO_FLIGHT_RECORDER_H  */
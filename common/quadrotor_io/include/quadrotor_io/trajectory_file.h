@@ -0,0 +1,269 @@
+/**
+ *  @file   trajectory_file.h
+ *  @brief  quadrotor's memory mapped binary trajectory file related functionality declaration & definition
+ *  @author thor
+ *  @date   12.12.2021
+ */
+#ifndef QUADROTOR_IO_TRAJECTORY_FILE_H
+#define QUADROTOR_IO_TRAJECTORY_FILE_H
+
+//  std dependencies
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+//  quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_trajectory_point.h"
+
+namespace quadrotor_io {
+
+/**
+ *  @brief  Presence bits of the trajectory point members, in declaration order
+ */
+enum TrajectoryField : std::uint32_t {
+  kPosition             = 1u << 0,
+  kOrientation          = 1u << 1,
+  kHeading              = 1u << 2,
+  kVelocity             = 1u << 3,
+  kAcceleration         = 1u << 4,
+  kJerk                 = 1u << 5,
+  kSnap                 = 1u << 6,
+  kBodyrates            = 1u << 7,
+  kAngularAcceleration  = 1u << 8,
+  kAngularJerk          = 1u << 9,
+  kAngularSnap          = 1u << 10,
+  kHeadingRate          = 1u << 11,
+  kHeadingAcceleration  = 1u << 12,
+
+  //  @brief  All members
+  kAllFields            = (1u << 13) - 1,
+
+  //  @brief  The members of a flat trajectory, i.e. those read by the reference inputs and the position control
+  kFlatFields           = kPosition | kHeading | kVelocity | kAcceleration | kJerk | kSnap |
+                          kHeadingRate | kHeadingAcceleration
+};
+
+//  @brief  Number of trajectory point members
+constexpr int kNumTrajectoryFields = 13;
+
+/**
+ *  @brief  TrajectoryFileHeader struct implementation
+ *  @detail The first two cache lines of a trajectory file, little endian, followed by the
+ *          records at data_offset. Both data_offset and record_bytes are multiples of the cache
+ *          line size, i.e. no record straddles a cache line more than it has to, the padding is
+ *          zeros. Every record holds the present members at field_offsets (bytes, in the
+ *          record), as doubles, the quaternion as x, y, z, w. The present members are packed in
+ *          declaration order, i.e. absent members take no space and the layout does not depend
+ *          on the writing build. The records are read by the field offsets, i.e. by view: the
+ *          point is not trivially copyable, so its bytes are never reinterpreted as a point.
+ *          No flags are defined, readers ignore them.
+ */
+struct TrajectoryFileHeader {
+  //  @brief  "QTRJ", i.e. 0x4a525451 little endian
+  static constexpr std::uint32_t kMagic = 0x4a525451u;
+  static constexpr std::uint16_t kVersion = 2;
+
+  std::uint32_t magic;
+  std::uint16_t version;
+  std::uint16_t header_bytes;
+  std::uint32_t fields;
+  std::uint32_t record_bytes;
+  std::uint64_t num_points;
+  std::uint64_t data_offset;
+  std::uint32_t field_offsets[kNumTrajectoryFields];
+  std::uint32_t flags;
+  std::uint8_t reserved[40];
+};  /*  struct TrajectoryFileHeader  */
+
+static_assert(sizeof(TrajectoryFileHeader) == 128, "trajectory file header of two cache lines");
+
+/**
+ *  @brief  Write the trajectory points into a trajectory file
+ *  @param  path    - file path, replaced if it exists
+ *  @param  points  - n trajectory points
+ *  @param  fields  - the members to write, see TrajectoryField
+ *  @return boolean value where
+ *            + true  - Indicates the file has been written
+ *            + false - Otherwise, i.e. the file could not be written or the host is big endian
+ */
+bool writeTrajectoryFile(
+    const std::string& path,
+    const quadrotor_common::QuadrotorTrajectoryPoint* points,
+    const std::size_t n,
+    const std::uint32_t fields = kAllFields);
+
+/**
+ *  @brief  TrajectoryPointView class implementation
+ *  @detail Zero copy view of a record of a mapped trajectory file, valid as long as the file
+ *          is mapped. Absent members read as zero, the orientation as identity.
+ */
+class TrajectoryPointView {
+ public:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    typedef Eigen::Map<const Eigen::Vector3d> Vector3;
+    typedef Eigen::Map<const Eigen::Quaterniond> Quaternion;
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  TrajectoryPointView's constructor, called by TrajectoryFile
+     */
+    TrajectoryPointView(const char* record, const TrajectoryFileHeader& header)
+        : record_(record), header_(header) {}
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    Vector3 position() const { return vector(kPosition, 0); }
+    Quaternion orientation() const;
+    double heading() const { return scalar(kHeading, 2); }
+    Vector3 velocity() const { return vector(kVelocity, 3); }
+    Vector3 acceleration() const { return vector(kAcceleration, 4); }
+    Vector3 jerk() const { return vector(kJerk, 5); }
+    Vector3 snap() const { return vector(kSnap, 6); }
+    Vector3 bodyrates() const { return vector(kBodyrates, 7); }
+    Vector3 angularAcceleration() const { return vector(kAngularAcceleration, 8); }
+    Vector3 angularJerk() const { return vector(kAngularJerk, 9); }
+    Vector3 angularSnap() const { return vector(kAngularSnap, 10); }
+    double headingRate() const { return scalar(kHeadingRate, 11); }
+    double headingAcceleration() const { return scalar(kHeadingAcceleration, 12); }
+
+    /**
+     *  @brief  Copy the present members into the trajectory point, the absent ones are kept
+     */
+    void copyTo(quadrotor_common::QuadrotorTrajectoryPoint& point) const;
+
+ private:
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    const double* field(const std::uint32_t field, const int index) const;
+    Vector3 vector(const std::uint32_t field, const int index) const { return Vector3(this->field(field, index)); }
+    double scalar(const std::uint32_t field, const int index) const { return *this->field(field, index); }
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    const char* record_;
+    const TrajectoryFileHeader& header_;
+
+};  /*  class TrajectoryPointView  */
+
+/**
+ *  @brief  TrajectoryFile class implementation
+ *  @detail Read only memory mapping of a trajectory file, i.e. opening it costs an mmap and
+ *          the header checks, the pages are read on first access. The records are served as
+ *          zero copy views, see TrajectoryPointView, e.g. copied into a reused trajectory point
+ *          to feed the reference inputs.
+ */
+class TrajectoryFile {
+ public:
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  TrajectoryFile's default constructor, called when an instance is created
+     */
+    TrajectoryFile();
+
+    /**
+     *  @brief  TrajectoryFile's default destructor, called when an instance is destroyed, unmaps the file
+     */
+    ~TrajectoryFile();
+
+    TrajectoryFile(const TrajectoryFile&) = delete;
+    TrajectoryFile& operator=(const TrajectoryFile&) = delete;
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Map the trajectory file, unmapping the previous one
+     *  @return boolean value where
+     *            + true  - Indicates the file has been mapped
+     *            + false - Otherwise, i.e. it could not be mapped, is not a trajectory file of
+     *                      this version or is truncated, see error()
+     */
+    bool open(const std::string& path);
+
+    /**
+     *  @brief  Unmap the file
+     */
+    void close();
+
+    /**
+     *  @brief  Accessors for the mapped file
+     */
+    bool isOpen() const { return header_ != nullptr; }
+    std::size_t size() const { return header_ ? header_->num_points : 0; }
+    std::uint32_t fields() const { return header_ ? header_->fields : 0; }
+    bool hasField(const std::uint32_t field) const { return (fields() & field) == field; }
+    const std::string& error() const { return error_; }
+
+    /**
+     *  @brief  Zero copy view of the i-th record
+     */
+    TrajectoryPointView operator[](const std::size_t i) const {
+      return TrajectoryPointView(data_ + i * header_->record_bytes, *header_);
+    }
+
+ private:
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    //  @brief  The mapping of the whole file
+    void* mapping_;
+    std::size_t mapping_bytes_;
+
+    //  @brief  The header and the records in the mapping
+    const TrajectoryFileHeader* header_;
+    const char* data_;
+
+    //  @brief  The reason the last open() failed
+    std::string error_;
+
+};  /*  class TrajectoryFile  */
+
+/**
+ *  @detail
+ */
+inline const double* TrajectoryPointView::field(const std::uint32_t field, const int index) const {
+  static const double kZero[3] = {0.0, 0.0, 0.0};
+  if ((header_.fields & field) == 0) {
+    return kZero;
+  } //  absent
+  return reinterpret_cast<const double*>(record_ + header_.field_offsets[index]);
+}
+
+/**
+ *  @detail
+ */
+inline TrajectoryPointView::Quaternion TrajectoryPointView::orientation() const {
+  static const double kIdentity[4] = {0.0, 0.0, 0.0, 1.0};
+  if ((header_.fields & kOrientation) == 0) {
+    return Quaternion(kIdentity);
+  } //  absent
+  return Quaternion(reinterpret_cast<const double*>(record_ + header_.field_offsets[1]));
+}
+
+} /*  namespace quadrotor_io  */
+
+#endif  /*  QUADROTOR_IO_TRAJECTORY_FILE_H  */
@@ -0,0 +1,496 @@
+/**
+ *  @file   flight_recorder.cpp
+ *  @brief  quadrotor's lock free flight recorder related functionality implementation
+ *  @author thor
+ *  @date   13.12.2021
+ */
+#include "quadrotor_io/flight_recorder.h"
+
+//  std dependencies
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+//  3rd party dependencies
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace quadrotor_io {
+
+namespace {
+
+constexpr std::int64_t kNanosecondsPerSecond = 1000000000;
+
+//  @brief  The page size, i.e. the alignment of the ring and the records in the flight log
+constexpr std::size_t kPageBytes = 4096;
+
+static_assert(sizeof(FlightRecord) % 64 == 0, "flight records of whole cache lines");
+
+/**
+ *  @brief  Current time of the monotonic clock [ns]
+ */
+std::int64_t now() {
+  timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * kNanosecondsPerSecond + time.tv_nsec;
+}
+
+/**
+ *  @brief  The smallest power of two not less than n
+ */
+std::size_t nextPowerOfTwo(const std::size_t n) {
+  std::size_t power = 1;
+  while (power < n) {
+    power <<= 1;
+  }
+  return power;
+}
+
+/**
+ *  @brief  The header of the records of this build
+ */
+FlightLogHeader makeHeader() {
+  const FlightRecord record;
+  const char* const base = reinterpret_cast<const char*>(&record);
+  FlightLogHeader header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = FlightLogHeader::kMagic;
+  header.version = FlightLogHeader::kVersion;
+  header.header_bytes = sizeof(FlightLogHeader);
+  header.record_bytes = sizeof(FlightRecord);
+  header.state_estimate_offset = reinterpret_cast<const char*>(&record.state_estimate) - base;
+  header.reference_state_offset = reinterpret_cast<const char*>(&record.reference_state) - base;
+  header.control_command_offset = reinterpret_cast<const char*>(&record.control_command) - base;
+  header.data_offset = kPageBytes;
+  return header;
+}
+
+/**
+ *  @brief  A trivially copyable member of a flight record, its offset and size in the record
+ */
+struct RecordMember {
+  std::size_t offset;
+  std::size_t bytes;
+};  /*  struct RecordMember  */
+
+/**
+ *  @brief  The member of the record, of count values of type T
+ */
+template <typename T>
+RecordMember recordMember(const FlightRecord& record, const T* member, const std::size_t count = 1) {
+  static_assert(std::is_trivially_copyable<T>::value, "flight record members copied as bytes");
+  return {static_cast<std::size_t>(reinterpret_cast<const char*>(member) - reinterpret_cast<const char*>(&record)),
+          count * sizeof(T)};
+}
+
+/**
+ *  @brief  The trivially copyable members of a flight record of this build, in declaration order
+ */
+const std::vector<RecordMember>& recordMembers() {
+  static const std::vector<RecordMember> members = []() {
+    const FlightRecord record;
+    const quadrotor_common::QuadrotorStateEstimate& s = record.state_estimate;
+    const quadrotor_common::QuadrotorTrajectoryPoint& r = record.reference_state;
+    const quadrotor_common::QuadrotorControlCommand& c = record.control_command;
+    return std::vector<RecordMember>{
+      recordMember(record, &record.tick),
+      recordMember(record, &s.timestamp),
+      recordMember(record, &s.coordinate_frame),
+      recordMember(record, s.position.data(), 3),
+      recordMember(record, s.orientation.coeffs().data(), 4),
+      recordMember(record, s.velocity.data(), 3),
+      recordMember(record, s.bodyrates.data(), 3),
+      recordMember(record, r.position.data(), 3),
+      recordMember(record, r.orientation.coeffs().data(), 4),
+      recordMember(record, &r.heading),
+      recordMember(record, r.velocity.data(), 3),
+      recordMember(record, r.acceleration.data(), 3),
+      recordMember(record, r.jerk.data(), 3),
+      recordMember(record, r.snap.data(), 3),
+      recordMember(record, r.bodyrates.data(), 3),
+      recordMember(record, r.angular_acceleration.data(), 3),
+      recordMember(record, r.angular_jerk.data(), 3),
+      recordMember(record, r.angular_snap.data(), 3),
+      recordMember(record, &r.heading_rate),
+      recordMember(record, &r.heading_acceleration),
+      recordMember(record, &c.timestamp),
+      recordMember(record, &c.control_mode),
+      recordMember(record, c.orientation.coeffs().data(), 4),
+      recordMember(record, c.bodyrates.data(), 3),
+      recordMember(record, c.angular_acceleration.data(), 3),
+      recordMember(record, &c.collective_thrust)};
+  }();
+  return members;
+}
+
+/**
+ *  @brief  Write the buffers completely, resuming after partial writes and interrupts
+ */
+bool writeFully(const int fd, iovec* buffers, int count) {
+  while (count > 0) {
+    const ssize_t written = ::writev(fd, buffers, count);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    std::size_t left = written;
+    while (count > 0 && left >= buffers->iov_len) {
+      left -= buffers->iov_len;
+      ++buffers;
+      --count;
+    }
+    if (count > 0) {
+      buffers->iov_base = static_cast<char*>(buffers->iov_base) + left;
+      buffers->iov_len -= left;
+    }
+  }
+  return true;
+}
+
+}  /*  namespace  */
+
+/**
+ *  @detail The ring is zero filled before the records are constructed, i.e. all its pages are
+ *          mapped before the first push().
+ */
+FlightRecorder::FlightRecorder(const FlightRecorderParameters& parameters)
+    : parameters_(parameters),
+      batch_records_(nextPowerOfTwo(std::max<std::size_t>(parameters.batch_records, 64))),
+      capacity_(nextPowerOfTwo(std::max(parameters.capacity, batch_records_))),
+      ring_(nullptr),
+      fd_(-1),
+      recording_(false),
+      stop_(false),
+      head_(0),
+      tail_(0),
+      cached_tail_(0),
+      pushed_(0),
+      dropped_(0),
+      max_push_latency_(0),
+      written_(0),
+      writes_(0),
+      write_errors_(0),
+      direct_io_(false) {
+  void* memory = nullptr;
+  if (::posix_memalign(&memory, kPageBytes, capacity_ * sizeof(FlightRecord)) != 0) {
+    throw std::bad_alloc();
+  }
+  std::memset(memory, 0, capacity_ * sizeof(FlightRecord));
+  ring_ = static_cast<FlightRecord*>(memory);
+  for (std::size_t i = 0; i < capacity_; ++i) {
+    new (ring_ + i) FlightRecord();
+  }
+}
+
+/**
+ *  @detail FlightRecorder's default destructor definition
+ */
+FlightRecorder::~FlightRecorder() {
+  stop();
+  for (std::size_t i = 0; i < capacity_; ++i) {
+    ring_[i].~FlightRecord();
+  }
+  std::free(ring_);
+}
+
+/**
+ *  @detail The header is written through the page cache, the log is switched to O_DIRECT
+ *          afterwards, i.e. at a page aligned offset. File systems without O_DIRECT, e.g.
+ *          tmpfs, are written through the page cache, see FlightRecorderStatistics::direct_io.
+ */
+bool FlightRecorder::start(const std::string& path) {
+  stop();
+
+  const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    return false;
+  }
+  std::vector<char> header_page(kPageBytes, 0);
+  const FlightLogHeader header = makeHeader();
+  std::memcpy(header_page.data(), &header, sizeof(header));
+  iovec buffer = {header_page.data(), header_page.size()};
+  if (!writeFully(fd, &buffer, 1)) {
+    ::close(fd);
+    ::unlink(path.c_str());
+    return false;
+  }
+
+  bool direct_io = false;
+#ifdef O_DIRECT
+  if (parameters_.direct_io) {
+    direct_io = ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_DIRECT) == 0;
+  }
+#endif
+
+  head_.store(0);
+  tail_.store(0);
+  cached_tail_ = 0;
+  pushed_.store(0);
+  dropped_.store(0);
+  max_push_latency_.store(0);
+  written_.store(0);
+  writes_.store(0);
+  write_errors_.store(0);
+  direct_io_.store(direct_io);
+
+  fd_ = fd;
+  stop_.store(false);
+  writer_ = std::thread(&FlightRecorder::writerLoop, this);
+  recording_.store(true, std::memory_order_release);
+  return true;
+}
+
+/**
+ *  @detail
+ */
+void FlightRecorder::stop() {
+  if (fd_ < 0) {
+    return;
+  }
+  recording_.store(false, std::memory_order_release);
+  stop_.store(true);
+  writer_.join();
+  ::close(fd_);
+  fd_ = -1;
+}
+
+/**
+ *  @detail The counters of the producer are written by the producer only, i.e. plain loads and
+ *          stores instead of read modify write instructions.
+ */
+bool FlightRecorder::push(
+    const std::uint64_t tick,
+    const quadrotor_common::QuadrotorStateEstimate& state_estimate,
+    const quadrotor_common::QuadrotorTrajectoryPoint& reference_state,
+    const quadrotor_common::QuadrotorControlCommand& control_command) {
+  if (!recording_.load(std::memory_order_acquire)) {
+    return false;
+  }
+  const std::int64_t start = parameters_.measure_push_latency ? now() : 0;
+
+  const std::uint64_t head = head_.load(std::memory_order_relaxed);
+  if (head - cached_tail_ >= capacity_) {
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    if (head - cached_tail_ >= capacity_) {
+      dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      return false;
+    } //  full
+  }
+  FlightRecord& record = ring_[head & (capacity_ - 1)];
+  record.tick = tick;
+  record.state_estimate = state_estimate;
+  record.reference_state = reference_state;
+  record.control_command = control_command;
+  head_.store(head + 1, std::memory_order_release);
+  pushed_.store(pushed_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+  if (parameters_.measure_push_latency) {
+    const std::int64_t latency = now() - start;
+    if (latency > max_push_latency_.load(std::memory_order_relaxed)) {
+      max_push_latency_.store(latency, std::memory_order_relaxed);
+    }
+  }
+  return true;
+}
+
+/**
+ *  @detail
+ */
+FlightRecorderStatistics FlightRecorder::statistics() const {
+  FlightRecorderStatistics statistics;
+  statistics.pushed = pushed_.load(std::memory_order_relaxed);
+  statistics.dropped = dropped_.load(std::memory_order_relaxed);
+  statistics.written = written_.load(std::memory_order_relaxed);
+  statistics.writes = writes_.load(std::memory_order_relaxed);
+  statistics.write_errors = write_errors_.load(std::memory_order_relaxed);
+  statistics.max_push_latency = max_push_latency_.load(std::memory_order_relaxed);
+  statistics.direct_io = direct_io_.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+/**
+ *  @detail Whole batches are written as soon as they are complete, a partial batch once it
+ *          waited for the flush period, except with O_DIRECT, which requires whole pages.
+ */
+void FlightRecorder::writerLoop() {
+  const std::int64_t poll_period = parameters_.poll_period * kNanosecondsPerSecond;
+  const std::int64_t flush_period = parameters_.flush_period * kNanosecondsPerSecond;
+  std::int64_t last_write = now();
+
+  while (!stop_.load(std::memory_order_acquire)) {
+    std::this_thread::sleep_for(std::chrono::nanoseconds(poll_period));
+    const bool flush = !direct_io_.load(std::memory_order_relaxed) && now() - last_write >= flush_period;
+    if (drain(flush) > 0 || flush) {
+      last_write = now();
+    }
+  }
+
+#ifdef O_DIRECT
+  if (direct_io_.load(std::memory_order_relaxed)) {
+    ::fcntl(fd_, F_SETFL, ::fcntl(fd_, F_GETFL) & ~O_DIRECT);
+  } //  the last partial batch
+#endif
+  drain(true);
+}
+
+/**
+ *  @detail The queued records span at most two runs of the ring, i.e. one writev of two
+ *          buffers. With O_DIRECT the tail stays at a batch boundary, and a batch is a multiple
+ *          of the page size, so the buffers and the file offset are page aligned. Records that
+ *          could not be written are released anyway, so that the producer does not stall.
+ */
+std::size_t FlightRecorder::drain(const bool all) {
+  const std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+  std::uint64_t n = head_.load(std::memory_order_acquire) - tail;
+  if (!all) {
+    n -= n % batch_records_;
+  }
+  if (n == 0) {
+    return 0;
+  }
+
+  const std::size_t first = tail & (capacity_ - 1);
+  const std::size_t run = std::min<std::size_t>(n, capacity_ - first);
+  iovec buffers[2] = {
+    {ring_ + first, run * sizeof(FlightRecord)},
+    {ring_, (n - run) * sizeof(FlightRecord)}
+  };
+  if (writeFully(fd_, buffers, run < n ? 2 : 1)) {
+    written_.store(written_.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+  } else {
+    write_errors_.store(write_errors_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+  writes_.store(writes_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+  tail_.store(tail + n, std::memory_order_release);
+  return n;
+}
+
+/**
+ *  @detail FlightLog's default constructor definition
+ */
+FlightLog::FlightLog()
+    : mapping_(nullptr),
+      mapping_bytes_(0),
+      data_(nullptr),
+      size_(0) {}
+
+/**
+ *  @detail FlightLog's default destructor definition
+ */
+FlightLog::~FlightLog() {
+  close();
+}
+
+/**
+ *  @detail A trailing partial record, e.g. of a crash while writing, is ignored.
+ */
+bool FlightLog::open(const std::string& path) {
+  close();
+  error_.clear();
+
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    error_ = "cannot open " + path;
+    return false;
+  }
+  struct stat status;
+  if (::fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(FlightLogHeader)) {
+    ::close(fd);
+    error_ = "truncated header";
+    return false;
+  }
+  const std::size_t bytes = status.st_size;
+  void* const mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    error_ = "cannot map " + path;
+    return false;
+  }
+  mapping_ = mapping;
+  mapping_bytes_ = bytes;
+
+  const FlightLogHeader& header = *static_cast<const FlightLogHeader*>(mapping);
+  const FlightLogHeader native = makeHeader();
+  if (header.magic != FlightLogHeader::kMagic) {
+    error_ = "not a flight log";
+  } else if (header.version != FlightLogHeader::kVersion) {
+    error_ = "unsupported version " + std::to_string(header.version);
+  } else if (header.header_bytes != sizeof(FlightLogHeader) ||
+             header.data_offset != native.data_offset ||
+             header.data_offset > bytes) {
+    error_ = "corrupt header";
+  } else if (header.record_bytes != native.record_bytes ||
+             header.state_estimate_offset != native.state_estimate_offset ||
+             header.reference_state_offset != native.reference_state_offset ||
+             header.control_command_offset != native.control_command_offset) {
+    error_ = "record layout of another build";
+  }
+  if (!error_.empty()) {
+    close();
+    return false;
+  }
+
+  data_ = static_cast<const char*>(mapping) + header.data_offset;
+  size_ = (bytes - header.data_offset) / header.record_bytes;
+  ::madvise(mapping, bytes, MADV_SEQUENTIAL);
+  return true;
+}
+
+/**
+ *  @detail
+ */
+void FlightLog::close() {
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mapping_bytes_);
+  }
+  mapping_ = nullptr;
+  mapping_bytes_ = 0;
+  data_ = nullptr;
+  size_ = 0;
+}
+
+/**
+ *  @detail The log is of the record layout of this build, see open(), i.e. every member is at
+ *          the same offset in the mapped record as in the given one.
+ */
+void FlightLog::read(const std::size_t i, FlightRecord& record) const {
+  const char* const source = data_ + i * sizeof(FlightRecord);
+  char* const destination = reinterpret_cast<char*>(&record);
+  for (const RecordMember& member : recordMembers()) {
+    std::memcpy(destination + member.offset, source + member.offset, member.bytes);
+  }
+}
+
+/**
+ *  @detail MADV_DONTNEED on a private read-only file mapping drops the process's page table
+ *          entries only, the pages were never copied on write, i.e. the page cache keeps them.
+ *          Only the pages entirely within the records are released, i.e. the neighbouring
+ *          records sharing the first and last page stay mapped.
+ */
+void FlightLog::release(const std::size_t first, const std::size_t n) const {
+  if (mapping_ == nullptr || first >= size_) {
+    return;
+  }
+  const std::uintptr_t page = ::sysconf(_SC_PAGESIZE);
+  const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(data_ + first * sizeof(FlightRecord));
+  const std::uintptr_t end = reinterpret_cast<std::uintptr_t>(data_ + std::min(size_, first + n) * sizeof(FlightRecord));
+  const std::uintptr_t aligned_begin = (begin + page - 1) / page * page;
+  const std::uintptr_t aligned_end = end / page * page;
+  if (aligned_begin < aligned_end) {
+    ::madvise(reinterpret_cast<void*>(aligned_begin), aligned_end - aligned_begin, MADV_DONTNEED);
+  }
+}
+
+} /*  namespace quadrotor_io  */
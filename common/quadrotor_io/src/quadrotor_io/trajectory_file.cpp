@@ -0,0 +1,250 @@
+/**
+ *  @file   trajectory_file.cpp
+ *  @brief  quadrotor's memory mapped binary trajectory file related functionality implementation
+ *  @author thor
+ *  @date   12.12.2021
+ */
+#include "quadrotor_io/trajectory_file.h"
+
+//  std dependencies
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+//  3rd party dependencies
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace quadrotor_io {
+
+namespace {
+
+typedef quadrotor_common::QuadrotorTrajectoryPoint TrajectoryPoint;
+
+//  @brief  The cache line size, i.e. the alignment of the records in the file
+constexpr std::size_t kCacheLineBytes = 64;
+
+/**
+ *  @brief  The bytes rounded up to a multiple of the cache line size
+ */
+constexpr std::size_t cacheLines(const std::size_t bytes) {
+  return (bytes + kCacheLineBytes - 1) / kCacheLineBytes * kCacheLineBytes;
+}
+
+//  @brief  Number of doubles per member, in declaration order
+constexpr std::uint32_t kFieldDoubles[kNumTrajectoryFields] = {3, 4, 1, 3, 3, 3, 3, 3, 3, 3, 3, 1, 1};
+
+/**
+ *  @brief  Whether the host is little endian, the only byte order of the format
+ */
+bool isLittleEndian() {
+  const std::uint16_t probe = 1;
+  std::uint8_t byte;
+  std::memcpy(&byte, &probe, 1);
+  return byte == 1;
+}
+
+/**
+ *  @brief  Pointers to the members of the trajectory point, in declaration order
+ *  @tparam Point   - TrajectoryPoint or const TrajectoryPoint
+ *  @tparam Double  - double or const double respectively
+ */
+template <typename Point, typename Double>
+void fieldPointers(Point& point, Double* pointers[kNumTrajectoryFields]) {
+  pointers[0] = point.position.data();
+  pointers[1] = point.orientation.coeffs().data();
+  pointers[2] = &point.heading;
+  pointers[3] = point.velocity.data();
+  pointers[4] = point.acceleration.data();
+  pointers[5] = point.jerk.data();
+  pointers[6] = point.snap.data();
+  pointers[7] = point.bodyrates.data();
+  pointers[8] = point.angular_acceleration.data();
+  pointers[9] = point.angular_jerk.data();
+  pointers[10] = point.angular_snap.data();
+  pointers[11] = &point.heading_rate;
+  pointers[12] = &point.heading_acceleration;
+}
+
+/**
+ *  @brief  The header of the members, packed in declaration order, the records padded to whole
+ *          cache lines
+ */
+TrajectoryFileHeader makeHeader(const std::size_t n, const std::uint32_t fields) {
+  TrajectoryFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  header.magic = TrajectoryFileHeader::kMagic;
+  header.version = TrajectoryFileHeader::kVersion;
+  header.header_bytes = sizeof(TrajectoryFileHeader);
+  header.fields = fields;
+  header.num_points = n;
+  header.data_offset = cacheLines(sizeof(TrajectoryFileHeader));
+
+  std::uint32_t offset = 0;
+  for (int i = 0; i < kNumTrajectoryFields; ++i) {
+    if (fields & (1u << i)) {
+      header.field_offsets[i] = offset;
+      offset += kFieldDoubles[i] * sizeof(double);
+    }
+  }
+  header.record_bytes = cacheLines(offset);
+  return header;
+}
+
+}  /*  namespace  */
+
+/**
+ *  @detail The records are written in one buffered pass, member by member into a zeroed record,
+ *          i.e. the padding within and after the members is written as zeros, as is the one
+ *          between the header and the records.
+ */
+bool writeTrajectoryFile(
+    const std::string& path,
+    const TrajectoryPoint* points,
+    const std::size_t n,
+    const std::uint32_t fields) {
+  if (!isLittleEndian() || (fields & ~kAllFields) != 0) {
+    return false;
+  }
+  const TrajectoryFileHeader header = makeHeader(n, fields);
+
+  std::FILE* const file = std::fopen(path.c_str(), "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  bool success = std::fwrite(&header, sizeof(header), 1, file) == 1;
+
+  const std::vector<char> padding(header.data_offset - sizeof(header), 0);
+  if (success && !padding.empty()) {
+    success = std::fwrite(padding.data(), padding.size(), 1, file) == 1;
+  }
+
+  std::vector<char> record(header.record_bytes, 0);
+  const double* pointers[kNumTrajectoryFields];
+  for (std::size_t k = 0; success && k < n; ++k) {
+    fieldPointers(points[k], pointers);
+    for (int i = 0; i < kNumTrajectoryFields; ++i) {
+      if (fields & (1u << i)) {
+        std::memcpy(record.data() + header.field_offsets[i], pointers[i], kFieldDoubles[i] * sizeof(double));
+      }
+    }
+    success = record.empty() || std::fwrite(record.data(), record.size(), 1, file) == 1;
+  }
+
+  success = std::fclose(file) == 0 && success;
+  if (!success) {
+    std::remove(path.c_str());
+  }
+  return success;
+}
+
+/**
+ *  @detail
+ */
+void TrajectoryPointView::copyTo(TrajectoryPoint& point) const {
+  double* pointers[kNumTrajectoryFields];
+  fieldPointers(point, pointers);
+  for (int i = 0; i < kNumTrajectoryFields; ++i) {
+    if (header_.fields & (1u << i)) {
+      std::memcpy(pointers[i], record_ + header_.field_offsets[i], kFieldDoubles[i] * sizeof(double));
+    }
+  }
+}
+
+/**
+ *  @detail TrajectoryFile's default constructor definition
+ */
+TrajectoryFile::TrajectoryFile()
+    : mapping_(nullptr),
+      mapping_bytes_(0),
+      header_(nullptr),
+      data_(nullptr) {}
+
+/**
+ *  @detail TrajectoryFile's default destructor definition
+ */
+TrajectoryFile::~TrajectoryFile() {
+  close();
+}
+
+/**
+ *  @detail The file is mapped private and read only, the kernel is advised of the sequential
+ *          access, i.e. to read ahead, which suits the playback of a trajectory.
+ */
+bool TrajectoryFile::open(const std::string& path) {
+  close();
+  error_.clear();
+  if (!isLittleEndian()) {
+    error_ = "big endian host";
+    return false;
+  }
+
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    error_ = "cannot open " + path;
+    return false;
+  }
+  struct stat status;
+  if (::fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < sizeof(TrajectoryFileHeader)) {
+    ::close(fd);
+    error_ = "truncated header";
+    return false;
+  }
+  const std::size_t bytes = status.st_size;
+  void* const mapping = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    error_ = "cannot map " + path;
+    return false;
+  }
+  mapping_ = mapping;
+  mapping_bytes_ = bytes;
+
+  const TrajectoryFileHeader& header = *static_cast<const TrajectoryFileHeader*>(mapping);
+  if (header.magic != TrajectoryFileHeader::kMagic) {
+    error_ = "not a trajectory file";
+  } else if (header.version != TrajectoryFileHeader::kVersion) {
+    error_ = "unsupported version " + std::to_string(header.version);
+  } else if (header.header_bytes != sizeof(TrajectoryFileHeader) ||
+             (header.fields & ~kAllFields) != 0 ||
+             header.data_offset < sizeof(TrajectoryFileHeader) ||
+             header.data_offset % kCacheLineBytes != 0 ||
+             header.record_bytes % kCacheLineBytes != 0) {
+    error_ = "corrupt header";
+  } else if (header.data_offset > bytes ||
+             (header.record_bytes > 0 && header.num_points > (bytes - header.data_offset) / header.record_bytes)) {
+    error_ = "truncated records";
+  }
+  for (int i = 0; error_.empty() && i < kNumTrajectoryFields; ++i) {
+    if ((header.fields & (1u << i)) &&
+        header.field_offsets[i] + kFieldDoubles[i] * sizeof(double) > header.record_bytes) {
+      error_ = "corrupt field offsets";
+    }
+  }
+  if (!error_.empty()) {
+    close();
+    return false;
+  }
+
+  header_ = &header;
+  data_ = static_cast<const char*>(mapping) + header.data_offset;
+  ::madvise(mapping, bytes, MADV_SEQUENTIAL);
+  return true;
+}
+
+/**
+ *  @detail
+ */
+void TrajectoryFile::close() {
+  if (mapping_ != nullptr) {
+    ::munmap(mapping_, mapping_bytes_);
+  }
+  mapping_ = nullptr;
+  mapping_bytes_ = 0;
+  header_ = nullptr;
+  data_ = nullptr;
+}
+
+} /*  namespace quadrotor_io  */
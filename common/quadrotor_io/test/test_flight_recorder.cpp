@@ -0,0 +1,330 @@
+/**
+ *  @file   test_flight_recorder.cpp
+ *  @brief  quadrotor's lock free flight recorder related functionality unit tests
+ *  @author thor
+ *  @date   13.12.2021
+ */
+#include "quadrotor_io/flight_recorder.h"
+
+//  std dependencies
+#include <cstdio>
+#include <string>
+#include <thread>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#include <unistd.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+namespace quadrotor_io {
+
+/**
+ *  @brief  Test fixture for testing the classes FlightRecorder and FlightLog
+ *  @detail reference: https://google.github.io/googletest/primer.html
+ */
+class FlightRecorderTest : public ::testing::Test {
+ protected:
+
+      /////////////////////////////////////////////////////
+      ////////////  Constructors & Destructors  ///////////
+      /////////////////////////////////////////////////////
+
+  /**
+   *  @brief  FlightRecorderTest's default constructor, called for each test
+   */
+  FlightRecorderTest() : path_("/tmp/test_flight_recorder_" + std::to_string(::getpid()) + ".qflr") {}
+
+  /**
+   *  @brief  FlightRecorderTest's default destructor, called for each test to remove the log
+   */
+  ~FlightRecorderTest() override {
+    std::remove(path_.c_str());
+  }
+
+      ////////////////////////////////////////
+      ////////////  Class Methods  ///////////
+      ////////////////////////////////////////
+
+  /**
+   *  @brief  Record the control tick, its members follow from the tick index
+   */
+  static bool push(FlightRecorder& recorder, const std::uint64_t tick) {
+    quadrotor_common::QuadrotorStateEstimate state_estimate;
+    state_estimate.position = Eigen::Vector3d::Constant(tick);
+    quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+    reference_state.position = Eigen::Vector3d::Constant(tick + 0.5);
+    reference_state.heading = 0.001 * tick;
+    quadrotor_common::QuadrotorControlCommand control_command;
+    control_command.collective_thrust = 9.81 + tick;
+    return recorder.push(tick, state_estimate, reference_state, control_command);
+  }
+
+  /**
+   *  @brief  Check the record against the members of its tick
+   */
+  static void expectRecord(const FlightRecord& record) {
+    const double tick = record.tick;
+    EXPECT_EQ(Eigen::Vector3d::Constant(tick), record.state_estimate.position);
+    EXPECT_EQ(Eigen::Vector3d::Constant(tick + 0.5), record.reference_state.position);
+    EXPECT_EQ(0.001 * tick, record.reference_state.heading);
+    EXPECT_EQ(9.81 + tick, record.control_command.collective_thrust);
+  }
+
+      ////////////////////////////////////////
+      ////////////  Class Members  ///////////
+      ////////////////////////////////////////
+
+  const std::string path_;
+};
+
+/**
+ *  @brief  Every pushed record is written in order
+ */
+TEST_F(FlightRecorderTest, Record) {
+  FlightRecorder recorder;
+  EXPECT_FALSE(push(recorder, 0));
+  ASSERT_TRUE(recorder.start(path_));
+  EXPECT_TRUE(recorder.isRecording());
+  for (std::uint64_t tick = 0; tick < 10000; ++tick) {
+    EXPECT_TRUE(push(recorder, tick));
+  }
+  recorder.stop();
+  EXPECT_FALSE(recorder.isRecording());
+
+  const FlightRecorderStatistics statistics = recorder.statistics();
+  EXPECT_EQ(10000u, statistics.pushed);
+  EXPECT_EQ(0u, statistics.dropped);
+  EXPECT_EQ(10000u, statistics.written);
+  EXPECT_EQ(0u, statistics.write_errors);
+  EXPECT_GT(statistics.max_push_latency, 0);
+
+  FlightLog log;
+  ASSERT_TRUE(log.open(path_)) << log.error();
+  ASSERT_EQ(10000u, log.size());
+  FlightRecord record;
+  for (std::size_t i = 0; i < log.size(); ++i) {
+    log.read(i, record);
+    ASSERT_EQ(i, record.tick);
+    expectRecord(record);
+  }
+}
+
+/**
+ *  @brief  Released records are paged in again on access, i.e. stay readable
+ */
+TEST_F(FlightRecorderTest, Release) {
+  FlightRecorder recorder;
+  ASSERT_TRUE(recorder.start(path_));
+  for (std::uint64_t tick = 0; tick < 1000; ++tick) {
+    ASSERT_TRUE(push(recorder, tick));
+  }
+  recorder.stop();
+
+  FlightLog log;
+  ASSERT_TRUE(log.open(path_)) << log.error();
+  log.release(0, 500);
+  log.release(900, 1000);
+  log.release(2000, 1);
+  ASSERT_EQ(1000u, log.size());
+  FlightRecord record;
+  for (std::size_t i = 0; i < log.size(); ++i) {
+    log.read(i, record);
+    ASSERT_EQ(i, record.tick);
+    expectRecord(record);
+  }
+}
+
+/**
+ *  @brief  Every member of a record is read back, into a record of other values
+ */
+TEST_F(FlightRecorderTest, ReadMembers) {
+  int k = 0;
+  auto next = [&k]() { return 0.25 * ++k; };
+  quadrotor_common::QuadrotorStateEstimate state_estimate;
+  state_estimate.coordinate_frame = quadrotor_common::QuadrotorStateEstimate::CoordinateFrame::kWorld;
+  state_estimate.position = Eigen::Vector3d::NullaryExpr(next);
+  state_estimate.orientation.coeffs() = Eigen::Vector4d::NullaryExpr(next);
+  state_estimate.velocity = Eigen::Vector3d::NullaryExpr(next);
+  state_estimate.bodyrates = Eigen::Vector3d::NullaryExpr(next);
+  quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+  reference_state.position = Eigen::Vector3d::NullaryExpr(next);
+  reference_state.orientation.coeffs() = Eigen::Vector4d::NullaryExpr(next);
+  reference_state.heading = next();
+  reference_state.velocity = Eigen::Vector3d::NullaryExpr(next);
+  reference_state.acceleration = Eigen::Vector3d::NullaryExpr(next);
+  reference_state.jerk = Eigen::Vector3d::NullaryExpr(next);
+  reference_state.snap = Eigen::Vector3d::NullaryExpr(next);
+  reference_state.bodyrates = Eigen::Vector3d::NullaryExpr(next);
+  reference_state.angular_acceleration = Eigen::Vector3d::NullaryExpr(next);
+  reference_state.angular_jerk = Eigen::Vector3d::NullaryExpr(next);
+  reference_state.angular_snap = Eigen::Vector3d::NullaryExpr(next);
+  reference_state.heading_rate = next();
+  reference_state.heading_acceleration = next();
+  quadrotor_common::QuadrotorControlCommand control_command;
+  control_command.control_mode = quadrotor_common::QuadrotorControlCommand::ControlMode::kAttitude;
+  control_command.orientation.coeffs() = Eigen::Vector4d::NullaryExpr(next);
+  control_command.bodyrates = Eigen::Vector3d::NullaryExpr(next);
+  control_command.angular_acceleration = Eigen::Vector3d::NullaryExpr(next);
+  control_command.collective_thrust = next();
+
+  FlightRecorder recorder;
+  ASSERT_TRUE(recorder.start(path_));
+  ASSERT_TRUE(recorder.push(4711, state_estimate, reference_state, control_command));
+  recorder.stop();
+
+  FlightLog log;
+  ASSERT_TRUE(log.open(path_)) << log.error();
+  ASSERT_EQ(1u, log.size());
+  FlightRecord record;
+  record.tick = 0;
+  record.state_estimate = quadrotor_common::QuadrotorStateEstimate();
+  record.reference_state = quadrotor_common::QuadrotorTrajectoryPoint();
+  record.control_command = quadrotor_common::QuadrotorControlCommand();
+  log.read(0, record);
+
+  EXPECT_EQ(4711u, record.tick);
+  const quadrotor_common::QuadrotorStateEstimate& s = record.state_estimate;
+  EXPECT_TRUE(state_estimate.timestamp == s.timestamp);
+  EXPECT_EQ(state_estimate.coordinate_frame, s.coordinate_frame);
+  EXPECT_EQ(state_estimate.position, s.position);
+  EXPECT_EQ(state_estimate.orientation.coeffs(), s.orientation.coeffs());
+  EXPECT_EQ(state_estimate.velocity, s.velocity);
+  EXPECT_EQ(state_estimate.bodyrates, s.bodyrates);
+  const quadrotor_common::QuadrotorTrajectoryPoint& r = record.reference_state;
+  EXPECT_EQ(reference_state.position, r.position);
+  EXPECT_EQ(reference_state.orientation.coeffs(), r.orientation.coeffs());
+  EXPECT_EQ(reference_state.heading, r.heading);
+  EXPECT_EQ(reference_state.velocity, r.velocity);
+  EXPECT_EQ(reference_state.acceleration, r.acceleration);
+  EXPECT_EQ(reference_state.jerk, r.jerk);
+  EXPECT_EQ(reference_state.snap, r.snap);
+  EXPECT_EQ(reference_state.bodyrates, r.bodyrates);
+  EXPECT_EQ(reference_state.angular_acceleration, r.angular_acceleration);
+  EXPECT_EQ(reference_state.angular_jerk, r.angular_jerk);
+  EXPECT_EQ(reference_state.angular_snap, r.angular_snap);
+  EXPECT_EQ(reference_state.heading_rate, r.heading_rate);
+  EXPECT_EQ(reference_state.heading_acceleration, r.heading_acceleration);
+  const quadrotor_common::QuadrotorControlCommand& c = record.control_command;
+  EXPECT_TRUE(control_command.timestamp == c.timestamp);
+  EXPECT_EQ(control_command.control_mode, c.control_mode);
+  EXPECT_EQ(control_command.orientation.coeffs(), c.orientation.coeffs());
+  EXPECT_EQ(control_command.bodyrates, c.bodyrates);
+  EXPECT_EQ(control_command.angular_acceleration, c.angular_acceleration);
+  EXPECT_EQ(control_command.collective_thrust, c.collective_thrust);
+}
+
+/**
+ *  @brief  A full ring drops and counts the records instead of blocking
+ */
+TEST_F(FlightRecorderTest, Dropped) {
+  FlightRecorderParameters parameters;
+  parameters.capacity = 64;
+  parameters.poll_period = 0.2;
+  FlightRecorder recorder(parameters);
+  EXPECT_EQ(64u, recorder.capacity());
+
+  ASSERT_TRUE(recorder.start(path_));
+  std::size_t pushed = 0;
+  for (std::uint64_t tick = 0; tick < 100; ++tick) {
+    pushed += push(recorder, tick);
+  }
+  recorder.stop();
+
+  const FlightRecorderStatistics statistics = recorder.statistics();
+  EXPECT_EQ(64u, pushed);
+  EXPECT_EQ(64u, statistics.pushed);
+  EXPECT_EQ(36u, statistics.dropped);
+  EXPECT_EQ(64u, statistics.written);
+
+  FlightLog log;
+  ASSERT_TRUE(log.open(path_)) << log.error();
+  ASSERT_EQ(64u, log.size());
+  FlightRecord record;
+  log.read(63, record);
+  EXPECT_EQ(63u, record.tick);
+}
+
+/**
+ *  @brief  A producer at full speed against the writer, with and without O_DIRECT
+ */
+TEST_F(FlightRecorderTest, Concurrent) {
+  for (const bool direct_io : {false, true}) {
+    FlightRecorderParameters parameters;
+    parameters.capacity = 1024;
+    parameters.poll_period = 0.0005;
+    parameters.direct_io = direct_io;
+    FlightRecorder recorder(parameters);
+    ASSERT_TRUE(recorder.start(path_));
+
+    constexpr std::uint64_t kTicks = 100000;
+    std::thread producer([&]() {
+      for (std::uint64_t tick = 0; tick < kTicks; ++tick) {
+        push(recorder, tick);
+      }
+    });
+    producer.join();
+    recorder.stop();
+
+    const FlightRecorderStatistics statistics = recorder.statistics();
+    EXPECT_EQ(kTicks, statistics.pushed + statistics.dropped);
+    EXPECT_EQ(statistics.pushed, statistics.written);
+    EXPECT_EQ(0u, statistics.write_errors);
+
+    FlightLog log;
+    ASSERT_TRUE(log.open(path_)) << log.error();
+    ASSERT_EQ(statistics.written, log.size());
+    FlightRecord record;
+    std::uint64_t previous_tick = 0;
+    for (std::size_t i = 0; i < log.size(); ++i) {
+      log.read(i, record);
+      if (i > 0) {
+        ASSERT_LT(previous_tick, record.tick);
+      }
+      expectRecord(record);
+      previous_tick = record.tick;
+    }
+  }
+}
+
+/**
+ *  @brief  Anything but a flight log is rejected, a trailing partial record is ignored
+ */
+TEST_F(FlightRecorderTest, Invalid) {
+  FlightLog log;
+  EXPECT_FALSE(log.open(path_));
+
+  std::FILE* const file = std::fopen(path_.c_str(), "wb");
+  ASSERT_NE(nullptr, file);
+  const char garbage[128] = "not a flight log";
+  std::fwrite(garbage, sizeof(garbage), 1, file);
+  std::fclose(file);
+  EXPECT_FALSE(log.open(path_));
+  EXPECT_FALSE(log.isOpen());
+
+  FlightRecorder recorder;
+  ASSERT_TRUE(recorder.start(path_));
+  push(recorder, 0);
+  push(recorder, 1);
+  recorder.stop();
+  ASSERT_EQ(0, ::truncate(path_.c_str(), 4096 + sizeof(FlightRecord) + 8));
+  ASSERT_TRUE(log.open(path_)) << log.error();
+  EXPECT_EQ(1u, log.size());
+}
+
+} /*  namespace quadrotor_io  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_flight_recorder");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
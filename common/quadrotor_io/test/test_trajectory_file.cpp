@@ -0,0 +1,273 @@
+/**
+ *  @file   test_trajectory_file.cpp
+ *  @brief  quadrotor's memory mapped binary trajectory file related functionality unit tests
+ *  @author thor
+ *  @date   12.12.2021
+ */
+#include "quadrotor_io/trajectory_file.h"
+
+//  std dependencies
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#include <unistd.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+namespace quadrotor_io {
+
+/**
+ *  @brief  Test fixture for testing the trajectory file writer and the class TrajectoryFile
+ *  @detail reference: https://google.github.io/googletest/primer.html
+ */
+class TrajectoryFileTest : public ::testing::Test {
+ protected:
+
+  typedef quadrotor_common::QuadrotorTrajectoryPoint TrajectoryPoint;
+  typedef std::vector<TrajectoryPoint, Eigen::aligned_allocator<TrajectoryPoint>> TrajectoryPoints;
+
+      /////////////////////////////////////////////////////
+      ////////////  Constructors & Destructors  ///////////
+      /////////////////////////////////////////////////////
+
+  /**
+   *  @brief  TrajectoryFileTest's default constructor, called for each test
+   *          to perform setup tasks, i.e. random trajectory points
+   */
+  TrajectoryFileTest()
+      : path_("/tmp/test_trajectory_file_" + std::to_string(::getpid()) + ".qtrj"),
+        points_(kPoints_) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+    auto random = [&]() { return value(generator); };
+    for (TrajectoryPoint& point : points_) {
+      point.position = Eigen::Vector3d::NullaryExpr(random);
+      point.orientation = Eigen::Quaterniond(Eigen::Vector4d::NullaryExpr(random)).normalized();
+      point.heading = random();
+      point.velocity = Eigen::Vector3d::NullaryExpr(random);
+      point.acceleration = Eigen::Vector3d::NullaryExpr(random);
+      point.jerk = Eigen::Vector3d::NullaryExpr(random);
+      point.snap = Eigen::Vector3d::NullaryExpr(random);
+      point.bodyrates = Eigen::Vector3d::NullaryExpr(random);
+      point.angular_acceleration = Eigen::Vector3d::NullaryExpr(random);
+      point.angular_jerk = Eigen::Vector3d::NullaryExpr(random);
+      point.angular_snap = Eigen::Vector3d::NullaryExpr(random);
+      point.heading_rate = random();
+      point.heading_acceleration = random();
+    }
+  }
+
+  /**
+   *  @brief  TrajectoryFileTest's default destructor, called for each test to remove the file
+   */
+  ~TrajectoryFileTest() override {
+    std::remove(path_.c_str());
+  }
+
+      ////////////////////////////////////////
+      ////////////  Class Methods  ///////////
+      ////////////////////////////////////////
+
+  /**
+   *  @brief  Overwrite the bytes of the written file at the offset
+   */
+  void patch(const long offset, const void* bytes, const std::size_t n) const {
+    std::FILE* const file = std::fopen(path_.c_str(), "r+b");
+    ASSERT_NE(nullptr, file);
+    ASSERT_EQ(0, std::fseek(file, offset, SEEK_SET));
+    ASSERT_EQ(1u, std::fwrite(bytes, n, 1, file));
+    std::fclose(file);
+  }
+
+      ////////////////////////////////////////
+      ////////////  Class Members  ///////////
+      ////////////////////////////////////////
+
+  static constexpr int kPoints_ = 1000;
+
+  const std::string path_;
+  TrajectoryPoints points_;
+};
+
+constexpr int TrajectoryFileTest::kPoints_;
+
+/**
+ *  @brief  All members are packed, on cache line aligned records, and read by view
+ */
+TEST_F(TrajectoryFileTest, AllFields) {
+  ASSERT_TRUE(writeTrajectoryFile(path_, points_.data(), points_.size()));
+
+  TrajectoryFile file;
+  ASSERT_TRUE(file.open(path_)) << file.error();
+  EXPECT_EQ(points_.size(), file.size());
+  EXPECT_EQ(static_cast<std::uint32_t>(kAllFields), file.fields());
+
+  for (int i = 0; i < kPoints_; ++i) {
+    const TrajectoryPoint& expected = points_[i];
+    const TrajectoryPointView view = file[i];
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(view.position().data()) % 64);
+    EXPECT_EQ(expected.position, view.position());
+    EXPECT_EQ(expected.orientation.coeffs(), view.orientation().coeffs());
+    EXPECT_EQ(expected.heading, view.heading());
+    EXPECT_EQ(expected.velocity, view.velocity());
+    EXPECT_EQ(expected.snap, view.snap());
+    EXPECT_EQ(expected.angular_snap, view.angularSnap());
+    EXPECT_EQ(expected.heading_rate, view.headingRate());
+    EXPECT_EQ(expected.heading_acceleration, view.headingAcceleration());
+
+    TrajectoryPoint point;
+    view.copyTo(point);
+    EXPECT_EQ(expected.jerk, point.jerk);
+    EXPECT_EQ(expected.bodyrates, point.bodyrates);
+  }
+}
+
+/**
+ *  @brief  The records are whole cache lines, the padding after the members is written as
+ *          zeros, not as the bytes of the points
+ */
+TEST_F(TrajectoryFileTest, Padding) {
+  alignas(TrajectoryPoint) unsigned char storage[sizeof(TrajectoryPoint)];
+  std::memset(storage, 0xff, sizeof(storage));
+  const TrajectoryPoint* const point = new (storage) TrajectoryPoint();  //  0, 1 and identity only
+  ASSERT_TRUE(writeTrajectoryFile(path_, point, 1));
+  point->~TrajectoryPoint();
+
+  TrajectoryFileHeader header;
+  std::FILE* const stream = std::fopen(path_.c_str(), "rb");
+  ASSERT_NE(nullptr, stream);
+  ASSERT_EQ(1u, std::fread(&header, sizeof(header), 1, stream));
+  EXPECT_EQ(0u, header.data_offset % 64);
+  EXPECT_EQ(0u, header.record_bytes % 64);
+  EXPECT_EQ(320u, header.record_bytes);  //  34 doubles of all members packed, 5 cache lines
+  std::vector<unsigned char> record(header.record_bytes);
+  std::fseek(stream, header.data_offset, SEEK_SET);
+  ASSERT_EQ(1u, std::fread(record.data(), record.size(), 1, stream));
+  std::fclose(stream);
+  for (const unsigned char byte : record) {
+    ASSERT_NE(0xff, byte);
+  }
+
+  ASSERT_TRUE(writeTrajectoryFile(path_, points_.data(), points_.size(), kFlatFields));
+  const std::uint32_t record_bytes = 22 * 8;
+  patch(12, &record_bytes, sizeof(record_bytes));
+  TrajectoryFile file;
+  EXPECT_FALSE(file.open(path_));
+  EXPECT_EQ("corrupt header", file.error());
+}
+
+/**
+ *  @brief  A subset of the members is packed, the absent ones read as zero or identity
+ */
+TEST_F(TrajectoryFileTest, PackedLayout) {
+  ASSERT_TRUE(writeTrajectoryFile(path_, points_.data(), points_.size(), kFlatFields | kOrientation));
+
+  TrajectoryFile file;
+  ASSERT_TRUE(file.open(path_)) << file.error();
+  EXPECT_EQ(points_.size(), file.size());
+  EXPECT_TRUE(file.hasField(kFlatFields));
+  EXPECT_TRUE(file.hasField(kOrientation));
+  EXPECT_FALSE(file.hasField(kAngularJerk));
+
+  //  position, orientation, heading, velocity, acceleration, jerk, snap, heading rate & acceleration,
+  //  i.e. 22 doubles padded to 3 cache lines
+  std::FILE* const stream = std::fopen(path_.c_str(), "rb");
+  ASSERT_NE(nullptr, stream);
+  std::fseek(stream, 0, SEEK_END);
+  EXPECT_EQ(128 + kPoints_ * 192, std::ftell(stream));
+  std::fclose(stream);
+
+  for (int i = 0; i < kPoints_; ++i) {
+    const TrajectoryPoint& expected = points_[i];
+    const TrajectoryPointView view = file[i];
+    EXPECT_EQ(expected.position, view.position());
+    EXPECT_EQ(expected.orientation.coeffs(), view.orientation().coeffs());
+    EXPECT_EQ(expected.snap, view.snap());
+    EXPECT_EQ(expected.heading_acceleration, view.headingAcceleration());
+    EXPECT_EQ(Eigen::Vector3d::Zero(), view.bodyrates());
+    EXPECT_EQ(Eigen::Vector3d::Zero(), view.angularSnap());
+
+    TrajectoryPoint point;
+    point.bodyrates = Eigen::Vector3d::Ones();
+    view.copyTo(point);
+    EXPECT_EQ(expected.jerk, point.jerk);
+    EXPECT_EQ(expected.heading, point.heading);
+    EXPECT_EQ(Eigen::Vector3d::Ones(), point.bodyrates);
+  }
+
+  ASSERT_TRUE(writeTrajectoryFile(path_, points_.data(), points_.size(), kPosition));
+  ASSERT_TRUE(file.open(path_)) << file.error();
+  EXPECT_EQ(points_[7].position, file[7].position());
+  EXPECT_TRUE(file[7].orientation().coeffs().isApprox(Eigen::Quaterniond::Identity().coeffs()));
+}
+
+/**
+ *  @brief  An empty trajectory is a header only
+ */
+TEST_F(TrajectoryFileTest, Empty) {
+  ASSERT_TRUE(writeTrajectoryFile(path_, nullptr, 0));
+
+  TrajectoryFile file;
+  ASSERT_TRUE(file.open(path_)) << file.error();
+  EXPECT_EQ(0u, file.size());
+  file.close();
+  EXPECT_FALSE(file.isOpen());
+}
+
+/**
+ *  @brief  Foreign, other version, corrupt and truncated files are rejected
+ */
+TEST_F(TrajectoryFileTest, Invalid) {
+  TrajectoryFile file;
+  EXPECT_FALSE(file.open(path_));
+  EXPECT_FALSE(writeTrajectoryFile(path_, points_.data(), points_.size(), 1u << 20));
+
+  ASSERT_TRUE(writeTrajectoryFile(path_, points_.data(), points_.size(), kFlatFields));
+  const std::uint16_t version = TrajectoryFileHeader::kVersion + 1;
+  patch(4, &version, sizeof(version));
+  EXPECT_FALSE(file.open(path_));
+  EXPECT_FALSE(file.isOpen());
+  EXPECT_FALSE(file.error().empty());
+
+  ASSERT_TRUE(writeTrajectoryFile(path_, points_.data(), points_.size(), kFlatFields));
+  const std::uint32_t magic = 0;
+  patch(0, &magic, sizeof(magic));
+  EXPECT_FALSE(file.open(path_));
+
+  ASSERT_TRUE(writeTrajectoryFile(path_, points_.data(), points_.size(), kFlatFields));
+  const std::uint64_t num_points = kPoints_ + 1;
+  patch(16, &num_points, sizeof(num_points));
+  EXPECT_FALSE(file.open(path_));
+
+  ASSERT_TRUE(writeTrajectoryFile(path_, points_.data(), points_.size(), kFlatFields));
+  const std::uint32_t field_offset = 1u << 16;
+  patch(32, &field_offset, sizeof(field_offset));
+  EXPECT_FALSE(file.open(path_));
+
+  ASSERT_TRUE(writeTrajectoryFile(path_, points_.data(), points_.size(), kFlatFields));
+  ASSERT_EQ(0, ::truncate(path_.c_str(), 100));
+  EXPECT_FALSE(file.open(path_));
+}
+
+} /*  namespace quadrotor_io  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_trajectory_file");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
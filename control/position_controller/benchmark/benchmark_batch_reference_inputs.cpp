@@ -0,0 +1,170 @@
+/**
+ *  @file   benchmark_batch_reference_inputs.cpp
+ *  @brief  quadrotor position control's batched reference inputs related functionality benchmarks
+ *  @author thor
+ *  @date   24.11.2021
+ */
+#include "position_controller/batch_reference_inputs.h"
+
+//  std dependencies
+#include <random>
+#include <vector>
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+
+//  position_controller dependencies
+#include "position_controller/reference_inputs.h"
+#include "position_controller/reference_inputs_solver.h"
+
+namespace position_controller {
+
+namespace {
+
+template <typename Scalar = double>
+using StateEstimates = std::vector<quadrotor_common::QuadrotorStateEstimate_<Scalar>,
+    Eigen::aligned_allocator<quadrotor_common::QuadrotorStateEstimate_<Scalar>>>;
+template <typename Scalar = double>
+using TrajectoryPoints = std::vector<quadrotor_common::QuadrotorTrajectoryPoint_<Scalar>,
+    Eigen::aligned_allocator<quadrotor_common::QuadrotorTrajectoryPoint_<Scalar>>>;
+template <typename Scalar = double>
+using ControlCommands = std::vector<quadrotor_common::QuadrotorControlCommand_<Scalar>,
+    Eigen::aligned_allocator<quadrotor_common::QuadrotorControlCommand_<Scalar>>>;
+
+/**
+ *  @brief  Fill n random, non singular reference states
+ */
+template <typename Scalar>
+void randomize(const std::size_t n, StateEstimates<Scalar>& state_estimates,
+               TrajectoryPoints<Scalar>& reference_states) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<Scalar> uniform(-3.0, 3.0);
+  auto random_vector = [&]() {
+    return Eigen::Matrix<Scalar, 3, 1>(
+        uniform(generator), uniform(generator), uniform(generator));
+  };
+
+  state_estimates.resize(n);
+  reference_states.resize(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    reference_states[i].heading = uniform(generator);
+    reference_states[i].velocity = random_vector();
+    reference_states[i].acceleration = random_vector();
+    reference_states[i].jerk = random_vector();
+    reference_states[i].snap = random_vector();
+    reference_states[i].heading_rate = uniform(generator);
+    reference_states[i].heading_acceleration = uniform(generator);
+  }
+}
+
+/**
+ *  @brief  Rotor drag constants of the benchmarked drag model
+ */
+template <typename RotorDragModel>
+RotorDragModel makeRotorDrag();
+
+template <>
+NoRotorDrag makeRotorDrag<NoRotorDrag>() { return NoRotorDrag(); }
+
+template <>
+IsotropicRotorDrag makeRotorDrag<IsotropicRotorDrag>() { return IsotropicRotorDrag(0.3); }
+
+template <>
+AnisotropicRotorDrag makeRotorDrag<AnisotropicRotorDrag>() {
+  return AnisotropicRotorDrag(0.4, 0.3, 0.1);
+}
+
+template <>
+NoRotorDragf makeRotorDrag<NoRotorDragf>() { return NoRotorDragf(); }
+
+template <>
+AnisotropicRotorDragf makeRotorDrag<AnisotropicRotorDragf>() {
+  return AnisotropicRotorDragf(0.4f, 0.3f, 0.1f);
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  Throughput of the one-shot ReferenceInputs, one point at a time
+ */
+static void BM_OneShotReferenceInputs(benchmark::State& state) {
+  const std::size_t n = state.range(0);
+  StateEstimates<> state_estimates;
+  TrajectoryPoints<> reference_states;
+  ControlCommands<> reference_inputs(n);
+  randomize(n, state_estimates, reference_states);
+
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      const ReferenceInputs one_shot(state_estimates[i], reference_states[i]);
+      reference_inputs[i] = one_shot.getReferenceInputs();
+    }
+    benchmark::DoNotOptimize(reference_inputs.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_OneShotReferenceInputs)->Arg(64)->Arg(1024)->Arg(16384);
+
+/**
+ *  @brief  Throughput of the scalar ReferenceInputsSolver path, one point at a time
+ */
+template <typename RotorDragModel, XiKernel kXiKernel = XiKernel::kBodyFrame>
+static void BM_ScalarReferenceInputs(benchmark::State& state) {
+  typedef typename RotorDragModel::Scalar Scalar;
+  const std::size_t n = state.range(0);
+  StateEstimates<Scalar> state_estimates;
+  TrajectoryPoints<Scalar> reference_states;
+  ControlCommands<Scalar> reference_inputs(n);
+  randomize(n, state_estimates, reference_states);
+
+  ReferenceInputsSolver_<RotorDragModel, kXiKernel> solver(
+      makeRotorDrag<RotorDragModel>());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < n; ++i) {
+      solver.solve(state_estimates[i], reference_states[i], reference_inputs[i]);
+    }
+    benchmark::DoNotOptimize(reference_inputs.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_ScalarReferenceInputs, NoRotorDrag)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_ScalarReferenceInputs, IsotropicRotorDrag)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_ScalarReferenceInputs, AnisotropicRotorDrag, XiKernel::kMatrixForm)
+    ->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_ScalarReferenceInputs, AnisotropicRotorDrag, XiKernel::kBodyFrame)
+    ->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_ScalarReferenceInputs, NoRotorDragf)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_ScalarReferenceInputs, AnisotropicRotorDragf)
+    ->Arg(64)->Arg(1024)->Arg(16384);
+
+/**
+ *  @brief  Throughput of the batched BatchReferenceInputs path, lanes() points at a time
+ */
+template <typename RotorDragModel>
+static void BM_BatchReferenceInputs(benchmark::State& state) {
+  typedef typename RotorDragModel::Scalar Scalar;
+  const std::size_t n = state.range(0);
+  StateEstimates<Scalar> state_estimates;
+  TrajectoryPoints<Scalar> reference_states;
+  ControlCommands<Scalar> reference_inputs(n);
+  randomize(n, state_estimates, reference_states);
+
+  BatchReferenceInputs_<RotorDragModel> batch(makeRotorDrag<RotorDragModel>());
+  for (auto _ : state) {
+    batch.compute(state_estimates.data(), reference_states.data(),
+                  reference_inputs.data(), n);
+    benchmark::DoNotOptimize(reference_inputs.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  state.counters["lanes"] = BatchReferenceInputs_<RotorDragModel>::lanes();
+}
+BENCHMARK_TEMPLATE(BM_BatchReferenceInputs, NoRotorDrag)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_BatchReferenceInputs, IsotropicRotorDrag)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_BatchReferenceInputs, AnisotropicRotorDrag)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_BatchReferenceInputs, NoRotorDragf)->Arg(64)->Arg(1024)->Arg(16384);
+BENCHMARK_TEMPLATE(BM_BatchReferenceInputs, AnisotropicRotorDragf)->Arg(64)->Arg(1024)->Arg(16384);
+
+} /*  namespace position_controller  */
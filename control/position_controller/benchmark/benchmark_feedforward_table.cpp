@@ -0,0 +1,86 @@
+/**
+ *  @file   benchmark_feedforward_table.cpp
+ *  @brief  quadrotor position control's precomputed reference inputs related functionality benchmarks
+ *  @author thor
+ *  @date   11.12.2021
+ */
+#include "position_controller/feedforward_table.h"
+
+//  std dependencies
+#include <cmath>
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+
+//  position_controller dependencies
+#include "trajectory_fixtures.h"
+
+namespace position_controller {
+
+namespace {
+
+//  @brief  Number of control ticks per benchmark iteration, i.e. 1 kHz over about one circle
+constexpr int kTicks = 3000;
+constexpr double kDt = 0.001;
+
+/**
+ *  @brief  Circle of 2 m radius at 2 rad/s with the heading along the velocity, see trajectory_fixtures.h
+ */
+void sampleCircle(const double t, quadrotor_common::QuadrotorTrajectoryPoint& point) {
+  const double r = 2.0, w = 2.0;
+  const double c = std::cos(w * t), s = std::sin(w * t);
+  point.position = Eigen::Vector3d(r*c, r*s, 1.0);
+  point.velocity = r*w * Eigen::Vector3d(-s, c, 0.0);
+  point.acceleration = r*w*w * Eigen::Vector3d(-c, -s, 0.0);
+  point.jerk = r*w*w*w * Eigen::Vector3d(s, -c, 0.0);
+  point.snap = r*w*w*w*w * Eigen::Vector3d(c, s, 0.0);
+  point.heading = std::atan2(c, -s);
+  point.heading_rate = w;
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  Reference inputs of the control ticks from the live solver, i.e. the baseline
+ */
+static void BM_FeedforwardSolver(benchmark::State& state) {
+  benchmark_fixtures::TrajectoryPoints reference_states(kTicks);
+  for (int i = 0; i < kTicks; ++i) {
+    sampleCircle(i * kDt, reference_states[i]);
+  }
+  const quadrotor_common::QuadrotorStateEstimate state_estimate;
+  ReferenceInputsSolver solver;
+  quadrotor_common::QuadrotorControlCommand reference_inputs;
+
+  for (auto _ : state) {
+    for (int i = 0; i < kTicks; ++i) {
+      solver.solve(state_estimate, reference_states[i], reference_inputs);
+      benchmark::DoNotOptimize(&reference_inputs);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kTicks);
+}
+BENCHMARK(BM_FeedforwardSolver);
+
+/**
+ *  @brief  Reference inputs of the control ticks from a table of the given sample period [ms],
+ *          i.e. interpolated between the samples for periods above the tick period
+ */
+static void BM_FeedforwardTableLookup(benchmark::State& state) {
+  FeedforwardTable table;
+  table.compile(sampleCircle, 0.0, kTicks * kDt, 1e-3 * state.range(0));
+  quadrotor_common::QuadrotorControlCommand reference_inputs;
+
+  for (auto _ : state) {
+    for (int i = 0; i < kTicks; ++i) {
+      const bool found = table.lookup(i * kDt + 0.0003, reference_inputs);
+      benchmark::DoNotOptimize(found);
+      benchmark::DoNotOptimize(&reference_inputs);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kTicks);
+  state.counters["bytes"] = table.size() * 48.0;
+}
+BENCHMARK(BM_FeedforwardTableLookup)->Arg(1)->Arg(10);
+
+} /*  namespace position_controller  */
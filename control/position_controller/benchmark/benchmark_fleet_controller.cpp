@@ -0,0 +1,52 @@
+/**
+ *  @file   benchmark_fleet_controller.cpp
+ *  @brief  quadrotor position control's multi vehicle fleet related functionality benchmarks
+ *  @author thor
+ *  @date   05.12.2021
+ */
+#include "position_controller/fleet_controller.h"
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+
+//  position_controller dependencies
+#include "trajectory_fixtures.h"
+
+namespace position_controller {
+
+namespace {
+
+//  @brief  Number of vehicles of the target fleet, i.e. 10k vehicles at 1 kHz
+constexpr int kVehicles = 10000;
+
+}  /*  namespace  */
+
+/**
+ *  @brief  One lockstep tick of the fleet, every vehicle at its own phase of the lemniscate
+ *          fixture, scaling from 1 to 64 threads. The ticks counter is the achievable
+ *          control rate of the fleet, i.e. >= 1000 meets the 10k vehicles at 1 kHz goal.
+ */
+static void BM_FleetController(benchmark::State& state) {
+  const int num_threads = static_cast<int>(state.range(0));
+  const int vehicles = static_cast<int>(state.range(1));
+  const FleetController::TrajectoryPoints reference_states =
+      benchmark_fixtures::makeTrajectory(benchmark_fixtures::kLemniscate, vehicles);
+  const FleetController::StateEstimates state_estimates =
+      benchmark_fixtures::makeStateEstimates(reference_states);
+  FleetController::ControlCommands commands(vehicles);
+  FleetController fleet_controller(num_threads);
+
+  for (auto _ : state) {
+    fleet_controller.run(state_estimates, reference_states, commands);
+    benchmark::DoNotOptimize(commands.data());
+  }
+  state.SetItemsProcessed(state.iterations() * vehicles);
+  state.counters["ticks"] = benchmark::Counter(
+      static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_FleetController)
+    ->ArgsProduct({benchmark::CreateRange(1, 64, 2), {kVehicles}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+} /*  namespace position_controller  */
@@ -0,0 +1,64 @@
+/**
+ *  @file   benchmark_position_controller.cpp
+ *  @brief  quadrotor's position control related functionality benchmarks
+ *  @author thor
+ *  @date   30.11.2021
+ */
+#include "position_controller/position_controller.h"
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+
+//  position_controller dependencies
+#include "trajectory_fixtures.h"
+
+namespace position_controller {
+
+namespace {
+
+//  @brief  Number of sampled points per trajectory fixture
+constexpr int kPoints = 1024;
+
+}  /*  namespace  */
+
+/**
+ *  @brief  PositionController::run() along the trajectory fixtures, one control tick per point
+ */
+static void BM_PositionControllerRun(benchmark::State& state) {
+  const benchmark_fixtures::TrajectoryFixture trajectory =
+      static_cast<benchmark_fixtures::TrajectoryFixture>(state.range(0));
+  const benchmark_fixtures::TrajectoryPoints reference_states =
+      benchmark_fixtures::makeTrajectory(trajectory, kPoints);
+  const benchmark_fixtures::StateEstimates state_estimates =
+      benchmark_fixtures::makeStateEstimates(reference_states);
+  PositionController position_controller;
+
+  for (auto _ : state) {
+    for (int i = 0; i < kPoints; ++i) {
+      const quadrotor_common::QuadrotorControlCommand control_command =
+          position_controller.run(state_estimates[i], reference_states[i]);
+      benchmark::DoNotOptimize(&control_command);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+  state.SetLabel(benchmark_fixtures::name(trajectory));
+}
+BENCHMARK(BM_PositionControllerRun)
+    ->DenseRange(benchmark_fixtures::kHover, benchmark_fixtures::kNearFreeFall);
+
+/**
+ *  @brief  Default construction of a control command, i.e. the cost of the clock stamping
+ *          every temporary, the RosClock requires a ros time source and is left out
+ */
+template <typename Clock>
+static void BM_ControlCommandConstruction(benchmark::State& state) {
+  for (auto _ : state) {
+    quadrotor_common::QuadrotorControlCommand_<double, Clock> control_command;
+    benchmark::DoNotOptimize(&control_command);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_ControlCommandConstruction, quadrotor_common::NullClock);
+BENCHMARK_TEMPLATE(BM_ControlCommandConstruction, quadrotor_common::SteadyClock);
+
+} /*  namespace position_controller  */
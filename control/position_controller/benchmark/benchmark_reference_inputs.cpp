@@ -0,0 +1,319 @@
+/**
+ *  @file   benchmark_reference_inputs.cpp
+ *  @brief  quadrotor position control's reference inputs related functionality benchmarks
+ *  @author thor
+ *  @date   30.11.2021
+ */
+#include "position_controller/reference_inputs_solver.h"
+
+//  std dependencies
+#include <cmath>
+#include <vector>
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+
+//  position_controller dependencies
+#include "position_controller/heading_frame_cache.h"
+#include "position_controller/reference_inputs.h"
+#include "position_controller/stage_profiler.h"
+#include "trajectory_fixtures.h"
+
+namespace position_controller {
+
+namespace {
+
+using benchmark_fixtures::StateEstimates;
+using benchmark_fixtures::TrajectoryFixture;
+using benchmark_fixtures::TrajectoryPoints;
+
+//  @brief  Number of sampled points per trajectory fixture
+constexpr int kPoints = 1024;
+
+/**
+ *  @brief  Expose the protected pipeline stages of the reference inputs solver
+ */
+class ReferenceInputsStages : public ReferenceInputsSolver {
+ public:
+  using ReferenceInputsSolver::BodyratesSystem;
+  using ReferenceInputsSolver::computeReferenceOrientation;
+  using ReferenceInputsSolver::computeReferenceCollectiveThrust;
+  using ReferenceInputsSolver::computeReferenceBodyrates;
+  using ReferenceInputsSolver::computeReferenceAngularAcceleration;
+  using ReferenceInputsSolver::computeRobustBodyXAxis;
+  using ReferenceInputsSolver::computeRobustBodyYAxis;
+};
+
+/**
+ *  @brief  Inputs of each pipeline stage, computed by the preceding stages
+ */
+struct StageInputs {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  Eigen::Vector3d x_C, y_C;
+  Eigen::Matrix3d R;
+  double c;
+  ReferenceInputsStages::BodyratesSystem system;
+  Eigen::Vector3d bodyrates;
+};
+typedef std::vector<StageInputs, Eigen::aligned_allocator<StageInputs>> StagesInputs;
+
+/**
+ *  @brief  Trajectory fixture, state estimates and stage inputs of a benchmark
+ */
+struct Fixture {
+  explicit Fixture(const TrajectoryFixture fixture)
+      : reference_states(benchmark_fixtures::makeTrajectory(fixture, kPoints)),
+        state_estimates(benchmark_fixtures::makeStateEstimates(reference_states)),
+        stage_inputs(kPoints) {
+    for (int i = 0; i < kPoints; ++i) {
+      StageInputs& inputs = stage_inputs[i];
+      const double phi = reference_states[i].heading;
+      inputs.x_C = Eigen::Vector3d(std::cos(phi), std::sin(phi), 0.0);
+      inputs.y_C = Eigen::Vector3d(-std::sin(phi), std::cos(phi), 0.0);
+      stages.computeReferenceOrientation(state_estimates[i], reference_states[i],
+                                         inputs.x_C, inputs.y_C, inputs.R);
+      inputs.c = stages.computeReferenceCollectiveThrust(reference_states[i], inputs.R.col(2));
+      stages.computeReferenceBodyrates(reference_states[i], inputs.x_C, inputs.y_C,
+                                       inputs.R, inputs.c, inputs.system, inputs.bodyrates);
+    }
+  }
+
+  TrajectoryPoints reference_states;
+  StateEstimates state_estimates;
+  StagesInputs stage_inputs;
+  ReferenceInputsStages stages;
+};
+
+/**
+ *  @brief  Register a benchmark for every trajectory fixture
+ */
+void fixtureArguments(benchmark::internal::Benchmark* benchmark) {
+  benchmark->DenseRange(benchmark_fixtures::kHover, benchmark_fixtures::kNearFreeFall);
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  End to end one-shot ReferenceInputs
+ */
+static void BM_ReferenceInputs(benchmark::State& state) {
+  const TrajectoryFixture trajectory = static_cast<TrajectoryFixture>(state.range(0));
+  const Fixture fixture(trajectory);
+
+  for (auto _ : state) {
+    for (int i = 0; i < kPoints; ++i) {
+      const ReferenceInputs reference_inputs(fixture.state_estimates[i],
+                                             fixture.reference_states[i]);
+      benchmark::DoNotOptimize(&reference_inputs.getReferenceInputs());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+  state.SetLabel(benchmark_fixtures::name(trajectory));
+}
+BENCHMARK(BM_ReferenceInputs)->Apply(fixtureArguments);
+
+/**
+ *  @brief  End to end persistent ReferenceInputsSolver, with the mean cycles per stage
+ *          if built with POSITION_CONTROLLER_STAGE_PROFILING
+ */
+static void BM_ReferenceInputsSolver(benchmark::State& state) {
+  const TrajectoryFixture trajectory = static_cast<TrajectoryFixture>(state.range(0));
+  const Fixture fixture(trajectory);
+  ReferenceInputsSolver solver;
+  quadrotor_common::QuadrotorControlCommand reference_inputs;
+  StageProfiler::reset();
+
+  for (auto _ : state) {
+    for (int i = 0; i < kPoints; ++i) {
+      solver.solve(fixture.state_estimates[i], fixture.reference_states[i], reference_inputs);
+      benchmark::DoNotOptimize(&reference_inputs);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+  state.SetLabel(benchmark_fixtures::name(trajectory));
+
+  for (int stage = 0; StageProfiler::enabled() && stage < static_cast<int>(Stage::kNumStages); ++stage) {
+    const StageStatistics statistics = StageProfiler::statistics(static_cast<Stage>(stage));
+    state.counters[StageProfiler::name(static_cast<Stage>(stage))] = statistics.meanCycles();
+  } //  mean cycles per stage, if instrumented
+}
+BENCHMARK(BM_ReferenceInputsSolver)->Apply(fixtureArguments);
+
+/**
+ *  @brief  Heading frame x_C, y_C from std::cos, std::sin for a stream of consecutive points
+ */
+static void BM_HeadingFrame(benchmark::State& state) {
+  const TrajectoryFixture trajectory = static_cast<TrajectoryFixture>(state.range(0));
+  const TrajectoryPoints reference_states = benchmark_fixtures::makeTrajectory(trajectory, kPoints);
+  Eigen::Vector3d x_C, y_C;
+
+  for (auto _ : state) {
+    for (int i = 0; i < kPoints; ++i) {
+      const double phi = reference_states[i].heading;
+      x_C = Eigen::Vector3d(std::cos(phi), std::sin(phi), 0.0);
+      y_C = Eigen::Vector3d(-std::sin(phi), std::cos(phi), 0.0);
+      benchmark::DoNotOptimize(x_C.data());
+      benchmark::DoNotOptimize(y_C.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+  state.SetLabel(benchmark_fixtures::name(trajectory));
+}
+BENCHMARK(BM_HeadingFrame)->Apply(fixtureArguments);
+
+/**
+ *  @brief  Heading frame x_C, y_C from the HeadingFrameCache for a stream of consecutive points
+ */
+static void BM_HeadingFrameCache(benchmark::State& state) {
+  const TrajectoryFixture trajectory = static_cast<TrajectoryFixture>(state.range(0));
+  const TrajectoryPoints reference_states = benchmark_fixtures::makeTrajectory(trajectory, kPoints);
+  HeadingFrameCache cache;
+  Eigen::Vector3d x_C, y_C;
+
+  for (auto _ : state) {
+    for (int i = 0; i < kPoints; ++i) {
+      cache.update(reference_states[i].heading, x_C, y_C);
+      benchmark::DoNotOptimize(x_C.data());
+      benchmark::DoNotOptimize(y_C.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+  state.SetLabel(benchmark_fixtures::name(trajectory));
+}
+BENCHMARK(BM_HeadingFrameCache)->Apply(fixtureArguments);
+
+/**
+ *  @brief  Orientation stage, i.e. robust x_B, y_B and z_B
+ */
+static void BM_ReferenceOrientation(benchmark::State& state) {
+  const TrajectoryFixture trajectory = static_cast<TrajectoryFixture>(state.range(0));
+  const Fixture fixture(trajectory);
+  Eigen::Matrix3d R;
+
+  for (auto _ : state) {
+    for (int i = 0; i < kPoints; ++i) {
+      const StageInputs& inputs = fixture.stage_inputs[i];
+      fixture.stages.computeReferenceOrientation(
+          fixture.state_estimates[i], fixture.reference_states[i], inputs.x_C, inputs.y_C, R);
+      benchmark::DoNotOptimize(R.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+  state.SetLabel(benchmark_fixtures::name(trajectory));
+}
+BENCHMARK(BM_ReferenceOrientation)->Apply(fixtureArguments);
+
+/**
+ *  @brief  Collective thrust stage
+ */
+static void BM_ReferenceCollectiveThrust(benchmark::State& state) {
+  const TrajectoryFixture trajectory = static_cast<TrajectoryFixture>(state.range(0));
+  const Fixture fixture(trajectory);
+
+  for (auto _ : state) {
+    for (int i = 0; i < kPoints; ++i) {
+      const double c = fixture.stages.computeReferenceCollectiveThrust(
+          fixture.reference_states[i], fixture.stage_inputs[i].R.col(2));
+      benchmark::DoNotOptimize(c);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+  state.SetLabel(benchmark_fixtures::name(trajectory));
+}
+BENCHMARK(BM_ReferenceCollectiveThrust)->Apply(fixtureArguments);
+
+/**
+ *  @brief  Bodyrates stage, including the coefficients of the bodyrates system
+ */
+static void BM_ReferenceBodyrates(benchmark::State& state) {
+  const TrajectoryFixture trajectory = static_cast<TrajectoryFixture>(state.range(0));
+  const Fixture fixture(trajectory);
+  ReferenceInputsStages::BodyratesSystem system;
+  Eigen::Vector3d bodyrates;
+
+  for (auto _ : state) {
+    for (int i = 0; i < kPoints; ++i) {
+      const StageInputs& inputs = fixture.stage_inputs[i];
+      fixture.stages.computeReferenceBodyrates(
+          fixture.reference_states[i], inputs.x_C, inputs.y_C, inputs.R, inputs.c,
+          system, bodyrates);
+      benchmark::DoNotOptimize(bodyrates.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+  state.SetLabel(benchmark_fixtures::name(trajectory));
+}
+BENCHMARK(BM_ReferenceBodyrates)->Apply(fixtureArguments);
+
+/**
+ *  @brief  Angular acceleration stage
+ */
+static void BM_ReferenceAngularAcceleration(benchmark::State& state) {
+  const TrajectoryFixture trajectory = static_cast<TrajectoryFixture>(state.range(0));
+  const Fixture fixture(trajectory);
+  Eigen::Vector3d angular_acceleration;
+
+  for (auto _ : state) {
+    for (int i = 0; i < kPoints; ++i) {
+      const StageInputs& inputs = fixture.stage_inputs[i];
+      fixture.stages.computeReferenceAngularAcceleration(
+          fixture.reference_states[i], inputs.x_C, inputs.y_C, inputs.R, inputs.c,
+          inputs.system, inputs.bodyrates, angular_acceleration);
+      benchmark::DoNotOptimize(angular_acceleration.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+  state.SetLabel(benchmark_fixtures::name(trajectory));
+}
+BENCHMARK(BM_ReferenceAngularAcceleration)->Apply(fixtureArguments);
+
+/**
+ *  @brief  Robust x_B, regular branch (circle) and singular branch (near free fall)
+ */
+static void BM_RobustBodyXAxis(benchmark::State& state) {
+  const bool singular = state.range(0);
+  const Fixture fixture(singular ? benchmark_fixtures::kNearFreeFall
+                                 : benchmark_fixtures::kCircle);
+
+  for (auto _ : state) {
+    for (int i = 0; i < kPoints; ++i) {
+      const StageInputs& inputs = fixture.stage_inputs[i];
+      const Eigen::Vector3d x_B = fixture.stages.computeRobustBodyXAxis(
+          fixture.state_estimates[i], fixture.reference_states[i], inputs.x_C, inputs.y_C);
+      benchmark::DoNotOptimize(x_B.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+  state.SetLabel(singular ? "singular" : "regular");
+}
+BENCHMARK(BM_RobustBodyXAxis)->Arg(0)->Arg(1);
+
+/**
+ *  @brief  Robust y_B, regular branch (circle) and singular branch (x_B collinear to beta)
+ */
+static void BM_RobustBodyYAxis(benchmark::State& state) {
+  const bool singular = state.range(0);
+  const Fixture fixture(benchmark_fixtures::kCircle);
+
+  std::vector<Eigen::Vector3d> x_B(kPoints);
+  for (int i = 0; i < kPoints; ++i) {
+    const Eigen::Vector3d beta =
+        fixture.reference_states[i].acceleration + Eigen::Vector3d(0.0, 0.0, 9.81);
+    x_B[i] = singular ? beta.normalized() : Eigen::Vector3d(fixture.stage_inputs[i].R.col(0));
+  }
+
+  for (auto _ : state) {
+    for (int i = 0; i < kPoints; ++i) {
+      const Eigen::Vector3d y_B = fixture.stages.computeRobustBodyYAxis(
+          fixture.state_estimates[i], fixture.reference_states[i],
+          fixture.stage_inputs[i].y_C, x_B[i]);
+      benchmark::DoNotOptimize(y_B.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+  state.SetLabel(singular ? "singular" : "regular");
+}
+BENCHMARK(BM_RobustBodyYAxis)->Arg(0)->Arg(1);
+
+} /*  namespace position_controller  */
@@ -0,0 +1,168 @@
+/**
+ *  @file   benchmark_reference_inputs_models.cpp
+ *  @brief  quadrotor position control's reference inputs models dispatch related functionality benchmarks
+ *  @author thor
+ *  @date   04.12.2021
+ */
+#include "reference_inputs/reference_inputs_registry.h"
+
+//  std dependencies
+#include <string>
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+
+//  position_controller dependencies
+#include "reference_inputs/aero_compensated_reference_inputs.h"
+#include "reference_inputs/nominal_reference_inputs.h"
+#include "trajectory_fixtures.h"
+
+namespace position_controller {
+
+namespace {
+
+using benchmark_fixtures::StateEstimates;
+using benchmark_fixtures::TrajectoryFixture;
+using benchmark_fixtures::TrajectoryPoints;
+
+//  @brief  Number of sampled points per trajectory fixture
+constexpr int kPoints = 1024;
+
+typedef std::vector<quadrotor_common::QuadrotorControlCommand,
+    Eigen::aligned_allocator<quadrotor_common::QuadrotorControlCommand>> ControlCommands;
+
+/**
+ *  @brief  The former virtual interface of the reference inputs, i.e. one indirect call per stage
+ */
+class VirtualReferenceInputs {
+ public:
+  virtual ~VirtualReferenceInputs() {}
+  virtual Eigen::Quaterniond computeDesiredAttitude() const = 0;
+  virtual double computeDesiredCollectiveThrust(const Eigen::Quaterniond& q_W_B) const = 0;
+  virtual Eigen::Vector3d computeDesiredBodyRates(
+      const Eigen::Quaterniond& q_W_B, const double collective_thrust) const = 0;
+};
+
+/**
+ *  @brief  The reference inputs model behind the virtual interface
+ */
+template <typename Model>
+class VirtualModel : public VirtualReferenceInputs {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  VirtualModel(const quadrotor_common::QuadrotorStateEstimate& state_estimate,
+               const quadrotor_common::QuadrotorTrajectoryPoint& reference_state,
+               const ReferenceInputsParameters& parameters)
+      : model(state_estimate, reference_state, parameters) {}
+
+  Eigen::Quaterniond computeDesiredAttitude() const override {
+    return model.computeDesiredAttitude();
+  }
+  double computeDesiredCollectiveThrust(const Eigen::Quaterniond& q_W_B) const override {
+    return model.computeDesiredCollectiveThrust(q_W_B);
+  }
+  Eigen::Vector3d computeDesiredBodyRates(
+      const Eigen::Quaterniond& q_W_B, const double collective_thrust) const override {
+    return model.computeDesiredBodyRates(q_W_B, collective_thrust);
+  }
+
+ private:
+  const Model model;
+};
+
+/**
+ *  @brief  Trajectory fixture and its output buffer
+ */
+struct Fixture {
+  explicit Fixture(const TrajectoryFixture trajectory)
+      : reference_states(benchmark_fixtures::makeTrajectory(trajectory, kPoints)),
+        state_estimates(benchmark_fixtures::makeStateEstimates(reference_states)),
+        commands(kPoints) {
+    parameters.rotor_drag_coefficients = Eigen::Vector3d(0.4, 0.3, 0.1);
+  }
+
+  TrajectoryPoints reference_states;
+  StateEstimates state_estimates;
+  ControlCommands commands;
+  ReferenceInputsParameters parameters;
+};
+
+void fixtureArguments(benchmark::internal::Benchmark* benchmark) {
+  benchmark->DenseRange(benchmark_fixtures::kHover, benchmark_fixtures::kNearFreeFall);
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  Stages called through the virtual interface, i.e. the former dispatch
+ */
+template <typename Model>
+static void BM_VirtualReferenceInputs(benchmark::State& state) {
+  const TrajectoryFixture trajectory = static_cast<TrajectoryFixture>(state.range(0));
+  Fixture fixture(trajectory);
+
+  for (auto _ : state) {
+    for (int i = 0; i < kPoints; ++i) {
+      const VirtualModel<Model> model(
+          fixture.state_estimates[i], fixture.reference_states[i], fixture.parameters);
+      //  hide the dynamic type, i.e. the stages are called indirectly as through a base pointer
+      const VirtualReferenceInputs* reference_inputs = &model;
+      benchmark::DoNotOptimize(reference_inputs);
+
+      quadrotor_common::QuadrotorControlCommand& command = fixture.commands[i];
+      command.orientation = reference_inputs->computeDesiredAttitude();
+      command.collective_thrust = reference_inputs->computeDesiredCollectiveThrust(
+          command.orientation);
+      command.bodyrates = reference_inputs->computeDesiredBodyRates(
+          command.orientation, command.collective_thrust);
+    }
+    benchmark::DoNotOptimize(fixture.commands.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+  state.SetLabel(benchmark_fixtures::name(trajectory));
+}
+BENCHMARK_TEMPLATE(BM_VirtualReferenceInputs, NominalReferenceInputs)->Apply(fixtureArguments);
+BENCHMARK_TEMPLATE(BM_VirtualReferenceInputs, AeroCompensatedReferenceInputs)->Apply(fixtureArguments);
+
+/**
+ *  @brief  Stages bound at compile time
+ */
+template <typename Model>
+static void BM_StaticReferenceInputs(benchmark::State& state) {
+  const TrajectoryFixture trajectory = static_cast<TrajectoryFixture>(state.range(0));
+  Fixture fixture(trajectory);
+
+  for (auto _ : state) {
+    computeReferenceInputs<Model>(fixture.state_estimates.data(), fixture.reference_states.data(),
+        kPoints, fixture.parameters, fixture.commands.data());
+    benchmark::DoNotOptimize(fixture.commands.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+  state.SetLabel(benchmark_fixtures::name(trajectory));
+}
+BENCHMARK_TEMPLATE(BM_StaticReferenceInputs, NominalReferenceInputs)->Apply(fixtureArguments);
+BENCHMARK_TEMPLATE(BM_StaticReferenceInputs, AeroCompensatedReferenceInputs)->Apply(fixtureArguments);
+
+/**
+ *  @brief  Model picked by name from the registry, i.e. one indirect call per batch
+ */
+static void BM_RegistryReferenceInputs(benchmark::State& state) {
+  const TrajectoryFixture trajectory = static_cast<TrajectoryFixture>(state.range(0));
+  Fixture fixture(trajectory);
+  const std::string name = state.range(1) ? "aero_compensated" : "nominal";
+  const ReferenceInputsFunction function = ReferenceInputsRegistry::find(name);
+
+  for (auto _ : state) {
+    function(fixture.state_estimates.data(), fixture.reference_states.data(),
+        kPoints, fixture.parameters, fixture.commands.data());
+    benchmark::DoNotOptimize(fixture.commands.data());
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+  state.SetLabel(std::string(benchmark_fixtures::name(trajectory)) + " " + name);
+}
+BENCHMARK(BM_RegistryReferenceInputs)->ArgsProduct({
+    benchmark::CreateDenseRange(benchmark_fixtures::kHover, benchmark_fixtures::kNearFreeFall, 1),
+    {0, 1}});
+
+} /*  namespace position_controller  */
@@ -0,0 +1,47 @@
+/**
+ *  @file   benchmark_rotor_drag_estimator.cpp
+ *  @brief  quadrotor position control's online rotor drag identification related functionality benchmarks
+ *  @author thor
+ *  @date   18.12.2021
+ */
+#include "position_controller/rotor_drag_estimator.h"
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+
+//  position_controller dependencies
+#include "trajectory_fixtures.h"
+
+namespace position_controller {
+
+namespace {
+
+//  @brief  Number of sampled points per trajectory fixture
+constexpr int kPoints = 1024;
+
+}  /*  namespace  */
+
+/**
+ *  @brief  RotorDragEstimator::update() along the circle fixture, one state estimate per point,
+ *          published every sample, i.e. the worst case of the estimator thread
+ */
+static void BM_RotorDragEstimatorUpdate(benchmark::State& state) {
+  const benchmark_fixtures::TrajectoryPoints reference_states =
+      benchmark_fixtures::makeTrajectory(benchmark_fixtures::kCircle, kPoints);
+  const benchmark_fixtures::StateEstimates state_estimates =
+      benchmark_fixtures::makeStateEstimates(reference_states);
+  RotorDragEstimatorParameters parameters;
+  parameters.publish_decimation = state.range(0);
+  RotorDragMailbox rotor_drags;
+  RotorDragEstimator estimator(parameters, rotor_drags);
+
+  for (auto _ : state) {
+    for (int i = 0; i < kPoints; ++i) {
+      benchmark::DoNotOptimize(estimator.update(state_estimates[i], 9.81, 0.001));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+}
+BENCHMARK(BM_RotorDragEstimatorUpdate)->Arg(1)->Arg(100);
+
+} /*  namespace position_controller  */
@@ -0,0 +1,141 @@
+/**
+ *  @file   trajectory_fixtures.h
+ *  @brief  quadrotor position control's benchmark trajectory fixtures declaration & definition
+ *  @author thor
+ *  @date   30.11.2021
+ */
+#ifndef POSITION_CONTROLLER_BENCHMARK_TRAJECTORY_FIXTURES_H
+#define POSITION_CONTROLLER_BENCHMARK_TRAJECTORY_FIXTURES_H
+
+//  std dependencies
+#include <cmath>
+#include <vector>
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+//  quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_state_estimate.h"
+#include "quadrotor_common/quadrotor_trajectory_point.h"
+
+namespace position_controller {
+namespace benchmark_fixtures {
+
+typedef std::vector<quadrotor_common::QuadrotorStateEstimate,
+    Eigen::aligned_allocator<quadrotor_common::QuadrotorStateEstimate>> StateEstimates;
+typedef std::vector<quadrotor_common::QuadrotorTrajectoryPoint,
+    Eigen::aligned_allocator<quadrotor_common::QuadrotorTrajectoryPoint>> TrajectoryPoints;
+
+/**
+ *  @brief  TrajectoryFixture enum implementation.
+ *  @detail Analytic reference trajectories, sampled over one period:
+ *            + kHover          - hover at 1m with constant heading
+ *            + kCircle         - 2m radius circle at 2 rad/s, heading along the velocity
+ *            + kLemniscate     - 3m x 1.5m figure eight (lemniscate of Gerono) at 1 rad/s
+ *            + kNearFreeFall   - falling with almost zero thrust, i.e. the singular branches
+ *                                of the robust body axes
+ */
+enum TrajectoryFixture {
+  kHover,
+  kCircle,
+  kLemniscate,
+  kNearFreeFall
+};
+
+/**
+ *  @brief  Name of the trajectory fixture, used as benchmark label
+ */
+inline const char* name(const TrajectoryFixture fixture) {
+  switch (fixture) {
+    case kHover:        return "hover";
+    case kCircle:       return "circle";
+    case kLemniscate:   return "lemniscate";
+    case kNearFreeFall: return "near_free_fall";
+  }
+  return "unknown";
+}
+
+/**
+ *  @brief  Sample n points of the reference trajectory fixture
+ */
+inline TrajectoryPoints makeTrajectory(const TrajectoryFixture fixture, const int n) {
+  constexpr double kPi = 3.14159265358979323846;
+  TrajectoryPoints points(n);
+  for (int i = 0; i < n; ++i) {
+    quadrotor_common::QuadrotorTrajectoryPoint& point = points[i];
+    const double phase = 2.0 * kPi * i / n;
+    switch (fixture) {
+      case kHover: {
+        point.position = Eigen::Vector3d(0.0, 0.0, 1.0);
+        point.heading = 0.3;
+        break;
+      }
+      case kCircle: {
+        //  p = r[cos(wt) sin(wt) h/r]^T
+        const double r = 2.0, w = 2.0;
+        const double c = std::cos(phase), s = std::sin(phase);
+        point.position = Eigen::Vector3d(r*c, r*s, 1.0);
+        point.velocity = r*w * Eigen::Vector3d(-s, c, 0.0);
+        point.acceleration = r*w*w * Eigen::Vector3d(-c, -s, 0.0);
+        point.jerk = r*w*w*w * Eigen::Vector3d(s, -c, 0.0);
+        point.snap = r*w*w*w*w * Eigen::Vector3d(c, s, 0.0);
+        point.heading = std::atan2(c, -s);
+        point.heading_rate = w;
+        break;
+      }
+      case kLemniscate: {
+        //  p = [a sin(wt)  b sin(2wt)  h]^T, the k-th derivative of sin(x) is sin(x + k.pi/2)
+        const double a = 3.0, b = 1.5, w = 1.0;
+        for (int k = 0; k <= 4; ++k) {
+          const Eigen::Vector3d derivative(
+              a * std::pow(w, k) * std::sin(phase + k * kPi / 2),
+              b * std::pow(2*w, k) * std::sin(2*phase + k * kPi / 2),
+              0.0);
+          switch (k) {
+            case 0: point.position = derivative + Eigen::Vector3d(0.0, 0.0, 1.0); break;
+            case 1: point.velocity = derivative; break;
+            case 2: point.acceleration = derivative; break;
+            case 3: point.jerk = derivative; break;
+            case 4: point.snap = derivative; break;
+          }
+        }
+        point.heading = 0.2 * std::sin(phase);
+        point.heading_rate = 0.2 * w * std::cos(phase);
+        point.heading_acceleration = -0.2 * w * w * std::sin(phase);
+        break;
+      }
+      case kNearFreeFall: {
+        //  |a + g.z_W| well below the almost zero value threshold of the robust axes
+        const double t = 0.5 * i / n;
+        point.position = Eigen::Vector3d(0.0, 0.0, 10.0 - 0.5 * 9.81 * t * t);
+        point.velocity = Eigen::Vector3d(0.0, 0.0, -9.81 * t);
+        point.acceleration = Eigen::Vector3d(1e-4 * std::sin(phase), 0.0, -9.81 + 1e-4);
+        point.jerk = Eigen::Vector3d(1e-3, -1e-3, 0.0);
+        point.heading = 0.5;
+        point.heading_rate = 0.1;
+        break;
+      }
+    }
+  }
+  return points;
+}
+
+/**
+ *  @brief  Sample n state estimates slightly tilted off the reference trajectory fixture
+ */
+inline StateEstimates makeStateEstimates(const TrajectoryPoints& points) {
+  StateEstimates state_estimates(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    state_estimates[i].position = points[i].position + Eigen::Vector3d(0.05, -0.02, 0.01);
+    state_estimates[i].velocity = points[i].velocity;
+    state_estimates[i].orientation = Eigen::Quaterniond(
+        Eigen::AngleAxisd(points[i].heading, Eigen::Vector3d::UnitZ()) *
+        Eigen::AngleAxisd(0.05, Eigen::Vector3d::UnitX()));
+  }
+  return state_estimates;
+}
+
+} /*  namespace benchmark_fixtures  */
+} /*  namespace position_controller  */
+
+#endif  /*  POSITION_CONTROLLER_BENCHMARK_TRAJECTORY_FIXTURES_H  */
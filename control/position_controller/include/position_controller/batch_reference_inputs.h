@@ -0,0 +1,118 @@
+/**
+ *  @file   batch_reference_inputs.h
+ *  @brief  quadrotor position control's batched reference inputs related functionality declaration & definition
+ *  @author thor
+ *  @date   24.11.2021
+ */
+#ifndef POSITION_CONTROLLER_BATCH_REFERENCE_INPUTS_H
+#define POSITION_CONTROLLER_BATCH_REFERENCE_INPUTS_H
+
+//  std dependencies
+#include <cstddef>
+
+//  quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_control_command.h"
+#include "quadrotor_common/quadrotor_state_estimate.h"
+#include "quadrotor_common/quadrotor_trajectory_point.h"
+
+//  position_controller dependencies
+#include "position_controller/reference_inputs_solver.h"
+#include "position_controller/rotor_drag_models.h"
+
+namespace position_controller {
+
+/**
+ *  @brief  BatchReferenceInputs class implementation
+ *  @detail Compute the reference inputs (see ReferenceInputsSolver) for whole spans of
+ *          state estimate / reference state pairs. The pairs are processed in
+ *          blocks of lanes() points in struct-of-arrays form, so that each equation
+ *          maps to one SIMD instruction per block:
+ *            + 8 (double) or 16 (float) lanes with AVX-512
+ *            + 4 (double) or 8 (float) lanes with AVX/AVX2
+ *            + 2 (double) or 4 (float) lanes with SSE2
+ *          The instruction set is selected by the compiler flags (e.g. -march=native).
+ *          Lanes hitting the singular branches of the robust body axes are
+ *          recomputed with the scalar ReferenceInputsSolver path, without its heading frame
+ *          cache, i.e. every lane depends on its own pair only, whatever the lane order,
+ *          the chunking and the number of threads, and compute() is thread safe.
+ *  @tparam RotorDragModel  - rotor drag policy, see rotor_drag_models.h
+ */
+template <typename RotorDragModel>
+class BatchReferenceInputs_ {
+ public:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    typedef typename ReferenceInputsSolver_<RotorDragModel>::StateEstimate StateEstimate;
+    typedef typename ReferenceInputsSolver_<RotorDragModel>::TrajectoryPoint TrajectoryPoint;
+    typedef typename ReferenceInputsSolver_<RotorDragModel>::ControlCommand ControlCommand;
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  BatchReferenceInputs' default constructor, called when an instance is created
+     *  @param  rotor_drag  - rotor drag constants
+     */
+    explicit BatchReferenceInputs_(const RotorDragModel& rotor_drag = RotorDragModel());
+
+    /**
+     *  @brief  BatchReferenceInputs' default destructor, called when an instance is destroyed
+     */
+    ~BatchReferenceInputs_();
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Compute the reference inputs for n state estimate / reference state pairs
+     *  @detail Only the orientation, collective thrust, bodyrates and angular acceleration
+     *          of the output commands are written, i.e. timestamp and control mode are kept.
+     *  @param  state_estimates   - n quadrotor's current state estimates
+     *  @param  reference_states  - n quadrotor's reference states to track
+     *  @param  reference_inputs  - n output quadrotor's reference inputs
+     *  @param  n                 - number of points
+     */
+    void compute(
+        const StateEstimate* state_estimates,
+        const TrajectoryPoint* reference_states,
+        ControlCommand* reference_inputs,
+        const std::size_t n) const;
+
+    /**
+     *  @brief  Number of points processed at once, depends on the enabled instruction set
+     */
+    static int lanes();
+
+ private:
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    //  @brief  Scalar solver for the singular lanes, see ReferenceInputsSolver::solveUncached()
+    ReferenceInputsSolver_<RotorDragModel> solver_;
+
+    //  @brief  Rotor drag constants
+    RotorDragModel rotor_drag_;
+
+};  /*  class BatchReferenceInputs_  */
+
+extern template class BatchReferenceInputs_<NoRotorDrag>;
+extern template class BatchReferenceInputs_<IsotropicRotorDrag>;
+extern template class BatchReferenceInputs_<AnisotropicRotorDrag>;
+extern template class BatchReferenceInputs_<NoRotorDragf>;
+extern template class BatchReferenceInputs_<IsotropicRotorDragf>;
+extern template class BatchReferenceInputs_<AnisotropicRotorDragf>;
+
+//  @brief  Batched reference inputs of the nominal dynamics
+typedef BatchReferenceInputs_<NoRotorDrag> BatchReferenceInputs;
+typedef BatchReferenceInputs_<NoRotorDragf> BatchReferenceInputsf;
+
+} /*  namespace position_controller  */
+
+#endif  /*  POSITION_CONTROLLER_BATCH_REFERENCE_INPUTS_H  */
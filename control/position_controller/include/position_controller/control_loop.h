@@ -0,0 +1,117 @@
+/**
+ *  @file   control_loop.h
+ *  @brief  quadrotor position control's real time inner loop related functionality declaration & definition
+ *  @author thor
+ *  @date   07.12.2021
+ */
+#ifndef POSITION_CONTROLLER_CONTROL_LOOP_H
+#define POSITION_CONTROLLER_CONTROL_LOOP_H
+
+//  std dependencies
+#include <cstdint>
+#include <functional>
+
+//  quadrotor_common dependencies
+#include "quadrotor_common/latest_value_mailbox.h"
+#include "quadrotor_common/quadrotor_control_command.h"
+#include "quadrotor_common/quadrotor_state_estimate.h"
+#include "quadrotor_common/quadrotor_trajectory_point.h"
+
+//  position_controller dependencies
+#include "position_controller/position_controller.h"
+#include "position_controller/realtime_executor.h"
+
+namespace position_controller {
+
+//  @brief  Mailbox of the control commands, from the control thread into the actuation
+typedef quadrotor_common::LatestValueMailbox<quadrotor_common::QuadrotorControlCommand> ControlCommandMailbox;
+
+/**
+ *  @brief  ControlLoop class implementation
+ *  @detail The PositionController on a RealTimeExecutor: every tick takes the latest state
+ *          estimate from its mailbox, samples the reference state and publishes the control
+ *          command into the command mailbox, i.e. the loop is the consumer of the state
+ *          estimates and the producer of the commands and never waits for either side.
+ */
+class ControlLoop {
+ public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    //  @brief  Reference state of a tick, written into the given trajectory point, must not throw
+    typedef std::function<void(std::uint64_t, quadrotor_common::QuadrotorTrajectoryPoint&)> ReferenceSource;
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  ControlLoop's default constructor, called when an instance is created
+     *  @param  parameters        - loop rate and real time setup, see RealTimeExecutor
+     *  @param  state_estimates   - mailbox the state estimates are published into
+     *  @param  reference_source  - reference state of every tick
+     *  @param  control_commands  - mailbox the control commands are published into
+     *  @throw  std::invalid_argument if the loop rate is not positive and finite
+     */
+    ControlLoop(
+        const RealTimeExecutorParameters& parameters,
+        quadrotor_common::StateEstimateMailbox& state_estimates,
+        const ReferenceSource& reference_source,
+        ControlCommandMailbox& control_commands);
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Start the loop on its own thread, see RealTimeExecutor::start()
+     */
+    void start() { executor_.start(); }
+
+    /**
+     *  @brief  Stop the loop, see RealTimeExecutor::stop()
+     */
+    void stop() { executor_.stop(); }
+
+    /**
+     *  @brief  Deadline misses, jitter and overruns of the loop
+     */
+    RealTimeExecutorStatistics statistics() const { return executor_.statistics(); }
+
+ private:
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  One control tick
+     */
+    void tick(const std::uint64_t tick);
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    //  @brief  The loop's inputs and outputs
+    quadrotor_common::StateEstimateMailbox& state_estimates_;
+    const ReferenceSource reference_source_;
+    ControlCommandMailbox& control_commands_;
+
+    //  @brief  The reference state of the current tick
+    quadrotor_common::QuadrotorTrajectoryPoint reference_state_;
+
+    //  @brief  The controller, only used by the loop thread
+    PositionController position_controller_;
+
+    //  @brief  The fixed rate loop, last member, i.e. stopped before the others are destroyed
+    RealTimeExecutor executor_;
+
+};  /*  class ControlLoop  */
+
+} /*  namespace position_controller  */
+
+#endif  /*  POSITION_CONTROLLER_CONTROL_LOOP_H  */
@@ -0,0 +1,204 @@
+/**
+ *  @file   feedforward_table.h
+ *  @brief  quadrotor position control's precomputed reference inputs related functionality declaration & definition
+ *  @author thor
+ *  @date   11.12.2021
+ */
+#ifndef POSITION_CONTROLLER_FEEDFORWARD_TABLE_H
+#define POSITION_CONTROLLER_FEEDFORWARD_TABLE_H
+
+//  std dependencies
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+//  position_controller dependencies
+#include "position_controller/reference_inputs_solver.h"
+#include "position_controller/rotor_drag_models.h"
+
+namespace position_controller {
+
+/**
+ *  @brief  FeedforwardTable class implementation
+ *  @detail Reference inputs (see ReferenceInputsSolver) of a trajectory known ahead of time,
+ *          e.g. a pre-planned mission: compile() samples the trajectory at a fixed dt and
+ *          stores the orientation, collective thrust, bodyrates and angular acceleration of
+ *          every sample in single precision, 48 bytes per sample, i.e. 2.9 MB per minute
+ *          at 1 kHz or 290 kB at 100 Hz. lookup() serves a time by indexing the two neighbouring samples
+ *          in O(1) and interpolating them, linearly and the orientation by normalized linear
+ *          interpolation. Samples in which the solver takes a singular branch of the robust
+ *          body axes depend on the state estimate (see isStateDependent()) and are marked
+ *          live: times next to a live sample are computed by the solver at the time of the
+ *          lookup, see compute(). Times outside the table are clamped to its first or last sample.
+ *  @tparam RotorDragModel  - rotor drag policy of the solver, see rotor_drag_models.h
+ */
+template <typename RotorDragModel>
+class FeedforwardTable_ {
+ public:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    typedef ReferenceInputsSolver_<RotorDragModel> Solver;
+    typedef typename Solver::StateEstimate StateEstimate;
+    typedef typename Solver::TrajectoryPoint TrajectoryPoint;
+    typedef typename Solver::ControlCommand ControlCommand;
+
+    //  @brief  Sample the reference state of the trajectory at the given time
+    typedef std::function<void(double, TrajectoryPoint&)> Sampler;
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  FeedforwardTable's default constructor, called when an instance is created
+     *  @param  rotor_drag  - rotor drag constants of the solver
+     */
+    explicit FeedforwardTable_(const RotorDragModel& rotor_drag = RotorDragModel());
+
+    /**
+     *  @brief  FeedforwardTable's default destructor, called when an instance is destroyed
+     */
+    ~FeedforwardTable_();
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Compile the table of the trajectory, replacing the previous one
+     *  @param  sampler     - reference states of the trajectory
+     *  @param  start_time  - time of the first sample [s]
+     *  @param  end_time    - time of the last sample at most [s]
+     *  @param  dt          - sample period [s]
+     *  @return boolean value where
+     *            + true  - Indicates the table has been compiled
+     *            + false - Otherwise, i.e. dt is not positive or end_time before start_time
+     */
+    bool compile(const Sampler& sampler, const double start_time, const double end_time, const double dt);
+
+    /**
+     *  @brief  Interpolate the reference inputs at the time from the table
+     *  @detail Only the orientation, collective thrust, bodyrates and angular acceleration
+     *          of the output command are written, as by ReferenceInputsSolver::solve().
+     *  @return boolean value where
+     *            + true  - Indicates the reference inputs have been written
+     *            + false - Otherwise, i.e. the table is empty or the time is next to a
+     *                      live sample, the output is left unchanged
+     */
+    bool lookup(const double time, ControlCommand& reference_inputs) const;
+
+    /**
+     *  @brief  Reference inputs at the time, from the table or, next to a live sample or
+     *          for an empty table, from the solver
+     *  @param  time              - reference time [s]
+     *  @param  state_estimate    - quadrotor's current state estimate
+     *  @param  reference_state   - quadrotor's reference state at the time
+     *  @param  reference_inputs  - output quadrotor's reference inputs
+     */
+    void compute(
+        const double time,
+        const StateEstimate& state_estimate,
+        const TrajectoryPoint& reference_state,
+        ControlCommand& reference_inputs);
+
+    /**
+     *  @brief  Accessors for the table
+     */
+    std::size_t size() const { return samples_.size(); }
+    bool empty() const { return samples_.empty(); }
+    double startTime() const { return start_time_; }
+    double dt() const { return dt_; }
+    double endTime() const { return start_time_ + (empty() ? 0.0 : (size() - 1) * dt_); }
+    std::size_t numLiveSamples() const;
+
+ private:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    /**
+     *  @brief  Reference inputs of a sample, single precision
+     */
+    struct Sample {
+      float orientation[4];           //  w, x, y, z, in the hemisphere of the previous sample
+      float collective_thrust;
+      float bodyrates[3];
+      float angular_acceleration[3];
+      std::uint32_t live;             //  depends on the state estimate
+    };  /*  struct Sample  */
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    //  @brief  The solver compiling the table and computing the live samples
+    Solver solver_;
+
+    //  @brief  The samples at start_time_ + i*dt_
+    std::vector<Sample> samples_;
+    double start_time_;
+    double dt_;
+    double inverse_dt_;
+
+};  /*  class FeedforwardTable_  */
+
+extern template class FeedforwardTable_<NoRotorDrag>;
+extern template class FeedforwardTable_<IsotropicRotorDrag>;
+extern template class FeedforwardTable_<AnisotropicRotorDrag>;
+
+typedef FeedforwardTable_<NoRotorDrag> FeedforwardTable;
+
+/**
+ *  @detail O(1) index of the left sample, both samples are interpolated in double precision.
+ */
+template <typename RotorDragModel>
+inline bool FeedforwardTable_<RotorDragModel>::lookup(
+    const double time, ControlCommand& reference_inputs) const {
+  if (samples_.empty()) {
+    return false;
+  } //  empty table
+
+  const double s = (time - start_time_) * inverse_dt_;
+  const std::size_t last = samples_.size() - 1;
+  std::size_t i = 0;
+  double w = 0.0;
+  if (s >= static_cast<double>(last)) {
+    i = last;
+  } //  clamped to the last sample
+  else if (s > 0.0) {
+    i = static_cast<std::size_t>(s);
+    w = s - i;
+  } //  else clamped to the first sample
+  const Sample& a = samples_[i];
+  const Sample& b = samples_[i < last ? i + 1 : last];
+  if (a.live | b.live) {
+    return false;
+  } //  state estimate dependent
+
+  typedef typename ControlCommand::Scalar Scalar;
+  const Scalar wa = Scalar(1.0 - w);
+  const Scalar wb = Scalar(w);
+  Eigen::Quaternion<Scalar> q(
+      wa * a.orientation[0] + wb * b.orientation[0], wa * a.orientation[1] + wb * b.orientation[1],
+      wa * a.orientation[2] + wb * b.orientation[2], wa * a.orientation[3] + wb * b.orientation[3]);
+  q.normalize();
+  reference_inputs.orientation = q;
+  reference_inputs.collective_thrust = wa * a.collective_thrust + wb * b.collective_thrust;
+  for (int k = 0; k < 3; ++k) {
+    reference_inputs.bodyrates(k) = wa * a.bodyrates[k] + wb * b.bodyrates[k];
+    reference_inputs.angular_acceleration(k) = wa * a.angular_acceleration[k] + wb * b.angular_acceleration[k];
+  }
+  return true;
+}
+
+} /*  namespace position_controller  */
+
+#endif  /*  POSITION_CONTROLLER_FEEDFORWARD_TABLE_H  */
@@ -0,0 +1,147 @@
+/**
+ *  @file   fleet_controller.h
+ *  @brief  quadrotor position control's multi vehicle fleet related functionality declaration & definition
+ *  @author thor
+ *  @date   05.12.2021
+ */
+#ifndef POSITION_CONTROLLER_FLEET_CONTROLLER_H
+#define POSITION_CONTROLLER_FLEET_CONTROLLER_H
+
+//  std dependencies
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+//  position_controller dependencies
+#include "position_controller/batch_reference_inputs.h"
+#include "position_controller/rotor_drag_models.h"
+#include "position_controller/thread_pool.h"
+
+namespace position_controller {
+
+/**
+ *  @brief  FleetController class implementation
+ *  @detail Compute the reference inputs (see ReferenceInputsSolver) of N vehicles in lockstep,
+ *          i.e. one state estimate / reference state pair per vehicle and tick.
+ *          The vehicles are split into one contiguous chunk per worker of the thread pool,
+ *          a multiple of BatchReferenceInputs::lanes() each, and every worker owns its
+ *          BatchReferenceInputs, i.e. the workers share no mutable state and write disjoint
+ *          ranges of the output commands. Within a chunk the vehicles are processed in
+ *          struct-of-arrays blocks of lanes() vehicles, see BatchReferenceInputs.
+ *  @tparam RotorDragModel  - rotor drag policy, see rotor_drag_models.h
+ */
+template <typename RotorDragModel>
+class FleetController_ {
+ public:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    typedef typename BatchReferenceInputs_<RotorDragModel>::StateEstimate StateEstimate;
+    typedef typename BatchReferenceInputs_<RotorDragModel>::TrajectoryPoint TrajectoryPoint;
+    typedef typename BatchReferenceInputs_<RotorDragModel>::ControlCommand ControlCommand;
+    typedef std::vector<StateEstimate, Eigen::aligned_allocator<StateEstimate>> StateEstimates;
+    typedef std::vector<TrajectoryPoint, Eigen::aligned_allocator<TrajectoryPoint>> TrajectoryPoints;
+    typedef std::vector<ControlCommand, Eigen::aligned_allocator<ControlCommand>> ControlCommands;
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  FleetController's default constructor, called when an instance is created
+     *  @param  num_threads - number of workers including the calling thread
+     *  @param  rotor_drag  - rotor drag constants
+     *  @param  pin_threads - pin worker i to core i, see ThreadPool
+     */
+    explicit FleetController_(
+        const int num_threads,
+        const RotorDragModel& rotor_drag = RotorDragModel(),
+        const bool pin_threads = false);
+
+    /**
+     *  @brief  FleetController's default destructor, called when an instance is destroyed
+     */
+    ~FleetController_();
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Compute the reference inputs of n vehicles for one tick
+     *  @detail Only the orientation, collective thrust, bodyrates and angular acceleration
+     *          of the output commands are written, i.e. timestamp and control mode are kept.
+     *  @param  state_estimates   - n vehicles' current state estimates
+     *  @param  reference_states  - n vehicles' reference states to track
+     *  @param  control_commands  - n vehicles' output reference inputs
+     *  @param  n                 - number of vehicles
+     */
+    void run(
+        const StateEstimate* state_estimates,
+        const TrajectoryPoint* reference_states,
+        ControlCommand* control_commands,
+        const std::size_t n);
+
+    /**
+     *  @brief  Compute the reference inputs of all vehicles for one tick, the output commands
+     *          are resized to the number of vehicles
+     */
+    void run(
+        const StateEstimates& state_estimates,
+        const TrajectoryPoints& reference_states,
+        ControlCommands& control_commands);
+
+    /**
+     *  @brief  Number of workers including the calling thread
+     */
+    int numThreads() const { return thread_pool_.size(); }
+
+ private:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    /**
+     *  @brief  State of one worker, padded to keep the workers off each other's cache lines
+     */
+    struct Worker {
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+      explicit Worker(const RotorDragModel& rotor_drag) : batch(rotor_drag) {}
+
+      BatchReferenceInputs_<RotorDragModel> batch;
+      char padding[64];
+    };
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    //  @brief  One worker state per thread of the pool
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    //  @brief  Workers, the calling thread being worker 0
+    ThreadPool thread_pool_;
+
+};  /*  class FleetController_  */
+
+extern template class FleetController_<NoRotorDrag>;
+extern template class FleetController_<IsotropicRotorDrag>;
+extern template class FleetController_<AnisotropicRotorDrag>;
+extern template class FleetController_<NoRotorDragf>;
+extern template class FleetController_<IsotropicRotorDragf>;
+extern template class FleetController_<AnisotropicRotorDragf>;
+
+//  @brief  Fleet controller of the nominal dynamics
+typedef FleetController_<NoRotorDrag> FleetController;
+typedef FleetController_<NoRotorDragf> FleetControllerf;
+
+} /*  namespace position_controller  */
+
+#endif  /*  POSITION_CONTROLLER_FLEET_CONTROLLER_H  */
@@ -0,0 +1,164 @@
+/**
+ *  @file   heading_frame_cache.h
+ *  @brief  quadrotor position control's heading frame cache related functionality declaration & definition
+ *  @author thor
+ *  @date   01.12.2021
+ */
+#ifndef POSITION_CONTROLLER_HEADING_FRAME_CACHE_H
+#define POSITION_CONTROLLER_HEADING_FRAME_CACHE_H
+
+//  std dependencies
+#include <cmath>
+#include <type_traits>
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+namespace position_controller {
+
+/**
+ *  @brief  HeadingFrameCache class implementation
+ *  @detail Incremental heading frame x_C = [cos(phi) sin(phi) 0]^T, y_C = [-sin(phi) cos(phi) 0]^T
+ *          for streams of consecutive reference states:
+ *            + unchanged heading     - x_C, y_C are reused
+ *            + small heading change  - x_C, y_C are rotated by delta = phi - phi_prev, with
+ *                                      cos(delta), sin(delta) from their Taylor series
+ *            + large heading change  - x_C, y_C are recomputed with std::cos, std::sin
+ *          The Taylor series are exact up to ~2.5e-13 per step (the first omitted term of
+ *          cos(delta), 0.1^8/8!), and the frame is recomputed after kMaxIncrements_ updates
+ *          to bound the accumulated error. The frame hence depends on the preceding updates,
+ *          by up to ~1.6e-11 for double and, dominated by the rounding of every update, by
+ *          up to ~1e-6 for float; reset() makes the next update() exact.
+ *          For non floating point scalars (e.g. automatic differentiation scalars) the frame
+ *          is always recomputed, so that the derivatives of the heading propagate.
+ *  @tparam Scalar  - scalar type of the heading
+ */
+template <typename Scalar>
+class HeadingFrameCache_ {
+ public:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  HeadingFrameCache's default constructor, called when an instance is created
+     */
+    HeadingFrameCache_() { reset(); }
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Update the heading frame to the given heading
+     *  @param  heading - reference heading phi [rad]
+     *  @param  x_C     - output x axis of the heading frame
+     *  @param  y_C     - output y axis of the heading frame
+     */
+    void update(const Scalar& heading, Vector3& x_C, Vector3& y_C) {
+      using std::abs;
+
+      if (!std::is_floating_point<Scalar>::value || !valid_) {
+        recompute(heading);
+      } //  no previous heading
+      else if (heading != heading_) {
+        const Scalar delta = heading - heading_;
+        if (abs(delta) < kMaxIncrement_ && increments_ < kMaxIncrements_) {
+          const Scalar delta2 = delta*delta;
+          const Scalar cos_delta = Scalar(1.0) - delta2*(Scalar(1.0/2.0) -
+              delta2*(Scalar(1.0/24.0) - delta2*Scalar(1.0/720.0)));
+          const Scalar sin_delta = delta*(Scalar(1.0) - delta2*(Scalar(1.0/6.0) -
+              delta2*(Scalar(1.0/120.0) - delta2*Scalar(1.0/5040.0))));
+          const Scalar cos_phi = cos_phi_*cos_delta - sin_phi_*sin_delta;
+          sin_phi_ = sin_phi_*cos_delta + cos_phi_*sin_delta;
+          cos_phi_ = cos_phi;
+          heading_ = heading;
+          ++increments_;
+        } //  small heading change, rotation update
+        else {
+          recompute(heading);
+        } //  large heading change
+      } //  changed heading, otherwise x_C, y_C are reused
+
+      x_C = Vector3(cos_phi_, sin_phi_, Scalar(0.0));
+      y_C = Vector3(-sin_phi_, cos_phi_, Scalar(0.0));
+    }
+
+    /**
+     *  @brief  Invalidate the cache, i.e. the next update() recomputes the heading frame
+     */
+    void reset() {
+      heading_ = Scalar(0.0);
+      cos_phi_ = Scalar(1.0);
+      sin_phi_ = Scalar(0.0);
+      increments_ = 0;
+      valid_ = false;
+    }
+
+ private:
+
+        ////////////////////////////////////
+        ////////////  Constants  ///////////
+        ////////////////////////////////////
+
+    //  @brief  Largest heading change [rad] applied as rotation update,
+    //          i.e. truncation error of the Taylor series below 0.1^8/8! ~ 2.5e-13
+    static constexpr double kMaxIncrement_ = 0.1;
+
+    //  @brief  Number of rotation updates before the heading frame is recomputed
+    static constexpr int kMaxIncrements_ = 64;
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Recompute the heading frame from scratch
+     */
+    void recompute(const Scalar& heading) {
+      using std::cos;
+      using std::sin;
+      heading_ = heading;
+      cos_phi_ = cos(heading);
+      sin_phi_ = sin(heading);
+      increments_ = 0;
+      valid_ = true;
+    }
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    //  @brief  Heading of the cached heading frame
+    Scalar heading_;
+
+    //  @brief  Cached cos(heading_), sin(heading_)
+    Scalar cos_phi_, sin_phi_;
+
+    //  @brief  Number of rotation updates since the last recompute
+    int increments_;
+
+    //  @brief  Whether the cached heading frame is valid
+    bool valid_;
+
+};  /*  class HeadingFrameCache_  */
+
+template <typename Scalar>
+constexpr double HeadingFrameCache_<Scalar>::kMaxIncrement_;
+
+template <typename Scalar>
+constexpr int HeadingFrameCache_<Scalar>::kMaxIncrements_;
+
+//  @brief  Heading frame cache of the double pipeline
+typedef HeadingFrameCache_<double> HeadingFrameCache;
+
+} /*  namespace position_controller  */
+
+#endif  /*  POSITION_CONTROLLER_HEADING_FRAME_CACHE_H  */
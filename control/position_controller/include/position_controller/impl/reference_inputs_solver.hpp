@@ -0,0 +1,437 @@
+/**
+ *  @file   reference_inputs_solver.hpp
+ *  @brief  quadrotor position control's reusable reference inputs solver related functionality implementation
+ *  @author thor
+ *  @date   26.11.2021
+ */
+#ifndef POSITION_CONTROLLER_IMPL_REFERENCE_INPUTS_SOLVER_HPP
+#define POSITION_CONTROLLER_IMPL_REFERENCE_INPUTS_SOLVER_HPP
+
+#include "position_controller/reference_inputs_solver.h"
+
+//  std dependencies
+#include <cmath>
+
+//  quadrotor_common dependencies
+#include "quadrotor_common/math.h"
+
+//  position_controller dependencies
+#include "position_controller/stage_profiler.h"
+
+namespace position_controller {
+
+/**
+ *  @detail
+ */
+template <typename RotorDragModel, XiKernel kXiKernel>
+ReferenceInputsSolver_<RotorDragModel, kXiKernel>::ReferenceInputsSolver_(
+    const RotorDragModel& rotor_drag)
+    : rotor_drag_(rotor_drag) {}
+
+/**
+ *  @detail
+ */
+template <typename RotorDragModel, XiKernel kXiKernel>
+ReferenceInputsSolver_<RotorDragModel, kXiKernel>::~ReferenceInputsSolver_() {}
+
+/**
+ *  @detail Every stage is profiled on its own, see StageProfiler.
+ *          Constraints based on reference heading phi i.e.,
+ *          projection of x_B into x_W - y_W plane should be collinear to x_C,
+ *          where x_C = [cos(phi) sin(phi) 0]^T, y_C = [-sin(phi) cos(phi) 0]^T
+ */
+template <typename RotorDragModel, XiKernel kXiKernel>
+void ReferenceInputsSolver_<RotorDragModel, kXiKernel>::solve(
+    const StateEstimate& state_estimate,
+    const TrajectoryPoint& reference_state,
+    ControlCommand& reference_inputs) {
+  Vector3 x_C, y_C;
+  heading_frame_.update(reference_state.heading, x_C, y_C);
+  solve(state_estimate, reference_state, x_C, y_C, reference_inputs);
+}
+
+/**
+ *  @detail The heading frame from std::cos, std::sin, as HeadingFrameCache::reset() would.
+ */
+template <typename RotorDragModel, XiKernel kXiKernel>
+void ReferenceInputsSolver_<RotorDragModel, kXiKernel>::solveUncached(
+    const StateEstimate& state_estimate,
+    const TrajectoryPoint& reference_state,
+    ControlCommand& reference_inputs) const {
+  using std::cos;
+  using std::sin;
+  const Scalar cos_phi = cos(reference_state.heading);
+  const Scalar sin_phi = sin(reference_state.heading);
+  const Vector3 x_C(cos_phi, sin_phi, Scalar(0.0));
+  const Vector3 y_C(-sin_phi, cos_phi, Scalar(0.0));
+  solve(state_estimate, reference_state, x_C, y_C, reference_inputs);
+}
+
+/**
+ *  @detail
+ */
+template <typename RotorDragModel, XiKernel kXiKernel>
+void ReferenceInputsSolver_<RotorDragModel, kXiKernel>::solve(
+    const StateEstimate& state_estimate,
+    const TrajectoryPoint& reference_state,
+    const Vector3& x_C,
+    const Vector3& y_C,
+    ControlCommand& reference_inputs) const {
+  Matrix3 R;
+  {
+    POSITION_CONTROLLER_PROFILE_STAGE(Stage::kOrientation);
+    computeReferenceOrientation(state_estimate, reference_state, x_C, y_C, R);
+    reference_inputs.orientation = Eigen::Quaternion<Scalar>(R);
+  }
+  {
+    POSITION_CONTROLLER_PROFILE_STAGE(Stage::kCollectiveThrust);
+    reference_inputs.collective_thrust = computeReferenceCollectiveThrust(
+        reference_state, R.col(2));
+  }
+  BodyratesSystem system;
+  {
+    POSITION_CONTROLLER_PROFILE_STAGE(Stage::kBodyrates);
+    computeReferenceBodyrates(
+        reference_state, x_C, y_C, R, reference_inputs.collective_thrust,
+        system, reference_inputs.bodyrates);
+  }
+  {
+    POSITION_CONTROLLER_PROFILE_STAGE(Stage::kAngularAcceleration);
+    computeReferenceAngularAcceleration(
+        reference_state, x_C, y_C, R, reference_inputs.collective_thrust,
+        system, reference_inputs.bodyrates, reference_inputs.angular_acceleration);
+  }
+}
+
+/**
+ *  @detail The same conditions as computeRobustBodyXAxis() and computeRobustBodyYAxis(),
+ *          without the heading frame cache, i.e. for any reference state in any order.
+ */
+template <typename RotorDragModel, XiKernel kXiKernel>
+bool ReferenceInputsSolver_<RotorDragModel, kXiKernel>::isStateDependent(
+    const TrajectoryPoint& reference_state) const {
+  using std::cos;
+  using std::sin;
+  const Vector3 y_C(-sin(reference_state.heading), cos(reference_state.heading), Scalar(0.0));
+
+  Vector3 alpha = reference_state.acceleration - kGravity_;
+  Vector3 beta = alpha;
+  if (RotorDragModel::kEnabled) {
+    alpha += rotor_drag_.dx() * reference_state.velocity;
+    beta += rotor_drag_.dy() * reference_state.velocity;
+  } //  rotor drag terms
+
+  const Vector3 x_B = y_C.cross(alpha);
+  if (quadrotor_common::isAlmostZero(x_B.norm(), kAlmostZeroValueThreshold_)) {
+    return true;
+  } //  y_C collinear to alpha or alpha is 0
+  return quadrotor_common::isAlmostZero(beta.cross(x_B.normalized()).norm(), kAlmostZeroValueThreshold_);
+}
+
+/**
+ *  @detail
+ */
+template <typename RotorDragModel, XiKernel kXiKernel>
+void ReferenceInputsSolver_<RotorDragModel, kXiKernel>::computeReferenceOrientation(
+    const StateEstimate& state_estimate,
+    const TrajectoryPoint& reference_state,
+    const Vector3& x_C,
+    const Vector3& y_C,
+    Matrix3& R) const {
+  R.col(0) = computeRobustBodyXAxis(state_estimate, reference_state, x_C, y_C);
+  R.col(1) = computeRobustBodyYAxis(state_estimate, reference_state, y_C, R.col(0));
+  R.col(2) = R.col(0).cross(R.col(1));
+}
+
+/**
+ *  @detail c = z_B^T(v_dot + g.z_W + dz.v)
+ */
+template <typename RotorDragModel, XiKernel kXiKernel>
+typename ReferenceInputsSolver_<RotorDragModel, kXiKernel>::Scalar
+ReferenceInputsSolver_<RotorDragModel, kXiKernel>::computeReferenceCollectiveThrust(
+    const TrajectoryPoint& reference_state,
+    const Vector3& z_B) const {
+  Vector3 gamma = reference_state.acceleration - kGravity_;
+  if (RotorDragModel::kEnabled) {
+    gamma += rotor_drag_.dz() * reference_state.velocity;
+  } //  rotor drag term
+
+  const Scalar thrust = z_B.dot(gamma);
+  return thrust;
+}
+
+/**
+ *  @detail The (dz - dx), (dx - dy) and (dy - dz) terms are only compiled for anisotropic
+ *          rotor drag and the dx, dy, dz terms only for enabled rotor drag.
+ */
+template <typename RotorDragModel, XiKernel kXiKernel>
+void ReferenceInputsSolver_<RotorDragModel, kXiKernel>::computeReferenceBodyrates(
+    const TrajectoryPoint& reference_state,
+    const Vector3& x_C,
+    const Vector3& y_C,
+    const Matrix3& R,
+    const Scalar& c,
+    BodyratesSystem& system,
+    Vector3& bodyrates) const {
+  const Vector3 x_B = R.col(0);
+  const Vector3 y_B = R.col(1);
+  const Vector3 z_B = R.col(2);
+  const Scalar dx = rotor_drag_.dx();
+  const Scalar dy = rotor_drag_.dy();
+  const Scalar dz = rotor_drag_.dz();
+
+  system.B1 = c;
+  system.C1 = Scalar(0.0);
+  system.A2 = c;
+  system.C2 = Scalar(0.0);
+  Scalar D1 = x_B.dot(reference_state.jerk);
+  Scalar D2 = -y_B.dot(reference_state.jerk);
+  if (RotorDragModel::kEnabled) {
+    D1 += dx * x_B.dot(reference_state.acceleration);
+    D2 -= dy * y_B.dot(reference_state.acceleration);
+  } //  rotor drag terms
+  if (RotorDragModel::kAnisotropic) {
+    system.B1 = c - (dz - dx)*(z_B.dot(reference_state.velocity));
+    system.C1 = -(dx - dy)*(y_B.dot(reference_state.velocity));
+    system.A2 = c + (dy - dz)*(z_B.dot(reference_state.velocity));
+    system.C2 = (dx - dy)*(x_B.dot(reference_state.velocity));
+  } //  anisotropic rotor drag terms
+  system.B3 = -y_C.dot(z_B);
+  system.C3 = (y_C.cross(z_B)).norm();
+  const Scalar D3 = reference_state.heading_rate * x_C.dot(x_B);
+
+  solveBodyratesSystem(system, D1, D2, D3, bodyrates);
+}
+
+/**
+ *  @detail The (dz - dx), (dx - dy) and (dy - dz) terms are only compiled for anisotropic
+ *          rotor drag and the dx, dy, dz terms only for enabled rotor drag.
+ */
+template <typename RotorDragModel, XiKernel kXiKernel>
+void ReferenceInputsSolver_<RotorDragModel, kXiKernel>::computeReferenceAngularAcceleration(
+    const TrajectoryPoint& reference_state,
+    const Vector3& x_C,
+    const Vector3& y_C,
+    const Matrix3& R,
+    const Scalar& c,
+    const BodyratesSystem& system,
+    const Vector3& bodyrates,
+    Vector3& bodyrates_dot) const {
+  const Vector3 x_B = R.col(0);
+  const Vector3 y_B = R.col(1);
+  const Vector3 z_B = R.col(2);
+  const Scalar dx = rotor_drag_.dx();
+  const Scalar dy = rotor_drag_.dy();
+  const Scalar dz = rotor_drag_.dz();
+
+  Scalar c_dot = z_B.dot(reference_state.jerk);
+  Scalar xi_x(0.0), xi_y(0.0);  //  x_B^T xi, y_B^T xi
+  if (RotorDragModel::kAnisotropic) {
+    c_dot += bodyrates.x()*(dy - dz)*(y_B.dot(reference_state.velocity)) + \
+        bodyrates.y()*(dz - dx)*(x_B.dot(reference_state.velocity)) + \
+        dz * z_B.dot(reference_state.acceleration);
+
+    computeRotorDragXi(reference_state, R, bodyrates, xi_x, xi_y);
+  } //  anisotropic rotor drag terms
+  else if (RotorDragModel::kEnabled) {
+    //  with D = d*I, the velocity and acceleration terms of xi cancel out, i.e. xi = d*jerk
+    c_dot += dz * z_B.dot(reference_state.acceleration);
+    xi_x = dx * x_B.dot(reference_state.jerk);
+    xi_y = dy * y_B.dot(reference_state.jerk);
+  } //  isotropic rotor drag terms
+
+  const Scalar E1 = x_B.dot(reference_state.snap) - 2*c_dot * bodyrates.y() - \
+      c * bodyrates.x() * bodyrates.z() + xi_x;
+  const Scalar E2 = -y_B.dot(reference_state.snap) - 2*c_dot * bodyrates.x() + \
+      c * bodyrates.y() * bodyrates.z() - xi_y;
+  const Scalar E3 = reference_state.heading_acceleration * x_C.dot(x_B) + \
+      2*reference_state.heading_rate * bodyrates.z() * x_C.dot(y_B) - \
+      2*reference_state.heading_rate * bodyrates.y() * x_C.dot(z_B) - \
+      bodyrates.x() * bodyrates.y() * y_C.dot(y_B) - \
+      bodyrates.x() * bodyrates.z() * y_C.dot(z_B);
+
+  solveBodyratesSystem(system, E1, E2, E3, bodyrates_dot);
+}
+
+/**
+ *  @detail With Omega = skew(omega) and v_B = R^T.v, a_B = R^T.a, j_B = R^T.j
+ *          R^T.xi = (Omega^2.D + D.Omega^2 + 2.Omega.D.Omega^T).v_B
+ *                 + 2.(Omega.D + D.Omega^T).a_B + D.j_B
+ *          which in body frame reads, with Omega^T = -Omega and Omega.x = omega x x,
+ *          R^T.xi = omega x (omega x D.v_B) + D.(omega x (omega x v_B))
+ *                 - 2.omega x D.(omega x v_B) + 2.(omega x D.a_B - D.(omega x a_B)) + D.j_B
+ *          and x_B^T.xi, y_B^T.xi are its x, y components.
+ */
+template <typename RotorDragModel, XiKernel kXiKernel>
+void ReferenceInputsSolver_<RotorDragModel, kXiKernel>::computeRotorDragXi(
+    const TrajectoryPoint& reference_state,
+    const Matrix3& R,
+    const Vector3& bodyrates,
+    Scalar& xi_x,
+    Scalar& xi_y) const {
+  const Vector3 d(rotor_drag_.dx(), rotor_drag_.dy(), rotor_drag_.dz());
+
+  if (kXiKernel == XiKernel::kMatrixForm) {
+    const Matrix3 omega_hat = quadrotor_common::skew(bodyrates);
+    const Matrix3 D = d.asDiagonal();
+    const Vector3 xi =
+        R * (omega_hat * omega_hat * D + D * omega_hat * omega_hat +
+          Scalar(2.0) * omega_hat * D * omega_hat.transpose()
+        ) * R.transpose() * reference_state.velocity + \
+        Scalar(2.0) * R * (omega_hat * D + D * omega_hat.transpose()
+        ) * R.transpose() * reference_state.acceleration + \
+        R * D * R.transpose() * reference_state.jerk;
+    xi_x = R.col(0).dot(xi);
+    xi_y = R.col(1).dot(xi);
+    return;
+  } //  matrix form kernel
+
+  const Vector3 v_B = R.transpose() * reference_state.velocity;
+  const Vector3 a_B = R.transpose() * reference_state.acceleration;
+  const Vector3 omega_x_v_B = bodyrates.cross(v_B);
+  const Vector3 omega_x_a_B = bodyrates.cross(a_B);
+
+  const Vector3 xi_B =
+      bodyrates.cross(bodyrates.cross(d.cwiseProduct(v_B))) + \
+      d.cwiseProduct(bodyrates.cross(omega_x_v_B)) - \
+      Scalar(2.0) * bodyrates.cross(d.cwiseProduct(omega_x_v_B)) + \
+      Scalar(2.0) * (bodyrates.cross(d.cwiseProduct(a_B)) - d.cwiseProduct(omega_x_a_B));
+  xi_x = xi_B.x() + d.x() * R.col(0).dot(reference_state.jerk);
+  xi_y = xi_B.y() + d.y() * R.col(1).dot(reference_state.jerk);
+}
+
+/**
+ *  @detail Solution by Cramer's rule, for C1 = C2 = 0 it simplifies to
+ *          x = rhs2/A2, y = rhs1/B1, z = (B1*rhs3 - B3*rhs1)/(B1*C3)
+ */
+template <typename RotorDragModel, XiKernel kXiKernel>
+void ReferenceInputsSolver_<RotorDragModel, kXiKernel>::solveBodyratesSystem(
+    const BodyratesSystem& system,
+    const Scalar& rhs1, const Scalar& rhs2, const Scalar& rhs3,
+    Vector3& solution) const {
+  const Scalar& A2 = system.A2;
+  const Scalar& B1 = system.B1;
+  const Scalar& C1 = system.C1;
+  const Scalar& C2 = system.C2;
+  const Scalar& B3 = system.B3;
+  const Scalar& C3 = system.C3;
+
+  // check if B1*C3 - B3*C1 is 0
+  const Scalar denominator = RotorDragModel::kAnisotropic ? Scalar(B1*C3 - B3*C1) : Scalar(B1*C3);
+  if (quadrotor_common::isAlmostZero(denominator, kAlmostZeroValueThreshold_)) {
+    solution.setZero();
+    return;
+  } //  zero solution
+
+  if (quadrotor_common::isAlmostZero(A2, kAlmostZeroValueThreshold_)) {
+    solution.x() = 0.0;
+  } //  zero solution.x()
+  else if (RotorDragModel::kAnisotropic) {
+    solution.x() = (-B1*C2*rhs3 + B1*C3*rhs2 - B3*C1*rhs2 + B3*C2*rhs1)/ \
+        (A2*denominator);
+  }
+  else {
+    solution.x() = rhs2/A2;
+  }
+
+  if (RotorDragModel::kAnisotropic) {
+    solution.y() = (-C1*rhs3 + C3*rhs1)/denominator;
+  }
+  else {
+    solution.y() = rhs1/B1;
+  }
+  solution.z() = ( B1*rhs3 - B3*rhs1)/denominator;
+}
+
+/**
+ *  @detail For x_C = [cos(phi) sin(phi) 0]^T, y_C = [-sin(phi) cos(phi) 0]^T,
+ *          and alpha = v_dot + g.z_W + dx.v
+ *          Check if norm(y_C x alpha) == 0
+ *            if true, check if norm(x_B_est - (x_B_est^T.y_C)y_C) == 0
+ *                      if true, set x_B = x_C
+ *                      else, set x_B = normalized(x_B_est - (x_B_est^T.y_C)y_C)
+ *            else, set x_B = normalized(y_C x alpha)
+ */
+template <typename RotorDragModel, XiKernel kXiKernel>
+typename ReferenceInputsSolver_<RotorDragModel, kXiKernel>::Vector3
+ReferenceInputsSolver_<RotorDragModel, kXiKernel>::computeRobustBodyXAxis(
+    const StateEstimate& state_estimate,
+    const TrajectoryPoint& reference_state,
+    const Vector3& x_C,
+    const Vector3& y_C) const {
+  Vector3 alpha = reference_state.acceleration - kGravity_;
+  if (RotorDragModel::kEnabled) {
+    alpha += rotor_drag_.dx() * reference_state.velocity;
+  } //  rotor drag term
+  Vector3 x_B = y_C.cross(alpha);
+
+  //  check if y_C is collinear to alpha or alpha is 0
+  if (quadrotor_common::isAlmostZero(x_B.norm(), kAlmostZeroValueThreshold_)) {
+    POSITION_CONTROLLER_PROFILE_STAGE(Stage::kBodyXAxisSingularity);
+    //  project x_B estimate into x_C - z_C plane, using scalar projection onto y_C
+    //  followed by vector rejection
+    const Vector3 x_B_est = state_estimate.orientation * Vector3::UnitX();
+    const Vector3 x_B_proj = x_B_est - (x_B_est.dot(y_C))*y_C;
+
+    //  check if norm(x_B_proj) is 0
+    if (quadrotor_common::isAlmostZero(x_B_proj.norm(), kAlmostZeroValueThreshold_)) {
+      x_B = x_C;
+    } //  special case which may lead to jumps in the desired orientation
+    else {
+      x_B = x_B_proj.normalized();
+    }
+  } //  handle singularity case
+  else {
+    x_B.normalize();
+  } //  normalize
+
+  return x_B;
+}
+
+/**
+ *  @detail For x_C = [cos(phi) sin(phi) 0]^T, y_C = [-sin(phi) cos(phi) 0]^T,
+ *          and beta = v_dot + g.z_W + dy.v
+ *          Check if norm(beta x x_B) == 0
+ *            if true, check if norm(z_B_est x x_B) == 0
+ *                      if true, set y_B = y_C
+ *                      else, set y_B = normalized(z_B_est x x_B)
+ *            else, set y_B = normalized(beta x x_B)
+ */
+template <typename RotorDragModel, XiKernel kXiKernel>
+typename ReferenceInputsSolver_<RotorDragModel, kXiKernel>::Vector3
+ReferenceInputsSolver_<RotorDragModel, kXiKernel>::computeRobustBodyYAxis(
+    const StateEstimate& state_estimate,
+    const TrajectoryPoint& reference_state,
+    const Vector3& y_C,
+    const Vector3& x_B) const {
+  Vector3 beta = reference_state.acceleration - kGravity_;
+  if (RotorDragModel::kEnabled) {
+    beta += rotor_drag_.dy() * reference_state.velocity;
+  } //  rotor drag term
+  Vector3 y_B = beta.cross(x_B);
+
+  //  check if x_B is collinear to beta or beta is 0
+  if (quadrotor_common::isAlmostZero(y_B.norm(), kAlmostZeroValueThreshold_)) {
+    POSITION_CONTROLLER_PROFILE_STAGE(Stage::kBodyYAxisSingularity);
+    //  y_B should also be perpendicular to z_B_est and x_B
+    const Vector3 z_B_est = state_estimate.orientation * Vector3::UnitZ();
+    const Vector3 y_B_temp = z_B_est.cross(x_B);
+
+    //  check if norm(y_B_temp) is 0
+    if (quadrotor_common::isAlmostZero(y_B_temp.norm(), kAlmostZeroValueThreshold_)) {
+      y_B = y_C;
+    } //  special case which may lead to jumps in the desired orientation
+    else {
+      y_B = y_B_temp.normalized();
+    }
+  } //  handle singularity case
+  else {
+    y_B.normalize();
+  } //  normalize
+
+  return y_B;
+}
+
+} /*  namespace position_controller  */
+
+#endif  /*  POSITION_CONTROLLER_IMPL_REFERENCE_INPUTS_SOLVER_HPP  */
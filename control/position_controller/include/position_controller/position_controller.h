@@ -15,6 +15,9 @@
 #include "quadrotor_common/quadrotor_state_estimate.h"
 #include "quadrotor_common/quadrotor_trajectory_point.h"
 
+// position_controller dependencies
+#include "position_controller/reference_inputs_solver.h"
+
 namespace position_controller {
 
 /**
@@ -31,8 +34,10 @@ namespace position_controller {
  *              High-Speed Trajectories https://arxiv.org/pdf/1712.02402.pdf
  *            + Thrust Mixing, Saturation, and Body-Rate Control for Accurate Aggressive Quadrotor Flight
  *              https://www.ifi.uzh.ch/dam/jcr:5f3668fe-1d4e-4c2b-a190-8f5608f40cf3/RAL16_Faessler.pdf
+ *  @tparam RotorDragModel  - rotor drag policy of the reference inputs, see rotor_drag_models.h
  */
-class PositionController {
+template <typename RotorDragModel>
+class PositionController_ {
  public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
@@ -42,13 +47,14 @@ class PositionController {
 
     /**
      *  @brief  PositionController's default constructor, called when an instance is created.
+     *  @param  rotor_drag  - rotor drag constants of the reference inputs
      */
-    PositionController();
+    explicit PositionController_(const RotorDragModel& rotor_drag = RotorDragModel());
 
     /**
      *  @brief  PositionController's default destructor, called when an instance is destroyed.
      */
-    ~PositionController();
+    ~PositionController_();
 
         //////////////////////////////////////
         //////////// Class Methods ///////////
@@ -68,6 +74,37 @@ class PositionController {
         const quadrotor_common::QuadrotorStateEstimate& state_estimate,
         const quadrotor_common::QuadrotorTrajectoryPoint& reference_state);
 
+    /**
+     *  @brief  Compute the high level position control outputs into the given control command.
+     *  @detail As run() above, without the copy of the returned command, e.g. into the slot of a
+     *          mailbox. Only the orientation, collective thrust, bodyrates and angular
+     *          acceleration are written, i.e. timestamp and control mode are kept.
+     *  @param  state_estimate    - quadrotor's current state estimate
+     *  @param  reference_state   - quadrotor's reference state to track
+     *  @param  control_command   - output control command
+     */
+    void run(
+        const quadrotor_common::QuadrotorStateEstimate& state_estimate,
+        const quadrotor_common::QuadrotorTrajectoryPoint& reference_state,
+        quadrotor_common::QuadrotorControlCommand& control_command);
+
+    /**
+     *  @brief  Forget the previous run(), i.e. the next one equals the one of a fresh controller.
+     *  @detail The reference inputs solver advances the heading frame from the previous run().
+     */
+    void reset() { reference_inputs_solver_.reset(); }
+
+    /**
+     *  @brief  Set the rotor drag constants of the reference inputs of the next run().
+     *  @detail E.g. of the RotorDragEstimator, polled from its mailbox by the control thread.
+     */
+    void setRotorDrag(const RotorDragModel& rotor_drag) { reference_inputs_solver_.setRotorDrag(rotor_drag); }
+
+    /**
+     *  @brief  The rotor drag constants of the reference inputs.
+     */
+    const RotorDragModel& rotorDrag() const { return reference_inputs_solver_.rotorDrag(); }
+
  private:
 
         //////////////////////////////////
@@ -79,17 +116,32 @@ class PositionController {
         //////////////////////////////////////
 
     /**
-     *  @brief
-     *  @detail
-     *  @param  reference_state   -
-     *  @param  attitude_estimate -
-     *  @return  control_command  -
+     *  @brief  Compute the reference inputs as feed-forward terms.
+     *  @detail Using the persistent reference inputs solver, i.e. without per-tick copies.
+     *  @param  state_estimate    - quadrotor's current state estimate
+     *  @param  reference_state   - quadrotor's reference state to track
+     *  @return  control_command  - reference orientation, collective thrust, bodyrates
+     *                              and angular acceleration
      */
     quadrotor_common::QuadrotorControlCommand computeReferenceInputs(
         const quadrotor_common::QuadrotorStateEstimate& state_estimate,
-        const quadrotor_common::QuadrotorTrajectoryPoint& reference_state) const;
+        const quadrotor_common::QuadrotorTrajectoryPoint& reference_state);
+
+        //////////////////////////////////////
+        //////////// Class Members ///////////
+        //////////////////////////////////////
+
+    //  @brief  Reference inputs solver, reused for every control tick
+    ReferenceInputsSolver_<RotorDragModel> reference_inputs_solver_;
+
+};  /* class PositionController_ */
+
+extern template class PositionController_<NoRotorDrag>;
+extern template class PositionController_<IsotropicRotorDrag>;
+extern template class PositionController_<AnisotropicRotorDrag>;
 
-};  /* class PositionController */
+//  @brief  Position controller of the nominal dynamics
+typedef PositionController_<NoRotorDrag> PositionController;
 
 } /* namespace position_controller */
 
@@ -0,0 +1,199 @@
+/**
+ *  @file   realtime_executor.h
+ *  @brief  quadrotor position control's real time fixed rate loop related functionality declaration & definition
+ *  @author thor
+ *  @date   07.12.2021
+ */
+#ifndef POSITION_CONTROLLER_REALTIME_EXECUTOR_H
+#define POSITION_CONTROLLER_REALTIME_EXECUTOR_H
+
+//  std dependencies
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+namespace position_controller {
+
+/**
+ *  @brief  Parameters of the RealTimeExecutor
+ */
+struct RealTimeExecutorParameters {
+  //  @brief  Loop rate [Hz]
+  double rate = 1000.0;
+
+  //  @brief  Core the loop thread is pinned to, negative to not pin it (linux only)
+  int cpu = -1;
+
+  //  @brief  SCHED_FIFO priority of the loop thread in [1, 99], 0 to keep the default policy
+  int priority = 0;
+
+  //  @brief  Lock all current and future pages of the process into memory (mlockall)
+  bool lock_memory = false;
+
+  //  @brief  Stack and heap bytes touched before the first tick, so that the loop does not page fault
+  std::size_t prefault_stack_bytes = 256 * 1024;
+  std::size_t prefault_heap_bytes = 0;
+};  /*  struct RealTimeExecutorParameters  */
+
+/**
+ *  @brief  Counters of the RealTimeExecutor, all durations in nanoseconds
+ *  @detail The jitter is the wake up latency after the release time of a tick, the execution
+ *          time spans the tick function. A tick misses its deadline if it finishes after the
+ *          release time of the next tick, the release times then passed in the meantime are
+ *          skipped and counted as overruns, i.e. the loop does not try to catch up with a burst.
+ */
+struct RealTimeExecutorStatistics {
+  std::uint64_t ticks = 0;
+  std::uint64_t deadline_misses = 0;
+  std::uint64_t overruns = 0;
+  std::int64_t last_jitter = 0;
+  std::int64_t max_jitter = 0;
+  std::int64_t total_jitter = 0;
+  std::int64_t last_execution_time = 0;
+  std::int64_t max_execution_time = 0;
+  std::int64_t total_execution_time = 0;
+
+  //  @brief  Whether the requested pinning, scheduling policy and memory locking took effect
+  bool pinned = false;
+  bool realtime = false;
+  bool memory_locked = false;
+
+  double meanJitter() const { return ticks > 0 ? static_cast<double>(total_jitter) / ticks : 0.0; }
+  double meanExecutionTime() const {
+    return ticks > 0 ? static_cast<double>(total_execution_time) / ticks : 0.0;
+  }
+};  /*  struct RealTimeExecutorStatistics  */
+
+/**
+ *  @brief  RealTimeExecutor class implementation
+ *  @detail Run a tick function at a fixed rate on a dedicated thread, e.g. the 1 kHz inner loop
+ *          around the PositionController (see ControlLoop). The loop sleeps until absolute
+ *          release times (clock_nanosleep on CLOCK_MONOTONIC), i.e. the period does not drift
+ *          with the execution time or the wake up latency. Before the first tick the thread is
+ *          optionally pinned, switched to SCHED_FIFO and the memory is locked and pre-faulted.
+ *          Failing to do so, e.g. without CAP_SYS_NICE, is not an error: the loop runs anyway
+ *          and the statistics report what took effect. The counters are written by the loop
+ *          thread only and may be read from any thread while it runs.
+ */
+class RealTimeExecutor {
+ public:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    //  @brief  Tick function, called with the tick index, must not throw
+    typedef std::function<void(std::uint64_t)> Tick;
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  RealTimeExecutor's default constructor, called when an instance is created
+     *  @param  parameters  - loop rate and real time setup
+     *  @param  tick        - the function called once per period
+     *  @throw  std::invalid_argument if the rate is not positive and finite
+     */
+    RealTimeExecutor(const RealTimeExecutorParameters& parameters, const Tick& tick);
+
+    /**
+     *  @brief  RealTimeExecutor's default destructor, called when an instance is destroyed
+     *  @detail Stops and joins the loop thread, if running.
+     */
+    ~RealTimeExecutor();
+
+    RealTimeExecutor(const RealTimeExecutor&) = delete;
+    RealTimeExecutor& operator=(const RealTimeExecutor&) = delete;
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Start the loop on its own thread, no-op if already running, restarts a stopped loop
+     */
+    void start();
+
+    /**
+     *  @brief  Request the loop to stop after the current tick, and join the thread of start()
+     *          unless called from the tick function itself
+     */
+    void stop();
+
+    /**
+     *  @brief  Run the loop on the calling thread until stop() is called, e.g. from the tick function
+     */
+    void run();
+
+    /**
+     *  @brief  Snapshot of the counters, each of them consistent on its own
+     */
+    RealTimeExecutorStatistics statistics() const;
+
+    /**
+     *  @brief  Reset the counters, only while the loop is not running
+     */
+    void resetStatistics();
+
+    /**
+     *  @brief  The loop period [ns]
+     */
+    std::int64_t period() const { return period_; }
+
+ private:
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Pin, set the scheduling policy, lock and pre-fault memory for the calling thread
+     */
+    void setup();
+
+    /**
+     *  @brief  The fixed rate loop
+     */
+    void loop();
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    //  @brief  Loop rate and real time setup
+    const RealTimeExecutorParameters parameters_;
+
+    //  @brief  The loop period [ns]
+    const std::int64_t period_;
+
+    //  @brief  The function called once per period
+    const Tick tick_;
+
+    //  @brief  The loop thread of start()
+    std::thread thread_;
+
+    //  @brief  Whether the loop shall exit
+    std::atomic<bool> stop_;
+
+    //  @brief  The counters, see RealTimeExecutorStatistics
+    std::atomic<std::uint64_t> ticks_;
+    std::atomic<std::uint64_t> deadline_misses_;
+    std::atomic<std::uint64_t> overruns_;
+    std::atomic<std::int64_t> last_jitter_;
+    std::atomic<std::int64_t> max_jitter_;
+    std::atomic<std::int64_t> total_jitter_;
+    std::atomic<std::int64_t> last_execution_time_;
+    std::atomic<std::int64_t> max_execution_time_;
+    std::atomic<std::int64_t> total_execution_time_;
+    std::atomic<bool> pinned_;
+    std::atomic<bool> realtime_;
+    std::atomic<bool> memory_locked_;
+
+};  /*  class RealTimeExecutor  */
+
+} /*  namespace position_controller  */
+
+#endif  /*  POSITION_CONTROLLER_REALTIME_EXECUTOR_H  */
@@ -0,0 +1,311 @@
+/**
+ *  @file   reference_inputs_solver.h
+ *  @brief  quadrotor position control's reusable reference inputs solver related functionality declaration & definition
+ *  @author thor
+ *  @date   26.11.2021
+ */
+#ifndef POSITION_CONTROLLER_REFERENCE_INPUTS_SOLVER_H
+#define POSITION_CONTROLLER_REFERENCE_INPUTS_SOLVER_H
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+//  quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_control_command.h"
+#include "quadrotor_common/quadrotor_state_estimate.h"
+#include "quadrotor_common/quadrotor_trajectory_point.h"
+
+//  position_controller dependencies
+#include "position_controller/heading_frame_cache.h"
+#include "position_controller/rotor_drag_models.h"
+
+namespace position_controller {
+
+/**
+ *  @brief  Kernels of the rotor drag term xi of the angular accelerations,
+ *          xi = d^3(R*D*R^T*v)/dt^3 - R*D*R^T*j i.e. only non zero for anisotropic rotor drag
+ */
+enum class XiKernel {
+  kMatrixForm,  //  world frame xi from dense 3x3 products of R, D and skew(omega)
+  kBodyFrame    //  body frame x_B^T.xi, y_B^T.xi from cross products of omega and R^T.v
+};
+
+/**
+ *  @brief  ReferenceInputsSolver class implementation
+ *  @detail Compute the desired orientation, the desired collective thrust command,
+ *          the desired body rates (angular velocity) and the desired angular acceleration;
+ *          required for high-level position control.
+ *          The solver is meant to be created once and reused for every control tick:
+ *          solve() neither copies its inputs nor allocates, and writes the reference
+ *          inputs in place into the given control command. The heading frame x_C, y_C
+ *          is updated incrementally from the previous solve(), see HeadingFrameCache,
+ *          i.e. the results depend on the preceding calls by rounding errors, reset()
+ *          makes the next solve() depend on its inputs only.
+ *          The pipeline stages are protected, so that they can be profiled separately.
+ *          The flatness equations are templated on the scalar type of the rotor drag
+ *          policy, the double and float pipelines are compiled into the library,
+ *          other scalar types (e.g. automatic differentiation scalars) have to include
+ *          position_controller/impl/reference_inputs_solver.hpp.
+ *  @tparam RotorDragModel  - rotor drag policy, see rotor_drag_models.h, only the
+ *                            arithmetic of the non vanishing drag terms is compiled
+ *  @tparam kXiKernel       - kernel of the anisotropic rotor drag term xi, see XiKernel
+ */
+template <typename RotorDragModel, XiKernel kXiKernel = XiKernel::kBodyFrame>
+class ReferenceInputsSolver_ {
+ public:
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    typedef typename RotorDragModel::Scalar Scalar;
+    typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+    typedef Eigen::Matrix<Scalar, 3, 3> Matrix3;
+    typedef quadrotor_common::QuadrotorStateEstimate_<Scalar> StateEstimate;
+    typedef quadrotor_common::QuadrotorTrajectoryPoint_<Scalar> TrajectoryPoint;
+    typedef quadrotor_common::QuadrotorControlCommand_<Scalar> ControlCommand;
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  ReferenceInputsSolver's default constructor, called when an instance is created
+     *  @param  rotor_drag  - rotor drag constants
+     */
+    explicit ReferenceInputsSolver_(const RotorDragModel& rotor_drag = RotorDragModel());
+
+    /**
+     *  @brief  ReferenceInputsSolver's default destructor, called when an instance is destroyed
+     */
+    ~ReferenceInputsSolver_();
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Compute the reference inputs to track the reference state
+     *  @detail Only the orientation, collective thrust, bodyrates and angular acceleration
+     *          of the output command are written, i.e. timestamp and control mode are kept.
+     *          The heading frame is advanced from the one of the previous call, i.e. the
+     *          results differ from the ones of a fresh solver by up to ~1e-11, see reset().
+     *  @param  state_estimate    - quadrotor's current state estimate
+     *  @param  reference_state   - quadrotor's reference state to track
+     *  @param  reference_inputs  - output quadrotor's reference inputs
+     */
+    void solve(
+        const StateEstimate& state_estimate,
+        const TrajectoryPoint& reference_state,
+        ControlCommand& reference_inputs);
+
+    /**
+     *  @brief  Compute the reference inputs as solve() without the heading frame cache, i.e.
+     *          as a fresh solver would, independently of the previous calls and concurrently
+     *          from several threads
+     */
+    void solveUncached(
+        const StateEstimate& state_estimate,
+        const TrajectoryPoint& reference_state,
+        ControlCommand& reference_inputs) const;
+
+    /**
+     *  @brief  Check if solve() takes a singular branch of the robust body axes for the
+     *          reference state, i.e. if the reference inputs depend on the state estimate
+     *  @return boolean value where
+     *            + true  - Indicates y_C is collinear to alpha or x_B is collinear to beta
+     *            + false - Otherwise, i.e. the reference inputs depend on the reference state only
+     */
+    bool isStateDependent(const TrajectoryPoint& reference_state) const;
+
+    /**
+     *  @brief  Forget the previous solve(), i.e. the next one equals the one of a fresh solver
+     */
+    void reset() { heading_frame_.reset(); }
+
+    /**
+     *  @brief  Set the rotor drag constants of the next solve(), e.g. identified online
+     */
+    void setRotorDrag(const RotorDragModel& rotor_drag) { rotor_drag_ = rotor_drag; }
+
+    /**
+     *  @brief  Accessors
+     */
+    const RotorDragModel& rotorDrag() const { return rotor_drag_; }
+
+ protected:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    /**
+     *  @brief  Coefficients of the bodyrates system, shared by the bodyrates and the
+     *          angular accelerations, see solveBodyratesSystem()
+     */
+    struct BodyratesSystem {
+      Scalar A2, B1, C1, C2, B3, C3;
+    };
+
+        ////////////////////////////////////
+        ////////////  Constants  ///////////
+        ////////////////////////////////////
+
+    //  @brief  The gravity acting in -ve z_W direction i.e kGravity_ = -g.z_W
+    const Vector3 kGravity_ = Vector3(Scalar(0.0), Scalar(0.0), Scalar(-9.81));
+
+    //  @brief  The almost zero value threshold
+    static constexpr double kAlmostZeroValueThreshold_ = 0.001;
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Compute the reference inputs in the given heading frame
+     *  @param  x_C, y_C  - heading constraints of the reference heading
+     */
+    void solve(
+        const StateEstimate& state_estimate,
+        const TrajectoryPoint& reference_state,
+        const Vector3& x_C,
+        const Vector3& y_C,
+        ControlCommand& reference_inputs) const;
+
+    /**
+     *  @brief  Compute the robust reference orientation R = [x_B, y_B, z_B]
+     *  @detail for x_B refer computeRobustBodyXAxis()
+     *          for y_B refer computeRobustBodyYAxis()
+     *  @param  x_C, y_C  - heading constraints
+     *  @param  R         - computed reference orientation
+     */
+    void computeReferenceOrientation(
+        const StateEstimate& state_estimate,
+        const TrajectoryPoint& reference_state,
+        const Vector3& x_C,
+        const Vector3& y_C,
+        Matrix3& R) const;
+
+    /**
+     *  @brief  Compute the reference collective thrust c
+     *  @param  z_B - z axis of the orientation computed from computeReferenceOrientation()
+     */
+    Scalar computeReferenceCollectiveThrust(
+        const TrajectoryPoint& reference_state,
+        const Vector3& z_B) const;
+
+    /**
+     *  @brief  Compute the reference bodyrates omega
+     *  @param  x_C, y_C      - heading constraints
+     *  @param  R             - orientation computed from computeReferenceOrientation()
+     *  @param  c             - thrust computed from computeReferenceCollectiveThrust()
+     *  @param  system        - computed coefficients of the bodyrates system
+     *  @param  bodyrates     - computed bodyrates
+     */
+    void computeReferenceBodyrates(
+        const TrajectoryPoint& reference_state,
+        const Vector3& x_C,
+        const Vector3& y_C,
+        const Matrix3& R,
+        const Scalar& c,
+        BodyratesSystem& system,
+        Vector3& bodyrates) const;
+
+    /**
+     *  @brief  Compute the reference angular accelerations omega_dot
+     *  @param  x_C, y_C      - heading constraints
+     *  @param  R             - orientation computed from computeReferenceOrientation()
+     *  @param  c             - thrust computed from computeReferenceCollectiveThrust()
+     *  @param  system        - coefficients computed from computeReferenceBodyrates()
+     *  @param  bodyrates     - bodyrates computed from computeReferenceBodyrates()
+     *  @param  bodyrates_dot - computed angular accelerations
+     */
+    void computeReferenceAngularAcceleration(
+        const TrajectoryPoint& reference_state,
+        const Vector3& x_C,
+        const Vector3& y_C,
+        const Matrix3& R,
+        const Scalar& c,
+        const BodyratesSystem& system,
+        const Vector3& bodyrates,
+        Vector3& bodyrates_dot) const;
+
+    /**
+     *  @brief  Compute the body frame components x_B^T.xi and y_B^T.xi of the anisotropic
+     *          rotor drag term xi, with the kernel selected by kXiKernel
+     *  @param  R         - orientation computed from computeReferenceOrientation()
+     *  @param  bodyrates - bodyrates computed from computeReferenceBodyrates()
+     *  @param  xi_x      - computed x_B^T.xi
+     *  @param  xi_y      - computed y_B^T.xi
+     */
+    void computeRotorDragXi(
+        const TrajectoryPoint& reference_state,
+        const Matrix3& R,
+        const Vector3& bodyrates,
+        Scalar& xi_x,
+        Scalar& xi_y) const;
+
+    /**
+     *  @brief  Solve the linear system of the bodyrates (right hand side D1, D2, D3)
+     *          or of the angular accelerations (right hand side E1, E2, E3)
+     *  @detail  [  0  B1  C1 ] [x]   [rhs1]
+     *           [ A2   0  C2 ] [y] = [rhs2]
+     *           [  0  B3  C3 ] [z]   [rhs3]
+     *          with C1 = C2 = 0 and B1 = A2 = c for isotropic rotor drag.
+     *          The solution is set to 0 if the system is (almost) singular.
+     */
+    void solveBodyratesSystem(
+        const BodyratesSystem& system,
+        const Scalar& rhs1, const Scalar& rhs2, const Scalar& rhs3,
+        Vector3& solution) const;
+
+    /**
+     *  @brief  Compute robust x_B from the input constraints, where x_B = (y_C x alpha)
+     *  @detail Handle singularities when y_C is aligned with alpha or alpha = 0.
+     *          For an extreme case solution we set x_B = x_C.
+     */
+    Vector3 computeRobustBodyXAxis(
+        const StateEstimate& state_estimate,
+        const TrajectoryPoint& reference_state,
+        const Vector3& x_C,
+        const Vector3& y_C) const;
+
+    /**
+     *  @brief  Compute robust y_B from the input constraints, where y_B = (beta x x_B)
+     *  @detail Handle singularities when x_B is aligned with beta or beta = 0.
+     *          For an extreme case solution we set y_B = y_C.
+     *  @param  x_B   - robust x_B computed from computeRobustBodyXAxis()
+     */
+    Vector3 computeRobustBodyYAxis(
+        const StateEstimate& state_estimate,
+        const TrajectoryPoint& reference_state,
+        const Vector3& y_C,
+        const Vector3& x_B) const;
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    //  @brief  Rotor drag constants
+    RotorDragModel rotor_drag_;
+
+    //  @brief  Heading frame x_C, y_C of the previous reference state
+    HeadingFrameCache_<Scalar> heading_frame_;
+
+};  /*  class ReferenceInputsSolver_  */
+
+extern template class ReferenceInputsSolver_<NoRotorDrag>;
+extern template class ReferenceInputsSolver_<IsotropicRotorDrag>;
+extern template class ReferenceInputsSolver_<AnisotropicRotorDrag, XiKernel::kMatrixForm>;
+extern template class ReferenceInputsSolver_<AnisotropicRotorDrag, XiKernel::kBodyFrame>;
+extern template class ReferenceInputsSolver_<NoRotorDragf>;
+extern template class ReferenceInputsSolver_<IsotropicRotorDragf>;
+extern template class ReferenceInputsSolver_<AnisotropicRotorDragf, XiKernel::kMatrixForm>;
+extern template class ReferenceInputsSolver_<AnisotropicRotorDragf, XiKernel::kBodyFrame>;
+
+//  @brief  Reference inputs solver of the nominal dynamics
+typedef ReferenceInputsSolver_<NoRotorDrag> ReferenceInputsSolver;
+typedef ReferenceInputsSolver_<NoRotorDragf> ReferenceInputsSolverf;
+
+} /*  namespace position_controller  */
+
+#endif  /*  POSITION_CONTROLLER_REFERENCE_INPUTS_SOLVER_H  */
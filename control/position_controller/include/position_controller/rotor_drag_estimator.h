@@ -0,0 +1,203 @@
+/**
+ *  @file   rotor_drag_estimator.h
+ *  @brief  quadrotor position control's online rotor drag identification related functionality declaration & definition
+ *  @author thor
+ *  @date   18.12.2021
+ */
+#ifndef POSITION_CONTROLLER_ROTOR_DRAG_ESTIMATOR_H
+#define POSITION_CONTROLLER_ROTOR_DRAG_ESTIMATOR_H
+
+//  std dependencies
+#include <cstdint>
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+//  quadrotor_common dependencies
+#include "quadrotor_common/latest_value_mailbox.h"
+#include "quadrotor_common/quadrotor_state_estimate.h"
+
+//  position_controller dependencies
+#include "position_controller/rotor_drag_models.h"
+
+namespace position_controller {
+
+/**
+ *  @brief  Parameters of the RotorDragEstimator
+ */
+struct RotorDragEstimatorParameters {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  //  @brief  Gravity [m/s^2], along -z_W
+  double gravity = 9.81;
+
+  //  @brief  Forgetting factor in (0, 1], i.e. an effective memory of 1 / (1 - lambda) samples
+  double forgetting_factor = 0.999;
+
+  //  @brief  Initial coefficients [1/s] and their initial and maximum variances [1/s^2], the
+  //          latter bounds the covariance windup of unexcited axes, e.g. while hovering
+  Eigen::Vector3d initial_rotor_drag = Eigen::Vector3d::Zero();
+  double initial_variance = 1.0;
+  double max_variance = 1e3;
+
+  //  @brief  Publish every n-th sample into the mailbox
+  int publish_decimation = 1;
+};  /*  struct RotorDragEstimatorParameters  */
+
+/**
+ *  @brief  Snapshot of the identified rotor drag coefficients
+ */
+struct RotorDragEstimate {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  //  @brief  The coefficients dx, dy, dz [1/s] and their variances [1/s^2], up to the noise variance
+  Eigen::Vector3d rotor_drag = Eigen::Vector3d::Zero();
+  Eigen::Vector3d variance = Eigen::Vector3d::Zero();
+
+  //  @brief  Number of samples taken
+  std::uint64_t samples = 0;
+
+  /**
+   *  @brief  The coefficients as the rotor drag constants of the reference inputs, clamped to be
+   *          non negative, e.g. for PositionController_<AnisotropicRotorDrag>::setRotorDrag()
+   */
+  AnisotropicRotorDrag rotorDrag() const {
+    const Eigen::Vector3d d = rotor_drag.cwiseMax(0.0);
+    return AnisotropicRotorDrag(d.x(), d.y(), d.z());
+  }
+};  /*  struct RotorDragEstimate  */
+
+//  @brief  Mailbox of the rotor drag estimates, from the estimator into the control thread
+typedef quadrotor_common::LatestValueMailbox<RotorDragEstimate> RotorDragMailbox;
+
+/**
+ *  @brief  RotorDragEstimator class implementation
+ *  @detail Recursive least squares identification of the rotor drag D = diag(dx, dy, dz) of
+ *          the dynamics v_dot = -g*z_W + c*z_B - R*D*R^T*v from the state estimates and the
+ *          commanded mass normalized collective thrust c. In the body frame the dynamics
+ *          decouple per axis:
+ *            x_B^T*(v_dot + g*z_W)     = -dx * x_B^T*v
+ *            y_B^T*(v_dot + g*z_W)     = -dy * y_B^T*v
+ *            z_B^T*(v_dot + g*z_W) - c = -dz * z_B^T*v
+ *          i.e. three scalar regressions with a forgetting factor, O(1) time and memory per
+ *          sample. The acceleration is the difference quotient of two consecutive velocities,
+ *          and the equations are taken at the midpoint of the two samples, i.e. the velocity
+ *          and orientation are averaged, so that the sampling error is second order in dt.
+ *          White velocity noise of standard deviation sigma is uncorrelated between the
+ *          difference quotient and the midpoint velocity, but it is in the regressor, i.e. an
+ *          errors in variables problem: the estimate of an axis is attenuated by the factor
+ *          E[phi^2] / (E[phi^2] + sigma^2 / 2), e.g. by less than 1e-5 at sigma = 0.01 m/s and
+ *          3 m/s of velocity along the axis, by about 1% at sigma = 0.4 m/s.
+ *          The thrust command is taken as the thrust over the interval, i.e. the motor lag
+ *          biases dz during thrust transients. Every publish_decimation samples the estimate is
+ *          published into the mailbox, a copy of seven words and an atomic exchange, so that the
+ *          control thread polls it without ever waiting for the estimator, e.g.
+ *            if (rotor_drags.poll()) {
+ *              position_controller.setRotorDrag(rotor_drags.value().rotorDrag());
+ *            }
+ *          The estimator is the mailbox's only producer, update() is not thread safe.
+ */
+class RotorDragEstimator {
+ public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  RotorDragEstimator's default constructor, called when an instance is created
+     *  @param  parameters  - forgetting factor, prior and publishing rate
+     *  @param  rotor_drags - mailbox the estimates are published into, has to outlive the instance
+     */
+    RotorDragEstimator(const RotorDragEstimatorParameters& parameters, RotorDragMailbox& rotor_drags);
+
+    /**
+     *  @brief  RotorDragEstimator's default destructor, called when an instance is destroyed
+     */
+    ~RotorDragEstimator();
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Take the next state estimate
+     *  @param  state_estimate    - state estimate of the world frame
+     *  @param  collective_thrust - mass normalized collective thrust [m/s^2] commanded since the
+     *                              previous state estimate
+     *  @param  dt                - time since the previous state estimate [s]
+     *  @return boolean value where
+     *            + true  - Indicates a sample has been taken, i.e. the estimate updated
+     *            + false - Otherwise, i.e. the first state estimate or a non positive dt
+     */
+    bool update(
+        const quadrotor_common::QuadrotorStateEstimate& state_estimate,
+        const double collective_thrust,
+        const double dt);
+
+    /**
+     *  @brief  Restart from the prior, e.g. after a payload change, the next state estimate
+     *          is the first one again
+     */
+    void reset();
+
+    /**
+     *  @brief  The regression of the rotor drag between two consecutive state estimates, i.e.
+     *          y(i) = d(i) * phi(i) per body axis i at the midpoint of both, see update()
+     *  @param  previous_velocity     - velocity of the previous state estimate
+     *  @param  previous_orientation  - orientation of the previous state estimate
+     *  @param  state_estimate        - the state estimate
+     *  @param  collective_thrust     - mass normalized collective thrust commanded in between
+     *  @param  dt                    - time in between [s], positive
+     *  @param  gravity               - gravity [m/s^2]
+     *  @param  phi                   - output body frame midpoint velocity
+     *  @param  y                     - output body frame drag acceleration
+     */
+    static void regression(
+        const Eigen::Vector3d& previous_velocity,
+        const Eigen::Quaterniond& previous_orientation,
+        const quadrotor_common::QuadrotorStateEstimate& state_estimate,
+        const double collective_thrust,
+        const double dt,
+        const double gravity,
+        Eigen::Vector3d& phi,
+        Eigen::Vector3d& y);
+
+    /**
+     *  @brief  Accessors
+     */
+    const RotorDragEstimate& estimate() const { return estimate_; }
+    const RotorDragEstimatorParameters& parameters() const { return parameters_; }
+
+ private:
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Publish the estimate into the mailbox
+     */
+    void publish();
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    const RotorDragEstimatorParameters parameters_;
+    RotorDragMailbox& rotor_drags_;
+
+    //  @brief  The coefficients and their variances
+    RotorDragEstimate estimate_;
+
+    //  @brief  The previous state estimate
+    bool has_previous_;
+    Eigen::Vector3d previous_velocity_;
+    Eigen::Quaterniond previous_orientation_;
+
+};  /*  class RotorDragEstimator  */
+
+} /*  namespace position_controller  */
+
+#endif  /*  POSITION_CONTROLLER_ROTOR_DRAG_ESTIMATOR_H  */
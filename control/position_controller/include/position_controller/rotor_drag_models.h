@@ -0,0 +1,97 @@
+/**
+ *  @file   rotor_drag_models.h
+ *  @brief  quadrotor position control's rotor drag models related functionality declaration & definition
+ *  @author thor
+ *  @date   29.11.2021
+ */
+#ifndef POSITION_CONTROLLER_ROTOR_DRAG_MODELS_H
+#define POSITION_CONTROLLER_ROTOR_DRAG_MODELS_H
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+namespace position_controller {
+
+/**
+ *  @brief  Rotor drag model policies of the reference inputs pipeline.
+ *  @detail The rotor drag enters the dynamics as v_dot = -g*z_W + c*z_B - R*D*R^T*v,
+ *          with D = diag(dx, dy, dz). Each policy tells at compile time which terms survive:
+ *            + kEnabled      - false if D = 0, i.e. all drag terms vanish
+ *            + kAnisotropic  - false if dx = dy = dz, i.e. all (dx - dy), (dy - dz), (dz - dx)
+ *                              terms vanish and R*D*R^T = d*I
+ *          The Scalar typedef of the policy is the scalar type of the whole pipeline.
+ */
+
+/**
+ *  @brief  NoRotorDrag struct implementation
+ *  @detail Nominal dynamics, i.e. D = 0.
+ *  @tparam Scalar_ - scalar type of the reference inputs pipeline, e.g. double, float
+ *                    or an automatic differentiation scalar
+ */
+template <typename Scalar_>
+struct NoRotorDrag_ {
+  typedef Scalar_ Scalar;
+
+  static constexpr bool kEnabled = false;
+  static constexpr bool kAnisotropic = false;
+
+  Scalar dx() const { return Scalar(0.0); }
+  Scalar dy() const { return Scalar(0.0); }
+  Scalar dz() const { return Scalar(0.0); }
+};  /*  struct NoRotorDrag_  */
+
+/**
+ *  @brief  IsotropicRotorDrag struct implementation
+ *  @detail Equal rotor drag in all body axes, i.e. D = d*I.
+ */
+template <typename Scalar_>
+struct IsotropicRotorDrag_ {
+  typedef Scalar_ Scalar;
+
+  static constexpr bool kEnabled = true;
+  static constexpr bool kAnisotropic = false;
+
+  explicit IsotropicRotorDrag_(const Scalar& d = Scalar(0.0)) : d(d) {}
+
+  Scalar dx() const { return d; }
+  Scalar dy() const { return d; }
+  Scalar dz() const { return d; }
+
+  //  @brief  Rotor drag constant
+  Scalar d;
+};  /*  struct IsotropicRotorDrag_  */
+
+/**
+ *  @brief  AnisotropicRotorDrag struct implementation
+ *  @detail Individual rotor drag per body axis, i.e. D = diag(dx, dy, dz).
+ */
+template <typename Scalar_>
+struct AnisotropicRotorDrag_ {
+  typedef Scalar_ Scalar;
+
+  static constexpr bool kEnabled = true;
+  static constexpr bool kAnisotropic = true;
+
+  AnisotropicRotorDrag_(const Scalar& dx = Scalar(0.0), const Scalar& dy = Scalar(0.0),
+                        const Scalar& dz = Scalar(0.0))
+      : d(dx, dy, dz) {}
+
+  Scalar dx() const { return d.x(); }
+  Scalar dy() const { return d.y(); }
+  Scalar dz() const { return d.z(); }
+
+  //  @brief  Rotor drag constants [dx, dy, dz]
+  Eigen::Matrix<Scalar, 3, 1> d;
+};  /*  struct AnisotropicRotorDrag_  */
+
+typedef NoRotorDrag_<double> NoRotorDrag;
+typedef IsotropicRotorDrag_<double> IsotropicRotorDrag;
+typedef AnisotropicRotorDrag_<double> AnisotropicRotorDrag;
+
+typedef NoRotorDrag_<float> NoRotorDragf;
+typedef IsotropicRotorDrag_<float> IsotropicRotorDragf;
+typedef AnisotropicRotorDrag_<float> AnisotropicRotorDragf;
+
+} /*  namespace position_controller  */
+
+#endif  /*  POSITION_CONTROLLER_ROTOR_DRAG_MODELS_H  */
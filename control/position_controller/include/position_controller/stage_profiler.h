@@ -0,0 +1,161 @@
+/**
+ *  @file   stage_profiler.h
+ *  @brief  quadrotor position control's per stage latency instrumentation related functionality declaration & definition
+ *  @author thor
+ *  @date   08.12.2021
+ */
+#ifndef POSITION_CONTROLLER_STAGE_PROFILER_H
+#define POSITION_CONTROLLER_STAGE_PROFILER_H
+
+//  std dependencies
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+//  3rd party dependencies
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace position_controller {
+
+/**
+ *  @brief  The instrumented stages of the reference inputs pipeline
+ */
+enum class Stage {
+  kOrientation,             //  desired orientation, including the robust body axes
+  kCollectiveThrust,        //  desired collective thrust
+  kBodyrates,               //  desired bodyrates
+  kAngularAcceleration,     //  desired angular acceleration
+  kBodyXAxisSingularity,    //  singular branch of the robust body x axis, i.e. y_C collinear to alpha
+  kBodyYAxisSingularity,    //  singular branch of the robust body y axis, i.e. x_B collinear to beta
+  kNumStages
+};
+
+/**
+ *  @brief  Histogram of the cycle counts of one stage
+ *  @detail Bucket 0 holds 0 cycles and bucket b > 0 holds [2^(b-1), 2^b) cycles,
+ *          the last bucket also holds everything above.
+ */
+struct StageStatistics {
+  static constexpr int kBuckets = 32;
+
+  std::uint64_t count = 0;
+  std::uint64_t total_cycles = 0;
+  std::uint64_t max_cycles = 0;
+  std::array<std::uint64_t, kBuckets> buckets = {};
+
+  double meanCycles() const { return count > 0 ? static_cast<double>(total_cycles) / count : 0.0; }
+
+  /**
+   *  @brief  Upper bound of the bucket holding the quantile q in [0, 1], i.e. within a factor of 2
+   */
+  std::uint64_t quantileCycles(const double q) const;
+};  /*  struct StageStatistics  */
+
+/**
+ *  @brief  StageProfiler class implementation
+ *  @detail Records the cycle counts of the reference inputs pipeline stages into fixed size
+ *          histograms, one set per thread, i.e. recording neither locks, allocates nor shares
+ *          a cache line with the other threads, once the thread is registered, on its first
+ *          record() or up front with registerThread(). The histograms of all threads, including the
+ *          exited ones, are summed up when queried. Recording is compiled in with
+ *          POSITION_CONTROLLER_STAGE_PROFILING only, e.g.
+ *          catkin build --cmake-args -DPOSITION_CONTROLLER_STAGE_PROFILING=ON
+ *          otherwise POSITION_CONTROLLER_PROFILE_STAGE() expands to nothing and the pipeline
+ *          code is identical to the uninstrumented one, while the queries return empty histograms.
+ *          The cycles are the time stamp counter on x86, the virtual counter on aarch64 and
+ *          nanoseconds of the steady clock otherwise.
+ */
+class StageProfiler {
+ public:
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Whether the pipeline stages are instrumented in this build
+     */
+    static constexpr bool enabled() {
+#ifdef POSITION_CONTROLLER_STAGE_PROFILING
+      return true;
+#else
+      return false;
+#endif
+    }
+
+    /**
+     *  @brief  Current value of the cycle counter
+     */
+    static std::uint64_t cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+      return __rdtsc();
+#elif defined(__aarch64__)
+      std::uint64_t counter;
+      asm volatile("mrs %0, cntvct_el0" : "=r"(counter));
+      return counter;
+#else
+      return std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    /**
+     *  @brief  Register the calling thread's histograms, which locks and allocates once per
+     *          thread, i.e. to be called before a real time loop, otherwise the first record()
+     *          of the thread pays for it. A no op if the stages are not instrumented.
+     */
+    static void registerThread();
+
+    /**
+     *  @brief  Record the cycle count of a stage into the calling thread's histogram
+     *  @detail Registers the calling thread first, if not yet done, see registerThread()
+     */
+    static void record(const Stage stage, const std::uint64_t cycles);
+
+    /**
+     *  @brief  Histogram of a stage summed up over all threads
+     */
+    static StageStatistics statistics(const Stage stage);
+
+    /**
+     *  @brief  Clear the histograms of all threads, counts recorded concurrently may be kept
+     */
+    static void reset();
+
+    /**
+     *  @brief  Name of a stage, e.g. for printing
+     */
+    static const char* name(const Stage stage);
+
+};  /*  class StageProfiler  */
+
+/**
+ *  @brief  StageTimer class implementation
+ *  @detail Records the cycles from its construction to its destruction, i.e. of the enclosing scope.
+ */
+class StageTimer {
+ public:
+    explicit StageTimer(const Stage stage) : stage_(stage), start_(StageProfiler::cycles()) {}
+    ~StageTimer() { StageProfiler::record(stage_, StageProfiler::cycles() - start_); }
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+ private:
+    const Stage stage_;
+    const std::uint64_t start_;
+};  /*  class StageTimer  */
+
+} /*  namespace position_controller  */
+
+//  @brief  Profile the rest of the enclosing scope as the given stage, if enabled
+#ifdef POSITION_CONTROLLER_STAGE_PROFILING
+#define POSITION_CONTROLLER_PROFILE_STAGE(stage) \
+  const ::position_controller::StageTimer position_controller_stage_timer_(::position_controller::stage)
+#else
+#define POSITION_CONTROLLER_PROFILE_STAGE(stage)
+#endif
+
+#endif  /*  POSITION_CONTROLLER_STAGE_PROFILER_H  */
@@ -0,0 +1,137 @@
+/**
+ *  @file   aero_compensated_reference_inputs.h
+ *  @brief  quadrotor position control's aerodynamics compensated reference inputs related functionality declaration & definition
+ *  @author neo
+ *  @data   04.12.2021
+ */
+#ifndef REFERENCE_INPUTS_AERO_COMPENSATED_REFERENCE_INPUTS_H
+#define REFERENCE_INPUTS_AERO_COMPENSATED_REFERENCE_INPUTS_H
+
+// 3rd party dependencies
+#include <Eigen/Dense>
+
+// position_controller dependencies
+#include "reference_inputs/reference_inputs.h"
+
+namespace position_controller {
+
+/**
+ *  @brief  AeroCompensatedReferenceInputs class implementation.
+ *  @detail Reference inputs of the dynamics with rotor drag D = diag(dx, dy, dz), where
+ *          alpha = v_dot + g*z_W + dx*v, beta = v_dot + g*z_W + dy*v, gamma = v_dot + g*z_W + dz*v
+ */
+class AeroCompensatedReferenceInputs : public ReferenceInputs<AeroCompensatedReferenceInputs> {
+ public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        ///////////////////////////////////////////////////
+        //////////// Constructors & Destructors ///////////
+        ///////////////////////////////////////////////////
+
+    /**
+     *  @brief  AeroCompensatedReferenceInputs's default constructor, called when an instance is created.
+     *  @detail The inputs are referenced, i.e. they have to outlive the instance.
+     */
+    AeroCompensatedReferenceInputs(
+        const quadrotor_common::QuadrotorStateEstimate& state_est,
+        const quadrotor_common::QuadrotorTrajectoryPoint& state_ref,
+        const ReferenceInputsParameters& params)
+        : ReferenceInputs(state_est, state_ref, params) {}
+
+    /**
+     *  @brief  The inputs are referenced, not copied, i.e. temporaries would dangle.
+     */
+    AeroCompensatedReferenceInputs(
+        const quadrotor_common::QuadrotorStateEstimate&&,
+        const quadrotor_common::QuadrotorTrajectoryPoint&,
+        const ReferenceInputsParameters&) = delete;
+    AeroCompensatedReferenceInputs(
+        const quadrotor_common::QuadrotorStateEstimate&,
+        const quadrotor_common::QuadrotorTrajectoryPoint&&,
+        const ReferenceInputsParameters&) = delete;
+    AeroCompensatedReferenceInputs(
+        const quadrotor_common::QuadrotorStateEstimate&,
+        const quadrotor_common::QuadrotorTrajectoryPoint&,
+        const ReferenceInputsParameters&&) = delete;
+
+    /**
+     *  @brief  AeroCompensatedReferenceInputs's default destructor, called when an instance is destroyed.
+     */
+    ~AeroCompensatedReferenceInputs() {}
+
+        //////////////////////////////////////
+        //////////// Class Methods ///////////
+        //////////////////////////////////////
+
+    /**
+     *  @brief  Compute reference orientation matrix R.
+     *  @detail We use the following equations for derivation:
+     *          1. v_dot = -g*z_W + c*z_B - R*D*R^T*V
+     *          2. reference heading phi
+     *  @return computed desired attitude based on quadrotor's state estimate and reference state.
+     */
+    Eigen::Quaterniond computeDesiredAttitudeImpl() const {
+      const Eigen::Vector3d& d = parameters.rotor_drag_coefficients;
+      const Eigen::Vector3d desired_acceleration = reference_state.acceleration - kGravity_;
+      const Eigen::Vector3d alpha = desired_acceleration + d.x() * reference_state.velocity;
+      const Eigen::Vector3d beta = desired_acceleration + d.y() * reference_state.velocity;
+
+      Eigen::Matrix3d R_W_B;
+      R_W_B.col(0) = computeRobustBodyXAxis(y_C, alpha, state_estimate.orientation, x_C);
+      R_W_B.col(1) = computeRobustBodyYAxis(R_W_B.col(0), beta, state_estimate.orientation, y_C);
+      R_W_B.col(2) = R_W_B.col(0).cross(R_W_B.col(1));
+
+      return Eigen::Quaterniond(R_W_B);
+    }
+
+    /**
+     *  @brief  Compute reference collective thrust c.
+     *  @detail We use the following equation for derivation:
+     *          1. v_dot = -g*z_W + c*z_B - R*D*R^T*V
+     *          i.e. collective_thrust = z_B^T gamma
+     *  @return computed desired collective thrust.
+     */
+    double computeDesiredCollectiveThrustImpl(
+        const Eigen::Quaterniond& q_W_B) const {
+      const Eigen::Vector3d gamma = reference_state.acceleration - kGravity_ + \
+          parameters.rotor_drag_coefficients.z() * reference_state.velocity;
+      const Eigen::Vector3d z_B = q_W_B * Eigen::Vector3d::UnitZ();
+      return z_B.dot(gamma);
+    }
+
+    /**
+     *  @brief  Compute reference body rates omega.
+     *  @detail We use the following equation for derivation and
+     *          and under the differential flatness assumption:
+     *          1. v_dot = -g*z_W + c*z_B - R*D*R^T*V
+     *          2. R_dot = R*bodyrates_hat
+     */
+    Eigen::Vector3d computeDesiredBodyRatesImpl(
+        const Eigen::Quaterniond& q_W_B,
+        const double collective_thrust) const {
+      const Eigen::Matrix3d R_W_B = q_W_B.toRotationMatrix();
+      const Eigen::Vector3d x_B = R_W_B.col(0);
+      const Eigen::Vector3d y_B = R_W_B.col(1);
+      const Eigen::Vector3d z_B = R_W_B.col(2);
+      const Eigen::Vector3d& v = reference_state.velocity;
+      const double dx = parameters.rotor_drag_coefficients.x();
+      const double dy = parameters.rotor_drag_coefficients.y();
+      const double dz = parameters.rotor_drag_coefficients.z();
+      const double c = collective_thrust;
+
+      return solveBodyRates(
+          c + (dy - dz)*(z_B.dot(v)),
+          c - (dz - dx)*(z_B.dot(v)),
+          -(dx - dy)*(y_B.dot(v)),
+          (dx - dy)*(x_B.dot(v)),
+          -y_C.dot(z_B), (y_C.cross(z_B)).norm(),
+          x_B.dot(reference_state.jerk) + dx * x_B.dot(reference_state.acceleration),
+          -y_B.dot(reference_state.jerk) - dy * y_B.dot(reference_state.acceleration),
+          reference_state.heading_rate * x_C.dot(x_B));
+    }
+
+};  /* class AeroCompensatedReferenceInputs */
+
+} /* namespace position_controller */
+
+#endif  /* REFERENCE_INPUTS_AERO_COMPENSATED_REFERENCE_INPUTS_H */
@@ -17,9 +17,9 @@ namespace position_controller {
 
 /**
  *  @brief  NominalReferenceInputs class implementation.
- *  @detail
+ *  @detail Reference inputs of the nominal dynamics, i.e. without rotor drag.
  */
-class NominalReferenceInputs : public ReferenceInputs {
+class NominalReferenceInputs : public ReferenceInputs<NominalReferenceInputs> {
  public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 
@@ -29,34 +29,78 @@ class NominalReferenceInputs : public ReferenceInputs {
 
     /**
      *  @brief  NominalReferenceInputs's default constructor, called when an instance is created.
+     *  @detail The inputs are referenced, i.e. they have to outlive the instance.
      */
     NominalReferenceInputs(
         const quadrotor_common::QuadrotorStateEstimate& state_est,
-        const quadrotor_common::QuadrotorTrajectoryPoint& state_ref)
-        : ReferenceInputs(state_est, state_ref) {}
+        const quadrotor_common::QuadrotorTrajectoryPoint& state_ref,
+        const ReferenceInputsParameters& params = kDefaultParameters_)
+        : ReferenceInputs(state_est, state_ref, params) {}
+
+    /**
+     *  @brief  The inputs are referenced, not copied, i.e. temporaries would dangle.
+     */
+    NominalReferenceInputs(
+        const quadrotor_common::QuadrotorStateEstimate&&,
+        const quadrotor_common::QuadrotorTrajectoryPoint&,
+        const ReferenceInputsParameters& = kDefaultParameters_) = delete;
+    NominalReferenceInputs(
+        const quadrotor_common::QuadrotorStateEstimate&,
+        const quadrotor_common::QuadrotorTrajectoryPoint&&,
+        const ReferenceInputsParameters& = kDefaultParameters_) = delete;
+    NominalReferenceInputs(
+        const quadrotor_common::QuadrotorStateEstimate&,
+        const quadrotor_common::QuadrotorTrajectoryPoint&,
+        const ReferenceInputsParameters&&) = delete;
 
     /**
      *  @brief  NominalReferenceInputs's default destructor, called when an instance is destroyed.
      */
     ~NominalReferenceInputs() {}
 
+        //////////////////////////////////////
+        //////////// Class Methods ///////////
+        //////////////////////////////////////
+
     /**
      *  @brief  Compute reference orientation matrix R.
      *  @detail We use the following equations for derivation:
      *          1. v_dot = -g*z_W + c*z_B
      *          2. reference heading phi
+     *          In nominal dynamics scenario, constraints: alpha, beta and gamma
+     *          values are equal i.e. to desired acceleration.
      *  @return computed desired attitude based on quadrotor's state estimate and reference state.
      */
-    Eigen::Quaterniond computeDesiredAttitude() const override;
+    Eigen::Quaterniond computeDesiredAttitudeImpl() const {
+      // Constraints based on acceleration i.e. alpha, beta and gamma
+      const Eigen::Vector3d desired_acceleration = reference_state.acceleration - kGravity_;
+
+      // Compute robust x_B, y_B and z_B that statisfies all required constraints
+      Eigen::Matrix3d R_W_B;
+      R_W_B.col(0) = computeRobustBodyXAxis(
+          y_C, desired_acceleration, state_estimate.orientation, x_C);
+      R_W_B.col(1) = computeRobustBodyYAxis(
+          R_W_B.col(0), desired_acceleration, state_estimate.orientation, y_C);
+      R_W_B.col(2) = R_W_B.col(0).cross(R_W_B.col(1));
+
+      // Construct desired(reference) attitude
+      return Eigen::Quaterniond(R_W_B);
+    }
 
     /**
      *  @brief  Compute reference collective thrust c.
      *  @detail We use the following equation for derivation:
      *          1. v_dot = -g*z_W + c*z_B
+     *          In nominal dynamics scenario, we can further simplfy as
+     *          collective_thrust = z_B^T desired_acceleration
      *  @return computed desired collective thrust.
      */
-    virtual float computeDesiredCollectiveThrust(
-        const Eigen::Quaterniond& q_W_B) const override;
+    double computeDesiredCollectiveThrustImpl(
+        const Eigen::Quaterniond& q_W_B) const {
+      const Eigen::Vector3d desired_acceleration = reference_state.acceleration - kGravity_;
+      const Eigen::Vector3d z_B = q_W_B * Eigen::Vector3d::UnitZ();
+      return z_B.dot(desired_acceleration);
+    }
 
     /**
      *  @brief  Compute reference body rates omega.
@@ -64,10 +108,30 @@ class NominalReferenceInputs : public ReferenceInputs {
      *          and under the differential flatness assumption:
      *          1. v_dot = -g*z_W + c*z_B
      *          2. R_dot = R*bodyrates_hat
+     *          i.e. omega_x = -y_B^T j/c, omega_y = x_B^T j/c
      */
-    virtual Eigen::Vector3d computeDesiredBodyRates(
+    Eigen::Vector3d computeDesiredBodyRatesImpl(
         const Eigen::Quaterniond& q_W_B,
-        const float collective_thrust) const override;
+        const double collective_thrust) const {
+      const Eigen::Matrix3d R_W_B = q_W_B.toRotationMatrix();
+      const double c = collective_thrust;
+
+      return solveBodyRates(
+          c, c, 0.0, 0.0,
+          -y_C.dot(R_W_B.col(2)), (y_C.cross(R_W_B.col(2))).norm(),
+          R_W_B.col(0).dot(reference_state.jerk),
+          -R_W_B.col(1).dot(reference_state.jerk),
+          reference_state.heading_rate * x_C.dot(R_W_B.col(0)));
+    }
+
+ private:
+
+        //////////////////////////////////
+        //////////// Constants ///////////
+        //////////////////////////////////
+
+    //  @brief  The default parameters, i.e. the nominal dynamics have no parameters
+    static const ReferenceInputsParameters kDefaultParameters_;
 
 };  /* class NominalReferenceInputs */
 
@@ -7,23 +7,56 @@
 #ifndef REFERENCE_INPUTS_REFERENCE_INPUTS_H
 #define REFERENCE_INPUTS_REFERENCE_INPUTS_H
 
+// std dependencies
+#include <cmath>
+
 // 3rd party dependencies
 #include <Eigen/Dense>
 
 // quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_control_command.h"
 #include "quadrotor_common/quadrotor_state_estimate.h"
 #include "quadrotor_common/quadrotor_trajectory_point.h"
 
+// position_controller dependencies
+#include "position_controller/stage_profiler.h"
+
 namespace position_controller {
 
+/**
+ *  @brief  ReferenceInputsParameters struct implementation.
+ *  @detail Parameters shared by all reference inputs models, i.e. unused parameters are ignored
+ *          by a model, e.g. the rotor drag coefficients by NominalReferenceInputs.
+ */
+struct ReferenceInputsParameters {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  //  @brief  The rotor drag coefficients dx, dy, dz [1/s]
+  Eigen::Vector3d rotor_drag_coefficients = Eigen::Vector3d::Zero();
+
+};  /* struct ReferenceInputsParameters */
+
 /**
  *  @brief  ReferenceInputs class implementation.
  *  @detail Compute the desired orientation, the desired collective thrust command,
- *          the desired body rates, and the desired angular acceleration,
- *          required for high-level position controller.
- *          The key functionalities are implemented maninly in NominalReferenceInputs and
- *          AeroCompensatedReferenceInputs concrete classes.
+ *          and the desired body rates, required for high-level position controller.
+ *          The key functionalities are implemented mainly in NominalReferenceInputs and
+ *          AeroCompensatedReferenceInputs concrete classes, which are bound at compile time
+ *          (curiously recurring template pattern), i.e. the stages are inlined into each other
+ *          without an indirect call. A model is picked by name at runtime with the
+ *          ReferenceInputsRegistry, i.e. with a single indirect call per batch of points.
+ *          The concrete class implements:
+ *            + Eigen::Quaterniond computeDesiredAttitudeImpl() const
+ *            + double computeDesiredCollectiveThrustImpl(const Eigen::Quaterniond&) const
+ *            + Eigen::Vector3d computeDesiredBodyRatesImpl(const Eigen::Quaterniond&, double) const
+ *          The state estimate, reference state and parameters are referenced, not copied, as a
+ *          model is constructed per point, i.e. they have to outlive the instance and binding a
+ *          temporary does not compile. The models compute the orientation, collective thrust
+ *          and bodyrates only, not the angular acceleration of ReferenceInputsSolver_, i.e.
+ *          the angular acceleration of the output command is left as it was.
+ *  @tparam Derived - concrete reference inputs model
  */
+template <typename Derived>
 class ReferenceInputs {
  public:
     EIGEN_MAKE_ALIGNED_OPERATOR_NEW
@@ -34,19 +67,23 @@ class ReferenceInputs {
 
     /**
      *  @brief  ReferenceInputs's default constructor, called when an concrete class's instance is created.
+     *  @detail The inputs are referenced, i.e. they have to outlive the instance, which the
+     *          concrete classes enforce for temporaries by deleted rvalue constructors.
      */
     ReferenceInputs(
         const quadrotor_common::QuadrotorStateEstimate& state_est,
-        const quadrotor_common::QuadrotorTrajectoryPoint& state_ref)
+        const quadrotor_common::QuadrotorTrajectoryPoint& state_ref,
+        const ReferenceInputsParameters& params)
         : state_estimate(state_est),
-          reference_state(state_ref) {
+          reference_state(state_ref),
+          parameters(params) {
 
       // constraints based on reference heading, i.e.,
       // projection of x_B into x_W - y_W plane will be collinear with x_C
-      const Eigen::Quaterniond q_heading = Eigen::Quaterniond(
-          Eigen::AngleAxisd(reference_state.heading, Eigen::Vector3d::UnitZ()));
-      x_C = q_heading * Eigen::Vector3d::UnitX();
-      y_C = q_heading * Eigen::Vector3d::UnitY();
+      const double cos_heading = std::cos(reference_state.heading);
+      const double sin_heading = std::sin(reference_state.heading);
+      x_C = Eigen::Vector3d(cos_heading, sin_heading, 0.0);
+      y_C = Eigen::Vector3d(-sin_heading, cos_heading, 0.0);
     }
 
         //////////////////////////////////////
@@ -60,7 +97,9 @@ class ReferenceInputs {
      *          2. reference heading phi
      *  @return computed desired attitude based on quadrotor's state estimate and reference state.
      */
-    virtual Eigen::Quaterniond computeDesiredAttitude() const = 0;
+    Eigen::Quaterniond computeDesiredAttitude() const {
+      return derived().computeDesiredAttitudeImpl();
+    }
 
     /**
      *  @brief  Compute reference collective thrust c.
@@ -68,8 +107,10 @@ class ReferenceInputs {
      *          1. v_dot = -g*z_W + c*z_B - R*D*R^T*V
      *  @return computed desired collective thrust.
      */
-    virtual float computeDesiredCollectiveThrust(
-        const Eigen::Quaterniond& q_W_B) const = 0;
+    double computeDesiredCollectiveThrust(
+        const Eigen::Quaterniond& q_W_B) const {
+      return derived().computeDesiredCollectiveThrustImpl(q_W_B);
+    }
 
     /**
      *  @brief  Compute reference body rates omega.
@@ -78,9 +119,36 @@ class ReferenceInputs {
      *          1. v_dot = -g*z_W + c*z_B - R*D*R^T*V
      *          2. R_dot = R*bodyrates_hat
      */
-    virtual Eigen::Vector3d computeDesiredBodyRates(
+    Eigen::Vector3d computeDesiredBodyRates(
         const Eigen::Quaterniond& q_W_B,
-        const float collective_thrust) const = 0;
+        const double collective_thrust) const {
+      return derived().computeDesiredBodyRatesImpl(q_W_B, collective_thrust);
+    }
+
+    /**
+     *  @brief  Compute all stages, i.e. the desired attitude, collective thrust and body rates.
+     *  @detail Only the orientation, collective thrust and bodyrates of the output command
+     *          are written, i.e. timestamp, control mode and angular acceleration are kept.
+     *          Every stage is profiled on its own, see StageProfiler.
+     *  @param  reference_inputs  - output quadrotor's reference inputs
+     */
+    void computeReferenceInputs(
+        quadrotor_common::QuadrotorControlCommand& reference_inputs) const {
+      {
+        POSITION_CONTROLLER_PROFILE_STAGE(Stage::kOrientation);
+        reference_inputs.orientation = computeDesiredAttitude();
+      }
+      {
+        POSITION_CONTROLLER_PROFILE_STAGE(Stage::kCollectiveThrust);
+        reference_inputs.collective_thrust = computeDesiredCollectiveThrust(
+            reference_inputs.orientation);
+      }
+      {
+        POSITION_CONTROLLER_PROFILE_STAGE(Stage::kBodyrates);
+        reference_inputs.bodyrates = computeDesiredBodyRates(
+            reference_inputs.orientation, reference_inputs.collective_thrust);
+      }
+    }
 
     /**
      *  @brief  Compute robust x_B from the input constraints, where x_B = (y_C x alpha).
@@ -118,13 +186,13 @@ class ReferenceInputs {
      *  @brief  Accessor for x_C constraint
      *  @return computed x_C projection constraint
      */
-    Eigen::Vector3d getX_C() { return x_C; }
+    Eigen::Vector3d getX_C() const { return x_C; }
 
     /**
      *  @brief  Accessor for y_C constraint
      *  @return computed y_C projection constraint
      */
-    Eigen::Vector3d getY_C() { return y_C; }
+    Eigen::Vector3d getY_C() const { return y_C; }
 
  protected:
 
@@ -135,13 +203,18 @@ class ReferenceInputs {
     //  @brief  The gravity in -ve z_W direction
     const Eigen::Vector3d kGravity_ = Eigen::Vector3d(0.0, 0.0, -9.81);
 
-    //  @brief
+    //  @brief  The almost zero value threshold
     static constexpr double kAlmostZeroValueThreshold_ = 0.001;
 
         //////////////////////////////////////
         //////////// Class Methods ///////////
         //////////////////////////////////////
 
+    /**
+     *  @brief  Accessor for the concrete reference inputs model
+     */
+    const Derived& derived() const { return static_cast<const Derived&>(*this); }
+
     /**
      *  @brief  Check if the input value is below the almost zero value threshold or not.
      *  @param  value   - input value to check
@@ -149,23 +222,137 @@ class ReferenceInputs {
      *            + true  - Indicates the input value is almost zero
      *            + false - Otherwise
      */
-    bool isAlmostZero(const double value) const;
+    bool isAlmostZero(const double value) const {
+      return std::fabs(value) < kAlmostZeroValueThreshold_;
+    }
+
+    /**
+     *  @brief  Solve the bodyrates system of the flatness equations
+     *  @detail B1*omega_y + C1*omega_z = D1
+     *          A2*omega_x + C2*omega_z = D2
+     *          B3*omega_y + C3*omega_z = D3
+     */
+    Eigen::Vector3d solveBodyRates(
+        const double A2, const double B1, const double C1, const double C2,
+        const double B3, const double C3,
+        const double D1, const double D2, const double D3) const;
 
         //////////////////////////////////////
         //////////// Class Members ///////////
         //////////////////////////////////////
 
-    //  @brief
-    quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+    //  @brief  The quadrotor's current state estimate, referenced, see ReferenceInputs()
+    const quadrotor_common::QuadrotorStateEstimate& state_estimate;
+
+    //  @brief  The quadrotor's reference state to track
+    const quadrotor_common::QuadrotorTrajectoryPoint& reference_state;
 
-    //  @brief
-    quadrotor_common::QuadrotorStateEstimate state_estimate;
+    //  @brief  The reference inputs model parameters
+    const ReferenceInputsParameters& parameters;
 
     //  @brief  Constraints to enforce reference heading phi
     Eigen::Vector3d x_C, y_C;
 
 };  /* class ReferenceInputs */
 
+/**
+ *  @detail Perform the following:
+ *          check if norm(y_C x alpha) == 0
+ *            if true, the check if norm(x_B_est - (x_B_est^T y_C)y_C) == 0
+ *                      if true, set x_B = x_C
+ *                      else, set x_B = normalized(x_B_est - (x_B_est^T y_C)y_C)
+ *            else, set x_B = normalized(y_C x alpha)
+ */
+template <typename Derived>
+Eigen::Vector3d ReferenceInputs<Derived>::computeRobustBodyXAxis(
+    const Eigen::Vector3d& y_C,
+    const Eigen::Vector3d& alpha,
+    const Eigen::Quaterniond& attitude_estimate,
+    const Eigen::Vector3d& x_C) const {
+
+  Eigen::Vector3d x_B = y_C.cross(alpha);
+
+  // check if y_C is collinear to alpha
+  if (isAlmostZero(x_B.norm())) {
+    POSITION_CONTROLLER_PROFILE_STAGE(Stage::kBodyXAxisSingularity);
+
+    // project estimated x_B into x_C - z_C plane using scalar projection onto y_C, followed by vector rejection
+    const Eigen::Vector3d x_B_est = attitude_estimate * Eigen::Vector3d::UnitX();
+    const Eigen::Vector3d x_B_proj = x_B_est - (x_B_est.dot(y_C)) * y_C;
+    if (isAlmostZero(x_B_proj.norm()))
+      x_B = x_C;  // special case which may lead to jumps in the desired orientation
+    else
+      x_B = x_B_proj.normalized();
+
+  } // handle singuarity case
+  else {
+    x_B.normalize();
+  } // normalize
+
+  return x_B;
+}
+
+/**
+ *  @detail Perform the following:
+ *          check if norm(beta x x_B) == 0
+ *            if true, check if norm(z_B_est x x_B) == 0
+ *                      if true, set y_B = y_C
+ *                      else, set y_B = normalized(z_B_est x x_B)
+ *            else, set y_B = normalized(beta x x_B)
+ */
+template <typename Derived>
+Eigen::Vector3d ReferenceInputs<Derived>::computeRobustBodyYAxis(
+    const Eigen::Vector3d& x_B,
+    const Eigen::Vector3d& beta,
+    const Eigen::Quaterniond& attitude_estimate,
+    const Eigen::Vector3d& y_C) const {
+
+  Eigen::Vector3d y_B = beta.cross(x_B);
+
+  // check if x_B is collinear to beta
+  if (isAlmostZero(y_B.norm())) {
+    POSITION_CONTROLLER_PROFILE_STAGE(Stage::kBodyYAxisSingularity);
+
+    // project estimated x_B into x_C - z_C plane using scalar projection onto y_C
+    const Eigen::Vector3d z_B_est = attitude_estimate * Eigen::Vector3d::UnitZ();
+    y_B = z_B_est.cross(x_B);
+    if (isAlmostZero(y_B.norm()))
+      y_B = y_C;  // special case which may lead to jumps in the desired orientation
+    else
+      y_B.normalize();
+
+  } // handle singuarity case
+  else {
+    y_B.normalize();
+  } // normalize
+
+  return y_B;
+}
+
+/**
+ *  @detail omega_y, omega_z from the first and third equations, omega_x from the second one.
+ *          For B1*C3 - B3*C1 = 0 the bodyrates are zero, for A2 = 0 omega_x is zero.
+ */
+template <typename Derived>
+Eigen::Vector3d ReferenceInputs<Derived>::solveBodyRates(
+    const double A2, const double B1, const double C1, const double C2,
+    const double B3, const double C3,
+    const double D1, const double D2, const double D3) const {
+  Eigen::Vector3d bodyrates = Eigen::Vector3d::Zero();
+
+  const double denominator = B1*C3 - B3*C1;
+  if (isAlmostZero(denominator)) {
+    return bodyrates;
+  } // zero solution
+
+  bodyrates.y() = (-C1*D3 + C3*D1)/denominator;
+  bodyrates.z() = (B1*D3 - B3*D1)/denominator;
+  if (!isAlmostZero(A2)) {
+    bodyrates.x() = (D2 - C2*bodyrates.z())/A2;
+  }
+  return bodyrates;
+}
+
 } /* namespace position_controller */
 
 #endif  /* REFERENCE_INPUTS_REFERENCE_INPUTS_H */
@@ -0,0 +1,99 @@
+/**
+ *  @file   reference_inputs_registry.h
+ *  @brief  quadrotor position control's reference inputs models registry related functionality declaration & definition
+ *  @author neo
+ *  @data   04.12.2021
+ */
+#ifndef REFERENCE_INPUTS_REFERENCE_INPUTS_REGISTRY_H
+#define REFERENCE_INPUTS_REFERENCE_INPUTS_REGISTRY_H
+
+// std dependencies
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// position_controller dependencies
+#include "reference_inputs/reference_inputs.h"
+
+namespace position_controller {
+
+/**
+ *  @brief  Compute the reference inputs of a batch of points with one reference inputs model.
+ *  @param  state_estimates   - quadrotor's current state estimates
+ *  @param  reference_states  - quadrotor's reference states to track
+ *  @param  n                 - number of points
+ *  @param  parameters        - reference inputs model parameters
+ *  @param  reference_inputs  - output quadrotor's reference inputs, see computeReferenceInputs()
+ */
+typedef void (*ReferenceInputsFunction)(
+    const quadrotor_common::QuadrotorStateEstimate* state_estimates,
+    const quadrotor_common::QuadrotorTrajectoryPoint* reference_states,
+    std::size_t n,
+    const ReferenceInputsParameters& parameters,
+    quadrotor_common::QuadrotorControlCommand* reference_inputs);
+
+/**
+ *  @brief  The ReferenceInputsFunction of a reference inputs model, i.e. the stages
+ *          of the model are bound at compile time and inlined into the loop over the points.
+ *  @tparam Model - concrete reference inputs model, e.g. NominalReferenceInputs
+ */
+template <typename Model>
+void computeReferenceInputs(
+    const quadrotor_common::QuadrotorStateEstimate* state_estimates,
+    const quadrotor_common::QuadrotorTrajectoryPoint* reference_states,
+    const std::size_t n,
+    const ReferenceInputsParameters& parameters,
+    quadrotor_common::QuadrotorControlCommand* reference_inputs) {
+  for (std::size_t i = 0; i < n; ++i) {
+    const Model model(state_estimates[i], reference_states[i], parameters);
+    model.computeReferenceInputs(reference_inputs[i]);
+  }
+}
+
+/**
+ *  @brief  ReferenceInputsRegistry class implementation.
+ *  @detail Runtime selection of a reference inputs model by name, e.g. from a parameter at startup:
+ *            + "nominal"           - NominalReferenceInputs
+ *            + "aero_compensated"  - AeroCompensatedReferenceInputs
+ *          Only the lookup is dynamic, the returned function runs the statically bound model
+ *          for a whole batch of points. Models are registered at startup, add() and remove() are not thread safe.
+ */
+class ReferenceInputsRegistry {
+ public:
+
+        //////////////////////////////////////
+        //////////// Class Methods ///////////
+        //////////////////////////////////////
+
+    /**
+     *  @brief  Register a reference inputs model.
+     *  @return boolean value where
+     *            + true  - Indicates the model is registered
+     *            + false - Otherwise, i.e. the name is already taken
+     */
+    static bool add(const std::string& name, ReferenceInputsFunction function);
+
+    /**
+     *  @brief  Unregister a reference inputs model, e.g. one added by a test.
+     *  @return boolean value where
+     *            + true  - Indicates the model is unregistered
+     *            + false - Otherwise, i.e. the name is unknown
+     */
+    static bool remove(const std::string& name);
+
+    /**
+     *  @brief  Find a reference inputs model by name.
+     *  @return the function of the model, nullptr for an unknown name.
+     */
+    static ReferenceInputsFunction find(const std::string& name);
+
+    /**
+     *  @brief  Names of all registered reference inputs models, sorted.
+     */
+    static std::vector<std::string> names();
+
+};  /* class ReferenceInputsRegistry */
+
+} /* namespace position_controller */
+
+#endif  /* REFERENCE_INPUTS_REFERENCE_INPUTS_REGISTRY_H */
@@ -0,0 +1,377 @@
+/**
+ *  @file   batch_reference_inputs.cpp
+ *  @brief  quadrotor position control's batched reference inputs related functionality implementation
+ *  @author thor
+ *  @date   24.11.2021
+ */
+#include "position_controller/batch_reference_inputs.h"
+
+//  std dependencies
+#include <algorithm>
+#include <cmath>
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+namespace position_controller {
+
+namespace {
+
+//  @brief  SIMD register width in bytes
+#if defined(EIGEN_VECTORIZE_AVX512)
+constexpr int kRegisterBytes = 64;
+#elif defined(EIGEN_VECTORIZE_AVX)
+constexpr int kRegisterBytes = 32;
+#else
+constexpr int kRegisterBytes = 16;
+#endif
+
+//  @brief  The gravity acting in -ve z_W direction, same as used by ReferenceInputsSolver
+constexpr double kGravity = 9.81;
+
+//  @brief  The almost zero value threshold, same as used by ReferenceInputsSolver
+constexpr double kAlmostZeroValueThreshold = 0.001;
+
+/**
+ *  @brief  Number of lanes, i.e. scalars per SIMD register (twice as many floats as doubles)
+ */
+template <typename Scalar>
+struct Lanes {
+  static constexpr int kLanes = kRegisterBytes / static_cast<int>(sizeof(Scalar));
+  typedef Eigen::Array<Scalar, kLanes, 1> Lane;
+  typedef Eigen::Array<bool, kLanes, 1> LaneMask;
+};
+
+/**
+ *  @brief  3d vectors of all lanes in struct-of-arrays form
+ */
+template <typename Scalar>
+struct LaneVector3 {
+  typedef typename Lanes<Scalar>::Lane Lane;
+
+  Lane x, y, z;
+
+  void set(const int lane, const Eigen::Matrix<Scalar, 3, 1>& v) {
+    x[lane] = v.x();
+    y[lane] = v.y();
+    z[lane] = v.z();
+  }
+
+  Eigen::Matrix<Scalar, 3, 1> get(const int lane) const {
+    return Eigen::Matrix<Scalar, 3, 1>(x[lane], y[lane], z[lane]);
+  }
+};
+
+template <typename Scalar>
+inline typename Lanes<Scalar>::Lane dot(const LaneVector3<Scalar>& a,
+                                        const LaneVector3<Scalar>& b) {
+  return a.x*b.x + a.y*b.y + a.z*b.z;
+}
+
+template <typename Scalar>
+inline LaneVector3<Scalar> cross(const LaneVector3<Scalar>& a, const LaneVector3<Scalar>& b) {
+  return {a.y*b.z - a.z*b.y, a.z*b.x - a.x*b.z, a.x*b.y - a.y*b.x};
+}
+
+template <typename Scalar>
+inline LaneVector3<Scalar> normalized(const LaneVector3<Scalar>& v,
+                                      const typename Lanes<Scalar>::Lane& norm) {
+  return {v.x/norm, v.y/norm, v.z/norm};
+}
+
+template <typename Scalar>
+inline LaneVector3<Scalar> diagonal(const Scalar dx, const Scalar dy, const Scalar dz,
+                                    const LaneVector3<Scalar>& v) {
+  return {dx*v.x, dy*v.y, dz*v.z};
+}
+
+template <typename Scalar>
+inline LaneVector3<Scalar> operator+(const LaneVector3<Scalar>& a, const LaneVector3<Scalar>& b) {
+  return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+template <typename Scalar>
+inline LaneVector3<Scalar> operator-(const LaneVector3<Scalar>& a, const LaneVector3<Scalar>& b) {
+  return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+template <typename Scalar>
+inline LaneVector3<Scalar> operator*(const Scalar s, const LaneVector3<Scalar>& v) {
+  return {s*v.x, s*v.y, s*v.z};
+}
+
+/**
+ *  @brief  Quaternion of the rotation matrix R = [x_B, y_B, z_B] per lane,
+ *          branch free version of Eigen's quaternion from rotation matrix conversion
+ */
+template <typename Scalar, typename Lane = typename Lanes<Scalar>::Lane,
+          typename LaneMask = typename Lanes<Scalar>::LaneMask>
+void toQuaternion(const LaneVector3<Scalar>& x_B, const LaneVector3<Scalar>& y_B,
+                  const LaneVector3<Scalar>& z_B,
+                  Lane& qw, Lane& qx, Lane& qy, Lane& qz) {
+  const Lane& m00 = x_B.x; const Lane& m01 = y_B.x; const Lane& m02 = z_B.x;
+  const Lane& m10 = x_B.y; const Lane& m11 = y_B.y; const Lane& m12 = z_B.y;
+  const Lane& m20 = x_B.z; const Lane& m21 = y_B.z; const Lane& m22 = z_B.z;
+
+  //  w is the largest component
+  const LaneMask case_w = (m00 + m11 + m22) > 0.0;
+  const Lane tw = (m00 + m11 + m22 + 1.0).sqrt();
+  const Lane rw = 0.5/tw;
+
+  //  x, y or z is the largest component
+  const LaneMask case_y = (m11 > m00);
+  const LaneMask case_z = (m22 > case_y.select(m11, m00));
+  const Lane t0 = (m00 - m11 - m22 + 1.0).sqrt();
+  const Lane t1 = (m11 - m22 - m00 + 1.0).sqrt();
+  const Lane t2 = (m22 - m00 - m11 + 1.0).sqrt();
+  const Lane r0 = 0.5/t0, r1 = 0.5/t1, r2 = 0.5/t2;
+
+  const Lane w_xyz = case_z.select((m10 - m01)*r2,
+      case_y.select((m02 - m20)*r1, (m21 - m12)*r0));
+  const Lane x_xyz = case_z.select((m02 + m20)*r2,
+      case_y.select((m01 + m10)*r1, 0.5*t0));
+  const Lane y_xyz = case_z.select((m12 + m21)*r2,
+      case_y.select(0.5*t1, (m10 + m01)*r0));
+  const Lane z_xyz = case_z.select(0.5*t2,
+      case_y.select((m21 + m12)*r1, (m20 + m02)*r0));
+
+  qw = case_w.select(0.5*tw, w_xyz);
+  qx = case_w.select((m21 - m12)*rw, x_xyz);
+  qy = case_w.select((m02 - m20)*rw, y_xyz);
+  qz = case_w.select((m10 - m01)*rw, z_xyz);
+}
+
+/**
+ *  @brief  Solve the linear system of the bodyrates or of the angular accelerations per lane,
+ *          see ReferenceInputsSolver_::solveBodyratesSystem()
+ */
+template <bool kAnisotropic, typename Scalar, typename Lane = typename Lanes<Scalar>::Lane,
+          typename LaneMask = typename Lanes<Scalar>::LaneMask>
+LaneVector3<Scalar> solveBodyratesSystem(
+    const Lane& A2, const Lane& B1, const Lane& C1,
+    const Lane& C2, const Lane& B3, const Lane& C3,
+    const Lane& rhs1, const Lane& rhs2, const Lane& rhs3) {
+  const Lane denominator = kAnisotropic ? Lane(B1*C3 - B3*C1) : Lane(B1*C3);
+  const LaneMask zero_denominator = denominator.abs() < Scalar(kAlmostZeroValueThreshold);
+  const LaneMask zero_x = zero_denominator || (A2.abs() < Scalar(kAlmostZeroValueThreshold));
+
+  LaneVector3<Scalar> solution;
+  if (kAnisotropic) {
+    solution.x = zero_x.select(Lane::Zero(),
+        (-B1*C2*rhs3 + B1*C3*rhs2 - B3*C1*rhs2 + B3*C2*rhs1)/(A2*denominator));
+    solution.y = zero_denominator.select(Lane::Zero(), (-C1*rhs3 + C3*rhs1)/denominator);
+  }
+  else {
+    solution.x = zero_x.select(Lane::Zero(), rhs2/A2);
+    solution.y = zero_denominator.select(Lane::Zero(), rhs1/B1);
+  }
+  solution.z = zero_denominator.select(Lane::Zero(), ( B1*rhs3 - B3*rhs1)/denominator);
+  return solution;
+}
+
+/**
+ *  @brief  Compute the reference inputs of up to kLanes points,
+ *          see ReferenceInputsSolver for the derivation of the equations
+ */
+template <typename RotorDragModel>
+void computeBlock(
+    const typename ReferenceInputsSolver_<RotorDragModel>::StateEstimate* state_estimates,
+    const typename ReferenceInputsSolver_<RotorDragModel>::TrajectoryPoint* reference_states,
+    typename ReferenceInputsSolver_<RotorDragModel>::ControlCommand* reference_inputs,
+    const int count,
+    const ReferenceInputsSolver_<RotorDragModel>& solver,
+    const RotorDragModel& rotor_drag) {
+  typedef typename RotorDragModel::Scalar Scalar;
+  typedef typename Lanes<Scalar>::Lane Lane;
+  typedef typename Lanes<Scalar>::LaneMask LaneMask;
+  typedef LaneVector3<Scalar> LaneVector;
+  constexpr int kLanes = Lanes<Scalar>::kLanes;
+  constexpr bool kAnisotropic = RotorDragModel::kAnisotropic;
+
+  const Scalar dx = rotor_drag.dx();
+  const Scalar dy = rotor_drag.dy();
+  const Scalar dz = rotor_drag.dz();
+
+  //  gather into struct-of-arrays, unused lanes repeat the last point
+  LaneVector velocity, acceleration, jerk, snap, x_C, y_C;
+  Lane heading_rate, heading_acceleration;
+  for (int lane = 0; lane < kLanes; ++lane) {
+    const typename ReferenceInputsSolver_<RotorDragModel>::TrajectoryPoint& reference_state =
+        reference_states[std::min(lane, count - 1)];
+    velocity.set(lane, reference_state.velocity);
+    acceleration.set(lane, reference_state.acceleration);
+    jerk.set(lane, reference_state.jerk);
+    snap.set(lane, reference_state.snap);
+    heading_rate[lane] = reference_state.heading_rate;
+    heading_acceleration[lane] = reference_state.heading_acceleration;
+
+    //  x_C = [cos(phi) sin(phi) 0]^T, y_C = [-sin(phi) cos(phi) 0]^T
+    const Scalar cos_phi = std::cos(reference_state.heading);
+    const Scalar sin_phi = std::sin(reference_state.heading);
+    x_C.x[lane] = cos_phi;
+    x_C.y[lane] = sin_phi;
+    x_C.z[lane] = Scalar(0.0);
+    y_C.x[lane] = -sin_phi;
+    y_C.y[lane] = cos_phi;
+    y_C.z[lane] = Scalar(0.0);
+  }
+
+  // ------------- orientation ------------- //
+  LaneVector alpha = acceleration;
+  alpha.z += Scalar(kGravity);
+  LaneVector beta = alpha;
+  LaneVector gamma = alpha;
+  if (RotorDragModel::kEnabled) {
+    alpha = alpha + dx * velocity;
+    beta = beta + dy * velocity;
+    gamma = gamma + dz * velocity;
+  } //  rotor drag terms
+
+  const LaneVector x_B_raw = cross(y_C, alpha);
+  const Lane x_B_norm = dot(x_B_raw, x_B_raw).sqrt();
+  const LaneVector x_B = normalized(x_B_raw, x_B_norm);
+
+  const LaneVector y_B_raw = cross(beta, x_B);
+  const Lane y_B_norm = dot(y_B_raw, y_B_raw).sqrt();
+  const LaneVector y_B = normalized(y_B_raw, y_B_norm);
+
+  const LaneVector z_B = cross(x_B, y_B);
+
+  //  singular lanes depend on the state estimate, see computeRobustBodyXAxis()
+  //  and computeRobustBodyYAxis(), and are recomputed with the scalar path
+  const LaneMask singular = (x_B_norm < Scalar(kAlmostZeroValueThreshold)) ||
+      (y_B_norm < Scalar(kAlmostZeroValueThreshold));
+
+  Lane qw, qx, qy, qz;
+  toQuaternion(x_B, y_B, z_B, qw, qx, qy, qz);
+
+  // ------------- collective thrust ------------- //
+  const Lane c = dot(z_B, gamma);
+
+  // ------------- body rates ------------- //
+  //  reference velocity, acceleration and jerk in body frame
+  const LaneVector v_B = {dot(x_B, velocity), dot(y_B, velocity), dot(z_B, velocity)};
+  const LaneVector a_B = {dot(x_B, acceleration), dot(y_B, acceleration),
+                           dot(z_B, acceleration)};
+  const LaneVector j_B = {dot(x_B, jerk), dot(y_B, jerk), dot(z_B, jerk)};
+
+  Lane B1 = c, C1 = Lane::Zero(), A2 = c, C2 = Lane::Zero();
+  Lane D1 = j_B.x;
+  Lane D2 = -j_B.y;
+  if (RotorDragModel::kEnabled) {
+    D1 += dx*a_B.x;
+    D2 -= dy*a_B.y;
+  } //  rotor drag terms
+  if (RotorDragModel::kAnisotropic) {
+    B1 = c - (dz - dx)*v_B.z;
+    C1 = -(dx - dy)*v_B.y;
+    A2 = c + (dy - dz)*v_B.z;
+    C2 = (dx - dy)*v_B.x;
+  } //  anisotropic rotor drag terms
+  const Lane B3 = -dot(y_C, z_B);
+  const LaneVector y_C_cross_z_B = cross(y_C, z_B);
+  const Lane C3 = dot(y_C_cross_z_B, y_C_cross_z_B).sqrt();
+  const Lane D3 = heading_rate*dot(x_C, x_B);
+
+  const LaneVector omega = solveBodyratesSystem<kAnisotropic, Scalar>(
+      A2, B1, C1, C2, B3, C3, D1, D2, D3);
+
+  // ------------- angular accelerations ------------- //
+  //  xi expressed in body frame, i.e. xi_B = R^T xi with omega_hat*v = omega x v,
+  //  so that x_B^T xi = xi_B.x and y_B^T xi = xi_B.y
+  Lane c_dot = j_B.z;
+  LaneVector xi_B = {Lane::Zero(), Lane::Zero(), Lane::Zero()};
+  if (RotorDragModel::kAnisotropic) {
+    c_dot += omega.x*(dy - dz)*v_B.y + omega.y*(dz - dx)*v_B.x + dz*a_B.z;
+
+    const LaneVector omega_x_v_B = cross(omega, v_B);
+    xi_B = cross(omega, cross(omega, diagonal(dx, dy, dz, v_B))) +
+        diagonal(dx, dy, dz, cross(omega, omega_x_v_B)) -
+        Scalar(2.0) * cross(omega, diagonal(dx, dy, dz, omega_x_v_B)) +
+        Scalar(2.0) * (cross(omega, diagonal(dx, dy, dz, a_B)) -
+               diagonal(dx, dy, dz, cross(omega, a_B))) +
+        diagonal(dx, dy, dz, j_B);
+  } //  anisotropic rotor drag terms
+  else if (RotorDragModel::kEnabled) {
+    c_dot += dz*a_B.z;
+    xi_B = diagonal(dx, dy, dz, j_B);
+  } //  isotropic rotor drag terms
+
+  const Lane E1 = dot(x_B, snap) - Scalar(2.0)*c_dot*omega.y - c*omega.x*omega.z + xi_B.x;
+  const Lane E2 = -dot(y_B, snap) - Scalar(2.0)*c_dot*omega.x + c*omega.y*omega.z - xi_B.y;
+  const Lane E3 = heading_acceleration*dot(x_C, x_B) +
+      Scalar(2.0)*heading_rate*omega.z*dot(x_C, y_B) -
+      Scalar(2.0)*heading_rate*omega.y*dot(x_C, z_B) -
+      omega.x*omega.y*dot(y_C, y_B) -
+      omega.x*omega.z*dot(y_C, z_B);
+
+  const LaneVector omega_dot = solveBodyratesSystem<kAnisotropic, Scalar>(
+      A2, B1, C1, C2, B3, C3, E1, E2, E3);
+
+  //  scatter back into array-of-structs
+  for (int lane = 0; lane < count; ++lane) {
+    typename ReferenceInputsSolver_<RotorDragModel>::ControlCommand& reference =
+        reference_inputs[lane];
+    if (singular[lane]) {
+      solver.solveUncached(state_estimates[lane], reference_states[lane], reference);
+    } //  state estimate dependent fallback
+    else {
+      reference.orientation = Eigen::Quaternion<Scalar>(
+          qw[lane], qx[lane], qy[lane], qz[lane]);
+      reference.collective_thrust = c[lane];
+      reference.bodyrates = omega.get(lane);
+      reference.angular_acceleration = omega_dot.get(lane);
+    }
+  }
+}
+
+} /*  namespace  */
+
+/**
+ *  @detail
+ */
+template <typename RotorDragModel>
+BatchReferenceInputs_<RotorDragModel>::BatchReferenceInputs_(
+    const RotorDragModel& rotor_drag)
+    : solver_(rotor_drag),
+      rotor_drag_(rotor_drag) {}
+
+/**
+ *  @detail
+ */
+template <typename RotorDragModel>
+BatchReferenceInputs_<RotorDragModel>::~BatchReferenceInputs_() {}
+
+/**
+ *  @detail Process the points in blocks of kLanes, the last block may be partially filled
+ */
+template <typename RotorDragModel>
+void BatchReferenceInputs_<RotorDragModel>::compute(
+    const StateEstimate* state_estimates,
+    const TrajectoryPoint* reference_states,
+    ControlCommand* reference_inputs,
+    const std::size_t n) const {
+  constexpr int kLanes = Lanes<typename RotorDragModel::Scalar>::kLanes;
+  for (std::size_t begin = 0; begin < n; begin += kLanes) {
+    const int count = static_cast<int>(std::min<std::size_t>(kLanes, n - begin));
+    computeBlock(state_estimates + begin, reference_states + begin,
+                 reference_inputs + begin, count, solver_, rotor_drag_);
+  }
+}
+
+/**
+ *  @detail
+ */
+template <typename RotorDragModel>
+int BatchReferenceInputs_<RotorDragModel>::lanes() {
+  return Lanes<typename RotorDragModel::Scalar>::kLanes;
+}
+
+template class BatchReferenceInputs_<NoRotorDrag>;
+template class BatchReferenceInputs_<IsotropicRotorDrag>;
+template class BatchReferenceInputs_<AnisotropicRotorDrag>;
+template class BatchReferenceInputs_<NoRotorDragf>;
+template class BatchReferenceInputs_<IsotropicRotorDragf>;
+template class BatchReferenceInputs_<AnisotropicRotorDragf>;
+
+} /*  namespace position_controller  */
@@ -0,0 +1,35 @@
+/**
+ *  @file   control_loop.cpp
+ *  @brief  quadrotor position control's real time inner loop related functionality implementation
+ *  @author thor
+ *  @date   07.12.2021
+ */
+#include "position_controller/control_loop.h"
+
+namespace position_controller {
+
+/**
+ *  @detail ControlLoop's default constructor definition
+ */
+ControlLoop::ControlLoop(
+    const RealTimeExecutorParameters& parameters,
+    quadrotor_common::StateEstimateMailbox& state_estimates,
+    const ReferenceSource& reference_source,
+    ControlCommandMailbox& control_commands)
+    : state_estimates_(state_estimates),
+      reference_source_(reference_source),
+      control_commands_(control_commands),
+      executor_(parameters, [this](const std::uint64_t tick) { this->tick(tick); }) {}
+
+/**
+ *  @detail The command is computed into the producer's slot, i.e. without an extra copy, the
+ *          slot's timestamp and control mode are the defaults, never written by the loop.
+ */
+void ControlLoop::tick(const std::uint64_t tick) {
+  const quadrotor_common::QuadrotorStateEstimate& state_estimate = state_estimates_.read();
+  reference_source_(tick, reference_state_);
+  position_controller_.run(state_estimate, reference_state_, control_commands_.writeSlot());
+  control_commands_.publish();
+}
+
+} /*  namespace position_controller  */
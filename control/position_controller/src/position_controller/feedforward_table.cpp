@@ -0,0 +1,108 @@
+/**
+ *  @file   feedforward_table.cpp
+ *  @brief  quadrotor position control's precomputed reference inputs related functionality implementation
+ *  @author thor
+ *  @date   11.12.2021
+ */
+#include "position_controller/feedforward_table.h"
+
+//  std dependencies
+#include <algorithm>
+#include <cmath>
+
+namespace position_controller {
+
+/**
+ *  @detail FeedforwardTable's default constructor definition
+ */
+template <typename RotorDragModel>
+FeedforwardTable_<RotorDragModel>::FeedforwardTable_(const RotorDragModel& rotor_drag)
+    : solver_(rotor_drag),
+      start_time_(0.0),
+      dt_(0.0),
+      inverse_dt_(0.0) {}
+
+/**
+ *  @detail FeedforwardTable's default destructor definition
+ */
+template <typename RotorDragModel>
+FeedforwardTable_<RotorDragModel>::~FeedforwardTable_() {}
+
+/**
+ *  @detail The live samples are solved with a default state estimate, i.e. their values are
+ *          kept for completeness only and never served. Every orientation is flipped into the
+ *          hemisphere of the previous one, so that the interpolation takes the short way.
+ */
+template <typename RotorDragModel>
+bool FeedforwardTable_<RotorDragModel>::compile(
+    const Sampler& sampler, const double start_time, const double end_time, const double dt) {
+  samples_.clear();
+  if (!(dt > 0.0) || !(end_time >= start_time)) {
+    return false;
+  } //  invalid times
+
+  const std::size_t n = static_cast<std::size_t>(std::floor((end_time - start_time) / dt + 1e-9)) + 1;
+  samples_.resize(n);
+  start_time_ = start_time;
+  dt_ = dt;
+  inverse_dt_ = 1.0 / dt;
+
+  const StateEstimate state_estimate;
+  TrajectoryPoint reference_state;
+  ControlCommand reference_inputs;
+  solver_.reset();  //  the table does not depend on the previous compile() or compute()
+  for (std::size_t i = 0; i < n; ++i) {
+    sampler(start_time + i * dt, reference_state);
+    solver_.solve(state_estimate, reference_state, reference_inputs);
+
+    Sample& sample = samples_[i];
+    Eigen::Quaternion<typename ControlCommand::Scalar> q = reference_inputs.orientation;
+    if (i > 0) {
+      const Sample& previous = samples_[i - 1];
+      const double dot = q.w() * previous.orientation[0] + q.x() * previous.orientation[1] +
+                         q.y() * previous.orientation[2] + q.z() * previous.orientation[3];
+      if (dot < 0.0) {
+        q.coeffs() = -q.coeffs();
+      }
+    } //  same hemisphere as the previous sample
+    sample.orientation[0] = static_cast<float>(q.w());
+    sample.orientation[1] = static_cast<float>(q.x());
+    sample.orientation[2] = static_cast<float>(q.y());
+    sample.orientation[3] = static_cast<float>(q.z());
+    sample.collective_thrust = static_cast<float>(reference_inputs.collective_thrust);
+    for (int k = 0; k < 3; ++k) {
+      sample.bodyrates[k] = static_cast<float>(reference_inputs.bodyrates(k));
+      sample.angular_acceleration[k] = static_cast<float>(reference_inputs.angular_acceleration(k));
+    }
+    sample.live = solver_.isStateDependent(reference_state) ? 1 : 0;
+  }
+  return true;
+}
+
+/**
+ *
+ */
+template <typename RotorDragModel>
+void FeedforwardTable_<RotorDragModel>::compute(
+    const double time,
+    const StateEstimate& state_estimate,
+    const TrajectoryPoint& reference_state,
+    ControlCommand& reference_inputs) {
+  if (!lookup(time, reference_inputs)) {
+    solver_.solve(state_estimate, reference_state, reference_inputs);
+  } //  live computation
+}
+
+/**
+ *
+ */
+template <typename RotorDragModel>
+std::size_t FeedforwardTable_<RotorDragModel>::numLiveSamples() const {
+  return std::count_if(samples_.begin(), samples_.end(), [](const Sample& sample) { return sample.live != 0; });
+}
+
+template class FeedforwardTable_<NoRotorDrag>;
+template class FeedforwardTable_<IsotropicRotorDrag>;
+template class FeedforwardTable_<AnisotropicRotorDrag>;
+
+} /*  namespace position_controller  */
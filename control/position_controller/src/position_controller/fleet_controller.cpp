@@ -0,0 +1,80 @@
+/**
+ *  @file   fleet_controller.cpp
+ *  @brief  quadrotor position control's multi vehicle fleet related functionality implementation
+ *  @author thor
+ *  @date   05.12.2021
+ */
+#include "position_controller/fleet_controller.h"
+
+//  std dependencies
+#include <algorithm>
+
+namespace position_controller {
+
+/**
+ *  @detail FleetController's default constructor definition
+ */
+template <typename RotorDragModel>
+FleetController_<RotorDragModel>::FleetController_(
+    const int num_threads,
+    const RotorDragModel& rotor_drag,
+    const bool pin_threads)
+    : thread_pool_(num_threads, pin_threads) {
+  workers_.reserve(thread_pool_.size());
+  for (int worker = 0; worker < thread_pool_.size(); ++worker) {
+    workers_.emplace_back(new Worker(rotor_drag));
+  }
+}
+
+/**
+ *  @detail FleetController's default destructor definition
+ */
+template <typename RotorDragModel>
+FleetController_<RotorDragModel>::~FleetController_() {}
+
+/**
+ *  @detail The chunk of each worker is rounded up to a multiple of the lanes, i.e. only the
+ *          last non empty chunk has a partial block and trailing workers may stay idle.
+ */
+template <typename RotorDragModel>
+void FleetController_<RotorDragModel>::run(
+    const StateEstimate* state_estimates,
+    const TrajectoryPoint* reference_states,
+    ControlCommand* control_commands,
+    const std::size_t n) {
+  const std::size_t num_threads = static_cast<std::size_t>(thread_pool_.size());
+  const std::size_t lanes = static_cast<std::size_t>(BatchReferenceInputs_<RotorDragModel>::lanes());
+  const std::size_t blocks = (n + lanes - 1) / lanes;
+  const std::size_t chunk = (blocks + num_threads - 1) / num_threads * lanes;
+
+  thread_pool_.run([&](const int worker) {
+    const std::size_t begin = std::min(n, worker * chunk);
+    const std::size_t end = std::min(n, begin + chunk);
+    if (begin < end) {
+      workers_[worker]->batch.compute(state_estimates + begin, reference_states + begin,
+                                      control_commands + begin, end - begin);
+    }
+  });
+}
+
+/**
+ *
+ */
+template <typename RotorDragModel>
+void FleetController_<RotorDragModel>::run(
+    const StateEstimates& state_estimates,
+    const TrajectoryPoints& reference_states,
+    ControlCommands& control_commands) {
+  const std::size_t n = std::min(state_estimates.size(), reference_states.size());
+  control_commands.resize(n);
+  run(state_estimates.data(), reference_states.data(), control_commands.data(), n);
+}
+
+template class FleetController_<NoRotorDrag>;
+template class FleetController_<IsotropicRotorDrag>;
+template class FleetController_<AnisotropicRotorDrag>;
+template class FleetController_<NoRotorDragf>;
+template class FleetController_<IsotropicRotorDragf>;
+template class FleetController_<AnisotropicRotorDragf>;
+
+} /*  namespace position_controller  */
@@ -19,54 +19,62 @@ namespace position_controller {
 /**
  *  @detail PositionController's default constructor definition
  */
-PositionController::PositionController() {}
+template <typename RotorDragModel>
+PositionController_<RotorDragModel>::PositionController_(const RotorDragModel& rotor_drag)
+    : reference_inputs_solver_(rotor_drag) {}
 
 /**
  *  @detail PositionController's default destructor definition
  */
-PositionController::~PositionController() {}
+template <typename RotorDragModel>
+PositionController_<RotorDragModel>::~PositionController_() {}
 
 /**
  *
  */
-quadrotor_common::QuadrotorControlCommand PositionController::run(
+template <typename RotorDragModel>
+quadrotor_common::QuadrotorControlCommand PositionController_<RotorDragModel>::run(
     const quadrotor_common::QuadrotorStateEstimate& state_estimate,
     const quadrotor_common::QuadrotorTrajectoryPoint& reference_state) {
 
   // compute reference inputs as feed forward terms
+  const quadrotor_common::QuadrotorControlCommand reference_inputs =
+      computeReferenceInputs(state_estimate, reference_state);
 
+  return reference_inputs;
 }
 
 /**
- *  @detail We use the following Nominal Quadrotor dynamics (where gravity = +9.81):
+ *  @detail The reference inputs are the whole control command, see run() above.
+ */
+template <typename RotorDragModel>
+void PositionController_<RotorDragModel>::run(
+    const quadrotor_common::QuadrotorStateEstimate& state_estimate,
+    const quadrotor_common::QuadrotorTrajectoryPoint& reference_state,
+    quadrotor_common::QuadrotorControlCommand& control_command) {
+  reference_inputs_solver_.solve(state_estimate, reference_state, control_command);
+}
+
+/**
+ *  @detail We use the following Quadrotor dynamics (where gravity = +9.81), D = diag(dx, dy, dz) of the RotorDragModel:
  *          position_dot  = velocity
- *          velocity_dot  = -gravity * z_W + collective_thrust * z_B
+ *          velocity_dot  = -gravity * z_W + collective_thrust * z_B - R * D * R^T * velocity
  *          R_dot         = R * bodyrates_hat
  *          bodyrates_dot = inertia_inverse * (torque_inputs - bodyrates x inertia*bodyrates)
  */
- quadrotor_common::QuadrotorControlCommand PositionController::computeReferenceInputs(
+ template <typename RotorDragModel>
+ quadrotor_common::QuadrotorControlCommand PositionController_<RotorDragModel>::computeReferenceInputs(
      const quadrotor_common::QuadrotorStateEstimate& state_estimate,
-     const quadrotor_common::QuadrotorTrajectoryPoint& reference_state) const {
+     const quadrotor_common::QuadrotorTrajectoryPoint& reference_state) {
+
+  quadrotor_common::QuadrotorControlCommand reference_inputs;
+  reference_inputs_solver_.solve(state_estimate, reference_state, reference_inputs);
 
-  // // constraints based on reference acceleration using quadrotor's dynamics
-  // const Eigen::Vector3d acceleration = reference_state.acceleration - kGravity_;
-  //
-  // // constraints based on reference heading using
-  // // projection of x_B into x_W - y_W plane will be collinear with x_C
-  // const Eigen::Quaterniond q_heading = Eigen::Quaterniond(
-  //     Eigen::AngleAxisd(reference_state.heading, Eigen::Vector3d::UnitZ()));
-  // const Eigen::Vector3d x_C = q_heading * Eigen::Vector3d::UnitX();
-  // const Eigen::Vector3d y_C = q_heading * Eigen::Vector3d::UnitY();
-  //
-  // // 1. compute quadrotor's reference orientation input i.e. R_ref = [x_B y_B z_B]
-  // const Eigen::Vector3d x_B = computeRobustBodyXAxis(y_C, acceleration, attitude_estimate, x_C);
-  // const Eigen::Vector3d y_B = computeRobustBodyYAxis(x_B, acceleration, attitude_estimate, y_C);
-  // const Eigen::Vector3d z_B = x_B.cross(y_B);
-  // const Eigen::Matrix3d R_W_B((Eigen::Matrix3d() << x_B, y_B, z_B).finished());
-  // const Eigen::Quaterniond q_W_B = Eigen::Quaterniond(R_W_B);
-  //
-  // // 2. compute quadrotor's reference collective thrust input i.e. c_ref
-  // const double c = z_B.dot(acceleration);
+  return reference_inputs;
 }
 
+template class PositionController_<NoRotorDrag>;
+template class PositionController_<IsotropicRotorDrag>;
+template class PositionController_<AnisotropicRotorDrag>;
+
 } /* namespace position_controller */
@@ -0,0 +1,292 @@
+/**
+ *  @file   realtime_executor.cpp
+ *  @brief  quadrotor position control's real time fixed rate loop related functionality implementation
+ *  @author thor
+ *  @date   07.12.2021
+ */
+#include "position_controller/realtime_executor.h"
+
+//  std dependencies
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+//  3rd party dependencies
+#ifdef __linux__
+#include <alloca.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+//  position_controller dependencies
+#include "position_controller/stage_profiler.h"
+
+namespace position_controller {
+
+namespace {
+
+constexpr std::int64_t kNanosecondsPerSecond = 1000000000;
+
+/**
+ *  @brief  Current time of the monotonic clock [ns]
+ */
+std::int64_t now() {
+#ifdef __linux__
+  timespec time;
+  clock_gettime(CLOCK_MONOTONIC, &time);
+  return time.tv_sec * kNanosecondsPerSecond + time.tv_nsec;
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/**
+ *  @brief  The period [ns] of the loop rate [Hz], at least 1 ns
+ *  @detail The rate is checked before the conversion, i.e. a period out of the range of the
+ *          nanosecond counter is never cast.
+ */
+std::int64_t periodOf(const double rate) {
+  const double period = kNanosecondsPerSecond / rate;
+  if (!std::isfinite(rate) || !(rate > 0.0) || !(period < 9.0e18)) {
+    throw std::invalid_argument("RealTimeExecutor: the rate must be positive and finite");
+  }
+  return std::max<std::int64_t>(1, static_cast<std::int64_t>(period));
+}
+
+/**
+ *  @brief  Sleep until the absolute time of the monotonic clock [ns]
+ */
+void sleepUntil(const std::int64_t time) {
+#ifdef __linux__
+  timespec deadline;
+  deadline.tv_sec = time / kNanosecondsPerSecond;
+  deadline.tv_nsec = time % kNanosecondsPerSecond;
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) != 0) {}  //  EINTR
+#else
+  std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(time)));
+#endif
+}
+
+/**
+ *  @brief  Touch the given number of stack bytes, i.e. map the pages the loop will grow into
+ *  @detail A single alloca() of the whole size, written once per page. The barrier keeps the dead
+ *          stores, noinline keeps the allocation out of the caller's frame, i.e. below the frames of
+ *          the loop. Off linux the loop is not real time anyway and nothing is touched.
+ */
+__attribute__((noinline)) void prefaultStack(const std::size_t bytes) {
+#ifdef __linux__
+  if (bytes == 0) {
+    return;
+  }
+  const std::size_t page_bytes = sysconf(_SC_PAGESIZE);
+  unsigned char* const stack = static_cast<unsigned char*>(alloca(bytes));
+  for (std::size_t i = 0; i < bytes; i += page_bytes) {
+    stack[i] = 0;
+  }
+  stack[bytes - 1] = 0;
+  asm volatile("" : : "r"(stack) : "memory");
+#else
+  (void)bytes;
+#endif
+}
+
+/**
+ *  @brief  Touch the given number of heap bytes and keep them with the allocator, i.e. later
+ *          allocations up to this size are served from mapped pages
+ */
+void prefaultHeap(const std::size_t bytes) {
+  if (bytes == 0) {
+    return;
+  }
+#ifdef __GLIBC__
+  mallopt(M_TRIM_THRESHOLD, -1);  //  never return freed memory to the system
+  mallopt(M_MMAP_MAX, 0);         //  serve large allocations from the heap as well
+#endif
+  void* const memory = std::malloc(bytes);
+  if (memory != nullptr) {
+    std::memset(memory, 0, bytes);
+    std::free(memory);
+  }
+}
+
+/**
+ *  @brief  Store the value if it is larger than the current one, single writer only
+ */
+void storeMax(std::atomic<std::int64_t>& maximum, const std::int64_t value) {
+  if (value > maximum.load(std::memory_order_relaxed)) {
+    maximum.store(value, std::memory_order_relaxed);
+  }
+}
+
+/**
+ *  @brief  Add to the value, single writer only, i.e. without a read-modify-write
+ */
+template <typename T>
+void add(std::atomic<T>& value, const T increment) {
+  value.store(value.load(std::memory_order_relaxed) + increment, std::memory_order_relaxed);
+}
+
+}  /*  namespace  */
+
+/**
+ *  @detail RealTimeExecutor's default constructor definition
+ */
+RealTimeExecutor::RealTimeExecutor(const RealTimeExecutorParameters& parameters, const Tick& tick)
+    : parameters_(parameters),
+      period_(periodOf(parameters.rate)),
+      tick_(tick),
+      stop_(false) {
+  resetStatistics();
+}
+
+/**
+ *  @detail RealTimeExecutor's default destructor definition
+ */
+RealTimeExecutor::~RealTimeExecutor() {
+  stop();
+}
+
+/**
+ *  @detail A thread whose loop was stopped, e.g. by the tick function, is joined first, i.e.
+ *          the executor can be restarted without a stop() from outside.
+ */
+void RealTimeExecutor::start() {
+  if (thread_.joinable() && stop_.load() && thread_.get_id() != std::this_thread::get_id()) {
+    thread_.join();
+  } //  stopped, possibly from inside
+  if (thread_.joinable()) {
+    return;
+  } //  already running
+  stop_.store(false);
+  thread_ = std::thread([this]() {
+    setup();
+    loop();
+  });
+}
+
+/**
+ *
+ */
+void RealTimeExecutor::stop() {
+  stop_.store(true);
+  if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+    thread_.join();
+  }
+}
+
+/**
+ *  @detail The thread of start() runs setup() and loop() without clearing the stop request,
+ *          i.e. a stop() right after start() is not lost.
+ */
+void RealTimeExecutor::run() {
+  stop_.store(false);
+  setup();
+  loop();
+}
+
+/**
+ *
+ */
+RealTimeExecutorStatistics RealTimeExecutor::statistics() const {
+  RealTimeExecutorStatistics statistics;
+  statistics.ticks = ticks_.load(std::memory_order_relaxed);
+  statistics.deadline_misses = deadline_misses_.load(std::memory_order_relaxed);
+  statistics.overruns = overruns_.load(std::memory_order_relaxed);
+  statistics.last_jitter = last_jitter_.load(std::memory_order_relaxed);
+  statistics.max_jitter = max_jitter_.load(std::memory_order_relaxed);
+  statistics.total_jitter = total_jitter_.load(std::memory_order_relaxed);
+  statistics.last_execution_time = last_execution_time_.load(std::memory_order_relaxed);
+  statistics.max_execution_time = max_execution_time_.load(std::memory_order_relaxed);
+  statistics.total_execution_time = total_execution_time_.load(std::memory_order_relaxed);
+  statistics.pinned = pinned_.load(std::memory_order_relaxed);
+  statistics.realtime = realtime_.load(std::memory_order_relaxed);
+  statistics.memory_locked = memory_locked_.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+/**
+ *
+ */
+void RealTimeExecutor::resetStatistics() {
+  ticks_.store(0);
+  deadline_misses_.store(0);
+  overruns_.store(0);
+  last_jitter_.store(0);
+  max_jitter_.store(0);
+  total_jitter_.store(0);
+  last_execution_time_.store(0);
+  max_execution_time_.store(0);
+  total_execution_time_.store(0);
+  pinned_.store(false);
+  realtime_.store(false);
+  memory_locked_.store(false);
+}
+
+/**
+ *  @detail The memory is locked before pre-faulting, so that the touched pages stay resident,
+ *          and the stage profiler's histograms are registered, so that the first tick does
+ *          not lock or allocate.
+ */
+void RealTimeExecutor::setup() {
+#ifdef __linux__
+  if (parameters_.cpu >= 0) {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(parameters_.cpu, &cpu_set);
+    pinned_.store(pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0);
+  }
+  if (parameters_.priority > 0) {
+    sched_param param;
+    param.sched_priority = std::min(parameters_.priority, sched_get_priority_max(SCHED_FIFO));
+    realtime_.store(pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0);
+  }
+  if (parameters_.lock_memory) {
+    memory_locked_.store(mlockall(MCL_CURRENT | MCL_FUTURE) == 0);
+  }
+#endif
+  prefaultStack(parameters_.prefault_stack_bytes);
+  prefaultHeap(parameters_.prefault_heap_bytes);
+  StageProfiler::registerThread();
+}
+
+/**
+ *  @detail Only the loop thread writes the counters, i.e. relaxed stores without read-modify-writes.
+ */
+void RealTimeExecutor::loop() {
+  std::int64_t release = now() + period_;
+  std::uint64_t tick = 0;
+  while (!stop_.load(std::memory_order_relaxed)) {
+    sleepUntil(release);
+    const std::int64_t start = now();
+    tick_(tick++);
+    const std::int64_t end = now();
+
+    const std::int64_t jitter = start - release;
+    const std::int64_t execution_time = end - start;
+    last_jitter_.store(jitter, std::memory_order_relaxed);
+    storeMax(max_jitter_, jitter);
+    add(total_jitter_, jitter);
+    last_execution_time_.store(execution_time, std::memory_order_relaxed);
+    storeMax(max_execution_time_, execution_time);
+    add(total_execution_time_, execution_time);
+    add<std::uint64_t>(ticks_, 1);
+
+    release += period_;
+    if (end > release) {
+      const std::int64_t skipped = (end - release) / period_ + 1;
+      add<std::uint64_t>(deadline_misses_, 1);
+      add<std::uint64_t>(overruns_, skipped);
+      release += skipped * period_;
+    } //  missed the next release time, skip the passed ones
+  }
+}
+
+} /*  namespace position_controller  */
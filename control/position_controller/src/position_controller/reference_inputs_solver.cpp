@@ -0,0 +1,23 @@
+/**
+ *  @file   reference_inputs_solver.cpp
+ *  @brief  quadrotor position control's reusable reference inputs solver related functionality implementation
+ *  @author thor
+ *  @date   26.11.2021
+ */
+#include "position_controller/reference_inputs_solver.h"
+
+//  position_controller dependencies
+#include "position_controller/impl/reference_inputs_solver.hpp"
+
+namespace position_controller {
+
+template class ReferenceInputsSolver_<NoRotorDrag>;
+template class ReferenceInputsSolver_<IsotropicRotorDrag>;
+template class ReferenceInputsSolver_<AnisotropicRotorDrag, XiKernel::kMatrixForm>;
+template class ReferenceInputsSolver_<AnisotropicRotorDrag, XiKernel::kBodyFrame>;
+template class ReferenceInputsSolver_<NoRotorDragf>;
+template class ReferenceInputsSolver_<IsotropicRotorDragf>;
+template class ReferenceInputsSolver_<AnisotropicRotorDragf, XiKernel::kMatrixForm>;
+template class ReferenceInputsSolver_<AnisotropicRotorDragf, XiKernel::kBodyFrame>;
+
+} /*  namespace position_controller  */
@@ -0,0 +1,112 @@
+/**
+ *  @file   rotor_drag_estimator.cpp
+ *  @brief  quadrotor position control's online rotor drag identification related functionality implementation
+ *  @author thor
+ *  @date   18.12.2021
+ */
+#include "position_controller/rotor_drag_estimator.h"
+
+//  std dependencies
+#include <algorithm>
+
+namespace position_controller {
+
+/**
+ *  @detail RotorDragEstimator's default constructor definition
+ */
+RotorDragEstimator::RotorDragEstimator(const RotorDragEstimatorParameters& parameters, RotorDragMailbox& rotor_drags)
+    : parameters_(parameters),
+      rotor_drags_(rotor_drags) {
+  reset();
+}
+
+/**
+ *  @detail RotorDragEstimator's default destructor definition
+ */
+RotorDragEstimator::~RotorDragEstimator() {}
+
+/**
+ *  @detail
+ */
+void RotorDragEstimator::reset() {
+  estimate_.rotor_drag = parameters_.initial_rotor_drag;
+  estimate_.variance.setConstant(parameters_.initial_variance);
+  estimate_.samples = 0;
+  has_previous_ = false;
+}
+
+/**
+ *  @detail The midpoint orientation is the normalized sum of the two orientations, i.e. exactly
+ *          their spherical interpolation at one half without trigonometric functions.
+ */
+void RotorDragEstimator::regression(
+    const Eigen::Vector3d& previous_velocity,
+    const Eigen::Quaterniond& previous_orientation,
+    const quadrotor_common::QuadrotorStateEstimate& state_estimate,
+    const double collective_thrust,
+    const double dt,
+    const double gravity,
+    Eigen::Vector3d& phi,
+    Eigen::Vector3d& y) {
+  Eigen::Vector4d q = state_estimate.orientation.coeffs();
+  if (q.dot(previous_orientation.coeffs()) < 0.0) {
+    q = -q;
+  } //  same hemisphere
+  const Eigen::Quaterniond orientation(Eigen::Vector4d(q + previous_orientation.coeffs()).normalized());
+  const Eigen::Matrix3d R = orientation.toRotationMatrix();
+
+  const Eigen::Vector3d velocity = 0.5 * (state_estimate.velocity + previous_velocity);
+  Eigen::Vector3d specific_force = (state_estimate.velocity - previous_velocity) / dt;
+  specific_force.z() += gravity;
+
+  phi = R.transpose() * velocity;
+  y = -(R.transpose() * specific_force);
+  y.z() += collective_thrust;
+}
+
+/**
+ *  @detail Per axis i with the regressor phi and the measurement y the scalar update is
+ *            k = P*phi / (lambda + phi*P*phi)
+ *            d = d + k*(y - phi*d)
+ *            P = min((P - k*phi*P) / lambda, max_variance)
+ */
+bool RotorDragEstimator::update(
+    const quadrotor_common::QuadrotorStateEstimate& state_estimate,
+    const double collective_thrust,
+    const double dt) {
+  if (!has_previous_ || !(dt > 0.0)) {
+    previous_velocity_ = state_estimate.velocity;
+    previous_orientation_ = state_estimate.orientation;
+    has_previous_ = true;
+    return false;
+  } //  first state estimate
+
+  Eigen::Vector3d phi, y;
+  regression(previous_velocity_, previous_orientation_, state_estimate, collective_thrust, dt, parameters_.gravity, phi, y);
+
+  const double lambda = parameters_.forgetting_factor;
+  for (int i = 0; i < 3; ++i) {
+    double& d = estimate_.rotor_drag(i);
+    double& P = estimate_.variance(i);
+    const double k = P * phi(i) / (lambda + phi(i) * P * phi(i));
+    d += k * (y(i) - phi(i) * d);
+    P = std::min((P - k * phi(i) * P) / lambda, parameters_.max_variance);
+  }
+
+  previous_velocity_ = state_estimate.velocity;
+  previous_orientation_ = state_estimate.orientation;
+  ++estimate_.samples;
+  if (estimate_.samples % std::max(1, parameters_.publish_decimation) == 0) {
+    publish();
+  }
+  return true;
+}
+
+/**
+ *  @detail
+ */
+void RotorDragEstimator::publish() {
+  rotor_drags_.write(estimate_);
+}
+
+} /*  namespace position_controller  */
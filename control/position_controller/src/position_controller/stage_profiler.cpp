@@ -0,0 +1,193 @@
+/**
+ *  @file   stage_profiler.cpp
+ *  @brief  quadrotor position control's per stage latency instrumentation related functionality implementation
+ *  @author thor
+ *  @date   08.12.2021
+ */
+#include "position_controller/stage_profiler.h"
+
+//  std dependencies
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+namespace position_controller {
+
+constexpr int StageStatistics::kBuckets;
+
+namespace {
+
+constexpr int kNumStages = static_cast<int>(Stage::kNumStages);
+
+/**
+ *  @brief  Histogram of one stage of one thread, written by that thread only, i.e. relaxed
+ *          loads and stores instead of read-modify-writes, read by the queries of any thread
+ */
+struct StageHistogram {
+  std::atomic<std::uint64_t> count;
+  std::atomic<std::uint64_t> total_cycles;
+  std::atomic<std::uint64_t> max_cycles;
+  std::atomic<std::uint64_t> buckets[StageStatistics::kBuckets];
+
+  StageHistogram() { clear(); }
+
+  void clear() {
+    count.store(0, std::memory_order_relaxed);
+    total_cycles.store(0, std::memory_order_relaxed);
+    max_cycles.store(0, std::memory_order_relaxed);
+    for (std::atomic<std::uint64_t>& bucket : buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  void add(std::atomic<std::uint64_t>& value, const std::uint64_t increment) {
+    value.store(value.load(std::memory_order_relaxed) + increment, std::memory_order_relaxed);
+  }
+
+  void record(const std::uint64_t cycles) {
+    add(count, 1);
+    add(total_cycles, cycles);
+    if (cycles > max_cycles.load(std::memory_order_relaxed)) {
+      max_cycles.store(cycles, std::memory_order_relaxed);
+    }
+    int bucket = 0;
+    for (std::uint64_t c = cycles; c != 0 && bucket < StageStatistics::kBuckets - 1; c >>= 1) {
+      ++bucket;
+    } //  bit width of the cycles
+    add(buckets[bucket], 1);
+  }
+
+  void accumulate(StageStatistics& statistics) const {
+    statistics.count += count.load(std::memory_order_relaxed);
+    statistics.total_cycles += total_cycles.load(std::memory_order_relaxed);
+    statistics.max_cycles = std::max(statistics.max_cycles, max_cycles.load(std::memory_order_relaxed));
+    for (int b = 0; b < StageStatistics::kBuckets; ++b) {
+      statistics.buckets[b] += buckets[b].load(std::memory_order_relaxed);
+    }
+  }
+};  /*  struct StageHistogram  */
+
+/**
+ *  @brief  Histograms of all stages of one thread, on their own cache lines
+ */
+struct alignas(64) ThreadHistograms {
+  StageHistogram stages[kNumStages];
+};  /*  struct ThreadHistograms  */
+
+/**
+ *  @brief  The histograms of the running threads and the sum of the exited ones
+ */
+struct Registry {
+  std::mutex mutex;
+  std::vector<ThreadHistograms*> threads;
+  std::vector<StageStatistics> exited = std::vector<StageStatistics>(kNumStages);
+};  /*  struct Registry  */
+
+Registry& registry() {
+  static Registry* const registry = new Registry();  //  never destroyed, i.e. outlives all threads
+  return *registry;
+}
+
+/**
+ *  @brief  Registers the calling thread's histograms on first use and retires them on exit
+ */
+struct LocalHistograms {
+  ThreadHistograms histograms;
+
+  LocalHistograms() {
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    registry().threads.push_back(&histograms);
+  }
+
+  ~LocalHistograms() {
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    std::vector<ThreadHistograms*>& threads = registry().threads;
+    threads.erase(std::find(threads.begin(), threads.end(), &histograms));
+    for (int s = 0; s < kNumStages; ++s) {
+      histograms.stages[s].accumulate(registry().exited[s]);
+    }
+  }
+};  /*  struct LocalHistograms  */
+
+ThreadHistograms& localHistograms() {
+  thread_local LocalHistograms local;
+  return local.histograms;
+}
+
+}  /*  namespace  */
+
+/**
+ *
+ */
+std::uint64_t StageStatistics::quantileCycles(const double q) const {
+  const std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(std::min(std::max(q, 0.0), 1.0) * count));
+  std::uint64_t cumulative = 0;
+  for (int b = 0; b < kBuckets; ++b) {
+    cumulative += buckets[b];
+    if (cumulative >= rank && cumulative > 0) {
+      return b == 0 ? 0 : std::min(max_cycles, (std::uint64_t(1) << b) - 1);
+    }
+  }
+  return max_cycles;
+}
+
+/**
+ *  @detail The registration pushes onto the registry under its mutex, i.e. may allocate.
+ */
+void StageProfiler::registerThread() {
+  if (enabled()) {
+    localHistograms();
+  }
+}
+
+/**
+ *
+ */
+void StageProfiler::record(const Stage stage, const std::uint64_t cycles) {
+  localHistograms().stages[static_cast<int>(stage)].record(cycles);
+}
+
+/**
+ *
+ */
+StageStatistics StageProfiler::statistics(const Stage stage) {
+  const int s = static_cast<int>(stage);
+  std::lock_guard<std::mutex> lock(registry().mutex);
+  StageStatistics statistics = registry().exited[s];
+  for (const ThreadHistograms* histograms : registry().threads) {
+    histograms->stages[s].accumulate(statistics);
+  }
+  return statistics;
+}
+
+/**
+ *
+ */
+void StageProfiler::reset() {
+  std::lock_guard<std::mutex> lock(registry().mutex);
+  registry().exited.assign(kNumStages, StageStatistics());
+  for (ThreadHistograms* histograms : registry().threads) {
+    for (int s = 0; s < kNumStages; ++s) {
+      histograms->stages[s].clear();
+    }
+  }
+}
+
+/**
+ *
+ */
+const char* StageProfiler::name(const Stage stage) {
+  switch (stage) {
+    case Stage::kOrientation: return "orientation";
+    case Stage::kCollectiveThrust: return "collective_thrust";
+    case Stage::kBodyrates: return "bodyrates";
+    case Stage::kAngularAcceleration: return "angular_acceleration";
+    case Stage::kBodyXAxisSingularity: return "body_x_axis_singularity";
+    case Stage::kBodyYAxisSingularity: return "body_y_axis_singularity";
+    default: return "unknown";
+  }
+}
+
+} /*  namespace position_controller  */
@@ -0,0 +1,141 @@
+/**
+ *  @file   thread_pool.cpp
+ *  @brief  quadrotor position control's fork join thread pool related functionality implementation
+ *  @author thor
+ *  @date   05.12.2021
+ */
+#include "position_controller/thread_pool.h"
+
+//  std dependencies
+#include <algorithm>
+
+//  3rd party dependencies
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace position_controller {
+
+constexpr int ThreadPool::kDefaultSpinIterations;
+constexpr std::chrono::milliseconds ThreadPool::kBlockTimeout_;
+
+namespace {
+
+/**
+ *  @brief  Pin the calling thread to the given core modulo the number of cores
+ */
+void pinToCore(const int core) {
+#ifdef __linux__
+  const int num_cores = std::max(1u, std::thread::hardware_concurrency());
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(core % num_cores, &cpu_set);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+#else
+  (void)core;
+#endif
+}
+
+}  /*  namespace  */
+
+/**
+ *  @detail ThreadPool's default constructor definition, the calling thread is not pinned, i.e.
+ *          constructing a pool has no side effect on its caller.
+ */
+ThreadPool::ThreadPool(const int num_threads, const bool pin_threads, const int spin_iterations)
+    : num_threads_(std::max(1, num_threads)),
+      spin_iterations_(std::max(0, spin_iterations)),
+      job_(nullptr),
+      generation_(0),
+      pending_(0),
+      stop_(false) {
+  threads_.reserve(num_threads_ - 1);
+  for (int worker = 1; worker < num_threads_; ++worker) {
+    threads_.emplace_back(&ThreadPool::work, this, worker, pin_threads);
+  }
+}
+
+/**
+ *  @detail ThreadPool's default destructor definition
+ */
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_.store(true);
+  }
+  start_.notify_all();
+  for (std::thread& thread : threads_) {
+    thread.join();
+  }
+}
+
+/**
+ *  @detail The generation is incremented under the mutex, so that a worker about to block
+ *          cannot miss it, and the workers spinning on it start without a wake up.
+ */
+void ThreadPool::run(const Job& job) {
+  if (threads_.empty()) {
+    job(0);
+    return;
+  } //  single worker
+
+  pending_.store(num_threads_ - 1, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    job_.store(&job, std::memory_order_relaxed);
+    generation_.fetch_add(1, std::memory_order_release);
+  }
+  start_.notify_all();
+
+  job(0);
+
+  for (int i = 0; i < spin_iterations_; ++i) {
+    if (pending_.load(std::memory_order_acquire) == 0) {
+      return;
+    }
+    std::this_thread::yield();
+  } //  spin on the other workers
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!done_.wait_for(lock, kBlockTimeout_, [this] { return pending_.load(std::memory_order_acquire) == 0; })) {}
+}
+
+/**
+ *
+ */
+void ThreadPool::work(const int worker, const bool pin_thread) {
+  if (pin_thread) {
+    pinToCore(worker);
+  }
+
+  std::uint64_t generation = 0;
+  while (true) {
+    for (int i = 0; i < spin_iterations_; ++i) {
+      if (generation_.load(std::memory_order_acquire) != generation) {
+        break;
+      }
+      std::this_thread::yield();
+    } //  spin on the next job
+
+    if (generation_.load(std::memory_order_acquire) == generation) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      while (!start_.wait_for(lock, kBlockTimeout_, [this, generation] {
+        return stop_.load() || generation_.load(std::memory_order_acquire) != generation;
+      })) {}
+    } //  block on the next job
+    if (stop_.load()) {
+      return;
+    }
+    generation = generation_.load(std::memory_order_acquire);
+    const Job* job = job_.load(std::memory_order_relaxed);
+
+    (*job)(worker);
+
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      done_.notify_one();
+    } //  last worker done
+  }
+}
+
+} /*  namespace position_controller  */
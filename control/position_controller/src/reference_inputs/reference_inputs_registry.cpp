@@ -0,0 +1,66 @@
+/**
+ *  @file   reference_inputs_registry.cpp
+ *  @brief  quadrotor position control's reference inputs models registry related functionality implementation
+ *  @author neo
+ *  @data   04.12.2021
+ */
+#include "reference_inputs/reference_inputs_registry.h"
+
+// std dependencies
+#include <map>
+
+// position_controller dependencies
+#include "reference_inputs/aero_compensated_reference_inputs.h"
+#include "reference_inputs/nominal_reference_inputs.h"
+
+namespace position_controller {
+
+namespace {
+
+/**
+ *  @brief  The registered reference inputs models, initialized with the built in models
+ */
+std::map<std::string, ReferenceInputsFunction>& registry() {
+  static std::map<std::string, ReferenceInputsFunction> functions = {
+    {"aero_compensated", &computeReferenceInputs<AeroCompensatedReferenceInputs>},
+    {"nominal", &computeReferenceInputs<NominalReferenceInputs>},
+  };
+  return functions;
+}
+
+}  /* namespace */
+
+/**
+ *
+ */
+bool ReferenceInputsRegistry::add(const std::string& name, ReferenceInputsFunction function) {
+  return function != nullptr && registry().emplace(name, function).second;
+}
+
+/**
+ *
+ */
+bool ReferenceInputsRegistry::remove(const std::string& name) {
+  return registry().erase(name) > 0;
+}
+
+/**
+ *
+ */
+ReferenceInputsFunction ReferenceInputsRegistry::find(const std::string& name) {
+  const auto it = registry().find(name);
+  return it == registry().end() ? nullptr : it->second;
+}
+
+/**
+ *
+ */
+std::vector<std::string> ReferenceInputsRegistry::names() {
+  std::vector<std::string> names;
+  for (const auto& entry : registry()) {
+    names.push_back(entry.first);
+  }
+  return names;
+}
+
+} /* namespace position_controller */
@@ -0,0 +1,264 @@
+/**
+ *  @file   test_batch_reference_inputs.cpp
+ *  @brief  quadrotor position control's batched reference inputs related functionality unit tests
+ *  @author thor
+ *  @date   24.11.2021
+ */
+#include "position_controller/batch_reference_inputs.h"
+
+//  std dependencies
+#include <random>
+#include <vector>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+//  position_controller dependencies
+#include "position_controller/reference_inputs_solver.h"
+
+namespace position_controller {
+
+/**
+ *  @brief  Test fixture for testing the class BatchReferenceInputs
+ *  @detail reference: https://google.github.io/googletest/primer.html
+ */
+class BatchReferenceInputsTest : public ::testing::Test {
+ protected:
+  typedef std::vector<quadrotor_common::QuadrotorControlCommand,
+      Eigen::aligned_allocator<quadrotor_common::QuadrotorControlCommand>> ControlCommands;
+
+      /////////////////////////////////////////////////////
+      ////////////  Constructors & Destructors  ///////////
+      /////////////////////////////////////////////////////
+
+  /**
+   *  @brief  BatchReferenceInputsTest's default constructor, called for each test
+   *          to perform setup tasks
+   */
+  BatchReferenceInputsTest() {}
+
+  /**
+   *  @brief  BatchReferenceInputsTest's default destructor, called for each test
+   *          to perform cleanup tasks
+   */
+  ~BatchReferenceInputsTest() override {}
+
+      ////////////////////////////////////////
+      ////////////  Class Methods  ///////////
+      ////////////////////////////////////////
+
+  /**
+   *  @brief  Fill n random state estimates and reference states
+   */
+  void randomize(const std::size_t n) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> uniform(-3.0, 3.0);
+    auto random_vector = [&]() {
+      return Eigen::Vector3d(uniform(generator), uniform(generator), uniform(generator));
+    };
+
+    state_estimates.resize(n);
+    reference_states.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      state_estimates[i].orientation = Eigen::Quaterniond(
+          Eigen::AngleAxisd(uniform(generator), random_vector().normalized()));
+      reference_states[i].heading = uniform(generator);
+      reference_states[i].velocity = random_vector();
+      reference_states[i].acceleration = random_vector();
+      reference_states[i].jerk = random_vector();
+      reference_states[i].snap = random_vector();
+      reference_states[i].heading_rate = uniform(generator);
+      reference_states[i].heading_acceleration = uniform(generator);
+    }
+  }
+
+  /**
+   *  @brief  Check the batched reference inputs against the scalar ReferenceInputsSolver path
+   */
+  template <typename RotorDragModel>
+  void expectNearScalar(
+      const ControlCommands& batch,
+      const RotorDragModel& rotor_drag = RotorDragModel()) const {
+    ASSERT_EQ(reference_states.size(), batch.size());
+    ReferenceInputsSolver_<RotorDragModel> solver(rotor_drag);
+    quadrotor_common::QuadrotorControlCommand scalar;
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      solver.solve(state_estimates[i], reference_states[i], scalar);
+      EXPECT_NEAR(0.0, scalar.orientation.angularDistance(batch[i].orientation), kTolerance_);
+      EXPECT_NEAR(scalar.collective_thrust, batch[i].collective_thrust, kTolerance_);
+      EXPECT_LT((scalar.bodyrates - batch[i].bodyrates).norm(),
+                kTolerance_ * (1.0 + scalar.bodyrates.norm()));
+      EXPECT_LT((scalar.angular_acceleration - batch[i].angular_acceleration).norm(),
+                kTolerance_ * (1.0 + scalar.angular_acceleration.norm()));
+    }
+  }
+
+      ////////////////////////////////////////
+      ////////////  Class Members  ///////////
+      ////////////////////////////////////////
+
+  //  @brief  Tolerance of the batched w.r.t. the scalar reference inputs
+  const double kTolerance_ = 1e-9;
+
+  std::vector<quadrotor_common::QuadrotorStateEstimate,
+      Eigen::aligned_allocator<quadrotor_common::QuadrotorStateEstimate>> state_estimates;
+  std::vector<quadrotor_common::QuadrotorTrajectoryPoint,
+      Eigen::aligned_allocator<quadrotor_common::QuadrotorTrajectoryPoint>> reference_states;
+
+}; /*  class BatchReferenceInputsTest  */
+
+/**
+ *  @brief  Test case to check if batched reference inputs match the scalar path,
+ *          including a partially filled last block
+ */
+TEST_F(BatchReferenceInputsTest, MatchesScalarPathTest) {
+  const std::size_t n = 8 * BatchReferenceInputs::lanes() + 3;
+  randomize(n);
+
+  ControlCommands batch(n);
+  BatchReferenceInputs().compute(
+      state_estimates.data(), reference_states.data(), batch.data(), n);
+  expectNearScalar<NoRotorDrag>(batch);
+}
+
+/**
+ *  @brief  Test case to check if batched reference inputs match the scalar path
+ *          for isotropic and anisotropic rotor drag
+ */
+TEST_F(BatchReferenceInputsTest, MatchesScalarPathWithRotorDragTest) {
+  const std::size_t n = 8 * BatchReferenceInputs::lanes() + 1;
+  randomize(n);
+
+  ControlCommands batch(n);
+  const IsotropicRotorDrag isotropic_rotor_drag(0.3);
+  BatchReferenceInputs_<IsotropicRotorDrag>(isotropic_rotor_drag).compute(
+      state_estimates.data(), reference_states.data(), batch.data(), n);
+  expectNearScalar(batch, isotropic_rotor_drag);
+
+  const AnisotropicRotorDrag anisotropic_rotor_drag(0.4, 0.3, 0.1);
+  BatchReferenceInputs_<AnisotropicRotorDrag>(anisotropic_rotor_drag).compute(
+      state_estimates.data(), reference_states.data(), batch.data(), n);
+  expectNearScalar(batch, anisotropic_rotor_drag);
+}
+
+/**
+ *  @brief  Test case to check if the float batched reference inputs match the float scalar path
+ */
+TEST_F(BatchReferenceInputsTest, FloatMatchesScalarPathTest) {
+  const std::size_t n = 4 * BatchReferenceInputsf::lanes() + 3;
+  randomize(n);
+
+  std::vector<quadrotor_common::QuadrotorStateEstimatef,
+      Eigen::aligned_allocator<quadrotor_common::QuadrotorStateEstimatef>> state_estimates_f;
+  std::vector<quadrotor_common::QuadrotorTrajectoryPointf,
+      Eigen::aligned_allocator<quadrotor_common::QuadrotorTrajectoryPointf>> reference_states_f;
+  for (std::size_t i = 0; i < n; ++i) {
+    state_estimates_f.push_back(state_estimates[i].cast<float>());
+    reference_states_f.push_back(reference_states[i].cast<float>());
+  }
+
+  const AnisotropicRotorDragf rotor_drag(0.4f, 0.3f, 0.1f);
+  std::vector<quadrotor_common::QuadrotorControlCommandf,
+      Eigen::aligned_allocator<quadrotor_common::QuadrotorControlCommandf>> batch(n);
+  BatchReferenceInputs_<AnisotropicRotorDragf>(rotor_drag).compute(
+      state_estimates_f.data(), reference_states_f.data(), batch.data(), n);
+
+  EXPECT_EQ(2 * BatchReferenceInputs::lanes(), BatchReferenceInputsf::lanes());
+  ReferenceInputsSolver_<AnisotropicRotorDragf> solver(rotor_drag);
+  quadrotor_common::QuadrotorControlCommandf scalar;
+  for (std::size_t i = 0; i < n; ++i) {
+    solver.solve(state_estimates_f[i], reference_states_f[i], scalar);
+    EXPECT_NEAR(0.0, scalar.orientation.angularDistance(batch[i].orientation), 1e-3);
+    EXPECT_NEAR(scalar.collective_thrust, batch[i].collective_thrust,
+                1e-4 * (1.0 + std::abs(scalar.collective_thrust)));
+    EXPECT_LT((scalar.bodyrates - batch[i].bodyrates).norm(),
+              1e-4 * (1.0 + scalar.bodyrates.norm()));
+    EXPECT_LT((scalar.angular_acceleration - batch[i].angular_acceleration).norm(),
+              1e-4 * (1.0 + scalar.angular_acceleration.norm()));
+  }
+}
+
+/**
+ *  @brief  Test case to check if singular lanes fall back to the scalar path
+ */
+TEST_F(BatchReferenceInputsTest, SingularLanesTest) {
+  const std::size_t n = 2 * BatchReferenceInputs::lanes();
+  randomize(n);
+
+  //  free fall, i.e. alpha = 0
+  reference_states[0].acceleration = Eigen::Vector3d(0.0, 0.0, -9.81);
+  reference_states[0].velocity.setZero();
+  //  hover, regular lane in the same batch as the singular one
+  reference_states[n - 1] = quadrotor_common::QuadrotorTrajectoryPoint();
+  reference_states[n - 1].heading = 0.5;
+
+  ControlCommands batch(n);
+  BatchReferenceInputs().compute(
+      state_estimates.data(), reference_states.data(), batch.data(), n);
+  expectNearScalar<NoRotorDrag>(batch);
+}
+
+/**
+ *  @brief  Test case to check if singular lanes depend on their own pair only, i.e. equal the
+ *          ones of a fresh scalar solver bit for bit, whatever the lane order and the chunking
+ */
+TEST_F(BatchReferenceInputsTest, SingularLanesOrderTest) {
+  const std::size_t n = 3 * BatchReferenceInputs::lanes() + 1;
+  randomize(n);
+  for (std::size_t i = 0; i < n; i += 2) {
+    reference_states[i].acceleration = Eigen::Vector3d(0.0, 0.0, -9.81);
+    reference_states[i].velocity.setZero();
+    reference_states[i].heading = 0.01 * i;
+  } //  free fall with close headings, i.e. within the rotation updates of a heading frame cache
+
+  const BatchReferenceInputs batch_reference_inputs;
+  ControlCommands batch(n), reversed(n), single(n);
+  batch_reference_inputs.compute(state_estimates.data(), reference_states.data(), batch.data(), n);
+  for (std::size_t i = n; i-- > 0;) {
+    batch_reference_inputs.compute(&state_estimates[i], &reference_states[i], &reversed[i], 1);
+  }
+  for (std::size_t i = 0; i < n; i += 2) {
+    ReferenceInputsSolver().solve(state_estimates[i], reference_states[i], single[i]);
+    for (const ControlCommands* commands : {&batch, &reversed}) {
+      EXPECT_EQ(single[i].orientation.coeffs(), (*commands)[i].orientation.coeffs());
+      EXPECT_EQ(single[i].collective_thrust, (*commands)[i].collective_thrust);
+      EXPECT_EQ(single[i].bodyrates, (*commands)[i].bodyrates);
+      EXPECT_EQ(single[i].angular_acceleration, (*commands)[i].angular_acceleration);
+    }
+  }
+}
+
+/**
+ *  @brief  Test case to check if timestamp and control mode of the output are kept
+ */
+TEST_F(BatchReferenceInputsTest, KeepsCommandMetadataTest) {
+  randomize(1);
+
+  ControlCommands batch(1);
+  batch[0].control_mode =
+      quadrotor_common::QuadrotorControlCommand::ControlMode::kBodyrates;
+  BatchReferenceInputs().compute(
+      state_estimates.data(), reference_states.data(), batch.data(), 1);
+  EXPECT_EQ(quadrotor_common::QuadrotorControlCommand::ControlMode::kBodyrates,
+            batch[0].control_mode);
+  expectNearScalar<NoRotorDrag>(batch);
+}
+
+} /*  namespace position_controller  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_batch_reference_inputs");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
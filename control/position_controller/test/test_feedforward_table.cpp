@@ -0,0 +1,139 @@
+/**
+ *  @file   test_feedforward_table.cpp
+ *  @brief  quadrotor position control's precomputed reference inputs related functionality unit tests
+ *  @author thor
+ *  @date   11.12.2021
+ */
+#include "position_controller/feedforward_table.h"
+
+//  std dependencies
+#include <cmath>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+namespace position_controller {
+
+namespace {
+
+/**
+ *  @brief  Circle of 2 m radius at 2 rad/s with the heading along the velocity for t < 3 s,
+ *          free fall afterwards, i.e. the singular branches of the robust body axes
+ */
+void sampleMission(const double t, quadrotor_common::QuadrotorTrajectoryPoint& point) {
+  point = quadrotor_common::QuadrotorTrajectoryPoint();
+  if (t >= 3.0) {
+    point.position = Eigen::Vector3d(0.0, 0.0, 10.0);
+    point.acceleration = Eigen::Vector3d(0.0, 0.0, -9.81);
+    point.heading = 0.5;
+    return;
+  } //  free fall
+  const double r = 2.0, w = 2.0;
+  const double c = std::cos(w * t), s = std::sin(w * t);
+  point.position = Eigen::Vector3d(r*c, r*s, 1.0);
+  point.velocity = r*w * Eigen::Vector3d(-s, c, 0.0);
+  point.acceleration = r*w*w * Eigen::Vector3d(-c, -s, 0.0);
+  point.jerk = r*w*w*w * Eigen::Vector3d(s, -c, 0.0);
+  point.snap = r*w*w*w*w * Eigen::Vector3d(c, s, 0.0);
+  point.heading = std::atan2(c, -s);
+  point.heading_rate = w;
+}
+
+/**
+ *  @brief  Check the table's reference inputs against the solver's
+ */
+void expectNear(const quadrotor_common::QuadrotorControlCommand& expected,
+                const quadrotor_common::QuadrotorControlCommand& actual,
+                const double tolerance) {
+  EXPECT_LT(expected.orientation.angularDistance(actual.orientation), tolerance);
+  EXPECT_NEAR(expected.collective_thrust, actual.collective_thrust, tolerance * 10.0);
+  EXPECT_LT((expected.bodyrates - actual.bodyrates).norm(), tolerance * 10.0);
+  EXPECT_LT((expected.angular_acceleration - actual.angular_acceleration).norm(), tolerance * 100.0);
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  Test case to check the table against the solver at and between the samples
+ */
+TEST(FeedforwardTableTest, LookupTest) {
+  FeedforwardTable table;
+  ASSERT_TRUE(table.compile(sampleMission, 0.0, 2.9, 0.001));
+  EXPECT_EQ(2901u, table.size());
+  EXPECT_NEAR(2.9, table.endTime(), 1e-12);
+  EXPECT_EQ(0u, table.numLiveSamples());
+
+  ReferenceInputsSolver solver;
+  const quadrotor_common::QuadrotorStateEstimate state_estimate;
+  quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+  quadrotor_common::QuadrotorControlCommand expected, actual;
+  for (double t = 0.0; t < 2.9; t += 0.0137) {
+    sampleMission(t, reference_state);
+    solver.solve(state_estimate, reference_state, expected);
+    ASSERT_TRUE(table.lookup(t, actual));
+    expectNear(expected, actual, 1e-5);
+  }
+
+  sampleMission(0.0, reference_state);
+  solver.solve(state_estimate, reference_state, expected);
+  ASSERT_TRUE(table.lookup(-1.0, actual));
+  expectNear(expected, actual, 1e-6);  //  clamped to the first sample
+}
+
+/**
+ *  @brief  Test case to check if the state estimate dependent samples are computed live
+ */
+TEST(FeedforwardTableTest, LiveTest) {
+  FeedforwardTable table;
+  ASSERT_TRUE(table.compile(sampleMission, 0.0, 4.0, 0.01));
+  EXPECT_EQ(101u, table.numLiveSamples());
+
+  quadrotor_common::QuadrotorStateEstimate state_estimate;
+  state_estimate.orientation = Eigen::Quaterniond(Eigen::AngleAxisd(1.0, Eigen::Vector3d::UnitZ()));
+  quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+  quadrotor_common::QuadrotorControlCommand expected, actual;
+  EXPECT_TRUE(table.lookup(2.985, actual));
+  EXPECT_FALSE(table.lookup(2.995, actual));
+  EXPECT_FALSE(table.lookup(3.5, actual));
+
+  ReferenceInputsSolver solver;
+  sampleMission(3.5, reference_state);
+  solver.solve(state_estimate, reference_state, expected);
+  table.compute(3.5, state_estimate, reference_state, actual);
+  EXPECT_TRUE(expected.orientation.isApprox(actual.orientation));
+  EXPECT_DOUBLE_EQ(expected.collective_thrust, actual.collective_thrust);
+}
+
+/**
+ *  @brief  Test case to check the invalid inputs
+ */
+TEST(FeedforwardTableTest, InvalidInputsTest) {
+  FeedforwardTable table;
+  quadrotor_common::QuadrotorControlCommand reference_inputs;
+  EXPECT_FALSE(table.lookup(0.0, reference_inputs));
+  EXPECT_FALSE(table.compile(sampleMission, 0.0, 1.0, 0.0));
+  EXPECT_FALSE(table.compile(sampleMission, 1.0, 0.0, 0.01));
+  EXPECT_TRUE(table.empty());
+  EXPECT_TRUE(table.compile(sampleMission, 1.0, 1.0, 0.01));
+  EXPECT_EQ(1u, table.size());
+  EXPECT_TRUE(table.lookup(2.0, reference_inputs));
+}
+
+} /*  namespace position_controller  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_feedforward_table");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
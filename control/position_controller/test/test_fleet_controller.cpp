@@ -0,0 +1,216 @@
+/**
+ *  @file   test_fleet_controller.cpp
+ *  @brief  quadrotor position control's multi vehicle fleet related functionality unit tests
+ *  @author thor
+ *  @date   05.12.2021
+ */
+#include "position_controller/fleet_controller.h"
+
+//  std dependencies
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+//  position_controller dependencies
+#include "position_controller/batch_reference_inputs.h"
+#include "position_controller/thread_pool.h"
+
+namespace position_controller {
+
+/**
+ *  @brief  Test fixture for testing the class FleetController
+ *  @detail reference: https://google.github.io/googletest/primer.html
+ */
+class FleetControllerTest : public ::testing::Test {
+ protected:
+
+      /////////////////////////////////////////////////////
+      ////////////  Constructors & Destructors  ///////////
+      /////////////////////////////////////////////////////
+
+  /**
+   *  @brief  FleetControllerTest's default constructor, called for each test
+   *          to perform setup tasks
+   */
+  FleetControllerTest() {}
+
+  /**
+   *  @brief  FleetControllerTest's default destructor, called for each test
+   *          to perform cleanup tasks
+   */
+  ~FleetControllerTest() override {}
+
+      ////////////////////////////////////////
+      ////////////  Class Methods  ///////////
+      ////////////////////////////////////////
+
+  /**
+   *  @brief  Fill n random state estimates and reference states
+   */
+  void randomize(const std::size_t n) {
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<double> uniform(-3.0, 3.0);
+    auto random_vector = [&]() {
+      return Eigen::Vector3d(uniform(generator), uniform(generator), uniform(generator));
+    };
+
+    state_estimates.resize(n);
+    reference_states.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+      state_estimates[i].orientation = Eigen::Quaterniond(
+          Eigen::AngleAxisd(uniform(generator), random_vector().normalized()));
+      reference_states[i].heading = uniform(generator);
+      reference_states[i].velocity = random_vector();
+      reference_states[i].acceleration = random_vector();
+      reference_states[i].jerk = random_vector();
+      reference_states[i].snap = random_vector();
+      reference_states[i].heading_rate = uniform(generator);
+      reference_states[i].heading_acceleration = uniform(generator);
+    }
+  }
+
+  /**
+   *  @brief  Check the fleet commands against a single BatchReferenceInputs, i.e. bitwise
+   */
+  void expectEqualBatch(const FleetController::ControlCommands& fleet) {
+    FleetController::ControlCommands batch(reference_states.size());
+    BatchReferenceInputs().compute(
+        state_estimates.data(), reference_states.data(), batch.data(), batch.size());
+    ASSERT_EQ(batch.size(), fleet.size());
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      EXPECT_EQ(batch[i].orientation.coeffs(), fleet[i].orientation.coeffs());
+      EXPECT_EQ(batch[i].collective_thrust, fleet[i].collective_thrust);
+      EXPECT_EQ(batch[i].bodyrates, fleet[i].bodyrates);
+      EXPECT_EQ(batch[i].angular_acceleration, fleet[i].angular_acceleration);
+    }
+  }
+
+      ////////////////////////////////////////
+      ////////////  Class Members  ///////////
+      ////////////////////////////////////////
+
+  FleetController::StateEstimates state_estimates;
+  FleetController::TrajectoryPoints reference_states;
+
+}; /*  class FleetControllerTest  */
+
+/**
+ *  @brief  Test case to check if every worker runs every job exactly once
+ */
+TEST(ThreadPoolTest, RunsEveryWorkerOnceTest) {
+  for (const int num_threads : {1, 2, 5}) {
+    ThreadPool thread_pool(num_threads);
+    std::vector<std::atomic<int>> counts(num_threads);
+    for (auto& count : counts) {
+      count.store(0);
+    }
+    for (int tick = 0; tick < 200; ++tick) {
+      thread_pool.run([&](const int worker) { counts[worker].fetch_add(1); });
+      for (int worker = 0; worker < num_threads; ++worker) {
+        ASSERT_EQ(tick + 1, counts[worker].load());
+      }
+    }
+  }
+}
+
+/**
+ *  @brief  Test case to check if jobs complete with and without spinning on the next one
+ */
+TEST(ThreadPoolTest, SpinIterationsTest) {
+  for (const int spin_iterations : {0, ThreadPool::kDefaultSpinIterations, 1 << 12}) {
+    ThreadPool thread_pool(3, false, spin_iterations);
+    std::atomic<int> count(0);
+    for (int tick = 0; tick < 100; ++tick) {
+      thread_pool.run([&count](const int) { count.fetch_add(1); });
+    }
+    EXPECT_EQ(300, count.load());
+  }
+}
+
+#ifdef __linux__
+/**
+ *  @brief  Test case to check if pinning leaves the calling thread's affinity as it was
+ */
+TEST(ThreadPoolTest, PinningKeepsCallerAffinityTest) {
+  cpu_set_t before, after;
+  ASSERT_EQ(0, pthread_getaffinity_np(pthread_self(), sizeof(before), &before));
+  {
+    ThreadPool thread_pool(2, true);
+    std::atomic<int> pinned_core(-1);
+    thread_pool.run([&pinned_core](const int worker) {
+      if (worker == 1) {
+        pinned_core.store(sched_getcpu());
+      }
+    });
+    if (std::thread::hardware_concurrency() > 1 && CPU_ISSET(1, &before)) {
+      EXPECT_EQ(1, pinned_core.load());
+    }
+  }
+  ASSERT_EQ(0, pthread_getaffinity_np(pthread_self(), sizeof(after), &after));
+  EXPECT_TRUE(CPU_EQUAL(&before, &after));
+}
+#endif
+
+/**
+ *  @brief  Test case to check if the fleet matches the batched reference inputs for
+ *          several numbers of threads and vehicles, including idle workers
+ */
+TEST_F(FleetControllerTest, MatchesBatchTest) {
+  for (const std::size_t n : {std::size_t(0), std::size_t(3), std::size_t(1001)}) {
+    randomize(n);
+    for (const int num_threads : {1, 3, 8}) {
+      FleetController fleet_controller(num_threads);
+      FleetController::ControlCommands commands;
+      for (int tick = 0; tick < 3; ++tick) {
+        fleet_controller.run(state_estimates, reference_states, commands);
+      }
+      expectEqualBatch(commands);
+    }
+  }
+}
+
+/**
+ *  @brief  Test case to check if the fleet keeps the command metadata
+ */
+TEST_F(FleetControllerTest, KeepsCommandMetadataTest) {
+  randomize(100);
+  FleetController::ControlCommands commands(100);
+  for (auto& command : commands) {
+    command.control_mode = quadrotor_common::QuadrotorControlCommand::ControlMode::kBodyrates;
+  }
+
+  FleetController fleet_controller(4);
+  fleet_controller.run(state_estimates, reference_states, commands);
+
+  for (const auto& command : commands) {
+    EXPECT_EQ(quadrotor_common::QuadrotorControlCommand::ControlMode::kBodyrates,
+              command.control_mode);
+  }
+}
+
+} /*  namespace position_controller  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_fleet_controller");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
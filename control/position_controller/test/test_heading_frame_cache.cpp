@@ -0,0 +1,131 @@
+/**
+ *  @file   test_heading_frame_cache.cpp
+ *  @brief  quadrotor position control's heading frame cache related functionality unit tests
+ *  @author thor
+ *  @date   01.12.2021
+ */
+#include "position_controller/heading_frame_cache.h"
+
+//  std dependencies
+#include <cmath>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+namespace position_controller {
+
+/**
+ *  @brief  Test fixture for testing the class HeadingFrameCache
+ *  @detail reference: https://google.github.io/googletest/primer.html
+ */
+class HeadingFrameCacheTest : public ::testing::Test {
+ protected:
+
+      /////////////////////////////////////////////////////
+      ////////////  Constructors & Destructors  ///////////
+      /////////////////////////////////////////////////////
+
+  /**
+   *  @brief  HeadingFrameCacheTest's default constructor, called for each test
+   *          to perform setup tasks
+   */
+  HeadingFrameCacheTest() {}
+
+  /**
+   *  @brief  HeadingFrameCacheTest's default destructor, called for each test
+   *          to perform cleanup tasks
+   */
+  ~HeadingFrameCacheTest() override {}
+
+      ////////////////////////////////////////
+      ////////////  Class Methods  ///////////
+      ////////////////////////////////////////
+
+  /**
+   *  @brief  Update the cache and check the heading frame against std::cos, std::sin
+   */
+  void expectHeadingFrame(const double heading) {
+    cache.update(heading, x_C, y_C);
+    EXPECT_NEAR(std::cos(heading), x_C.x(), kTolerance_);
+    EXPECT_NEAR(std::sin(heading), x_C.y(), kTolerance_);
+    EXPECT_EQ(0.0, x_C.z());
+    EXPECT_NEAR(-std::sin(heading), y_C.x(), kTolerance_);
+    EXPECT_NEAR(std::cos(heading), y_C.y(), kTolerance_);
+    EXPECT_EQ(0.0, y_C.z());
+  }
+
+      ////////////////////////////////////////
+      ////////////  Class Members  ///////////
+      ////////////////////////////////////////
+
+  //  @brief  Tolerance for the heading frame
+  const double kTolerance_ = 1e-12;
+
+  HeadingFrameCache cache;
+  Eigen::Vector3d x_C, y_C;
+
+}; /*  class HeadingFrameCacheTest  */
+
+/**
+ *  @brief  Test case to check the heading frame of a constant heading
+ */
+TEST_F(HeadingFrameCacheTest, ConstantHeadingTest) {
+  for (int i = 0; i < 10; ++i) {
+    expectHeadingFrame(0.7);
+  }
+}
+
+/**
+ *  @brief  Test case to check the rotation updates of a slowly changing heading,
+ *          including the accumulated round off over many updates
+ */
+TEST_F(HeadingFrameCacheTest, SmoothHeadingTest) {
+  for (int i = 0; i < 100000; ++i) {
+    expectHeadingFrame(-1.0 + 0.0371 * i);
+  }
+  for (int i = 0; i < 1000; ++i) {
+    expectHeadingFrame(0.5 * std::sin(0.01 * i));
+  }
+}
+
+/**
+ *  @brief  Test case to check the heading frame across large heading jumps
+ */
+TEST_F(HeadingFrameCacheTest, HeadingJumpTest) {
+  expectHeadingFrame(0.0);
+  expectHeadingFrame(3.1);
+  expectHeadingFrame(-3.1);
+  expectHeadingFrame(-3.05);
+  expectHeadingFrame(1.0);
+  expectHeadingFrame(1.0999);
+  expectHeadingFrame(1.2);
+}
+
+/**
+ *  @brief  Test case to check if reset() recomputes the heading frame
+ */
+TEST_F(HeadingFrameCacheTest, ResetTest) {
+  expectHeadingFrame(0.3);
+  cache.reset();
+  expectHeadingFrame(0.31);
+  expectHeadingFrame(0.32);
+}
+
+} /*  namespace position_controller  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_heading_frame_cache");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
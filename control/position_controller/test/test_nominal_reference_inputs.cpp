@@ -6,9 +6,14 @@
  */
 #include "reference_inputs/nominal_reference_inputs.h"
 
+// std dependencies
+#include <memory>
+
 // 3rd party dependencies
 #include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
 #include <ros/ros.h>
+#endif
 
 namespace position_controller {
 
@@ -74,7 +79,7 @@ TEST_F(NominalReferenceInputsTest, InitializationTest) {
  *  @brief  Test case to check if robust body xaxis is calculated correctly.
  */
 TEST_F(NominalReferenceInputsTest, ComputeRobustBodyXAxisTest) {
-  Eigen::Vector3d x_B, x_B_gt, alpha;
+  Eigen::Vector3d x_B, x_B_gt, alpha = Eigen::Vector3d::Zero();
 
   state_est_ptr.reset(new quadrotor_common::QuadrotorStateEstimate());
   state_ref_ptr.reset(new quadrotor_common::QuadrotorTrajectoryPoint());
@@ -112,7 +117,7 @@ TEST_F(NominalReferenceInputsTest, ComputeRobustBodyXAxisTest) {
  *  @brief  Test case to check if robust body yaxis is calculated correctly.
  */
 TEST_F(NominalReferenceInputsTest, ComputeRobustBodyYAxisTest) {
-  Eigen::Vector3d x_B, y_B, y_B_gt, beta;
+  Eigen::Vector3d x_B = Eigen::Vector3d::Zero(), y_B, y_B_gt, beta = Eigen::Vector3d::Zero();
 
   state_est_ptr.reset(new quadrotor_common::QuadrotorStateEstimate());
   state_ref_ptr.reset(new quadrotor_common::QuadrotorTrajectoryPoint());
@@ -233,8 +238,10 @@ TEST_F(NominalReferenceInputsTest, computeDesiredCollectiveThrustTest) {
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
 
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
   ros::init(argc, argv, "test_nominal_reference_inputs");
   ros::NodeHandle nh;
+#endif
 
   return RUN_ALL_TESTS();
 }
@@ -8,7 +8,9 @@
 
 // 3rd party dependencies
 #include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
 #include <ros/ros.h>
+#endif
 
 namespace position_controller {
 
@@ -59,6 +61,32 @@ TEST_F(PositionControllerTest, testCase1) {
   EXPECT_EQ(0, 0);
 }
 
+/**
+ *  @brief  Test case to check if run() into a given command equals the returned command
+ *          and keeps the control mode of the given command
+ */
+TEST_F(PositionControllerTest, RunIntoCommandTest) {
+  PositionController returning, writing;
+  quadrotor_common::QuadrotorStateEstimate state_estimate;
+  quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+  quadrotor_common::QuadrotorControlCommand command;
+  command.control_mode = quadrotor_common::QuadrotorControlCommand::ControlMode::kBodyrates;
+  for (int tick = 0; tick < 10; ++tick) {
+    reference_state.heading = 0.1 * tick;
+    reference_state.velocity = Eigen::Vector3d(1.0, 0.5 * tick, 0.0);
+    reference_state.acceleration = Eigen::Vector3d(0.2 * tick, 1.0, 0.5);
+    reference_state.jerk = Eigen::Vector3d(0.1, -0.3, 0.2 * tick);
+    reference_state.heading_rate = 0.3;
+    const quadrotor_common::QuadrotorControlCommand expected = returning.run(state_estimate, reference_state);
+    writing.run(state_estimate, reference_state, command);
+    EXPECT_EQ(expected.orientation.coeffs(), command.orientation.coeffs());
+    EXPECT_EQ(expected.collective_thrust, command.collective_thrust);
+    EXPECT_EQ(expected.bodyrates, command.bodyrates);
+    EXPECT_EQ(expected.angular_acceleration, command.angular_acceleration);
+    EXPECT_EQ(quadrotor_common::QuadrotorControlCommand::ControlMode::kBodyrates, command.control_mode);
+  }
+}
+
 } /* namespace position_controller */
 
 /**
@@ -67,8 +95,10 @@ TEST_F(PositionControllerTest, testCase1) {
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
 
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
   ros::init(argc, argv, "test_position_controller");
   ros::NodeHandle nh;
+#endif
 
   return RUN_ALL_TESTS();
 }
@@ -0,0 +1,331 @@
+/**
+ *  @file   test_realtime_executor.cpp
+ *  @brief  quadrotor position control's real time fixed rate loop related functionality unit tests
+ *  @author thor
+ *  @date   07.12.2021
+ */
+#include "position_controller/realtime_executor.h"
+
+//  std dependencies
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <memory>
+#include <thread>
+#include <vector>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+//  position_controller dependencies
+#include "position_controller/control_loop.h"
+
+namespace position_controller {
+
+namespace {
+
+//  @brief  Loop rate of the tests [Hz], i.e. the production inner loop rate
+constexpr double kRate = 1000.0;
+constexpr std::int64_t kPeriod = 1000000;
+
+#ifdef __linux__
+/**
+ *  @brief  Number of non resident pages of the given number of stack bytes below the caller
+ */
+std::size_t nonResidentStackPages(const std::size_t bytes) {
+  const std::uintptr_t page_bytes = sysconf(_SC_PAGESIZE);
+  volatile unsigned char top = 0;
+  const std::uintptr_t end = reinterpret_cast<std::uintptr_t>(&top) & ~(page_bytes - 1);
+  const std::uintptr_t begin = end - bytes;
+  std::vector<unsigned char> residency(bytes / page_bytes);
+  if (mincore(reinterpret_cast<void*>(begin), bytes, residency.data()) != 0) {
+    return residency.size();
+  }
+  std::size_t non_resident = 0;
+  for (const unsigned char page : residency) {
+    non_resident += (page & 1) == 0;
+  }
+  return non_resident;
+}
+
+/**
+ *  @brief  The first core the test process may run on, e.g. not core 0 in a restricted cpuset
+ */
+int allowedCpu() {
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &cpu_set)) {
+        return cpu;
+      }
+    }
+  }
+  return 0;
+}
+#endif
+
+}  /*  namespace  */
+
+/**
+ *  @brief  Test case to check the period, the tick count and the counters of an unloaded loop
+ */
+TEST(RealTimeExecutorTest, FixedRateTest) {
+  constexpr std::uint64_t kTicks = 100;
+  RealTimeExecutorParameters parameters;
+  parameters.rate = kRate;
+
+  std::uint64_t last_tick = 0;
+  RealTimeExecutor* executor_pointer = nullptr;
+  RealTimeExecutor executor(parameters, [&](const std::uint64_t tick) {
+    last_tick = tick;
+    if (tick + 1 == kTicks) {
+      executor_pointer->stop();
+    }
+  });
+  executor_pointer = &executor;
+  EXPECT_EQ(kPeriod, executor.period());
+
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  executor.run();
+  const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start;
+
+  const RealTimeExecutorStatistics statistics = executor.statistics();
+  EXPECT_EQ(kTicks - 1, last_tick);
+  EXPECT_EQ(kTicks, statistics.ticks);
+  EXPECT_GE(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+            static_cast<std::int64_t>(kTicks - statistics.deadline_misses - statistics.overruns) * kPeriod);
+  EXPECT_GE(statistics.max_jitter, statistics.meanJitter());
+  EXPECT_GE(statistics.max_jitter, 0);
+  EXPECT_GE(statistics.max_execution_time, statistics.last_execution_time);
+  EXPECT_FALSE(statistics.pinned);
+  EXPECT_FALSE(statistics.realtime);
+  EXPECT_FALSE(statistics.memory_locked);
+}
+
+/**
+ *  @brief  Test case to check if a rate which is not positive and finite is rejected
+ */
+TEST(RealTimeExecutorTest, InvalidRateTest) {
+  for (const double rate : {0.0, -kRate, 1e-12, std::numeric_limits<double>::quiet_NaN(),
+                            std::numeric_limits<double>::infinity()}) {
+    RealTimeExecutorParameters parameters;
+    parameters.rate = rate;
+    EXPECT_THROW(RealTimeExecutor(parameters, [](const std::uint64_t) {}), std::invalid_argument) << rate;
+  }
+}
+
+/**
+ *  @brief  Test case to check if a tick exceeding its period counts as a deadline miss, and the
+ *          release times passed in the meantime as overruns rather than being caught up with
+ */
+TEST(RealTimeExecutorTest, OverrunTest) {
+  RealTimeExecutorParameters parameters;
+  parameters.rate = kRate;
+
+  RealTimeExecutor* executor_pointer = nullptr;
+  RealTimeExecutor executor(parameters, [&](const std::uint64_t tick) {
+    if (tick == 1) {
+      std::this_thread::sleep_for(std::chrono::nanoseconds(5 * kPeriod / 2));
+    }
+    if (tick == 3) {
+      executor_pointer->stop();
+    }
+  });
+  executor_pointer = &executor;
+  executor.run();
+
+  const RealTimeExecutorStatistics statistics = executor.statistics();
+  EXPECT_EQ(4u, statistics.ticks);
+  EXPECT_GE(statistics.deadline_misses, 1u);
+  EXPECT_GE(statistics.overruns, 2u);
+  EXPECT_GE(statistics.max_execution_time, 5 * kPeriod / 2);
+}
+
+#ifdef __linux__
+/**
+ *  @brief  Test case to check if the stack the loop grows into is resident before the first tick.
+ *          No test locks the memory of the test process, see RealTimePrivilegesTest, i.e. no
+ *          mlockall(MCL_FUTURE) maps the new thread stacks regardless of the pre-faulting.
+ */
+TEST(RealTimeExecutorTest, PrefaultStackTest) {
+  constexpr std::size_t kStackBytes = 1 << 20;
+  constexpr std::size_t kSlackBytes = 64 * 1024;  //  frames between the pre-faulting and the tick
+  RealTimeExecutorParameters parameters;
+  parameters.rate = kRate;
+  parameters.prefault_stack_bytes = kStackBytes;
+
+  std::atomic<std::size_t> non_resident(0);
+  std::atomic<bool> ticked(false);
+  RealTimeExecutor executor(parameters, [&](const std::uint64_t tick) {
+    if (tick == 0) {
+      non_resident.store(nonResidentStackPages(kStackBytes - kSlackBytes));
+      ticked.store(true);
+    }
+  });
+  executor.start();
+  while (!ticked.load()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  executor.stop();
+  EXPECT_EQ(0u, non_resident.load());
+}
+#endif
+
+/**
+ *  @brief  Test case to check if the loop runs pinned to a core the process may run on, with the
+ *          heap pre-faulted
+ */
+TEST(RealTimeExecutorTest, RealTimeSetupTest) {
+  RealTimeExecutorParameters parameters;
+  parameters.rate = kRate;
+#ifdef __linux__
+  parameters.cpu = allowedCpu();
+#endif
+  parameters.prefault_heap_bytes = 1 << 20;
+
+  std::atomic<std::uint64_t> ticks(0);
+  RealTimeExecutor executor(parameters, [&ticks](const std::uint64_t) { ticks.fetch_add(1); });
+  executor.start();
+  while (ticks.load() < 10) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  executor.stop();
+
+  const RealTimeExecutorStatistics statistics = executor.statistics();
+  EXPECT_EQ(ticks.load(), statistics.ticks);
+#ifdef __linux__
+  EXPECT_TRUE(statistics.pinned);
+#endif
+}
+
+#ifdef __linux__
+/**
+ *  @brief  Test case to check if the loop runs with SCHED_FIFO and locked memory requested,
+ *          whether it took effect or not, e.g. without CAP_SYS_NICE and CAP_IPC_LOCK. Runs in a
+ *          re-executed child process, i.e. never locks the memory or raises the priority of the
+ *          test process itself.
+ */
+TEST(RealTimeExecutorTest, RealTimePrivilegesTest) {
+  ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+  EXPECT_EXIT({
+    RealTimeExecutorParameters parameters;
+    parameters.rate = kRate;
+    parameters.priority = 80;
+    parameters.lock_memory = true;
+
+    std::atomic<std::uint64_t> ticks(0);
+    RealTimeExecutor executor(parameters, [&ticks](const std::uint64_t) { ticks.fetch_add(1); });
+    executor.start();
+    while (ticks.load() < 10) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    executor.stop();
+    std::exit(ticks.load() == executor.statistics().ticks ? 0 : 1);
+  }, ::testing::ExitedWithCode(0), "");
+}
+#endif
+
+/**
+ *  @brief  Test case to check if a loop stopped by its tick function restarts, on its own thread
+ *          by start() and on the calling thread by run()
+ */
+TEST(RealTimeExecutorTest, RestartTest) {
+  constexpr std::uint64_t kTicks = 5;
+  RealTimeExecutorParameters parameters;
+  parameters.rate = kRate;
+
+  std::atomic<std::uint64_t> calls(0);
+  RealTimeExecutor* executor_pointer = nullptr;
+  RealTimeExecutor executor(parameters, [&](const std::uint64_t tick) {
+    calls.fetch_add(1);
+    if (tick + 1 == kTicks) {
+      executor_pointer->stop();
+    }
+  });
+  executor_pointer = &executor;
+
+  for (std::uint64_t run = 1; run <= 2; ++run) {
+    executor.start();
+    while (calls.load() < run * kTicks) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+  executor.stop();
+  EXPECT_EQ(2 * kTicks, calls.load());
+
+  executor.run();
+  EXPECT_EQ(3 * kTicks, calls.load());
+  EXPECT_EQ(3 * kTicks, executor.statistics().ticks);
+}
+
+/**
+ *  @brief  Test case to check if the control loop publishes the position controller's commands
+ *          for the latest state estimate
+ */
+TEST(RealTimeExecutorTest, ControlLoopTest) {
+  const std::unique_ptr<quadrotor_common::StateEstimateMailbox> state_estimates(
+      new quadrotor_common::StateEstimateMailbox());
+  const std::unique_ptr<ControlCommandMailbox> control_commands(new ControlCommandMailbox());
+
+  quadrotor_common::QuadrotorStateEstimate state_estimate;
+  state_estimate.position = Eigen::Vector3d(1.0, 2.0, 3.0);
+  state_estimate.velocity = Eigen::Vector3d(0.5, 0.0, 0.0);
+  state_estimates->write(state_estimate);
+
+  quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+  reference_state.position = Eigen::Vector3d(1.0, 2.0, 3.0);
+  reference_state.velocity = Eigen::Vector3d(1.0, 0.0, 0.0);
+  reference_state.acceleration = Eigen::Vector3d(0.0, 1.0, 0.0);
+
+  std::atomic<std::uint64_t> ticks(0);
+  RealTimeExecutorParameters parameters;
+  parameters.rate = kRate;
+  ControlLoop control_loop(
+      parameters, *state_estimates,
+      [&](const std::uint64_t, quadrotor_common::QuadrotorTrajectoryPoint& reference) {
+        reference = reference_state;
+        ticks.fetch_add(1);
+      },
+      *control_commands);
+  control_loop.start();
+  while (ticks.load() < 10) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  control_loop.stop();
+
+  PositionController position_controller;
+  const quadrotor_common::QuadrotorControlCommand expected =
+      position_controller.run(state_estimate, reference_state);
+  EXPECT_TRUE(control_commands->poll());
+  EXPECT_NEAR(expected.collective_thrust, control_commands->value().collective_thrust, 1e-12);
+  EXPECT_TRUE(expected.bodyrates.isApprox(control_commands->value().bodyrates));
+  EXPECT_EQ(ticks.load(), control_loop.statistics().ticks);
+}
+
+} /*  namespace position_controller  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_realtime_executor");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
@@ -8,7 +8,9 @@
 
 //  3rd party dependencies
 #include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
 #include <ros/ros.h>
+#endif
 
 namespace position_controller {
 
@@ -70,8 +72,10 @@ TEST_F(ReferenceInputsTest, SampleTest) {
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
 
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
   ros::init(argc, argv, "test_reference_inputs");
   ros::NodeHandle nh;
+#endif
 
   return RUN_ALL_TESTS();
 }
@@ -0,0 +1,196 @@
+/**
+ *  @file   test_reference_inputs_registry.cpp
+ *  @brief  quadrotor position control's reference inputs models registry related functionality unit tests
+ *  @author neo
+ *  @data   04.12.2021
+ */
+#include "reference_inputs/reference_inputs_registry.h"
+
+// std dependencies
+#include <type_traits>
+#include <vector>
+
+// 3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+// position_controller dependencies
+#include "position_controller/reference_inputs_solver.h"
+#include "reference_inputs/aero_compensated_reference_inputs.h"
+#include "reference_inputs/nominal_reference_inputs.h"
+
+namespace position_controller {
+
+/**
+ *  @brief  Test fixture for testing the class ReferenceInputsRegistry and the registered models.
+ *  @detail The models are checked against the ReferenceInputsSolver with the matching rotor drag.
+ */
+class ReferenceInputsRegistryTest : public ::testing::Test {
+ protected:
+        ///////////////////////////////////////////////////
+        //////////// Constructors & Destructors ///////////
+        ///////////////////////////////////////////////////
+
+    /**
+     *  @brief ReferenceInputsRegistryTest's default constructor, called for each test to do set-up work.
+     */
+    ReferenceInputsRegistryTest()
+        : state_estimates(kPoints),
+          reference_states(kPoints) {
+      for (int i = 0; i < kPoints; ++i) {
+        state_estimates[i].orientation = Eigen::Quaterniond(
+            Eigen::AngleAxisd(0.1 * i, Eigen::Vector3d::UnitZ()));
+        reference_states[i].heading = 0.3 * i;
+        reference_states[i].velocity = Eigen::Vector3d(1.0, -0.5 * i, 0.2);
+        reference_states[i].acceleration = Eigen::Vector3d(0.1 * i, 1.0, -2.0);
+        reference_states[i].jerk = Eigen::Vector3d(0.5, 0.1 * i, 0.0);
+        reference_states[i].heading_rate = 0.05 * i;
+      }
+      parameters.rotor_drag_coefficients = Eigen::Vector3d(0.4, 0.3, 0.1);
+    }
+
+    /**
+     *  @brief ReferenceInputsRegistryTest's default destructor, called for each test to do clean-up work.
+     */
+    ~ReferenceInputsRegistryTest() override {}
+
+        //////////////////////////////////////
+        //////////// Class Methods ///////////
+        //////////////////////////////////////
+
+    /**
+     *  @brief Check the registered model against the solver.
+     */
+    template <typename RotorDragModel>
+    void expectMatchesSolver(const std::string& name, const RotorDragModel& rotor_drag) {
+      const ReferenceInputsFunction function = ReferenceInputsRegistry::find(name);
+      ASSERT_NE(nullptr, function);
+
+      std::vector<quadrotor_common::QuadrotorControlCommand,
+          Eigen::aligned_allocator<quadrotor_common::QuadrotorControlCommand>> commands(kPoints);
+      function(state_estimates.data(), reference_states.data(), kPoints, parameters, commands.data());
+
+      ReferenceInputsSolver_<RotorDragModel> solver(rotor_drag);
+      for (int i = 0; i < kPoints; ++i) {
+        quadrotor_common::QuadrotorControlCommand expected;
+        solver.solve(state_estimates[i], reference_states[i], expected);
+        EXPECT_NEAR(0.0, expected.orientation.angularDistance(commands[i].orientation), kTolerance_);
+        EXPECT_NEAR(expected.collective_thrust, commands[i].collective_thrust, kTolerance_);
+        EXPECT_TRUE(expected.bodyrates.isApprox(commands[i].bodyrates, kTolerance_))
+            << expected.bodyrates.transpose() << " vs " << commands[i].bodyrates.transpose();
+      }
+    }
+
+        //////////////////////////////////////
+        //////////// Class Members ///////////
+        //////////////////////////////////////
+
+    //  @brief  Number of points
+    static constexpr int kPoints = 10;
+
+    //  @brief  Tolerance for the reference inputs
+    const double kTolerance_ = 1e-9;
+
+    std::vector<quadrotor_common::QuadrotorStateEstimate,
+        Eigen::aligned_allocator<quadrotor_common::QuadrotorStateEstimate>> state_estimates;
+    std::vector<quadrotor_common::QuadrotorTrajectoryPoint,
+        Eigen::aligned_allocator<quadrotor_common::QuadrotorTrajectoryPoint>> reference_states;
+    ReferenceInputsParameters parameters;
+
+};  /* class ReferenceInputsRegistryTest */
+
+/**
+ *  @brief  Test case to check the built in and the unknown models.
+ */
+TEST_F(ReferenceInputsRegistryTest, FindTest) {
+  EXPECT_EQ(std::vector<std::string>({"aero_compensated", "nominal"}),
+            ReferenceInputsRegistry::names());
+  EXPECT_EQ(&computeReferenceInputs<NominalReferenceInputs>,
+            ReferenceInputsRegistry::find("nominal"));
+  EXPECT_EQ(nullptr, ReferenceInputsRegistry::find("unknown"));
+}
+
+/**
+ *  @brief  Test case to check if a name can be registered once only, and unregistered, i.e. the
+ *          registry is left as found for the other tests.
+ */
+TEST_F(ReferenceInputsRegistryTest, AddTest) {
+  EXPECT_FALSE(ReferenceInputsRegistry::add(
+      "nominal", &computeReferenceInputs<AeroCompensatedReferenceInputs>));
+  EXPECT_EQ(&computeReferenceInputs<NominalReferenceInputs>,
+            ReferenceInputsRegistry::find("nominal"));
+  EXPECT_TRUE(ReferenceInputsRegistry::add(
+      "aero_compensated_copy", &computeReferenceInputs<AeroCompensatedReferenceInputs>));
+  EXPECT_EQ(&computeReferenceInputs<AeroCompensatedReferenceInputs>,
+            ReferenceInputsRegistry::find("aero_compensated_copy"));
+  EXPECT_TRUE(ReferenceInputsRegistry::remove("aero_compensated_copy"));
+  EXPECT_FALSE(ReferenceInputsRegistry::remove("aero_compensated_copy"));
+  EXPECT_EQ(nullptr, ReferenceInputsRegistry::find("aero_compensated_copy"));
+}
+
+/**
+ *  @brief  Test case to check the nominal model against the solver without rotor drag.
+ */
+TEST_F(ReferenceInputsRegistryTest, NominalMatchesSolverTest) {
+  expectMatchesSolver("nominal", NoRotorDrag());
+}
+
+/**
+ *  @brief  Test case to check the aero compensated model against the solver with rotor drag.
+ */
+TEST_F(ReferenceInputsRegistryTest, AeroCompensatedMatchesSolverTest) {
+  const Eigen::Vector3d& d = parameters.rotor_drag_coefficients;
+  expectMatchesSolver("aero_compensated", AnisotropicRotorDrag(d.x(), d.y(), d.z()));
+}
+
+/**
+ *  @brief  Test case to check if the models keep the command metadata.
+ */
+TEST_F(ReferenceInputsRegistryTest, KeepsCommandMetadataTest) {
+  quadrotor_common::QuadrotorControlCommand command;
+  command.control_mode = quadrotor_common::QuadrotorControlCommand::ControlMode::kBodyrates;
+  command.angular_acceleration = Eigen::Vector3d(1.0, 2.0, 3.0);
+
+  const NominalReferenceInputs model(state_estimates[1], reference_states[1]);
+  model.computeReferenceInputs(command);
+
+  EXPECT_EQ(quadrotor_common::QuadrotorControlCommand::ControlMode::kBodyrates,
+            command.control_mode);
+  EXPECT_EQ(Eigen::Vector3d(1.0, 2.0, 3.0), command.angular_acceleration);
+}
+
+/**
+ *  @brief  Test case to check if the models can not reference temporary inputs
+ */
+TEST_F(ReferenceInputsRegistryTest, RejectsTemporariesTest) {
+  typedef quadrotor_common::QuadrotorStateEstimate StateEstimate;
+  typedef quadrotor_common::QuadrotorTrajectoryPoint TrajectoryPoint;
+  EXPECT_TRUE((std::is_constructible<NominalReferenceInputs,
+      const StateEstimate&, const TrajectoryPoint&>::value));
+  EXPECT_FALSE((std::is_constructible<NominalReferenceInputs, StateEstimate, const TrajectoryPoint&>::value));
+  EXPECT_FALSE((std::is_constructible<NominalReferenceInputs, const StateEstimate&, TrajectoryPoint>::value));
+  EXPECT_FALSE((std::is_constructible<NominalReferenceInputs,
+      const StateEstimate&, const TrajectoryPoint&, ReferenceInputsParameters>::value));
+  EXPECT_TRUE((std::is_constructible<AeroCompensatedReferenceInputs,
+      const StateEstimate&, const TrajectoryPoint&, const ReferenceInputsParameters&>::value));
+  EXPECT_FALSE((std::is_constructible<AeroCompensatedReferenceInputs,
+      StateEstimate, TrajectoryPoint, ReferenceInputsParameters>::value));
+}
+
+} /* namespace position_controller */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_reference_inputs_registry");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
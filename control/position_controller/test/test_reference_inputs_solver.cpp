@@ -0,0 +1,319 @@
+/**
+ *  @file   test_reference_inputs_solver.cpp
+ *  @brief  quadrotor position control's reusable reference inputs solver related functionality unit tests
+ *  @author thor
+ *  @date   26.11.2021
+ */
+#include "position_controller/reference_inputs_solver.h"
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+#include <unsupported/Eigen/AutoDiff>
+
+//  position_controller dependencies
+#include "position_controller/impl/reference_inputs_solver.hpp"
+#include "position_controller/reference_inputs.h"
+
+namespace position_controller {
+
+/**
+ *  @brief  Test fixture for testing the class ReferenceInputsSolver
+ *  @detail reference: https://google.github.io/googletest/primer.html
+ */
+class ReferenceInputsSolverTest : public ::testing::Test {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+ protected:
+
+      /////////////////////////////////////////////////////
+      ////////////  Constructors & Destructors  ///////////
+      /////////////////////////////////////////////////////
+
+  /**
+   *  @brief  ReferenceInputsSolverTest's default constructor, called for each test
+   *          to perform setup tasks
+   */
+  ReferenceInputsSolverTest() {}
+
+  /**
+   *  @brief  ReferenceInputsSolverTest's default destructor, called for each test
+   *          to perform cleanup tasks
+   */
+  ~ReferenceInputsSolverTest() override {}
+
+      ////////////////////////////////////////
+      ////////////  Class Members  ///////////
+      ////////////////////////////////////////
+
+  //  @brief  Tolerance for the reference inputs
+  const double kTolerance_ = 1e-9;
+
+  ReferenceInputsSolver solver;
+  quadrotor_common::QuadrotorStateEstimate state_estimate;
+  quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+  quadrotor_common::QuadrotorControlCommand reference_inputs;
+
+}; /*  class ReferenceInputsSolverTest  */
+
+/**
+ *  @brief  Test case to check the reference inputs of a hover point with rotating heading
+ */
+TEST_F(ReferenceInputsSolverTest, HoverTest) {
+  reference_state.heading = 0.7;
+  reference_state.heading_rate = 0.3;
+
+  solver.solve(state_estimate, reference_state, reference_inputs);
+
+  const Eigen::Quaterniond q_gt(
+      Eigen::AngleAxisd(reference_state.heading, Eigen::Vector3d::UnitZ()));
+  EXPECT_NEAR(0.0, q_gt.angularDistance(reference_inputs.orientation), kTolerance_);
+  EXPECT_NEAR(9.81, reference_inputs.collective_thrust, kTolerance_);
+  EXPECT_TRUE(reference_inputs.bodyrates.isApprox(
+      Eigen::Vector3d(0.0, 0.0, reference_state.heading_rate), kTolerance_));
+  EXPECT_NEAR(0.0, reference_inputs.angular_acceleration.norm(), kTolerance_);
+}
+
+/**
+ *  @brief  Test case to check if solve() writes in place and keeps the command metadata
+ */
+TEST_F(ReferenceInputsSolverTest, InPlaceOutputTest) {
+  reference_inputs.control_mode =
+      quadrotor_common::QuadrotorControlCommand::ControlMode::kBodyrates;
+  reference_state.acceleration = Eigen::Vector3d(1.0, 0.0, 0.0);
+
+  solver.solve(state_estimate, reference_state, reference_inputs);
+
+  EXPECT_EQ(quadrotor_common::QuadrotorControlCommand::ControlMode::kBodyrates,
+            reference_inputs.control_mode);
+  EXPECT_NEAR(std::sqrt(1.0 + 9.81*9.81), reference_inputs.collective_thrust, kTolerance_);
+}
+
+/**
+ *  @brief  Test case to check if a reused solver matches the one-shot ReferenceInputs
+ */
+TEST_F(ReferenceInputsSolverTest, ReuseMatchesReferenceInputsTest) {
+  for (int i = 0; i < 10; ++i) {
+    reference_state.heading = 0.3 * i;
+    reference_state.velocity = Eigen::Vector3d(1.0, -0.5 * i, 0.2);
+    reference_state.acceleration = Eigen::Vector3d(0.1 * i, 1.0, -2.0);
+    reference_state.jerk = Eigen::Vector3d(0.5, 0.1 * i, 0.0);
+    reference_state.snap = Eigen::Vector3d(0.0, 0.3, 0.1 * i);
+    reference_state.heading_rate = 0.05 * i;
+    reference_state.heading_acceleration = -0.02 * i;
+
+    solver.solve(state_estimate, reference_state, reference_inputs);
+    const ReferenceInputs one_shot(state_estimate, reference_state);
+
+    const quadrotor_common::QuadrotorControlCommand& expected =
+        one_shot.getReferenceInputs();
+    EXPECT_TRUE(expected.orientation.isApprox(reference_inputs.orientation));
+    EXPECT_DOUBLE_EQ(expected.collective_thrust, reference_inputs.collective_thrust);
+    EXPECT_TRUE(expected.bodyrates.isApprox(reference_inputs.bodyrates));
+    EXPECT_TRUE(expected.angular_acceleration.isApprox(reference_inputs.angular_acceleration));
+  }
+}
+
+/**
+ *  @brief  Test case to check if reset() makes solve() independent of the preceding calls,
+ *          i.e. equal to the one of a fresh solver, bit for bit
+ */
+TEST_F(ReferenceInputsSolverTest, ResetTest) {
+  reference_state.acceleration = Eigen::Vector3d(1.0, -0.5, 0.2);
+  reference_state.jerk = Eigen::Vector3d(0.5, 0.1, 0.0);
+  reference_state.heading_rate = 0.4;
+  for (int i = 0; i < 50; ++i) {
+    reference_state.heading = 0.0123 * i;
+    solver.solve(state_estimate, reference_state, reference_inputs);
+  } //  incremental heading frame updates
+
+  reference_state.heading = 0.0123 * 50;
+  ReferenceInputsSolver fresh;
+  quadrotor_common::QuadrotorControlCommand expected;
+  fresh.solve(state_estimate, reference_state, expected);
+  solver.reset();
+  solver.solve(state_estimate, reference_state, reference_inputs);
+
+  EXPECT_EQ(expected.orientation.coeffs(), reference_inputs.orientation.coeffs());
+  EXPECT_EQ(expected.collective_thrust, reference_inputs.collective_thrust);
+  EXPECT_EQ(expected.bodyrates, reference_inputs.bodyrates);
+  EXPECT_EQ(expected.angular_acceleration, reference_inputs.angular_acceleration);
+}
+
+/**
+ *  @brief  Test case to check if the rotor drag policies agree where their models overlap
+ */
+TEST_F(ReferenceInputsSolverTest, RotorDragModelsTest) {
+  ReferenceInputsSolver_<IsotropicRotorDrag> isotropic(IsotropicRotorDrag(0.3));
+  ReferenceInputsSolver_<AnisotropicRotorDrag> anisotropic_isotropic(
+      AnisotropicRotorDrag(0.3, 0.3, 0.3));
+  ReferenceInputsSolver_<AnisotropicRotorDrag> anisotropic_zero(
+      AnisotropicRotorDrag(0.0, 0.0, 0.0));
+
+  quadrotor_common::QuadrotorControlCommand expected;
+  for (int i = 0; i < 10; ++i) {
+    reference_state.heading = -0.4 * i;
+    reference_state.velocity = Eigen::Vector3d(2.0, 0.5 * i, -0.3);
+    reference_state.acceleration = Eigen::Vector3d(-0.2 * i, 1.5, 0.5);
+    reference_state.jerk = Eigen::Vector3d(0.1 * i, -0.4, 0.2);
+    reference_state.snap = Eigen::Vector3d(0.3, 0.0, -0.1 * i);
+    reference_state.heading_rate = -0.1 * i;
+    reference_state.heading_acceleration = 0.03 * i;
+
+    //  isotropic rotor drag is anisotropic rotor drag with dx = dy = dz
+    isotropic.solve(state_estimate, reference_state, reference_inputs);
+    anisotropic_isotropic.solve(state_estimate, reference_state, expected);
+    EXPECT_TRUE(expected.orientation.isApprox(reference_inputs.orientation, kTolerance_));
+    EXPECT_NEAR(expected.collective_thrust, reference_inputs.collective_thrust, kTolerance_);
+    EXPECT_TRUE(expected.bodyrates.isApprox(reference_inputs.bodyrates, kTolerance_));
+    EXPECT_TRUE(expected.angular_acceleration.isApprox(
+        reference_inputs.angular_acceleration, kTolerance_));
+
+    //  no rotor drag is anisotropic rotor drag with dx = dy = dz = 0
+    solver.solve(state_estimate, reference_state, reference_inputs);
+    anisotropic_zero.solve(state_estimate, reference_state, expected);
+    EXPECT_TRUE(expected.orientation.isApprox(reference_inputs.orientation, kTolerance_));
+    EXPECT_NEAR(expected.collective_thrust, reference_inputs.collective_thrust, kTolerance_);
+    EXPECT_TRUE(expected.bodyrates.isApprox(reference_inputs.bodyrates, kTolerance_));
+    EXPECT_TRUE(expected.angular_acceleration.isApprox(
+        reference_inputs.angular_acceleration, kTolerance_));
+  }
+}
+
+/**
+ *  @brief  Test case to check if the body frame xi kernel matches the matrix form kernel
+ */
+TEST_F(ReferenceInputsSolverTest, XiKernelsTest) {
+  const AnisotropicRotorDrag rotor_drag(0.4, 0.3, 0.1);
+  ReferenceInputsSolver_<AnisotropicRotorDrag, XiKernel::kMatrixForm> matrix_form(
+      rotor_drag);
+  ReferenceInputsSolver_<AnisotropicRotorDrag, XiKernel::kBodyFrame> body_frame(
+      rotor_drag);
+
+  quadrotor_common::QuadrotorControlCommand expected;
+  for (int i = 0; i < 10; ++i) {
+    reference_state.heading = 0.6 * i;
+    reference_state.velocity = Eigen::Vector3d(-1.0, 0.8 * i, 0.5);
+    reference_state.acceleration = Eigen::Vector3d(0.4 * i, -2.0, 1.0);
+    reference_state.jerk = Eigen::Vector3d(-0.3, 0.2 * i, 0.7);
+    reference_state.snap = Eigen::Vector3d(0.1 * i, -0.5, 0.2);
+    reference_state.heading_rate = 0.2 * i;
+    reference_state.heading_acceleration = -0.05 * i;
+
+    matrix_form.solve(state_estimate, reference_state, expected);
+    body_frame.solve(state_estimate, reference_state, reference_inputs);
+    EXPECT_TRUE(expected.orientation.isApprox(reference_inputs.orientation, kTolerance_));
+    EXPECT_NEAR(expected.collective_thrust, reference_inputs.collective_thrust, kTolerance_);
+    EXPECT_TRUE(expected.bodyrates.isApprox(reference_inputs.bodyrates, kTolerance_));
+    EXPECT_TRUE(expected.angular_acceleration.isApprox(
+        reference_inputs.angular_acceleration, kTolerance_));
+  }
+}
+
+/**
+ *  @brief  Test case to check if the float pipeline matches the double pipeline
+ */
+TEST_F(ReferenceInputsSolverTest, FloatMatchesDoubleTest) {
+  const AnisotropicRotorDrag rotor_drag(0.4, 0.3, 0.1);
+  ReferenceInputsSolver_<AnisotropicRotorDrag> solver_d(rotor_drag);
+  ReferenceInputsSolver_<AnisotropicRotorDragf> solver_f(
+      AnisotropicRotorDragf(0.4f, 0.3f, 0.1f));
+
+  quadrotor_common::QuadrotorControlCommandf reference_inputs_f;
+  for (int i = 0; i < 10; ++i) {
+    reference_state.heading = 0.5 * i;
+    reference_state.velocity = Eigen::Vector3d(1.5, -0.2 * i, 0.4);
+    reference_state.acceleration = Eigen::Vector3d(-0.3 * i, 0.8, 1.2);
+    reference_state.jerk = Eigen::Vector3d(0.2, -0.1 * i, 0.3);
+    reference_state.snap = Eigen::Vector3d(-0.4, 0.1 * i, 0.0);
+    reference_state.heading_rate = 0.1 * i;
+    reference_state.heading_acceleration = 0.04 * i;
+
+    solver_d.solve(state_estimate, reference_state, reference_inputs);
+    solver_f.solve(state_estimate.cast<float>(), reference_state.cast<float>(),
+                   reference_inputs_f);
+    EXPECT_NEAR(0.0, reference_inputs.orientation.angularDistance(
+        reference_inputs_f.orientation.cast<double>()), 1e-5);
+    EXPECT_NEAR(reference_inputs.collective_thrust, reference_inputs_f.collective_thrust, 1e-4);
+    EXPECT_LT((reference_inputs.bodyrates - reference_inputs_f.bodyrates.cast<double>()).norm(),
+              1e-4);
+    EXPECT_LT((reference_inputs.angular_acceleration -
+               reference_inputs_f.angular_acceleration.cast<double>()).norm(), 1e-4);
+  }
+}
+
+/**
+ *  @brief  Test case to check the angular accelerations against the automatic differentiation
+ *          of the bodyrates along the reference trajectory, i.e. d/dt of the flatness
+ *          equations evaluated with dual numbers
+ */
+TEST_F(ReferenceInputsSolverTest, AutoDiffBodyratesDerivativeTest) {
+  typedef Eigen::AutoDiffScalar<Eigen::Matrix<double, 1, 1>> Dual;
+  typedef Eigen::Matrix<Dual, 3, 1> DualVector3;
+  auto dual = [](const double value, const double derivative) {
+    return Dual(value, Eigen::Matrix<double, 1, 1>(derivative));
+  };
+  auto dual_vector = [&](const Eigen::Vector3d& value, const Eigen::Vector3d& derivative) {
+    return DualVector3(dual(value.x(), derivative.x()), dual(value.y(), derivative.y()),
+                       dual(value.z(), derivative.z()));
+  };
+
+  ReferenceInputsSolver_<AnisotropicRotorDrag_<Dual>> solver_dual(
+      AnisotropicRotorDrag_<Dual>(Dual(0.4), Dual(0.3), Dual(0.1)));
+  ReferenceInputsSolver_<AnisotropicRotorDrag> solver_d(
+      AnisotropicRotorDrag(0.4, 0.3, 0.1));
+
+  const quadrotor_common::QuadrotorStateEstimate_<Dual> state_estimate_dual =
+      state_estimate.cast<Dual>();
+  quadrotor_common::QuadrotorTrajectoryPoint_<Dual> reference_state_dual;
+  quadrotor_common::QuadrotorControlCommand_<Dual> reference_inputs_dual;
+  for (int i = 0; i < 10; ++i) {
+    reference_state.heading = 0.4 * i;
+    reference_state.velocity = Eigen::Vector3d(0.7, 0.3 * i, -0.6);
+    reference_state.acceleration = Eigen::Vector3d(0.2 * i, -1.1, 0.9);
+    reference_state.jerk = Eigen::Vector3d(-0.5, 0.4, 0.1 * i);
+    reference_state.snap = Eigen::Vector3d(0.3 * i, 0.2, -0.6);
+    reference_state.heading_rate = 0.15 * i;
+    reference_state.heading_acceleration = -0.07 * i;
+
+    //  seed the time derivatives of the flat outputs
+    reference_state_dual.heading = dual(reference_state.heading, reference_state.heading_rate);
+    reference_state_dual.heading_rate = dual(reference_state.heading_rate,
+                                             reference_state.heading_acceleration);
+    reference_state_dual.heading_acceleration = dual(reference_state.heading_acceleration, 0.0);
+    reference_state_dual.velocity = dual_vector(reference_state.velocity,
+                                                reference_state.acceleration);
+    reference_state_dual.acceleration = dual_vector(reference_state.acceleration,
+                                                    reference_state.jerk);
+    reference_state_dual.jerk = dual_vector(reference_state.jerk, reference_state.snap);
+    reference_state_dual.snap = dual_vector(reference_state.snap, Eigen::Vector3d::Zero());
+
+    solver_d.solve(state_estimate, reference_state, reference_inputs);
+    solver_dual.solve(state_estimate_dual, reference_state_dual, reference_inputs_dual);
+
+    for (int axis = 0; axis < 3; ++axis) {
+      EXPECT_NEAR(reference_inputs.bodyrates[axis],
+                  reference_inputs_dual.bodyrates[axis].value(), kTolerance_);
+      EXPECT_NEAR(reference_inputs.angular_acceleration[axis],
+                  reference_inputs_dual.bodyrates[axis].derivatives()[0], 1e-6);
+    }
+  }
+}
+
+} /*  namespace position_controller  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_reference_inputs_solver");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
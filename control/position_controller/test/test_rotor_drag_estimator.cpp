@@ -0,0 +1,222 @@
+/**
+ *  @file   test_rotor_drag_estimator.cpp
+ *  @brief  quadrotor position control's online rotor drag identification related functionality unit tests
+ *  @author thor
+ *  @date   18.12.2021
+ */
+#include "position_controller/rotor_drag_estimator.h"
+
+//  std dependencies
+#include <cmath>
+#include <random>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+//  position_controller dependencies
+#include "position_controller/position_controller.h"
+#include "position_controller/reference_inputs_solver.h"
+
+namespace position_controller {
+
+/**
+ *  @brief  Test fixture for testing the class RotorDragEstimator
+ *  @detail reference: https://google.github.io/googletest/primer.html
+ */
+class RotorDragEstimatorTest : public ::testing::Test {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+ protected:
+
+      /////////////////////////////////////////////////////
+      ////////////  Constructors & Destructors  ///////////
+      /////////////////////////////////////////////////////
+
+  /**
+   *  @brief  RotorDragEstimatorTest's default constructor, called for each test
+   *          to perform setup tasks
+   */
+  RotorDragEstimatorTest() : solver(AnisotropicRotorDrag(0.4, 0.3, 0.1)) {}
+
+  /**
+   *  @brief  RotorDragEstimatorTest's default destructor, called for each test
+   *          to perform cleanup tasks
+   */
+  ~RotorDragEstimatorTest() override {}
+
+      ////////////////////////////////////////
+      ////////////  Class Methods  ///////////
+      ////////////////////////////////////////
+
+  /**
+   *  @brief  The reference state of a 2m radius circle at 1.5 rad/s, climbing and sinking 0.5m
+   *          at 3 rad/s, heading fixed, i.e. all body axes see the velocity
+   */
+  static void sample(const double t, quadrotor_common::QuadrotorTrajectoryPoint& point) {
+    const double w = 1.5, c = std::cos(w * t), s = std::sin(w * t);
+    const double cz = std::cos(2.0 * w * t), sz = std::sin(2.0 * w * t);
+    point.position = Eigen::Vector3d(2.0 * c, 2.0 * s, 1.0 + 0.5 * sz);
+    point.velocity = Eigen::Vector3d(-2.0 * w * s, 2.0 * w * c, w * cz);
+    point.acceleration = Eigen::Vector3d(-2.0 * w * w * c, -2.0 * w * w * s, -2.0 * w * w * sz);
+    point.jerk = Eigen::Vector3d(2.0 * w * w * w * s, -2.0 * w * w * w * c, -4.0 * w * w * w * cz);
+    point.snap = Eigen::Vector3d(2.0 * w * w * w * w * c, 2.0 * w * w * w * w * s, 8.0 * w * w * w * w * sz);
+  }
+
+  /**
+   *  @brief  The true state estimate at t and the thrust in the middle of the preceding interval,
+   *          i.e. the flight of the trajectory with the solver's rotor drag
+   */
+  void fly(const double t, const double dt) {
+    sample(t, reference_state);
+    solver.solve(state_estimate, reference_state, reference_inputs);
+    state_estimate.position = reference_state.position;
+    state_estimate.velocity = reference_state.velocity;
+    state_estimate.orientation = reference_inputs.orientation;
+
+    sample(t - 0.5 * dt, reference_state);
+    solver.solve(state_estimate, reference_state, reference_inputs);
+    collective_thrust = reference_inputs.collective_thrust;
+  }
+
+      ////////////////////////////////////////
+      ////////////  Class Members  ///////////
+      ////////////////////////////////////////
+
+  //  @brief  The true rotor drag of the flights
+  ReferenceInputsSolver_<AnisotropicRotorDrag> solver;
+
+  RotorDragMailbox rotor_drags;
+  quadrotor_common::QuadrotorStateEstimate state_estimate;
+  quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+  quadrotor_common::QuadrotorControlCommand reference_inputs;
+  double collective_thrust = 0.0;
+
+}; /*  class RotorDragEstimatorTest  */
+
+/**
+ *  @brief  Noise free, the estimate converges to the true rotor drag up to the sampling error
+ */
+TEST_F(RotorDragEstimatorTest, Converges) {
+  RotorDragEstimator estimator(RotorDragEstimatorParameters(), rotor_drags);
+  constexpr double kDt = 0.01;
+
+  fly(0.0, kDt);
+  EXPECT_FALSE(estimator.update(state_estimate, collective_thrust, kDt));
+  for (int k = 1; k <= 1000; ++k) {
+    fly(k * kDt, kDt);
+    ASSERT_TRUE(estimator.update(state_estimate, collective_thrust, kDt));
+  }
+
+  const RotorDragEstimate& estimate = estimator.estimate();
+  EXPECT_EQ(1000u, estimate.samples);
+  EXPECT_NEAR(0.4, estimate.rotor_drag.x(), 1e-3);
+  EXPECT_NEAR(0.3, estimate.rotor_drag.y(), 1e-3);
+  EXPECT_NEAR(0.1, estimate.rotor_drag.z(), 1e-3);
+  EXPECT_LT(estimate.variance.maxCoeff(), 1e-2);
+}
+
+/**
+ *  @brief  With white velocity noise the difference quotient is noisy but uncorrelated with the
+ *          midpoint velocity, the attenuation by the noise in the regressor is below 1e-5 at
+ *          0.01 m/s, i.e. the estimate is within its sampling error of the true rotor drag
+ */
+TEST_F(RotorDragEstimatorTest, Noise) {
+  RotorDragEstimatorParameters parameters;
+  parameters.forgetting_factor = 0.9999;
+  RotorDragEstimator estimator(parameters, rotor_drags);
+  std::mt19937_64 generator(3);
+  std::normal_distribution<double> normal(0.0, 0.01);
+  auto noise = [&]() { return normal(generator); };
+  constexpr double kDt = 0.01;
+
+  for (int k = 0; k <= 6000; ++k) {
+    fly(k * kDt, kDt);
+    state_estimate.velocity += Eigen::Vector3d::NullaryExpr(noise);
+    estimator.update(state_estimate, collective_thrust, kDt);
+  }
+
+  const RotorDragEstimate& estimate = estimator.estimate();
+  EXPECT_NEAR(0.4, estimate.rotor_drag.x(), 2e-2);
+  EXPECT_NEAR(0.3, estimate.rotor_drag.y(), 2e-2);
+  EXPECT_NEAR(0.1, estimate.rotor_drag.z(), 2e-2);
+}
+
+/**
+ *  @brief  While hovering no axis is excited, the estimate keeps the prior and the variance is bounded
+ */
+TEST_F(RotorDragEstimatorTest, Hover) {
+  RotorDragEstimatorParameters parameters;
+  parameters.forgetting_factor = 0.99;
+  parameters.initial_rotor_drag = Eigen::Vector3d(0.2, 0.2, 0.05);
+  parameters.max_variance = 10.0;
+  RotorDragEstimator estimator(parameters, rotor_drags);
+
+  for (int k = 0; k <= 1000; ++k) {
+    estimator.update(state_estimate, 9.81, 0.01);
+  }
+
+  const RotorDragEstimate& estimate = estimator.estimate();
+  EXPECT_EQ(parameters.initial_rotor_drag, estimate.rotor_drag);
+  EXPECT_EQ(Eigen::Vector3d::Constant(10.0), estimate.variance);
+
+  estimator.reset();
+  EXPECT_EQ(0u, estimator.estimate().samples);
+  EXPECT_EQ(Eigen::Vector3d::Constant(1.0), estimator.estimate().variance);
+  EXPECT_FALSE(estimator.update(state_estimate, 9.81, 0.01));
+}
+
+/**
+ *  @brief  Every publish_decimation samples the estimate is published, the control thread's
+ *          controller takes it from the mailbox and tracks with the identified rotor drag
+ */
+TEST_F(RotorDragEstimatorTest, Publish) {
+  RotorDragEstimatorParameters parameters;
+  parameters.publish_decimation = 10;
+  RotorDragEstimator estimator(parameters, rotor_drags);
+  PositionController_<AnisotropicRotorDrag> position_controller;
+  constexpr double kDt = 0.01;
+
+  for (int k = 0; k <= 9; ++k) {
+    fly(k * kDt, kDt);
+    estimator.update(state_estimate, collective_thrust, kDt);
+  }
+  EXPECT_FALSE(rotor_drags.poll());
+  fly(10 * kDt, kDt);
+  estimator.update(state_estimate, collective_thrust, kDt);
+  ASSERT_TRUE(rotor_drags.poll());
+  EXPECT_EQ(10u, rotor_drags.value().samples);
+  EXPECT_EQ(estimator.estimate().rotor_drag, rotor_drags.value().rotor_drag);
+
+  for (int k = 11; k <= 1000; ++k) {
+    fly(k * kDt, kDt);
+    estimator.update(state_estimate, collective_thrust, kDt);
+  }
+  ASSERT_TRUE(rotor_drags.poll());
+  position_controller.setRotorDrag(rotor_drags.value().rotorDrag());
+  EXPECT_EQ(rotor_drags.value().rotor_drag.cwiseMax(0.0), position_controller.rotorDrag().d);
+
+  sample(10.0, reference_state);
+  solver.solve(state_estimate, reference_state, reference_inputs);
+  const quadrotor_common::QuadrotorControlCommand command = position_controller.run(state_estimate, reference_state);
+  EXPECT_NEAR(reference_inputs.collective_thrust, command.collective_thrust, 1e-2);
+  EXPECT_NEAR(0.0, reference_inputs.orientation.angularDistance(command.orientation), 1e-3);
+}
+
+} /*  namespace position_controller  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_rotor_drag_estimator");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
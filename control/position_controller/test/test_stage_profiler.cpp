@@ -0,0 +1,157 @@
+/**
+ *  @file   test_stage_profiler.cpp
+ *  @brief  quadrotor position control's per stage latency instrumentation related functionality unit tests
+ *  @author thor
+ *  @date   08.12.2021
+ */
+#include "position_controller/stage_profiler.h"
+
+//  std dependencies
+#include <cstdint>
+#include <thread>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+//  position_controller dependencies
+#include "position_controller/reference_inputs_solver.h"
+#include "reference_inputs/nominal_reference_inputs.h"
+
+namespace position_controller {
+
+/**
+ *  @brief  Test case to check the histogram, i.e. counts, bucketing and quantiles
+ */
+TEST(StageProfilerTest, HistogramTest) {
+  StageProfiler::reset();
+  StageProfiler::record(Stage::kBodyrates, 0);
+  StageProfiler::record(Stage::kBodyrates, 1);
+  StageProfiler::record(Stage::kBodyrates, 100);
+  StageProfiler::record(Stage::kBodyrates, 1000);
+
+  const StageStatistics statistics = StageProfiler::statistics(Stage::kBodyrates);
+  EXPECT_EQ(4u, statistics.count);
+  EXPECT_EQ(1101u, statistics.total_cycles);
+  EXPECT_EQ(1000u, statistics.max_cycles);
+  EXPECT_DOUBLE_EQ(275.25, statistics.meanCycles());
+  EXPECT_EQ(1u, statistics.buckets[0]);
+  EXPECT_EQ(1u, statistics.buckets[1]);
+  EXPECT_EQ(1u, statistics.buckets[7]);   //  [64, 128)
+  EXPECT_EQ(1u, statistics.buckets[10]);  //  [512, 1024)
+  EXPECT_EQ(0u, statistics.quantileCycles(0.25));
+  EXPECT_EQ(127u, statistics.quantileCycles(0.75));
+  EXPECT_EQ(1000u, statistics.quantileCycles(1.0));
+  EXPECT_EQ(0u, StageProfiler::statistics(Stage::kOrientation).count);
+
+  StageProfiler::reset();
+  EXPECT_EQ(0u, StageProfiler::statistics(Stage::kBodyrates).count);
+}
+
+/**
+ *  @brief  Test case to check if the histograms of all threads are summed up,
+ *          including the ones of exited threads
+ */
+TEST(StageProfilerTest, PerThreadTest) {
+  constexpr int kThreads = 4;
+  constexpr int kRecords = 1000;
+  StageProfiler::reset();
+
+  std::thread threads[kThreads];
+  for (std::thread& thread : threads) {
+    thread = std::thread([]() {
+      for (int i = 0; i < kRecords; ++i) {
+        const StageTimer timer(Stage::kAngularAcceleration);
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  {
+    const StageTimer timer(Stage::kAngularAcceleration);
+  }
+
+  const StageStatistics statistics = StageProfiler::statistics(Stage::kAngularAcceleration);
+  EXPECT_EQ(static_cast<std::uint64_t>(kThreads * kRecords + 1), statistics.count);
+  std::uint64_t count = 0;
+  for (const std::uint64_t bucket : statistics.buckets) {
+    count += bucket;
+  }
+  EXPECT_EQ(statistics.count, count);
+}
+
+/**
+ *  @brief  Test case to check if a registered thread records as an unregistered one
+ */
+TEST(StageProfilerTest, RegisterThreadTest) {
+  StageProfiler::reset();
+  std::thread thread([]() {
+    StageProfiler::registerThread();
+    StageProfiler::registerThread();
+    StageProfiler::record(Stage::kOrientation, 100);
+    StageProfiler::record(Stage::kOrientation, 300);
+  });
+  thread.join();
+
+  const StageStatistics statistics = StageProfiler::statistics(Stage::kOrientation);
+  EXPECT_EQ(2u, statistics.count);
+  EXPECT_EQ(400u, statistics.total_cycles);
+  EXPECT_EQ(300u, statistics.max_cycles);
+}
+
+/**
+ *  @brief  Test case to check if the pipelines record every stage and the singular branches,
+ *          if instrumented, and nothing otherwise
+ */
+TEST(StageProfilerTest, PipelineTest) {
+  quadrotor_common::QuadrotorStateEstimate state_estimate;
+  quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+  reference_state.velocity = Eigen::Vector3d(1.0, 0.0, 0.0);
+  quadrotor_common::QuadrotorTrajectoryPoint free_fall_state;
+  free_fall_state.acceleration = Eigen::Vector3d(0.0, 0.0, -9.81);  //  alpha = beta = 0
+  quadrotor_common::QuadrotorControlCommand reference_inputs;
+  const std::uint64_t expected = StageProfiler::enabled() ? 1 : 0;
+
+  StageProfiler::reset();
+  ReferenceInputsSolver solver;
+  solver.solve(state_estimate, reference_state, reference_inputs);
+  EXPECT_EQ(expected, StageProfiler::statistics(Stage::kOrientation).count);
+  EXPECT_EQ(expected, StageProfiler::statistics(Stage::kCollectiveThrust).count);
+  EXPECT_EQ(expected, StageProfiler::statistics(Stage::kBodyrates).count);
+  EXPECT_EQ(expected, StageProfiler::statistics(Stage::kAngularAcceleration).count);
+  EXPECT_EQ(0u, StageProfiler::statistics(Stage::kBodyXAxisSingularity).count);
+  EXPECT_EQ(0u, StageProfiler::statistics(Stage::kBodyYAxisSingularity).count);
+
+  solver.solve(state_estimate, free_fall_state, reference_inputs);
+  EXPECT_EQ(expected, StageProfiler::statistics(Stage::kBodyXAxisSingularity).count);
+  EXPECT_EQ(expected, StageProfiler::statistics(Stage::kBodyYAxisSingularity).count);
+
+  StageProfiler::reset();
+  const NominalReferenceInputs nominal(state_estimate, free_fall_state);
+  nominal.computeReferenceInputs(reference_inputs);
+  EXPECT_EQ(expected, StageProfiler::statistics(Stage::kOrientation).count);
+  EXPECT_EQ(expected, StageProfiler::statistics(Stage::kCollectiveThrust).count);
+  EXPECT_EQ(expected, StageProfiler::statistics(Stage::kBodyrates).count);
+  EXPECT_EQ(0u, StageProfiler::statistics(Stage::kAngularAcceleration).count);
+  EXPECT_EQ(expected, StageProfiler::statistics(Stage::kBodyXAxisSingularity).count);
+  EXPECT_EQ(expected, StageProfiler::statistics(Stage::kBodyYAxisSingularity).count);
+}
+
+} /*  namespace position_controller  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_stage_profiler");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,76 @@
+/**
+ *  @file   benchmark_monte_carlo.cpp
+ *  @brief  quadrotor's closed loop Monte Carlo campaign related functionality benchmarks
+ *  @author thor
+ *  @date   15.12.2021
+ */
+#include "quadrotor_simulator/monte_carlo.h"
+
+//  std dependencies
+#include <cmath>
+#include <thread>
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+
+namespace quadrotor_simulator {
+
+namespace {
+
+/**
+ *  @brief  2m radius circle at 1 rad/s
+ */
+void circle(const double time, quadrotor_common::QuadrotorTrajectoryPoint& point) {
+  point = quadrotor_common::QuadrotorTrajectoryPoint();
+  const double c = std::cos(time), s = std::sin(time);
+  point.position = Eigen::Vector3d(2.0 * c, 2.0 * s, 1.0);
+  point.velocity = Eigen::Vector3d(-2.0 * s, 2.0 * c, 0.0);
+  point.acceleration = Eigen::Vector3d(-2.0 * c, -2.0 * s, 0.0);
+  point.jerk = Eigen::Vector3d(2.0 * s, -2.0 * c, 0.0);
+  point.snap = Eigen::Vector3d(2.0 * c, 2.0 * s, 0.0);
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  QuadrotorDynamics::step(), one Runge Kutta 4 step of the control period
+ */
+static void BM_QuadrotorDynamicsStep(benchmark::State& state) {
+  QuadrotorDynamicsParameters parameters;
+  parameters.rotor_drag = Eigen::Vector3d(0.3, 0.3, 0.1);
+  QuadrotorDynamics dynamics(parameters);
+  quadrotor_common::QuadrotorControlCommand command;
+  command.collective_thrust = 9.81;
+
+  for (auto _ : state) {
+    dynamics.step(command, 0.001);
+    benchmark::DoNotOptimize(&dynamics.state());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QuadrotorDynamicsStep);
+
+/**
+ *  @brief  A campaign of 5 s flights at 1 kHz on 1, 2, 4, ... threads up to the number of cores
+ */
+static void BM_MonteCarloCampaign(benchmark::State& state) {
+  constexpr std::size_t kRuns = 16;
+  MonteCarloParameters parameters;
+  parameters.num_threads = state.range(0);
+  MonteCarloCampaign campaign(parameters, circle);
+  MonteCarloRuns runs;
+
+  std::size_t first = 0;
+  for (auto _ : state) {
+    campaign.run(first, kRuns, runs);
+    first += kRuns;
+  }
+  state.SetItemsProcessed(state.iterations() * kRuns);
+}
+BENCHMARK(BM_MonteCarloCampaign)
+    ->RangeMultiplier(2)
+    ->Range(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} /*  namespace quadrotor_simulator  */
@@ -0,0 +1,64 @@
+/**
+ *  @file   benchmark_parameter_sweep.cpp
+ *  @brief  quadrotor's closed loop rotor drag and gain parameter sweep related functionality benchmarks
+ *  @author thor
+ *  @date   17.12.2021
+ */
+#include "quadrotor_simulator/parameter_sweep.h"
+
+//  std dependencies
+#include <cmath>
+#include <thread>
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+
+namespace quadrotor_simulator {
+
+namespace {
+
+/**
+ *  @brief  2m radius circle at 2 rad/s
+ */
+void circle(const double time, quadrotor_common::QuadrotorTrajectoryPoint& point) {
+  point = quadrotor_common::QuadrotorTrajectoryPoint();
+  const double c = std::cos(2.0 * time), s = std::sin(2.0 * time);
+  point.position = Eigen::Vector3d(2.0 * c, 2.0 * s, 1.0);
+  point.velocity = Eigen::Vector3d(-4.0 * s, 4.0 * c, 0.0);
+  point.acceleration = Eigen::Vector3d(-8.0 * c, -8.0 * s, 0.0);
+  point.jerk = Eigen::Vector3d(16.0 * s, -16.0 * c, 0.0);
+  point.snap = Eigen::Vector3d(32.0 * c, 32.0 * s, 0.0);
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  A Latin hypercube design of one lap flights at 1 kHz on 1, 2, 4, ... threads up to the
+ *          number of cores, the sweep built once, i.e. its simulations and reference table reused
+ */
+static void BM_ParameterSweep(benchmark::State& state) {
+  constexpr std::size_t kPoints = 64;
+  ParameterSweepParameters parameters;
+  parameters.num_threads = state.range(0);
+  parameters.flight.duration = M_PI;
+  parameters.plant.rotor_drag = Eigen::Vector3d(0.4, 0.4, 0.1);
+  ParameterSweep sweep(parameters, circle);
+  SweepSpace space;
+  space.dx = {0.0, 1.0, 1};
+  space.dy = {0.0, 1.0, 1};
+  space.dz = {0.0, 0.5, 1};
+  const SweepPoints points = ParameterSweep::latinHypercube(space, kPoints, 1);
+  SweepResults results;
+
+  for (auto _ : state) {
+    sweep.run(points, results);
+  }
+  state.SetItemsProcessed(state.iterations() * kPoints);
+}
+BENCHMARK(BM_ParameterSweep)
+    ->RangeMultiplier(2)
+    ->Range(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} /*  namespace quadrotor_simulator  */
@@ -0,0 +1,80 @@
+/**
+ *  @file   benchmark_quadrotor_plant.cpp
+ *  @brief  quadrotor's headless rigid body plant related functionality benchmarks
+ *  @author thor
+ *  @date   16.12.2021
+ */
+#include "quadrotor_simulator/quadrotor_plant.h"
+
+//  std dependencies
+#include <cmath>
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+
+//  quadrotor_simulator dependencies
+#include "quadrotor_simulator/closed_loop_simulation.h"
+
+namespace quadrotor_simulator {
+
+namespace {
+
+/**
+ *  @brief  2m radius circle at 1 rad/s
+ */
+void circle(const double time, quadrotor_common::QuadrotorTrajectoryPoint& point) {
+  point = quadrotor_common::QuadrotorTrajectoryPoint();
+  const double c = std::cos(time), s = std::sin(time);
+  point.position = Eigen::Vector3d(2.0 * c, 2.0 * s, 1.0);
+  point.velocity = Eigen::Vector3d(-2.0 * s, 2.0 * c, 0.0);
+  point.acceleration = Eigen::Vector3d(-2.0 * c, -2.0 * s, 0.0);
+  point.jerk = Eigen::Vector3d(2.0 * s, -2.0 * c, 0.0);
+  point.snap = Eigen::Vector3d(2.0 * c, 2.0 * s, 0.0);
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  QuadrotorPlant::step(), the low level loops and one Runge Kutta 4 step per substep
+ */
+static void BM_QuadrotorPlantStep(benchmark::State& state) {
+  QuadrotorPlantParameters parameters;
+  parameters.rotor_drag = Eigen::Vector3d(0.3, 0.3, 0.1);
+  parameters.substeps = state.range(0);
+  QuadrotorPlant plant(parameters);
+  quadrotor_common::QuadrotorControlCommand command;
+  command.collective_thrust = 9.81;
+
+  for (auto _ : state) {
+    plant.step(command, 0.001);
+    benchmark::DoNotOptimize(&plant.state());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_QuadrotorPlantStep)->Arg(1)->Arg(4);
+
+/**
+ *  @brief  A 10 s flight at 1 kHz of the PositionController on the plant, the real time factor
+ *          is the simulated over the wall clock time
+ */
+static void BM_PlantSimulationFly(benchmark::State& state) {
+  FlightParameters parameters;
+  parameters.duration = 10.0;
+  PlantSimulation simulation(circle, parameters);
+  QuadrotorState initial;
+  initial.position = Eigen::Vector3d(2.0, 0.0, 1.0);
+  initial.velocity = Eigen::Vector3d(0.0, 2.0, 0.0);
+  initial.orientation = Eigen::Quaterniond::FromTwoVectors(
+      Eigen::Vector3d::UnitZ(), Eigen::Vector3d(-2.0, 0.0, 9.81).normalized());
+
+  for (auto _ : state) {
+    const FlightMetrics metrics = simulation.fly(QuadrotorPlantParameters(), initial);
+    benchmark::DoNotOptimize(&metrics);
+  }
+  state.SetItemsProcessed(state.iterations() * 10000);
+  state.counters["real_time_factor"] = benchmark::Counter(
+      state.iterations() * parameters.duration, benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_PlantSimulationFly)->Unit(benchmark::kMillisecond);
+
+} /*  namespace quadrotor_simulator  */
@@ -0,0 +1,192 @@
+/**
+ *  @file   closed_loop_simulation.h
+ *  @brief  quadrotor's closed loop flight simulation related functionality declaration & definition
+ *  @author thor
+ *  @date   15.12.2021
+ */
+#ifndef QUADROTOR_SIMULATOR_CLOSED_LOOP_SIMULATION_H
+#define QUADROTOR_SIMULATOR_CLOSED_LOOP_SIMULATION_H
+
+//  std dependencies
+#include <cstdint>
+#include <functional>
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+//  quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_control_command.h"
+#include "quadrotor_common/quadrotor_state_estimate.h"
+#include "quadrotor_common/quadrotor_trajectory_point.h"
+#include "quadrotor_common/uninitialized.h"
+
+//  position_controller dependencies
+#include "position_controller/position_controller.h"
+#include "position_controller/rotor_drag_models.h"
+
+//  quadrotor_simulator dependencies
+#include "quadrotor_simulator/quadrotor_dynamics.h"
+#include "quadrotor_simulator/quadrotor_plant.h"
+
+namespace quadrotor_simulator {
+
+/**
+ *  @brief  Standard deviations of the white noise on the state estimates
+ */
+struct EstimateNoise {
+  double position = 0.0;      //  [m]
+  double velocity = 0.0;      //  [m/s]
+  double orientation = 0.0;   //  [rad], about a random axis
+  double bodyrates = 0.0;     //  [rad/s]
+};  /*  struct EstimateNoise  */
+
+/**
+ *  @brief  Parameters of a closed loop flight
+ */
+struct FlightParameters {
+  //  @brief  Flight duration [s]
+  double duration = 5.0;
+
+  //  @brief  Control and integration period [s]
+  double control_period = 0.001;
+
+  //  @brief  Position error [m] beyond which the flight is aborted as diverged
+  double divergence_threshold = 1.0;
+
+  //  @brief  Gains of the PD outer loop onto the reference acceleration [1/s^2], [1/s], i.e. a
+  //          critically damped 2 rad/s loop well below the 10 rad/s attitude loop, 0 to fly
+  //          the feed forward terms of the PositionController only
+  double position_gain = 4.0;
+  double velocity_gain = 4.0;
+};  /*  struct FlightParameters  */
+
+/**
+ *  @brief  Tracking errors of a closed loop flight, of the true state w.r.t. the reference
+ */
+struct FlightMetrics {
+  //  @brief  Simulated time [s], shorter than the duration if diverged
+  double time = 0.0;
+  std::uint64_t ticks = 0;
+  bool diverged = false;
+
+  double max_position_error = 0.0;
+  double rms_position_error = 0.0;
+  double final_position_error = 0.0;
+  double rms_velocity_error = 0.0;
+};  /*  struct FlightMetrics  */
+
+/**
+ *  @brief  ClosedLoopSimulation_ class implementation
+ *  @detail Fly the PositionController in lockstep with the plant along a reference
+ *          trajectory: every control period the reference is sampled, the state estimate is
+ *          the true state with optional white noise, the controller's command is held for one
+ *          integration step. The PositionController computes the feed forward terms of the
+ *          reference only, so the simulation closes the position loop with a PD outer loop on
+ *          the state estimate, which adds
+ *            a_fb = k_p * (p_ref - p_est) + k_v * (v_ref - v_est)
+ *          to the reference acceleration before run(), see FlightParameters. An instance is
+ *          meant to be reused for many flights, e.g. one per worker of a Monte Carlo campaign,
+ *          every flight resets the controller, i.e. its outcome depends on its initial state,
+ *          noise seed and plant parameters only.
+ *  @tparam Plant           - QuadrotorDynamics, the ideal low level loops, or QuadrotorPlant, the
+ *                            rigid body with rotors, i.e. anything with Parameters, setParameters(),
+ *                            setState(), state(), stateEstimate() and step()
+ *  @tparam RotorDragModel  - rotor drag policy of the controller, see rotor_drag_models.h, i.e.
+ *                            the drag the controller assumes, the plant's drag is its parameter
+ */
+template <typename Plant, typename RotorDragModel = position_controller::NoRotorDrag>
+class ClosedLoopSimulation_ {
+ public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    //  @brief  Reference trajectory, sampled at the flight time [s], must be thread safe if shared
+    typedef std::function<void(double, quadrotor_common::QuadrotorTrajectoryPoint&)> ReferenceSampler;
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  ClosedLoopSimulation_'s default constructor, called when an instance is created
+     *  @param  reference   - the reference trajectory
+     *  @param  parameters  - flight duration, control period and divergence threshold
+     *  @param  rotor_drag  - rotor drag constants of the controller
+     */
+    ClosedLoopSimulation_(
+        const ReferenceSampler& reference,
+        const FlightParameters& parameters = FlightParameters(),
+        const RotorDragModel& rotor_drag = RotorDragModel());
+
+    /**
+     *  @brief  ClosedLoopSimulation_'s default destructor, called when an instance is destroyed
+     */
+    ~ClosedLoopSimulation_();
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Fly from the initial state
+     *  @param  dynamics  - plant parameters of this flight, e.g. perturbed rotor drag
+     *  @param  initial   - initial true state
+     *  @param  noise     - state estimate noise
+     *  @param  seed      - seed of the state estimate noise
+     *  @return the tracking errors of the flight
+     */
+    FlightMetrics fly(
+        const typename Plant::Parameters& dynamics,
+        const QuadrotorState& initial,
+        const EstimateNoise& noise = EstimateNoise(),
+        const std::uint64_t seed = 0);
+
+    /**
+     *  @brief  Accessors
+     */
+    const Plant& dynamics() const { return dynamics_; }
+    const FlightParameters& parameters() const { return parameters_; }
+    const RotorDragModel& rotorDrag() const { return rotor_drag_; }
+
+    /**
+     *  @brief  Set the rotor drag constants of the controller of the next flights
+     */
+    void setRotorDrag(const RotorDragModel& rotor_drag) { rotor_drag_ = rotor_drag; }
+
+ private:
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    const ReferenceSampler reference_;
+    const FlightParameters parameters_;
+    RotorDragModel rotor_drag_;
+
+    //  @brief  The controller under test, reset per flight, and the plant
+    position_controller::PositionController_<RotorDragModel> controller_;
+    Plant dynamics_;
+
+    //  @brief  The state estimate and the command of the current tick, written in place
+    quadrotor_common::QuadrotorStateEstimate state_estimate_;
+    quadrotor_common::QuadrotorControlCommand command_;
+
+};  /*  class ClosedLoopSimulation_  */
+
+extern template class ClosedLoopSimulation_<QuadrotorDynamics>;
+extern template class ClosedLoopSimulation_<QuadrotorPlant>;
+extern template class ClosedLoopSimulation_<QuadrotorDynamics, position_controller::AnisotropicRotorDrag>;
+extern template class ClosedLoopSimulation_<QuadrotorPlant, position_controller::AnisotropicRotorDrag>;
+
+typedef ClosedLoopSimulation_<QuadrotorDynamics> ClosedLoopSimulation;
+typedef ClosedLoopSimulation_<QuadrotorPlant> PlantSimulation;
+
+//  @brief  The plant flown by the rotor drag compensating controller
+typedef ClosedLoopSimulation_<QuadrotorPlant, position_controller::AnisotropicRotorDrag> CompensatedPlantSimulation;
+
+} /*  namespace quadrotor_simulator  */
+
+#endif  /*  QUADROTOR_SIMULATOR_CLOSED_LOOP_SIMULATION_H  */
@@ -0,0 +1,185 @@
+/**
+ *  @file   monte_carlo.h
+ *  @brief  quadrotor's closed loop Monte Carlo campaign related functionality declaration & definition
+ *  @author thor
+ *  @date   15.12.2021
+ */
+#ifndef QUADROTOR_SIMULATOR_MONTE_CARLO_H
+#define QUADROTOR_SIMULATOR_MONTE_CARLO_H
+
+//  std dependencies
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+//  position_controller dependencies
+#include "position_controller/thread_pool.h"
+
+//  quadrotor_simulator dependencies
+#include "quadrotor_simulator/closed_loop_simulation.h"
+
+namespace quadrotor_simulator {
+
+/**
+ *  @brief  Parameters of the MonteCarloCampaign
+ */
+struct MonteCarloParameters {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  //  @brief  Number of workers including the calling thread, and whether to pin them
+  int num_threads = 1;
+  bool pin_threads = false;
+
+  //  @brief  Campaign seed, the seed of each run follows from it and the run index
+  std::uint64_t seed = 1;
+
+  //  @brief  The flights and the nominal dynamics
+  FlightParameters flight;
+  QuadrotorDynamicsParameters dynamics;
+
+  //  @brief  Standard deviations of the initial state w.r.t. the reference at time 0
+  double position_sigma = 0.1;      //  [m]
+  double velocity_sigma = 0.1;      //  [m/s]
+  double orientation_sigma = 0.05;  //  [rad], about a random axis
+  double bodyrates_sigma = 0.1;     //  [rad/s]
+
+  //  @brief  Standard deviations of the rotor drag coefficients w.r.t. the nominal ones, the
+  //          perturbed coefficients are clamped to be non negative
+  Eigen::Vector3d rotor_drag_sigma = Eigen::Vector3d(0.1, 0.1, 0.05);
+
+  //  @brief  The state estimate noise of every flight
+  EstimateNoise estimate_noise = {0.01, 0.02, 0.005, 0.01};
+};  /*  struct MonteCarloParameters  */
+
+/**
+ *  @brief  The perturbations and the outcome of one run
+ */
+struct MonteCarloRun {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  std::uint64_t seed = 0;
+  Eigen::Vector3d rotor_drag = Eigen::Vector3d::Zero();
+  FlightMetrics metrics;
+};  /*  struct MonteCarloRun  */
+
+typedef std::vector<MonteCarloRun, Eigen::aligned_allocator<MonteCarloRun>> MonteCarloRuns;
+
+/**
+ *  @brief  Statistics of a campaign
+ */
+struct MonteCarloSummary {
+  std::size_t runs = 0;
+  std::size_t diverged = 0;
+
+  //  @brief  Statistics of the maximum position error of the runs [m]
+  double mean_max_position_error = 0.0;
+  double p50_max_position_error = 0.0;
+  double p95_max_position_error = 0.0;
+  double p99_max_position_error = 0.0;
+  double worst_max_position_error = 0.0;
+
+  //  @brief  Wall time of the campaign [s] and simulated flight time [s]
+  double seconds = 0.0;
+  double flight_seconds = 0.0;
+
+  double divergenceRate() const { return runs > 0 ? static_cast<double>(diverged) / runs : 0.0; }
+  double runsPerHour() const { return seconds > 0.0 ? 3600.0 * runs / seconds : 0.0; }
+  double realTimeFactor() const { return seconds > 0.0 ? flight_seconds / seconds : 0.0; }
+};  /*  struct MonteCarloSummary  */
+
+/**
+ *  @brief  MonteCarloCampaign class implementation
+ *  @detail Fly many closed loop flights (see ClosedLoopSimulation) along one reference with
+ *          perturbed initial states, rotor drag coefficients and state estimate noise. Run i is
+ *          seeded with a hash of the campaign seed and i, and all its randomness is drawn from
+ *          that seed, i.e. the outcome of a run does not depend on the number of threads or the
+ *          order in which the runs are taken, and any run can be reproduced on its own.
+ *          The runs are spread across the workers of a thread pool, each worker reusing its own
+ *          simulation and claiming the next run from a shared counter.
+ */
+class MonteCarloCampaign {
+ public:
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  MonteCarloCampaign's default constructor, called when an instance is created
+     *  @param  parameters  - perturbations, flights and workers
+     *  @param  reference   - the reference trajectory of all flights, sampled concurrently
+     */
+    MonteCarloCampaign(const MonteCarloParameters& parameters, const ClosedLoopSimulation::ReferenceSampler& reference);
+
+    /**
+     *  @brief  MonteCarloCampaign's default destructor, called when an instance is destroyed
+     */
+    ~MonteCarloCampaign();
+
+    MonteCarloCampaign(const MonteCarloCampaign&) = delete;
+    MonteCarloCampaign& operator=(const MonteCarloCampaign&) = delete;
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Fly the runs first, ..., first + n - 1 into runs[0, n)
+     *  @return the statistics of the runs
+     */
+    MonteCarloSummary run(const std::size_t first, const std::size_t n, MonteCarloRuns& runs);
+
+    /**
+     *  @brief  Fly the single run, e.g. to reproduce an outlier of a campaign
+     */
+    MonteCarloRun runOne(const std::size_t run);
+
+    /**
+     *  @brief  The seed of the run
+     */
+    std::uint64_t seed(const std::size_t run) const;
+
+    /**
+     *  @brief  Statistics of the runs, the wall time excluded
+     */
+    static MonteCarloSummary summarize(const MonteCarloRuns& runs);
+
+    /**
+     *  @brief  Accessors
+     */
+    int numThreads() const { return thread_pool_.size(); }
+    const MonteCarloParameters& parameters() const { return parameters_; }
+
+ private:
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Draw the perturbations of the run and fly it on the simulation
+     */
+    void fly(const std::size_t run, ClosedLoopSimulation& simulation, MonteCarloRun& result) const;
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    const MonteCarloParameters parameters_;
+    const ClosedLoopSimulation::ReferenceSampler reference_;
+
+    //  @brief  One simulation per worker
+    std::vector<std::unique_ptr<ClosedLoopSimulation>> simulations_;
+
+    //  @brief  The workers
+    position_controller::ThreadPool thread_pool_;
+
+};  /*  class MonteCarloCampaign  */
+
+} /*  namespace quadrotor_simulator  */
+
+#endif  /*  QUADROTOR_SIMULATOR_MONTE_CARLO_H  */
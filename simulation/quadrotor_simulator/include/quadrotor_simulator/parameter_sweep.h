@@ -0,0 +1,208 @@
+/**
+ *  @file   parameter_sweep.h
+ *  @brief  quadrotor's closed loop rotor drag and gain parameter sweep related functionality declaration & definition
+ *  @author thor
+ *  @date   17.12.2021
+ */
+#ifndef QUADROTOR_SIMULATOR_PARAMETER_SWEEP_H
+#define QUADROTOR_SIMULATOR_PARAMETER_SWEEP_H
+
+//  std dependencies
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+//  quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_trajectory_point.h"
+
+//  position_controller dependencies
+#include "position_controller/thread_pool.h"
+
+//  quadrotor_simulator dependencies
+#include "quadrotor_simulator/closed_loop_simulation.h"
+#include "quadrotor_simulator/quadrotor_plant.h"
+
+namespace quadrotor_simulator {
+
+/**
+ *  @brief  A point of the sweep, i.e. the tuned parameters of one flight
+ */
+struct SweepPoint {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  //  @brief  Rotor drag coefficients dx, dy, dz [1/s] of the controller's reference inputs
+  Eigen::Vector3d rotor_drag = Eigen::Vector3d::Zero();
+
+  //  @brief  Gains of the low level attitude and bodyrate loops [1/s], see QuadrotorPlant
+  double attitude_gain = 10.0;
+  double bodyrate_gain = 50.0;
+};  /*  struct SweepPoint  */
+
+typedef std::vector<SweepPoint, Eigen::aligned_allocator<SweepPoint>> SweepPoints;
+
+/**
+ *  @brief  Range of a swept parameter, count values evenly spaced in [min, max] for a grid
+ */
+struct SweepRange {
+  double min = 0.0;
+  double max = 0.0;
+  int count = 1;
+};  /*  struct SweepRange  */
+
+/**
+ *  @brief  The swept parameter space, a range per parameter of the SweepPoint
+ */
+struct SweepSpace {
+  SweepRange dx;
+  SweepRange dy;
+  SweepRange dz;
+  SweepRange attitude_gain = {10.0, 10.0, 1};
+  SweepRange bodyrate_gain = {50.0, 50.0, 1};
+};  /*  struct SweepSpace  */
+
+/**
+ *  @brief  The outcome of a point
+ */
+struct SweepResult {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  //  @brief  Index of the point in the swept points
+  std::size_t index = 0;
+  SweepPoint point;
+  FlightMetrics metrics;
+};  /*  struct SweepResult  */
+
+typedef std::vector<SweepResult, Eigen::aligned_allocator<SweepResult>> SweepResults;
+
+/**
+ *  @brief  Parameters of the ParameterSweep
+ */
+struct ParameterSweepParameters {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  //  @brief  Number of workers including the calling thread, and whether to pin them
+  int num_threads = 1;
+  bool pin_threads = false;
+
+  //  @brief  The flights and the plant, i.e. the vehicle with its true rotor drag
+  FlightParameters flight;
+  QuadrotorPlantParameters plant;
+};  /*  struct ParameterSweepParameters  */
+
+/**
+ *  @brief  ParameterSweep class implementation
+ *  @detail Tune the rotor drag coefficients of the controller and the gains of the low level
+ *          loops in closed loop: every point of a grid or a Latin hypercube design is flown once
+ *          on the QuadrotorPlant by the rotor drag compensating PositionController (see
+ *          CompensatedPlantSimulation), noise free and starting on the reference, and the points
+ *          are ranked by their rms position error. The reference is sampled once at the control
+ *          period into a table shared by all flights, i.e. a flight reads it by index instead of
+ *          evaluating the trajectory. The points are spread across the workers of a thread pool,
+ *          each worker reusing its own simulation and claiming the next point from a shared
+ *          counter, i.e. the results do not depend on the number of threads.
+ */
+class ParameterSweep {
+ public:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    typedef std::vector<quadrotor_common::QuadrotorTrajectoryPoint,
+                        Eigen::aligned_allocator<quadrotor_common::QuadrotorTrajectoryPoint>> TrajectoryPoints;
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  ParameterSweep's default constructor, called when an instance is created
+     *  @param  parameters  - flights, plant and workers
+     *  @param  reference   - the reference trajectory of all flights, sampled once here
+     */
+    ParameterSweep(const ParameterSweepParameters& parameters, const CompensatedPlantSimulation::ReferenceSampler& reference);
+
+    /**
+     *  @brief  ParameterSweep's default destructor, called when an instance is destroyed
+     */
+    ~ParameterSweep();
+
+    ParameterSweep(const ParameterSweep&) = delete;
+    ParameterSweep& operator=(const ParameterSweep&) = delete;
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Fly all points, results[i] being the outcome of points[i]
+     *  @return the wall time of the sweep [s]
+     */
+    double run(const SweepPoints& points, SweepResults& results);
+
+    /**
+     *  @brief  Fly the single point, e.g. to inspect a ranked point
+     */
+    FlightMetrics runOne(const SweepPoint& point);
+
+    /**
+     *  @brief  The full grid of the space, the dx range varying fastest
+     */
+    static SweepPoints grid(const SweepSpace& space);
+
+    /**
+     *  @brief  A Latin hypercube design of n points of the space, i.e. every range split into n
+     *          strata and every stratum of every range taken by exactly one point
+     */
+    static SweepPoints latinHypercube(const SweepSpace& space, const std::size_t n, const std::uint64_t seed);
+
+    /**
+     *  @brief  Sort the results by rms position error, the diverged ones last by flight time,
+     *          ties by index, i.e. results[0] is the best point
+     */
+    static void rank(SweepResults& results);
+
+    /**
+     *  @brief  Accessors
+     */
+    int numThreads() const { return thread_pool_.size(); }
+    const ParameterSweepParameters& parameters() const { return parameters_; }
+    const TrajectoryPoints& trajectory() const { return trajectory_; }
+    const QuadrotorState& initialState() const { return initial_; }
+
+ private:
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Fly the point on the simulation
+     */
+    FlightMetrics fly(const SweepPoint& point, CompensatedPlantSimulation& simulation) const;
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    const ParameterSweepParameters parameters_;
+
+    //  @brief  The reference sampled at the control period, and the initial state on it
+    TrajectoryPoints trajectory_;
+    QuadrotorState initial_;
+
+    //  @brief  One simulation per worker
+    std::vector<std::unique_ptr<CompensatedPlantSimulation>> simulations_;
+
+    //  @brief  The workers
+    position_controller::ThreadPool thread_pool_;
+
+};  /*  class ParameterSweep  */
+
+} /*  namespace quadrotor_simulator  */
+
+#endif  /*  QUADROTOR_SIMULATOR_PARAMETER_SWEEP_H  */
@@ -0,0 +1,155 @@
+/**
+ *  @file   quadrotor_dynamics.h
+ *  @brief  quadrotor's nominal closed loop dynamics model related functionality declaration & definition
+ *  @author thor
+ *  @date   15.12.2021
+ */
+#ifndef QUADROTOR_SIMULATOR_QUADROTOR_DYNAMICS_H
+#define QUADROTOR_SIMULATOR_QUADROTOR_DYNAMICS_H
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+//  quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_control_command.h"
+#include "quadrotor_common/quadrotor_state_estimate.h"
+
+namespace quadrotor_simulator {
+
+/**
+ *  @brief  The true state of the simulated quadrotor, in the world frame
+ */
+struct QuadrotorState {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  Eigen::Vector3d position = Eigen::Vector3d::Zero();
+  Eigen::Vector3d velocity = Eigen::Vector3d::Zero();
+  Eigen::Quaterniond orientation = Eigen::Quaterniond::Identity();
+  Eigen::Vector3d bodyrates = Eigen::Vector3d::Zero();
+};  /*  struct QuadrotorState  */
+
+/**
+ *  @brief  Parameters of the QuadrotorDynamics
+ */
+struct QuadrotorDynamicsParameters {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  //  @brief  Gravity [m/s^2], along -z_W
+  double gravity = 9.81;
+
+  //  @brief  Mass normalized rotor drag coefficients dx, dy, dz [1/s], see rotor_drag_models.h
+  Eigen::Vector3d rotor_drag = Eigen::Vector3d::Zero();
+
+  //  @brief  Gain of the low level attitude loop onto the commanded orientation [1/s],
+  //          0 to track the commanded bodyrates only
+  double attitude_gain = 10.0;
+
+  //  @brief  Gain of the low level bodyrate loop onto the attitude loop's bodyrates [1/s]
+  double bodyrate_gain = 50.0;
+};  /*  struct QuadrotorDynamicsParameters  */
+
+/**
+ *  @brief  QuadrotorDynamics class implementation
+ *  @detail The nominal quadrotor dynamics of PositionController::computeReferenceInputs(), with
+ *          the rotor drag of the reference inputs (Faessler et al., rotor drag paper) and a model
+ *          of the low level flight controller which tracks the control command:
+ *            position_dot  = velocity
+ *            velocity_dot  = -gravity * z_W + collective_thrust * z_B - R * D * R^T * velocity
+ *            R_dot         = R * bodyrates_hat
+ *            bodyrates_dot = angular_acceleration + k_bodyrate * (bodyrates_ref - bodyrates)
+ *            bodyrates_ref = bodyrates_cmd + k_attitude * attitude_error(R, R_cmd)
+ *          where D = diag(dx, dy, dz), i.e. the collective thrust and the torques are applied
+ *          without delay. The state is integrated by a classic Runge Kutta 4 step of the
+ *          control period, holding the control command.
+ */
+class QuadrotorDynamics {
+ public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    typedef QuadrotorDynamicsParameters Parameters;
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  QuadrotorDynamics's default constructor, called when an instance is created
+     */
+    explicit QuadrotorDynamics(const QuadrotorDynamicsParameters& parameters = QuadrotorDynamicsParameters());
+
+    /**
+     *  @brief  QuadrotorDynamics's default destructor, called when an instance is destroyed
+     */
+    ~QuadrotorDynamics();
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Integrate the state over dt, holding the control command
+     *  @param  command - collective thrust, orientation, bodyrates and angular acceleration
+     *  @param  dt      - time step [s]
+     */
+    void step(const quadrotor_common::QuadrotorControlCommand& command, const double dt);
+
+    /**
+     *  @brief  The state as a noise free state estimate of the world frame
+     */
+    void stateEstimate(quadrotor_common::QuadrotorStateEstimate& state_estimate) const;
+
+    /**
+     *  @brief  Accessors
+     */
+    const QuadrotorState& state() const { return state_; }
+    void setState(const QuadrotorState& state) { state_ = state; }
+    const QuadrotorDynamicsParameters& parameters() const { return parameters_; }
+    void setParameters(const QuadrotorDynamicsParameters& parameters) { parameters_ = parameters; }
+
+ private:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    //  @brief  Time derivative of the state, the orientation's as a quaternion
+    struct Derivative {
+      Eigen::Vector3d position;
+      Eigen::Vector3d velocity;
+      Eigen::Vector4d orientation;
+      Eigen::Vector3d bodyrates;
+    };
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  The time derivative of the state under the control command
+     */
+    void derivative(
+        const QuadrotorState& state,
+        const quadrotor_common::QuadrotorControlCommand& command,
+        Derivative& derivative) const;
+
+    /**
+     *  @brief  The state advanced along the derivative by dt
+     */
+    static void advance(const QuadrotorState& state, const Derivative& derivative, const double dt, QuadrotorState& result);
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    QuadrotorDynamicsParameters parameters_;
+    QuadrotorState state_;
+
+};  /*  class QuadrotorDynamics  */
+
+} /*  namespace quadrotor_simulator  */
+
+#endif  /*  QUADROTOR_SIMULATOR_QUADROTOR_DYNAMICS_H  */
@@ -0,0 +1,185 @@
+/**
+ *  @file   quadrotor_plant.h
+ *  @brief  quadrotor's headless rigid body plant related functionality declaration & definition
+ *  @author thor
+ *  @date   16.12.2021
+ */
+#ifndef QUADROTOR_SIMULATOR_QUADROTOR_PLANT_H
+#define QUADROTOR_SIMULATOR_QUADROTOR_PLANT_H
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+//  quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_control_command.h"
+#include "quadrotor_common/quadrotor_state_estimate.h"
+
+//  quadrotor_simulator dependencies
+#include "quadrotor_simulator/quadrotor_dynamics.h"
+
+namespace quadrotor_simulator {
+
+/**
+ *  @brief  Parameters of the QuadrotorPlant, by default the AscTec Hummingbird of rotors_simulator
+ */
+struct QuadrotorPlantParameters {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  //  @brief  Gravity [m/s^2], along -z_W
+  double gravity = 9.81;
+
+  //  @brief  Mass [kg] and principal moments of inertia [kg m^2]
+  double mass = 0.68;
+  Eigen::Vector3d inertia = Eigen::Vector3d(0.007, 0.007, 0.012);
+
+  //  @brief  Distance of the rotors from the center [m], in + configuration along x_B, y_B, -x_B, -y_B
+  double arm_length = 0.17;
+
+  //  @brief  Rotor drag torque per rotor thrust [m], the rotors 0 and 2 spin counter clockwise
+  double rotor_moment_constant = 0.016;
+
+  //  @brief  Time constant of the first order motor lag [s] and maximum thrust of a rotor [N]
+  double motor_time_constant = 0.0125;
+  double max_rotor_thrust = 6.0;
+
+  //  @brief  Mass normalized rotor drag coefficients dx, dy, dz [1/s], see rotor_drag_models.h
+  Eigen::Vector3d rotor_drag = Eigen::Vector3d::Zero();
+
+  //  @brief  Gains of the low level attitude and bodyrate loops [1/s], see QuadrotorDynamics
+  double attitude_gain = 10.0;
+  double bodyrate_gain = 50.0;
+
+  //  @brief  Integration steps per step(), i.e. per control period, the low level loops run at each
+  int substeps = 1;
+};  /*  struct QuadrotorPlantParameters  */
+
+/**
+ *  @brief  QuadrotorPlant class implementation
+ *  @detail Headless in process quadrotor plant, in place of the rotors_simulator / Gazebo stack
+ *          to exercise the controller faster than real time. It models
+ *            + the rigid body of mass m and inertia J, driven by the thrusts f_i of four rotors:
+ *                position_dot  = velocity
+ *                velocity_dot  = -gravity * z_W + sum(f_i) / m * z_B - R * D * R^T * velocity
+ *                R_dot         = R * bodyrates_hat
+ *                bodyrates_dot = J^-1 * (torque(f) - bodyrates x J * bodyrates)
+ *              with the rotor drag D = diag(dx, dy, dz) of the reference inputs
+ *            + first order motor lag, f_i_dot = (f_i_cmd - f_i) / motor_time_constant
+ *            + the low level flight controller of QuadrotorDynamics, which turns the collective
+ *              thrust and the torque needed by the attitude and bodyrate loops into the rotor
+ *              thrust commands f_i_cmd, saturated in [0, max_rotor_thrust]
+ *          The low level controller runs at every integration step, the motor commands are held
+ *          during a Runge Kutta 4 step. The interface matches QuadrotorDynamics, i.e. both plants
+ *          fly in a ClosedLoopSimulation_.
+ */
+class QuadrotorPlant {
+ public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    typedef QuadrotorPlantParameters Parameters;
+    typedef Eigen::Vector4d RotorThrusts;
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  QuadrotorPlant's default constructor, called when an instance is created
+     */
+    explicit QuadrotorPlant(const QuadrotorPlantParameters& parameters = QuadrotorPlantParameters());
+
+    /**
+     *  @brief  QuadrotorPlant's default destructor, called when an instance is destroyed
+     */
+    ~QuadrotorPlant();
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Integrate the state over dt, holding the control command
+     *  @param  command - collective thrust, orientation, bodyrates and angular acceleration
+     *  @param  dt      - time step [s], split into the parameter's substeps
+     */
+    void step(const quadrotor_common::QuadrotorControlCommand& command, const double dt);
+
+    /**
+     *  @brief  The state as a noise free state estimate of the world frame
+     */
+    void stateEstimate(quadrotor_common::QuadrotorStateEstimate& state_estimate) const;
+
+    /**
+     *  @brief  Set the rigid body state, the rotors spin at the hover thrust
+     */
+    void setState(const QuadrotorState& state);
+
+    /**
+     *  @brief  Set the parameters, keeping the state
+     */
+    void setParameters(const QuadrotorPlantParameters& parameters);
+
+    /**
+     *  @brief  Accessors
+     */
+    const QuadrotorState& state() const { return state_; }
+    const RotorThrusts& rotorThrusts() const { return rotor_thrusts_; }
+    const RotorThrusts& rotorThrustCommands() const { return rotor_thrust_commands_; }
+    const QuadrotorPlantParameters& parameters() const { return parameters_; }
+
+ private:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    //  @brief  Time derivative of the state, the orientation's as a quaternion
+    struct Derivative {
+      Eigen::Vector3d position;
+      Eigen::Vector3d velocity;
+      Eigen::Vector4d orientation;
+      Eigen::Vector3d bodyrates;
+      RotorThrusts rotor_thrusts;
+    };
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  The rotor thrust commands of the low level controller in the current state
+     */
+    void mix(const quadrotor_common::QuadrotorControlCommand& command);
+
+    /**
+     *  @brief  The time derivative of the state under the current rotor thrust commands
+     */
+    void derivative(const QuadrotorState& state, const RotorThrusts& rotor_thrusts, Derivative& derivative) const;
+
+    /**
+     *  @brief  One Runge Kutta 4 step of the state under the current rotor thrust commands
+     */
+    void integrate(const double dt);
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    QuadrotorPlantParameters parameters_;
+
+    //  @brief  Collective thrust and torques x, y, z of the rotor thrusts, and its inverse
+    Eigen::Matrix4d allocation_;
+    Eigen::Matrix4d mixer_;
+
+    QuadrotorState state_;
+    RotorThrusts rotor_thrusts_;
+    RotorThrusts rotor_thrust_commands_;
+
+};  /*  class QuadrotorPlant  */
+
+} /*  namespace quadrotor_simulator  */
+
+#endif  /*  QUADROTOR_SIMULATOR_QUADROTOR_PLANT_H  */
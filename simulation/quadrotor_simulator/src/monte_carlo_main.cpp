@@ -0,0 +1,128 @@
+/**
+ *  @file   monte_carlo_main.cpp
+ *  @brief  quadrotor's closed loop Monte Carlo campaign command line tool
+ *  @author thor
+ *  @date   15.12.2021
+ *  @detail Flies perturbed closed loop flights of the PositionController of this build along a
+ *          reference circle and reports the tracking error statistics, e.g.
+ *            $ monte_carlo_campaign --runs 100000 --threads 32 --duration 5
+ *          The runs are reproducible by their index, e.g. --first 4711 --runs 1. Exits with 1
+ *          if the divergence rate exceeds --max-divergence-rate, 0 by default, i.e. usable to
+ *          validate controller releases.
+ */
+#include "quadrotor_simulator/monte_carlo.h"
+
+//  std dependencies
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+//  3rd party dependencies
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/time.h>
+#endif
+
+namespace {
+
+//  @brief  The reference circle, radius [m] and angular velocity [rad/s]
+double radius = 2.0;
+double rate = 1.0;
+
+/**
+ *  @brief  Circle at 1m height, heading fixed
+ */
+void circle(const double time, quadrotor_common::QuadrotorTrajectoryPoint& point) {
+  point = quadrotor_common::QuadrotorTrajectoryPoint();
+  const double c = std::cos(rate * time), s = std::sin(rate * time);
+  point.position = Eigen::Vector3d(radius * c, radius * s, 1.0);
+  point.velocity = radius * rate * Eigen::Vector3d(-s, c, 0.0);
+  point.acceleration = radius * rate * rate * Eigen::Vector3d(-c, -s, 0.0);
+  point.jerk = radius * rate * rate * rate * Eigen::Vector3d(s, -c, 0.0);
+  point.snap = radius * rate * rate * rate * rate * Eigen::Vector3d(c, s, 0.0);
+}
+
+/**
+ *  @brief  Print the usage
+ */
+int usage(const char* program) {
+  std::fprintf(stderr,
+               "usage: %s [--runs N] [--first RUN] [--threads N] [--seed SEED] [--duration SECONDS]\n"
+               "          [--radius METERS] [--rate RAD_PER_SECOND] [--max-divergence-rate RATE] [--csv PATH]\n",
+               program);
+  return 2;
+}
+
+}  /*  namespace  */
+
+/**
+ *
+ */
+int main(int argc, char** argv) {
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  //  wall clock ros time for the RosClock stamps, no ros master required
+  ros::Time::init();
+#endif
+  quadrotor_simulator::MonteCarloParameters parameters;
+  parameters.num_threads = std::max(1u, std::thread::hardware_concurrency());
+  std::size_t runs = 1000;
+  std::size_t first = 0;
+  double max_divergence_rate = 0.0;
+  const char* csv = nullptr;
+
+  for (int i = 1; i < argc; ++i) {
+    const bool value = i + 1 < argc;
+    if (std::strcmp(argv[i], "--runs") == 0 && value) {
+      runs = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--first") == 0 && value) {
+      first = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--threads") == 0 && value) {
+      parameters.num_threads = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--seed") == 0 && value) {
+      parameters.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--duration") == 0 && value) {
+      parameters.flight.duration = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--radius") == 0 && value) {
+      radius = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--rate") == 0 && value) {
+      rate = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--max-divergence-rate") == 0 && value) {
+      max_divergence_rate = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--csv") == 0 && value) {
+      csv = argv[++i];
+    } else {
+      return usage(argv[0]);
+    }
+  }
+
+  quadrotor_simulator::MonteCarloCampaign campaign(parameters, circle);
+  quadrotor_simulator::MonteCarloRuns results;
+  const quadrotor_simulator::MonteCarloSummary summary = campaign.run(first, runs, results);
+
+  std::printf("%zu runs on %d threads in %.3f s, %.0f runs/h, %.0fx real time\n", summary.runs,
+              campaign.numThreads(), summary.seconds, summary.runsPerHour(), summary.realTimeFactor());
+  std::printf("  diverged                 %zu (%.3g%%)\n", summary.diverged, 100.0 * summary.divergenceRate());
+  std::printf("  max position error [m]   mean %.4g p50 %.4g p95 %.4g p99 %.4g worst %.4g\n",
+              summary.mean_max_position_error, summary.p50_max_position_error, summary.p95_max_position_error,
+              summary.p99_max_position_error, summary.worst_max_position_error);
+
+  if (csv != nullptr) {
+    std::FILE* const file = std::fopen(csv, "w");
+    if (file == nullptr) {
+      std::fprintf(stderr, "cannot write %s\n", csv);
+      return 1;
+    }
+    std::fprintf(file, "run,seed,dx,dy,dz,diverged,time,max_position_error,rms_position_error,rms_velocity_error\n");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      const quadrotor_simulator::MonteCarloRun& run = results[i];
+      std::fprintf(file, "%zu,%llu,%.6g,%.6g,%.6g,%d,%.6g,%.6g,%.6g,%.6g\n", first + i,
+                   static_cast<unsigned long long>(run.seed), run.rotor_drag.x(), run.rotor_drag.y(),
+                   run.rotor_drag.z(), run.metrics.diverged ? 1 : 0, run.metrics.time,
+                   run.metrics.max_position_error, run.metrics.rms_position_error, run.metrics.rms_velocity_error);
+    }
+    std::fclose(file);
+  }
+  return summary.divergenceRate() <= max_divergence_rate ? 0 : 1;
+}
@@ -0,0 +1,210 @@
+/**
+ *  @file   parameter_sweep_main.cpp
+ *  @brief  quadrotor's closed loop rotor drag and gain parameter sweep command line tool
+ *  @author thor
+ *  @date   17.12.2021
+ *  @detail Flies the rotor drag compensating PositionController of this build on the plant along
+ *          a reference circle for every point of a grid or a Latin hypercube design of the rotor
+ *          drag coefficients and the low level gains, and prints the best points, e.g.
+ *            $ parameter_sweep --dx 0:1:21 --dy 0:1:21 --dz 0:0.5:21 --threads 32
+ *            $ parameter_sweep --dx 0:1 --dy 0:1 --dz 0:0.5 --lhs 10000 --threads 32
+ *          A range is MIN:MAX[:COUNT], a single value is constant, the plant flies with the
+ *          rotor drag --plant-drag, i.e. the best points should recover it.
+ */
+#include "quadrotor_simulator/parameter_sweep.h"
+
+//  std dependencies
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+//  3rd party dependencies
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/time.h>
+#endif
+
+namespace {
+
+//  @brief  The reference circle, radius [m] and angular velocity [rad/s]
+double radius = 2.0;
+double rate = 2.0;
+
+/**
+ *  @brief  Circle at 1m height, heading fixed
+ */
+void circle(const double time, quadrotor_common::QuadrotorTrajectoryPoint& point) {
+  point = quadrotor_common::QuadrotorTrajectoryPoint();
+  const double c = std::cos(rate * time), s = std::sin(rate * time);
+  point.position = Eigen::Vector3d(radius * c, radius * s, 1.0);
+  point.velocity = radius * rate * Eigen::Vector3d(-s, c, 0.0);
+  point.acceleration = radius * rate * rate * Eigen::Vector3d(-c, -s, 0.0);
+  point.jerk = radius * rate * rate * rate * Eigen::Vector3d(s, -c, 0.0);
+  point.snap = radius * rate * rate * rate * rate * Eigen::Vector3d(c, s, 0.0);
+}
+
+/**
+ *  @brief  Parse MIN[:MAX[:COUNT]] into the range
+ *  @return boolean value where
+ *            + true  - Indicates the range has been parsed
+ *            + false - Otherwise
+ */
+bool parse(const char* text, quadrotor_simulator::SweepRange& range) {
+  char* end = nullptr;
+  range.min = std::strtod(text, &end);
+  range.max = range.min;
+  range.count = 1;
+  if (end == text) {
+    return false;
+  }
+  if (*end == ':') {
+    text = end + 1;
+    range.max = std::strtod(text, &end);
+    if (end == text) {
+      return false;
+    }
+    range.count = 2;
+  }
+  if (*end == ':') {
+    text = end + 1;
+    range.count = std::strtol(text, &end, 10);
+    if (end == text || range.count < 1) {
+      return false;
+    }
+  }
+  return *end == '\0';
+}
+
+/**
+ *  @brief  Print the usage
+ */
+int usage(const char* program) {
+  std::fprintf(stderr,
+               "usage: %s [--dx RANGE] [--dy RANGE] [--dz RANGE] [--attitude-gain RANGE] [--bodyrate-gain RANGE]\n"
+               "          [--lhs N] [--seed SEED] [--threads N] [--duration SECONDS] [--radius METERS]\n"
+               "          [--rate RAD_PER_SECOND] [--plant-drag DX,DY,DZ] [--top K] [--csv PATH]\n"
+               "       RANGE is MIN[:MAX[:COUNT]], i.e. a grid of COUNT values, without --lhs\n",
+               program);
+  return 2;
+}
+
+}  /*  namespace  */
+
+/**
+ *
+ */
+int main(int argc, char** argv) {
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  //  wall clock ros time for the RosClock stamps, no ros master required
+  ros::Time::init();
+#endif
+  quadrotor_simulator::ParameterSweepParameters parameters;
+  parameters.num_threads = std::max(1u, std::thread::hardware_concurrency());
+  parameters.plant.rotor_drag = Eigen::Vector3d(0.4, 0.4, 0.1);
+  quadrotor_simulator::SweepSpace space;
+  space.dx = {0.0, 1.0, 11};
+  space.dy = {0.0, 1.0, 11};
+  space.dz = {0.0, 0.5, 6};
+  std::size_t lhs = 0;
+  std::uint64_t seed = 1;
+  std::size_t top = 10;
+  bool duration = false;
+  const char* csv = nullptr;
+
+  for (int i = 1; i < argc; ++i) {
+    const bool value = i + 1 < argc;
+    if (std::strcmp(argv[i], "--dx") == 0 && value) {
+      if (!parse(argv[++i], space.dx)) {
+        return usage(argv[0]);
+      }
+    } else if (std::strcmp(argv[i], "--dy") == 0 && value) {
+      if (!parse(argv[++i], space.dy)) {
+        return usage(argv[0]);
+      }
+    } else if (std::strcmp(argv[i], "--dz") == 0 && value) {
+      if (!parse(argv[++i], space.dz)) {
+        return usage(argv[0]);
+      }
+    } else if (std::strcmp(argv[i], "--attitude-gain") == 0 && value) {
+      if (!parse(argv[++i], space.attitude_gain)) {
+        return usage(argv[0]);
+      }
+    } else if (std::strcmp(argv[i], "--bodyrate-gain") == 0 && value) {
+      if (!parse(argv[++i], space.bodyrate_gain)) {
+        return usage(argv[0]);
+      }
+    } else if (std::strcmp(argv[i], "--lhs") == 0 && value) {
+      lhs = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--seed") == 0 && value) {
+      seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--threads") == 0 && value) {
+      parameters.num_threads = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--duration") == 0 && value) {
+      parameters.flight.duration = std::atof(argv[++i]);
+      duration = true;
+    } else if (std::strcmp(argv[i], "--radius") == 0 && value) {
+      radius = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--rate") == 0 && value) {
+      rate = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--plant-drag") == 0 && value) {
+      Eigen::Vector3d& d = parameters.plant.rotor_drag;
+      if (std::sscanf(argv[++i], "%lf,%lf,%lf", &d.x(), &d.y(), &d.z()) != 3) {
+        return usage(argv[0]);
+      }
+    } else if (std::strcmp(argv[i], "--top") == 0 && value) {
+      top = std::strtoull(argv[++i], nullptr, 10);
+    } else if (std::strcmp(argv[i], "--csv") == 0 && value) {
+      csv = argv[++i];
+    } else {
+      return usage(argv[0]);
+    }
+  }
+  if (!duration) {
+    parameters.flight.duration = 2.0 * M_PI / rate;
+  } //  one lap
+
+  const quadrotor_simulator::SweepPoints points = lhs > 0
+      ? quadrotor_simulator::ParameterSweep::latinHypercube(space, lhs, seed)
+      : quadrotor_simulator::ParameterSweep::grid(space);
+  quadrotor_simulator::ParameterSweep sweep(parameters, circle);
+  quadrotor_simulator::SweepResults results;
+  const double seconds = sweep.run(points, results);
+  quadrotor_simulator::ParameterSweep::rank(results);
+
+  std::size_t diverged = 0;
+  for (const quadrotor_simulator::SweepResult& result : results) {
+    diverged += result.metrics.diverged;
+  }
+  std::printf("%zu points on %d threads in %.3f s, %.0f points/s, %zu diverged\n", results.size(),
+              sweep.numThreads(), seconds, seconds > 0.0 ? results.size() / seconds : 0.0, diverged);
+  std::printf("  rank  point        dx       dy       dz  attitude  bodyrate   rms [m]   max [m]\n");
+  for (std::size_t i = 0; i < std::min(top, results.size()); ++i) {
+    const quadrotor_simulator::SweepResult& result = results[i];
+    std::printf("  %4zu %6zu  %8.4f %8.4f %8.4f  %8.3f  %8.3f  %8.4g  %8.4g%s\n", i + 1, result.index,
+                result.point.rotor_drag.x(), result.point.rotor_drag.y(), result.point.rotor_drag.z(),
+                result.point.attitude_gain, result.point.bodyrate_gain, result.metrics.rms_position_error,
+                result.metrics.max_position_error, result.metrics.diverged ? " diverged" : "");
+  }
+
+  if (csv != nullptr) {
+    std::FILE* const file = std::fopen(csv, "w");
+    if (file == nullptr) {
+      std::fprintf(stderr, "cannot write %s\n", csv);
+      return 1;
+    }
+    std::fprintf(file, "rank,point,dx,dy,dz,attitude_gain,bodyrate_gain,diverged,time,"
+                       "max_position_error,rms_position_error,rms_velocity_error\n");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      const quadrotor_simulator::SweepResult& result = results[i];
+      std::fprintf(file, "%zu,%zu,%.6g,%.6g,%.6g,%.6g,%.6g,%d,%.6g,%.6g,%.6g,%.6g\n", i + 1, result.index,
+                   result.point.rotor_drag.x(), result.point.rotor_drag.y(), result.point.rotor_drag.z(),
+                   result.point.attitude_gain, result.point.bodyrate_gain, result.metrics.diverged ? 1 : 0,
+                   result.metrics.time, result.metrics.max_position_error, result.metrics.rms_position_error,
+                   result.metrics.rms_velocity_error);
+    }
+    std::fclose(file);
+  }
+  return 0;
+}
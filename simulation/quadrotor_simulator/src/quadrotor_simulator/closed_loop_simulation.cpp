@@ -0,0 +1,112 @@
+/**
+ *  @file   closed_loop_simulation.cpp
+ *  @brief  quadrotor's closed loop flight simulation related functionality implementation
+ *  @author thor
+ *  @date   15.12.2021
+ */
+#include "quadrotor_simulator/closed_loop_simulation.h"
+
+//  std dependencies
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace quadrotor_simulator {
+
+/**
+ *  @detail ClosedLoopSimulation_'s default constructor definition
+ */
+template <typename Plant, typename RotorDragModel>
+ClosedLoopSimulation_<Plant, RotorDragModel>::ClosedLoopSimulation_(
+    const ReferenceSampler& reference,
+    const FlightParameters& parameters,
+    const RotorDragModel& rotor_drag)
+    : reference_(reference),
+      parameters_(parameters),
+      rotor_drag_(rotor_drag),
+      controller_(rotor_drag),
+      state_estimate_(quadrotor_common::kUninitialized),
+      command_(quadrotor_common::kUninitialized) {}
+
+/**
+ *  @detail ClosedLoopSimulation_'s default destructor definition
+ */
+template <typename Plant, typename RotorDragModel>
+ClosedLoopSimulation_<Plant, RotorDragModel>::~ClosedLoopSimulation_() {}
+
+/**
+ *  @detail The errors are taken before every step, i.e. at the control ticks, the orientation
+ *          noise is a rotation of normal distributed angle about a uniformly distributed axis.
+ *          The outer loop feeds back the noisy state estimate, as a flight controller would.
+ *          The state estimate and the command are the members, written in place every tick,
+ *          i.e. no tick reads the clock of their default constructors.
+ */
+template <typename Plant, typename RotorDragModel>
+FlightMetrics ClosedLoopSimulation_<Plant, RotorDragModel>::fly(
+    const typename Plant::Parameters& dynamics,
+    const QuadrotorState& initial,
+    const EstimateNoise& noise,
+    const std::uint64_t seed) {
+  controller_.reset();
+  controller_.setRotorDrag(rotor_drag_);
+  dynamics_.setParameters(dynamics);
+  dynamics_.setState(initial);
+
+  std::mt19937_64 generator(seed);
+  std::normal_distribution<double> normal(0.0, 1.0);
+  auto gaussian = [&]() { return normal(generator); };
+  const bool noisy = noise.position > 0.0 || noise.velocity > 0.0 || noise.orientation > 0.0 || noise.bodyrates > 0.0;
+
+  quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+  FlightMetrics metrics;
+  double sum_position_errors = 0.0;
+  double sum_velocity_errors = 0.0;
+  const std::uint64_t ticks = std::llround(parameters_.duration / parameters_.control_period);
+
+  for (std::uint64_t tick = 0; tick < ticks; ++tick) {
+    const double time = tick * parameters_.control_period;
+    reference_(time, reference_state);
+
+    const QuadrotorState& state = dynamics_.state();
+    const double position_error = (state.position - reference_state.position).norm();
+    const double velocity_error = (state.velocity - reference_state.velocity).norm();
+    metrics.max_position_error = std::max(metrics.max_position_error, position_error);
+    metrics.final_position_error = position_error;
+    sum_position_errors += position_error * position_error;
+    sum_velocity_errors += velocity_error * velocity_error;
+    metrics.ticks = tick + 1;
+    if (!(position_error <= parameters_.divergence_threshold)) {
+      metrics.diverged = true;
+      break;
+    } //  diverged, or not a number
+
+    dynamics_.stateEstimate(state_estimate_);
+    if (noisy) {
+      state_estimate_.position += noise.position * Eigen::Vector3d::NullaryExpr(gaussian);
+      state_estimate_.velocity += noise.velocity * Eigen::Vector3d::NullaryExpr(gaussian);
+      const Eigen::Vector3d axis = Eigen::Vector3d::NullaryExpr(gaussian).normalized();
+      state_estimate_.orientation = state_estimate_.orientation * Eigen::AngleAxisd(noise.orientation * gaussian(), axis);
+      state_estimate_.bodyrates += noise.bodyrates * Eigen::Vector3d::NullaryExpr(gaussian);
+    }
+
+    reference_state.acceleration +=
+        parameters_.position_gain * (reference_state.position - state_estimate_.position) +
+        parameters_.velocity_gain * (reference_state.velocity - state_estimate_.velocity);
+    controller_.run(state_estimate_, reference_state, command_);
+    dynamics_.step(command_, parameters_.control_period);
+  }
+
+  metrics.time = metrics.ticks * parameters_.control_period;
+  if (metrics.ticks > 0) {
+    metrics.rms_position_error = std::sqrt(sum_position_errors / metrics.ticks);
+    metrics.rms_velocity_error = std::sqrt(sum_velocity_errors / metrics.ticks);
+  }
+  return metrics;
+}
+
+template class ClosedLoopSimulation_<QuadrotorDynamics>;
+template class ClosedLoopSimulation_<QuadrotorPlant>;
+template class ClosedLoopSimulation_<QuadrotorDynamics, position_controller::AnisotropicRotorDrag>;
+template class ClosedLoopSimulation_<QuadrotorPlant, position_controller::AnisotropicRotorDrag>;
+
+} /*  namespace quadrotor_simulator  */
@@ -0,0 +1,150 @@
+/**
+ *  @file   monte_carlo.cpp
+ *  @brief  quadrotor's closed loop Monte Carlo campaign related functionality implementation
+ *  @author thor
+ *  @date   15.12.2021
+ */
+#include "quadrotor_simulator/monte_carlo.h"
+
+//  std dependencies
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+
+namespace quadrotor_simulator {
+
+namespace {
+
+/**
+ *  @brief  SplitMix64 finalizer, i.e. decorrelated seeds of consecutive run indices
+ */
+std::uint64_t mix(std::uint64_t x) {
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+/**
+ *  @brief  The value at the quantile of the sorted values
+ */
+double quantile(const std::vector<double>& sorted, const double q) {
+  return sorted[std::min(sorted.size() - 1, static_cast<std::size_t>(q * sorted.size()))];
+}
+
+}  /*  namespace  */
+
+/**
+ *  @detail MonteCarloCampaign's default constructor definition
+ */
+MonteCarloCampaign::MonteCarloCampaign(
+    const MonteCarloParameters& parameters,
+    const ClosedLoopSimulation::ReferenceSampler& reference)
+    : parameters_(parameters),
+      reference_(reference),
+      thread_pool_(parameters.num_threads, parameters.pin_threads) {
+  simulations_.reserve(thread_pool_.size());
+  for (int worker = 0; worker < thread_pool_.size(); ++worker) {
+    simulations_.emplace_back(new ClosedLoopSimulation(reference_, parameters_.flight));
+  }
+}
+
+/**
+ *  @detail MonteCarloCampaign's default destructor definition
+ */
+MonteCarloCampaign::~MonteCarloCampaign() {}
+
+/**
+ *  @detail The runs are claimed one by one, a flight takes milliseconds, i.e. the shared
+ *          counter is not contended, and diverged flights, which end early, balance out.
+ */
+MonteCarloSummary MonteCarloCampaign::run(const std::size_t first, const std::size_t n, MonteCarloRuns& runs) {
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  runs.resize(n);
+  std::atomic<std::size_t> next(0);
+  thread_pool_.run([&](const int worker) {
+    for (std::size_t i = next.fetch_add(1); i < n; i = next.fetch_add(1)) {
+      fly(first + i, *simulations_[worker], runs[i]);
+    }
+  });
+
+  MonteCarloSummary summary = summarize(runs);
+  summary.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return summary;
+}
+
+/**
+ *  @detail
+ */
+MonteCarloRun MonteCarloCampaign::runOne(const std::size_t run) {
+  MonteCarloRun result;
+  fly(run, *simulations_[0], result);
+  return result;
+}
+
+/**
+ *  @detail
+ */
+std::uint64_t MonteCarloCampaign::seed(const std::size_t run) const {
+  return mix(parameters_.seed ^ mix(run));
+}
+
+/**
+ *  @detail The initial state is the reference at time 0, perturbed, the initial orientation
+ *          the reference heading about z_W, perturbed, i.e. the low level attitude loop first
+ *          turns it onto the commanded orientation.
+ */
+void MonteCarloCampaign::fly(const std::size_t run, ClosedLoopSimulation& simulation, MonteCarloRun& result) const {
+  result.seed = seed(run);
+  std::mt19937_64 generator(result.seed);
+  std::normal_distribution<double> normal(0.0, 1.0);
+  auto gaussian = [&]() { return normal(generator); };
+
+  quadrotor_common::QuadrotorTrajectoryPoint reference_state;
+  reference_(0.0, reference_state);
+  QuadrotorState initial;
+  initial.position = reference_state.position + parameters_.position_sigma * Eigen::Vector3d::NullaryExpr(gaussian);
+  initial.velocity = reference_state.velocity + parameters_.velocity_sigma * Eigen::Vector3d::NullaryExpr(gaussian);
+  const Eigen::Vector3d axis = Eigen::Vector3d::NullaryExpr(gaussian).normalized();
+  initial.orientation = Eigen::AngleAxisd(reference_state.heading, Eigen::Vector3d::UnitZ()) *
+                        Eigen::AngleAxisd(parameters_.orientation_sigma * gaussian(), axis);
+  initial.bodyrates = parameters_.bodyrates_sigma * Eigen::Vector3d::NullaryExpr(gaussian);
+
+  QuadrotorDynamicsParameters dynamics = parameters_.dynamics;
+  dynamics.rotor_drag += parameters_.rotor_drag_sigma.cwiseProduct(Eigen::Vector3d::NullaryExpr(gaussian));
+  dynamics.rotor_drag = dynamics.rotor_drag.cwiseMax(0.0);
+  result.rotor_drag = dynamics.rotor_drag;
+
+  result.metrics = simulation.fly(dynamics, initial, parameters_.estimate_noise, generator());
+}
+
+/**
+ *  @detail
+ */
+MonteCarloSummary MonteCarloCampaign::summarize(const MonteCarloRuns& runs) {
+  MonteCarloSummary summary;
+  summary.runs = runs.size();
+  if (runs.empty()) {
+    return summary;
+  }
+
+  std::vector<double> errors;
+  errors.reserve(runs.size());
+  for (const MonteCarloRun& run : runs) {
+    summary.diverged += run.metrics.diverged;
+    summary.flight_seconds += run.metrics.time;
+    summary.mean_max_position_error += run.metrics.max_position_error;
+    errors.push_back(run.metrics.max_position_error);
+  }
+  summary.mean_max_position_error /= runs.size();
+
+  std::sort(errors.begin(), errors.end());
+  summary.p50_max_position_error = quantile(errors, 0.50);
+  summary.p95_max_position_error = quantile(errors, 0.95);
+  summary.p99_max_position_error = quantile(errors, 0.99);
+  summary.worst_max_position_error = errors.back();
+  return summary;
+}
+
+} /*  namespace quadrotor_simulator  */
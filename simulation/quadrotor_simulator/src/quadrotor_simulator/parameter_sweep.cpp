@@ -0,0 +1,204 @@
+/**
+ *  @file   parameter_sweep.cpp
+ *  @brief  quadrotor's closed loop rotor drag and gain parameter sweep related functionality implementation
+ *  @author thor
+ *  @date   17.12.2021
+ */
+#include "quadrotor_simulator/parameter_sweep.h"
+
+//  std dependencies
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+namespace quadrotor_simulator {
+
+namespace {
+
+/**
+ *  @brief  The k-th of the range's count values, evenly spaced in [min, max]
+ */
+double value(const SweepRange& range, const int k) {
+  return range.count > 1 ? range.min + k * (range.max - range.min) / (range.count - 1) : range.min;
+}
+
+/**
+ *  @brief  The number of grid values of the range
+ */
+std::size_t count(const SweepRange& range) {
+  return static_cast<std::size_t>(std::max(1, range.count));
+}
+
+}  /*  namespace  */
+
+/**
+ *  @detail ParameterSweep's default constructor definition
+ *          The initial state is the reference at time 0 with the orientation and bodyrates of
+ *          the reference inputs under the plant's rotor drag, i.e. the flights start on the
+ *          reference and the points differ in how well they keep it. The state estimate and
+ *          the command are constructed uninitialized, i.e. without reading a clock.
+ */
+ParameterSweep::ParameterSweep(
+    const ParameterSweepParameters& parameters,
+    const CompensatedPlantSimulation::ReferenceSampler& reference)
+    : parameters_(parameters),
+      thread_pool_(parameters.num_threads, parameters.pin_threads) {
+  const std::size_t ticks = std::llround(parameters_.flight.duration / parameters_.flight.control_period);
+  trajectory_.resize(ticks + 1);
+  for (std::size_t tick = 0; tick <= ticks; ++tick) {
+    reference(tick * parameters_.flight.control_period, trajectory_[tick]);
+  }
+
+  quadrotor_common::QuadrotorStateEstimate state_estimate(quadrotor_common::kUninitialized);
+  state_estimate.coordinate_frame = quadrotor_common::QuadrotorStateEstimate::CoordinateFrame::kWorld;
+  state_estimate.position = trajectory_[0].position;
+  state_estimate.velocity = trajectory_[0].velocity;
+  state_estimate.orientation.setIdentity();
+  state_estimate.bodyrates.setZero();
+  position_controller::PositionController_<position_controller::AnisotropicRotorDrag> controller(
+      position_controller::AnisotropicRotorDrag(
+          parameters_.plant.rotor_drag.x(), parameters_.plant.rotor_drag.y(), parameters_.plant.rotor_drag.z()));
+  quadrotor_common::QuadrotorControlCommand command(quadrotor_common::kUninitialized);
+  controller.run(state_estimate, trajectory_[0], command);
+  initial_.position = trajectory_[0].position;
+  initial_.velocity = trajectory_[0].velocity;
+  initial_.orientation = command.orientation;
+  initial_.bodyrates = command.bodyrates;
+
+  const TrajectoryPoints* const trajectory = &trajectory_;
+  const double control_period = parameters_.flight.control_period;
+  const CompensatedPlantSimulation::ReferenceSampler table =
+      [trajectory, control_period](const double time, quadrotor_common::QuadrotorTrajectoryPoint& point) {
+        const std::size_t tick = std::llround(time / control_period);
+        point = (*trajectory)[std::min(tick, trajectory->size() - 1)];
+      };
+  simulations_.reserve(thread_pool_.size());
+  for (int worker = 0; worker < thread_pool_.size(); ++worker) {
+    simulations_.emplace_back(new CompensatedPlantSimulation(table, parameters_.flight));
+  }
+}
+
+/**
+ *  @detail ParameterSweep's default destructor definition
+ */
+ParameterSweep::~ParameterSweep() {}
+
+/**
+ *  @detail The points are claimed one by one, a flight takes milliseconds, i.e. the shared
+ *          counter is not contended, and diverged flights, which end early, balance out.
+ */
+double ParameterSweep::run(const SweepPoints& points, SweepResults& results) {
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  const std::size_t n = points.size();
+  results.resize(n);
+  std::atomic<std::size_t> next(0);
+  thread_pool_.run([&](const int worker) {
+    for (std::size_t i = next.fetch_add(1); i < n; i = next.fetch_add(1)) {
+      results[i].index = i;
+      results[i].point = points[i];
+      results[i].metrics = fly(points[i], *simulations_[worker]);
+    }
+  });
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ *  @detail
+ */
+FlightMetrics ParameterSweep::runOne(const SweepPoint& point) {
+  return fly(point, *simulations_[0]);
+}
+
+/**
+ *  @detail
+ */
+FlightMetrics ParameterSweep::fly(const SweepPoint& point, CompensatedPlantSimulation& simulation) const {
+  simulation.setRotorDrag(position_controller::AnisotropicRotorDrag(
+      point.rotor_drag.x(), point.rotor_drag.y(), point.rotor_drag.z()));
+  QuadrotorPlantParameters plant = parameters_.plant;
+  plant.attitude_gain = point.attitude_gain;
+  plant.bodyrate_gain = point.bodyrate_gain;
+  return simulation.fly(plant, initial_);
+}
+
+/**
+ *  @detail
+ */
+SweepPoints ParameterSweep::grid(const SweepSpace& space) {
+  const std::size_t n = count(space.dx) * count(space.dy) * count(space.dz) *
+                        count(space.attitude_gain) * count(space.bodyrate_gain);
+  SweepPoints points;
+  points.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    std::size_t k = i;
+    SweepPoint point;
+    point.rotor_drag.x() = value(space.dx, k % count(space.dx));
+    k /= count(space.dx);
+    point.rotor_drag.y() = value(space.dy, k % count(space.dy));
+    k /= count(space.dy);
+    point.rotor_drag.z() = value(space.dz, k % count(space.dz));
+    k /= count(space.dz);
+    point.attitude_gain = value(space.attitude_gain, k % count(space.attitude_gain));
+    k /= count(space.attitude_gain);
+    point.bodyrate_gain = value(space.bodyrate_gain, k);
+    points.push_back(point);
+  }
+  return points;
+}
+
+/**
+ *  @detail Every range is split into n strata, a random permutation of the strata is drawn per
+ *          range and point i takes a uniformly distributed value in its stratum of every range.
+ *          The counts of the ranges are ignored, a range with min = max is constant.
+ */
+SweepPoints ParameterSweep::latinHypercube(const SweepSpace& space, const std::size_t n, const std::uint64_t seed) {
+  std::mt19937_64 generator(seed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  std::vector<std::size_t> strata(n);
+  auto sample = [&](const SweepRange& range, const std::size_t i) {
+    return range.min + (strata[i] + uniform(generator)) / n * (range.max - range.min);
+  };
+
+  SweepPoints points(n);
+  const SweepRange* const ranges[] = {&space.dx, &space.dy, &space.dz, &space.attitude_gain, &space.bodyrate_gain};
+  for (int dimension = 0; dimension < 5; ++dimension) {
+    std::iota(strata.begin(), strata.end(), 0);
+    std::shuffle(strata.begin(), strata.end(), generator);
+    for (std::size_t i = 0; i < n; ++i) {
+      const double x = sample(*ranges[dimension], i);
+      switch (dimension) {
+        case 0: points[i].rotor_drag.x() = x; break;
+        case 1: points[i].rotor_drag.y() = x; break;
+        case 2: points[i].rotor_drag.z() = x; break;
+        case 3: points[i].attitude_gain = x; break;
+        default: points[i].bodyrate_gain = x; break;
+      }
+    }
+  }
+  return points;
+}
+
+/**
+ *  @detail A not a number error ranks as diverged.
+ */
+void ParameterSweep::rank(SweepResults& results) {
+  std::sort(results.begin(), results.end(), [](const SweepResult& a, const SweepResult& b) {
+    const bool a_diverged = a.metrics.diverged || !(a.metrics.rms_position_error == a.metrics.rms_position_error);
+    const bool b_diverged = b.metrics.diverged || !(b.metrics.rms_position_error == b.metrics.rms_position_error);
+    if (a_diverged != b_diverged) {
+      return b_diverged;
+    }
+    if (a_diverged) {
+      return a.metrics.ticks != b.metrics.ticks ? a.metrics.ticks > b.metrics.ticks : a.index < b.index;
+    }
+    if (a.metrics.rms_position_error != b.metrics.rms_position_error) {
+      return a.metrics.rms_position_error < b.metrics.rms_position_error;
+    }
+    return a.index < b.index;
+  });
+}
+
+} /*  namespace quadrotor_simulator  */
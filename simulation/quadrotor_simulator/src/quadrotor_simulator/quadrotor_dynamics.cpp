@@ -0,0 +1,98 @@
+/**
+ *  @file   quadrotor_dynamics.cpp
+ *  @brief  quadrotor's nominal closed loop dynamics model related functionality implementation
+ *  @author thor
+ *  @date   15.12.2021
+ */
+#include "quadrotor_simulator/quadrotor_dynamics.h"
+
+namespace quadrotor_simulator {
+
+/**
+ *  @detail QuadrotorDynamics's default constructor definition
+ */
+QuadrotorDynamics::QuadrotorDynamics(const QuadrotorDynamicsParameters& parameters)
+    : parameters_(parameters) {}
+
+/**
+ *  @detail QuadrotorDynamics's default destructor definition
+ */
+QuadrotorDynamics::~QuadrotorDynamics() {}
+
+/**
+ *  @detail
+ */
+void QuadrotorDynamics::step(const quadrotor_common::QuadrotorControlCommand& command, const double dt) {
+  Derivative k1, k2, k3, k4;
+  QuadrotorState state;
+  derivative(state_, command, k1);
+  advance(state_, k1, 0.5 * dt, state);
+  derivative(state, command, k2);
+  advance(state_, k2, 0.5 * dt, state);
+  derivative(state, command, k3);
+  advance(state_, k3, dt, state);
+  derivative(state, command, k4);
+
+  Derivative sum;
+  sum.position = k1.position + 2.0 * (k2.position + k3.position) + k4.position;
+  sum.velocity = k1.velocity + 2.0 * (k2.velocity + k3.velocity) + k4.velocity;
+  sum.orientation = k1.orientation + 2.0 * (k2.orientation + k3.orientation) + k4.orientation;
+  sum.bodyrates = k1.bodyrates + 2.0 * (k2.bodyrates + k3.bodyrates) + k4.bodyrates;
+  advance(state_, sum, dt / 6.0, state_);
+}
+
+/**
+ *  @detail
+ */
+void QuadrotorDynamics::stateEstimate(quadrotor_common::QuadrotorStateEstimate& state_estimate) const {
+  state_estimate.coordinate_frame = quadrotor_common::QuadrotorStateEstimate::CoordinateFrame::kWorld;
+  state_estimate.position = state_.position;
+  state_estimate.velocity = state_.velocity;
+  state_estimate.orientation = state_.orientation;
+  state_estimate.bodyrates = state_.bodyrates;
+}
+
+/**
+ *  @detail The attitude error is the vector part of the body frame rotation onto the commanded
+ *          orientation, doubled and taken along the shorter way, i.e. the small angle axis error.
+ */
+void QuadrotorDynamics::derivative(
+    const QuadrotorState& state,
+    const quadrotor_common::QuadrotorControlCommand& command,
+    Derivative& derivative) const {
+  const Eigen::Matrix3d R = state.orientation.toRotationMatrix();
+
+  derivative.position = state.velocity;
+
+  const Eigen::Vector3d drag = R * parameters_.rotor_drag.cwiseProduct(R.transpose() * state.velocity);
+  derivative.velocity = command.collective_thrust * R.col(2) - drag;
+  derivative.velocity.z() -= parameters_.gravity;
+
+  const Eigen::Vector4d& q = state.orientation.coeffs();
+  const Eigen::Vector3d& w = state.bodyrates;
+  derivative.orientation <<  //  0.5 * q * (0, w), coefficients x, y, z, w
+      0.5 * ( q.w() * w.x() + q.y() * w.z() - q.z() * w.y()),
+      0.5 * ( q.w() * w.y() + q.z() * w.x() - q.x() * w.z()),
+      0.5 * ( q.w() * w.z() + q.x() * w.y() - q.y() * w.x()),
+      0.5 * (-q.x() * w.x() - q.y() * w.y() - q.z() * w.z());
+
+  Eigen::Vector3d bodyrates = command.bodyrates;
+  if (parameters_.attitude_gain > 0.0) {
+    const Eigen::Quaterniond error = state.orientation.conjugate() * command.orientation;
+    bodyrates += parameters_.attitude_gain * (error.w() < 0.0 ? -2.0 : 2.0) * error.vec();
+  } //  low level attitude loop
+  derivative.bodyrates = command.angular_acceleration + parameters_.bodyrate_gain * (bodyrates - state.bodyrates);
+}
+
+/**
+ *  @detail The orientation is renormalized, i.e. kept on the unit sphere.
+ */
+void QuadrotorDynamics::advance(const QuadrotorState& state, const Derivative& derivative, const double dt, QuadrotorState& result) {
+  result.position = state.position + dt * derivative.position;
+  result.velocity = state.velocity + dt * derivative.velocity;
+  result.orientation.coeffs() = state.orientation.coeffs() + dt * derivative.orientation;
+  result.orientation.normalize();
+  result.bodyrates = state.bodyrates + dt * derivative.bodyrates;
+}
+
+} /*  namespace quadrotor_simulator  */
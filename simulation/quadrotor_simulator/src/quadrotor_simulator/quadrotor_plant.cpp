@@ -0,0 +1,153 @@
+/**
+ *  @file   quadrotor_plant.cpp
+ *  @brief  quadrotor's headless rigid body plant related functionality implementation
+ *  @author thor
+ *  @date   16.12.2021
+ */
+#include "quadrotor_simulator/quadrotor_plant.h"
+
+//  std dependencies
+#include <algorithm>
+
+namespace quadrotor_simulator {
+
+/**
+ *  @detail QuadrotorPlant's default constructor definition
+ */
+QuadrotorPlant::QuadrotorPlant(const QuadrotorPlantParameters& parameters) {
+  setParameters(parameters);
+  setState(QuadrotorState());
+}
+
+/**
+ *  @detail QuadrotorPlant's default destructor definition
+ */
+QuadrotorPlant::~QuadrotorPlant() {}
+
+/**
+ *  @detail The rotors of the + configuration at (l, 0), (0, l), (-l, 0), (0, -l) of the body
+ *          frame, i.e. the torque of rotor i is r_i x f_i z_B plus its drag torque about z_B.
+ */
+void QuadrotorPlant::setParameters(const QuadrotorPlantParameters& parameters) {
+  parameters_ = parameters;
+  const double l = parameters_.arm_length;
+  const double k = parameters_.rotor_moment_constant;
+  allocation_ <<
+      1.0,  1.0,  1.0,  1.0,
+      0.0,    l,  0.0,   -l,
+       -l,  0.0,    l,  0.0,
+        k,   -k,    k,   -k;
+  mixer_ = allocation_.inverse();
+}
+
+/**
+ *  @detail
+ */
+void QuadrotorPlant::setState(const QuadrotorState& state) {
+  state_ = state;
+  rotor_thrusts_.setConstant(0.25 * parameters_.mass * parameters_.gravity);
+  rotor_thrust_commands_ = rotor_thrusts_;
+}
+
+/**
+ *  @detail
+ */
+void QuadrotorPlant::step(const quadrotor_common::QuadrotorControlCommand& command, const double dt) {
+  const int substeps = std::max(1, parameters_.substeps);
+  const double h = dt / substeps;
+  for (int i = 0; i < substeps; ++i) {
+    mix(command);
+    integrate(h);
+  }
+}
+
+/**
+ *  @detail
+ */
+void QuadrotorPlant::stateEstimate(quadrotor_common::QuadrotorStateEstimate& state_estimate) const {
+  state_estimate.coordinate_frame = quadrotor_common::QuadrotorStateEstimate::CoordinateFrame::kWorld;
+  state_estimate.position = state_.position;
+  state_estimate.velocity = state_.velocity;
+  state_estimate.orientation = state_.orientation;
+  state_estimate.bodyrates = state_.bodyrates;
+}
+
+/**
+ *  @detail The torque of the bodyrate loop includes the gyroscopic term, i.e. the unsaturated
+ *          motors realize bodyrates_dot of QuadrotorDynamics after the motor lag.
+ */
+void QuadrotorPlant::mix(const quadrotor_common::QuadrotorControlCommand& command) {
+  Eigen::Vector3d bodyrates = command.bodyrates;
+  if (parameters_.attitude_gain > 0.0) {
+    const Eigen::Quaterniond error = state_.orientation.conjugate() * command.orientation;
+    bodyrates += parameters_.attitude_gain * (error.w() < 0.0 ? -2.0 : 2.0) * error.vec();
+  } //  low level attitude loop
+  const Eigen::Vector3d& w = state_.bodyrates;
+  const Eigen::Vector3d Jw = parameters_.inertia.cwiseProduct(w);
+  const Eigen::Vector3d torque = parameters_.inertia.cwiseProduct(
+      command.angular_acceleration + parameters_.bodyrate_gain * (bodyrates - w)) + w.cross(Jw);
+
+  Eigen::Vector4d wrench;
+  wrench << parameters_.mass * command.collective_thrust, torque;
+  rotor_thrust_commands_ = (mixer_ * wrench).cwiseMax(0.0).cwiseMin(parameters_.max_rotor_thrust);
+}
+
+/**
+ *  @detail
+ */
+void QuadrotorPlant::derivative(const QuadrotorState& state, const RotorThrusts& rotor_thrusts, Derivative& derivative) const {
+  const Eigen::Matrix3d R = state.orientation.toRotationMatrix();
+  const Eigen::Vector4d wrench = allocation_ * rotor_thrusts;
+
+  derivative.position = state.velocity;
+
+  const Eigen::Vector3d drag = R * parameters_.rotor_drag.cwiseProduct(R.transpose() * state.velocity);
+  derivative.velocity = wrench(0) / parameters_.mass * R.col(2) - drag;
+  derivative.velocity.z() -= parameters_.gravity;
+
+  const Eigen::Vector4d& q = state.orientation.coeffs();
+  const Eigen::Vector3d& w = state.bodyrates;
+  derivative.orientation <<  //  0.5 * q * (0, w), coefficients x, y, z, w
+      0.5 * ( q.w() * w.x() + q.y() * w.z() - q.z() * w.y()),
+      0.5 * ( q.w() * w.y() + q.z() * w.x() - q.x() * w.z()),
+      0.5 * ( q.w() * w.z() + q.x() * w.y() - q.y() * w.x()),
+      0.5 * (-q.x() * w.x() - q.y() * w.y() - q.z() * w.z());
+
+  derivative.bodyrates = (wrench.tail<3>() - w.cross(parameters_.inertia.cwiseProduct(w))).cwiseQuotient(parameters_.inertia);
+  derivative.rotor_thrusts = (rotor_thrust_commands_ - rotor_thrusts) / parameters_.motor_time_constant;
+}
+
+/**
+ *  @detail The orientation is renormalized after the step, i.e. kept on the unit sphere.
+ */
+void QuadrotorPlant::integrate(const double dt) {
+  auto advance = [this](const Derivative& d, const double h, QuadrotorState& state, RotorThrusts& rotor_thrusts) {
+    state.position = state_.position + h * d.position;
+    state.velocity = state_.velocity + h * d.velocity;
+    state.orientation.coeffs() = state_.orientation.coeffs() + h * d.orientation;
+    state.orientation.normalize();
+    state.bodyrates = state_.bodyrates + h * d.bodyrates;
+    rotor_thrusts = rotor_thrusts_ + h * d.rotor_thrusts;
+  };
+
+  Derivative k1, k2, k3, k4;
+  QuadrotorState state;
+  RotorThrusts rotor_thrusts;
+  derivative(state_, rotor_thrusts_, k1);
+  advance(k1, 0.5 * dt, state, rotor_thrusts);
+  derivative(state, rotor_thrusts, k2);
+  advance(k2, 0.5 * dt, state, rotor_thrusts);
+  derivative(state, rotor_thrusts, k3);
+  advance(k3, dt, state, rotor_thrusts);
+  derivative(state, rotor_thrusts, k4);
+
+  Derivative sum;
+  sum.position = k1.position + 2.0 * (k2.position + k3.position) + k4.position;
+  sum.velocity = k1.velocity + 2.0 * (k2.velocity + k3.velocity) + k4.velocity;
+  sum.orientation = k1.orientation + 2.0 * (k2.orientation + k3.orientation) + k4.orientation;
+  sum.bodyrates = k1.bodyrates + 2.0 * (k2.bodyrates + k3.bodyrates) + k4.bodyrates;
+  sum.rotor_thrusts = k1.rotor_thrusts + 2.0 * (k2.rotor_thrusts + k3.rotor_thrusts) + k4.rotor_thrusts;
+  advance(sum, dt / 6.0, state_, rotor_thrusts_);
+}
+
+} /*  namespace quadrotor_simulator  */
@@ -0,0 +1,230 @@
+/**
+ *  @file   test_monte_carlo.cpp
+ *  @brief  quadrotor's closed loop Monte Carlo campaign related functionality unit tests
+ *  @author thor
+ *  @date   15.12.2021
+ */
+#include "quadrotor_simulator/monte_carlo.h"
+
+//  std dependencies
+#include <cmath>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+namespace quadrotor_simulator {
+
+namespace {
+
+/**
+ *  @brief  Hover at 1m
+ */
+void hover(const double, quadrotor_common::QuadrotorTrajectoryPoint& point) {
+  point = quadrotor_common::QuadrotorTrajectoryPoint();
+  point.position = Eigen::Vector3d(0.0, 0.0, 1.0);
+}
+
+/**
+ *  @brief  1m radius circle at 1 rad/s, heading fixed
+ */
+void circle(const double time, quadrotor_common::QuadrotorTrajectoryPoint& point) {
+  point = quadrotor_common::QuadrotorTrajectoryPoint();
+  const double c = std::cos(time), s = std::sin(time);
+  point.position = Eigen::Vector3d(c, s, 1.0);
+  point.velocity = Eigen::Vector3d(-s, c, 0.0);
+  point.acceleration = Eigen::Vector3d(-c, -s, 0.0);
+  point.jerk = Eigen::Vector3d(s, -c, 0.0);
+  point.snap = Eigen::Vector3d(c, s, 0.0);
+}
+
+/**
+ *  @brief  Whether two runs are identical
+ */
+void expectEqual(const MonteCarloRun& expected, const MonteCarloRun& run) {
+  EXPECT_EQ(expected.seed, run.seed);
+  EXPECT_EQ(expected.rotor_drag, run.rotor_drag);
+  EXPECT_EQ(expected.metrics.ticks, run.metrics.ticks);
+  EXPECT_EQ(expected.metrics.diverged, run.metrics.diverged);
+  EXPECT_EQ(expected.metrics.max_position_error, run.metrics.max_position_error);
+  EXPECT_EQ(expected.metrics.rms_position_error, run.metrics.rms_position_error);
+  EXPECT_EQ(expected.metrics.rms_velocity_error, run.metrics.rms_velocity_error);
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  The unperturbed noise free flight tracks the reference with the feed forward terms,
+ *          the outer loop only corrects the lag of the low level loops
+ */
+TEST(ClosedLoopSimulationTest, Nominal) {
+  FlightParameters parameters;
+  parameters.duration = 2.0;
+  ClosedLoopSimulation simulation(hover, parameters);
+  QuadrotorState initial;
+  initial.position = Eigen::Vector3d(0.0, 0.0, 1.0);
+  FlightMetrics metrics = simulation.fly(QuadrotorDynamicsParameters(), initial);
+  EXPECT_FALSE(metrics.diverged);
+  EXPECT_EQ(2000u, metrics.ticks);
+  EXPECT_NEAR(2.0, metrics.time, 1e-12);
+  EXPECT_NEAR(0.0, metrics.max_position_error, 1e-9);
+
+  ClosedLoopSimulation circling(circle, parameters);
+  initial.position = Eigen::Vector3d(1.0, 0.0, 1.0);
+  initial.velocity = Eigen::Vector3d(0.0, 1.0, 0.0);
+  initial.orientation = Eigen::Quaterniond::FromTwoVectors(
+      Eigen::Vector3d::UnitZ(), Eigen::Vector3d(-1.0, 0.0, 9.81).normalized());
+  metrics = circling.fly(QuadrotorDynamicsParameters(), initial);
+  EXPECT_FALSE(metrics.diverged);
+  EXPECT_LT(metrics.max_position_error, 1e-2);  //  lag of the low level loops
+}
+
+/**
+ *  @brief  A flight leaving the divergence threshold is aborted, e.g. on the feed forward terms
+ *          only, which do not correct an initial velocity error
+ */
+TEST(ClosedLoopSimulationTest, Diverged) {
+  FlightParameters parameters;
+  parameters.position_gain = 0.0;
+  parameters.velocity_gain = 0.0;
+  ClosedLoopSimulation simulation(hover, parameters);
+  QuadrotorState initial;
+  initial.position = Eigen::Vector3d(0.0, 0.0, 1.0);
+  initial.velocity = Eigen::Vector3d(1.0, 0.0, 0.0);
+  const FlightMetrics metrics = simulation.fly(QuadrotorDynamicsParameters(), initial);
+  EXPECT_TRUE(metrics.diverged);
+  EXPECT_LT(metrics.time, 1.1);
+  EXPECT_GT(metrics.max_position_error, 1.0);
+}
+
+/**
+ *  @brief  The outer loop corrects a perturbed initial state, i.e. the same flight converges
+ *          onto the reference instead of diverging
+ */
+TEST(ClosedLoopSimulationTest, Feedback) {
+  ClosedLoopSimulation simulation(circle);
+  QuadrotorState initial;
+  initial.position = Eigen::Vector3d(1.2, -0.1, 0.9);
+  initial.velocity = Eigen::Vector3d(0.5, 1.0, 0.2);
+  const FlightMetrics metrics = simulation.fly(QuadrotorDynamicsParameters(), initial);
+  EXPECT_FALSE(metrics.diverged);
+  EXPECT_GT(metrics.max_position_error, 0.2);
+  EXPECT_LT(metrics.final_position_error, 1e-2);
+}
+
+/**
+ *  @brief  The state estimate noise is fed back, i.e. it degrades the tracking, and the flight
+ *          depends on the noise seed
+ */
+TEST(ClosedLoopSimulationTest, Noise) {
+  ClosedLoopSimulation simulation(circle);
+  QuadrotorState initial;
+  initial.position = Eigen::Vector3d(1.0, 0.0, 1.0);
+  initial.velocity = Eigen::Vector3d(0.0, 1.0, 0.0);
+  initial.orientation = Eigen::Quaterniond::FromTwoVectors(
+      Eigen::Vector3d::UnitZ(), Eigen::Vector3d(-1.0, 0.0, 9.81).normalized());
+  const FlightMetrics nominal = simulation.fly(QuadrotorDynamicsParameters(), initial);
+
+  const EstimateNoise noise = {0.05, 0.1, 0.0, 0.0};
+  const FlightMetrics noisy = simulation.fly(QuadrotorDynamicsParameters(), initial, noise, 1);
+  const FlightMetrics reseeded = simulation.fly(QuadrotorDynamicsParameters(), initial, noise, 2);
+  EXPECT_FALSE(noisy.diverged);
+  EXPECT_GT(noisy.rms_position_error, 2.0 * nominal.rms_position_error);
+  EXPECT_GT(noisy.rms_velocity_error, 2.0 * nominal.rms_velocity_error);
+  EXPECT_NE(noisy.rms_position_error, reseeded.rms_position_error);
+}
+
+/**
+ *  @brief  The runs depend on their seed only, not on the threads or the order of the runs
+ */
+TEST(MonteCarloCampaignTest, Deterministic) {
+  MonteCarloParameters parameters;
+  parameters.flight.duration = 0.5;
+  parameters.position_sigma = 0.01;
+  parameters.velocity_sigma = 0.01;
+
+  MonteCarloRuns single, parallel;
+  MonteCarloCampaign campaign(parameters, circle);
+  const MonteCarloSummary summary = campaign.run(0, 32, single);
+  parameters.num_threads = 3;
+  MonteCarloCampaign parallel_campaign(parameters, circle);
+  EXPECT_EQ(3, parallel_campaign.numThreads());
+  parallel_campaign.run(0, 32, parallel);
+
+  ASSERT_EQ(32u, single.size());
+  ASSERT_EQ(32u, parallel.size());
+  for (std::size_t i = 0; i < single.size(); ++i) {
+    expectEqual(single[i], parallel[i]);
+  }
+  expectEqual(single[17], parallel_campaign.runOne(17));
+  EXPECT_NE(single[0].seed, single[1].seed);
+  EXPECT_NE(single[0].rotor_drag, single[1].rotor_drag);
+  EXPECT_GE(single[0].rotor_drag.minCoeff(), 0.0);
+
+  MonteCarloRuns shifted;
+  parallel_campaign.run(16, 8, shifted);
+  expectEqual(single[20], shifted[4]);
+
+  EXPECT_EQ(32u, summary.runs);
+  EXPECT_GT(summary.seconds, 0.0);
+  EXPECT_GT(summary.runsPerHour(), 0.0);
+  EXPECT_NEAR(32 * 0.5, summary.flight_seconds, 1e-9);
+  EXPECT_LE(summary.p50_max_position_error, summary.p95_max_position_error);
+  EXPECT_LE(summary.p95_max_position_error, summary.p99_max_position_error);
+  EXPECT_LE(summary.p99_max_position_error, summary.worst_max_position_error);
+}
+
+/**
+ *  @brief  The runs of the default campaign start off the reference and converge onto it
+ */
+TEST(MonteCarloCampaignTest, Converged) {
+  MonteCarloParameters parameters;
+  parameters.num_threads = 4;
+  MonteCarloCampaign campaign(parameters, circle);
+  MonteCarloRuns runs;
+  const MonteCarloSummary summary = campaign.run(0, 64, runs);
+  EXPECT_EQ(0u, summary.diverged);
+  for (const MonteCarloRun& run : runs) {
+    EXPECT_GT(run.metrics.max_position_error, 0.01);
+    EXPECT_LT(run.metrics.final_position_error, 0.05);
+  }
+}
+
+/**
+ *  @brief  The summary counts diverged runs and takes the quantiles of the maximum errors
+ */
+TEST(MonteCarloCampaignTest, Summary) {
+  MonteCarloRuns runs(100);
+  for (std::size_t i = 0; i < runs.size(); ++i) {
+    runs[i].metrics.max_position_error = 0.01 * (100 - i);
+    runs[i].metrics.diverged = i < 5;
+    runs[i].metrics.time = 1.0;
+  }
+  const MonteCarloSummary summary = MonteCarloCampaign::summarize(runs);
+  EXPECT_EQ(100u, summary.runs);
+  EXPECT_EQ(5u, summary.diverged);
+  EXPECT_NEAR(0.05, summary.divergenceRate(), 1e-12);
+  EXPECT_NEAR(0.505, summary.mean_max_position_error, 1e-12);
+  EXPECT_NEAR(0.51, summary.p50_max_position_error, 1e-12);
+  EXPECT_NEAR(0.96, summary.p95_max_position_error, 1e-12);
+  EXPECT_NEAR(1.0, summary.worst_max_position_error, 1e-12);
+  EXPECT_NEAR(100.0, summary.flight_seconds, 1e-12);
+}
+
+} /*  namespace quadrotor_simulator  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_monte_carlo");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
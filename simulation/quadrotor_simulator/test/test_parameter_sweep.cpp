@@ -0,0 +1,173 @@
+/**
+ *  @file   test_parameter_sweep.cpp
+ *  @brief  quadrotor's closed loop rotor drag and gain parameter sweep related functionality unit tests
+ *  @author thor
+ *  @date   17.12.2021
+ */
+#include "quadrotor_simulator/parameter_sweep.h"
+
+//  std dependencies
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+namespace quadrotor_simulator {
+
+namespace {
+
+/**
+ *  @brief  2m radius circle at 2 rad/s, heading fixed, i.e. 4 m/s
+ */
+void circle(const double time, quadrotor_common::QuadrotorTrajectoryPoint& point) {
+  point = quadrotor_common::QuadrotorTrajectoryPoint();
+  const double c = std::cos(2.0 * time), s = std::sin(2.0 * time);
+  point.position = Eigen::Vector3d(2.0 * c, 2.0 * s, 1.0);
+  point.velocity = Eigen::Vector3d(-4.0 * s, 4.0 * c, 0.0);
+  point.acceleration = Eigen::Vector3d(-8.0 * c, -8.0 * s, 0.0);
+  point.jerk = Eigen::Vector3d(16.0 * s, -16.0 * c, 0.0);
+  point.snap = Eigen::Vector3d(32.0 * c, 32.0 * s, 0.0);
+}
+
+/**
+ *  @brief  Sweep parameters of a lap on the plant with rotor drag
+ */
+ParameterSweepParameters lap(const int num_threads) {
+  ParameterSweepParameters parameters;
+  parameters.num_threads = num_threads;
+  parameters.flight.duration = M_PI;
+  parameters.flight.divergence_threshold = 5.0;
+  parameters.plant.rotor_drag = Eigen::Vector3d(0.4, 0.4, 0.1);
+  return parameters;
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  The grid takes every combination, dx varying fastest, a single value range is constant
+ */
+TEST(ParameterSweepTest, Grid) {
+  SweepSpace space;
+  space.dx = {0.0, 1.0, 3};
+  space.dy = {0.5, 0.5, 1};
+  space.dz = {0.0, 0.2, 2};
+  space.bodyrate_gain = {40.0, 60.0, 2};
+  const SweepPoints points = ParameterSweep::grid(space);
+
+  ASSERT_EQ(12u, points.size());
+  EXPECT_EQ(0.0, points[0].rotor_drag.x());
+  EXPECT_EQ(0.5, points[1].rotor_drag.x());
+  EXPECT_EQ(1.0, points[2].rotor_drag.x());
+  EXPECT_EQ(0.2, points[3].rotor_drag.z());
+  EXPECT_EQ(60.0, points[6].bodyrate_gain);
+  for (const SweepPoint& point : points) {
+    EXPECT_EQ(0.5, point.rotor_drag.y());
+    EXPECT_EQ(10.0, point.attitude_gain);
+  }
+}
+
+/**
+ *  @brief  Every stratum of every range is taken by exactly one point, and the design is seeded
+ */
+TEST(ParameterSweepTest, LatinHypercube) {
+  SweepSpace space;
+  space.dx = {0.0, 1.0, 1};
+  space.dy = {0.0, 2.0, 1};
+  space.dz = {0.25, 0.25, 1};
+  constexpr std::size_t kPoints = 64;
+  const SweepPoints points = ParameterSweep::latinHypercube(space, kPoints, 7);
+
+  ASSERT_EQ(kPoints, points.size());
+  std::vector<int> dx_strata(kPoints, 0), dy_strata(kPoints, 0);
+  for (const SweepPoint& point : points) {
+    ASSERT_GE(point.rotor_drag.x(), 0.0);
+    ASSERT_LT(point.rotor_drag.x(), 1.0);
+    ASSERT_GE(point.rotor_drag.y(), 0.0);
+    ASSERT_LT(point.rotor_drag.y(), 2.0);
+    ++dx_strata[static_cast<std::size_t>(point.rotor_drag.x() * kPoints)];
+    ++dy_strata[static_cast<std::size_t>(point.rotor_drag.y() / 2.0 * kPoints)];
+    EXPECT_EQ(0.25, point.rotor_drag.z());
+    EXPECT_EQ(10.0, point.attitude_gain);
+  }
+  EXPECT_EQ(std::vector<int>(kPoints, 1), dx_strata);
+  EXPECT_EQ(std::vector<int>(kPoints, 1), dy_strata);
+
+  const SweepPoints again = ParameterSweep::latinHypercube(space, kPoints, 7);
+  EXPECT_EQ(points[13].rotor_drag, again[13].rotor_drag);
+}
+
+/**
+ *  @brief  Diverged results rank last, the others by rms position error, ties by index
+ */
+TEST(ParameterSweepTest, Rank) {
+  SweepResults results(4);
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    results[i].index = i;
+  }
+  results[0].metrics.rms_position_error = 0.3;
+  results[1].metrics.rms_position_error = 0.1;
+  results[1].metrics.diverged = true;
+  results[2].metrics.rms_position_error = 0.2;
+  results[3].metrics.rms_position_error = 0.2;
+  ParameterSweep::rank(results);
+
+  EXPECT_EQ(2u, results[0].index);
+  EXPECT_EQ(3u, results[1].index);
+  EXPECT_EQ(0u, results[2].index);
+  EXPECT_EQ(1u, results[3].index);
+}
+
+/**
+ *  @brief  The controller compensating the plant's rotor drag tracks best, i.e. the sweep
+ *          recovers the plant's dx, dy, and the results do not depend on the number of threads
+ */
+TEST(ParameterSweepTest, RecoversRotorDrag) {
+  SweepSpace space;
+  space.dx = {0.0, 0.8, 5};
+  space.dy = {0.0, 0.8, 5};
+  space.dz = {0.1, 0.1, 1};
+  const SweepPoints points = ParameterSweep::grid(space);
+
+  ParameterSweep sweep(lap(1), circle);
+  SweepResults results;
+  sweep.run(points, results);
+  ParameterSweep::rank(results);
+  EXPECT_NEAR(0.4, results[0].point.rotor_drag.x(), 1e-12);
+  EXPECT_NEAR(0.4, results[0].point.rotor_drag.y(), 1e-12);
+  EXPECT_FALSE(results[0].metrics.diverged);
+  EXPECT_LT(results[0].metrics.rms_position_error, 0.5 * results[1].metrics.rms_position_error);
+
+  const FlightMetrics uncompensated = sweep.runOne(SweepPoint());
+  EXPECT_LT(5.0 * results[0].metrics.rms_position_error, uncompensated.rms_position_error);
+
+  ParameterSweep parallel(lap(4), circle);
+  SweepResults parallel_results;
+  parallel.run(points, parallel_results);
+  ParameterSweep::rank(parallel_results);
+  ASSERT_EQ(results.size(), parallel_results.size());
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i].index, parallel_results[i].index);
+    EXPECT_EQ(results[i].metrics.rms_position_error, parallel_results[i].metrics.rms_position_error);
+  }
+}
+
+} /*  namespace quadrotor_simulator  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_parameter_sweep");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,137 @@
+/**
+ *  @file   test_quadrotor_dynamics.cpp
+ *  @brief  quadrotor's nominal closed loop dynamics model related functionality unit tests
+ *  @author thor
+ *  @date   15.12.2021
+ */
+#include "quadrotor_simulator/quadrotor_dynamics.h"
+
+//  std dependencies
+#include <cmath>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+namespace quadrotor_simulator {
+
+namespace {
+
+constexpr double kDt = 0.001;
+
+/**
+ *  @brief  Integrate the dynamics for the duration, holding the command
+ */
+void integrate(QuadrotorDynamics& dynamics, const quadrotor_common::QuadrotorControlCommand& command, const double duration) {
+  const int steps = std::lround(duration / kDt);
+  for (int i = 0; i < steps; ++i) {
+    dynamics.step(command, kDt);
+  }
+}
+
+/**
+ *  @brief  The hover command, i.e. level and gravity compensating
+ */
+quadrotor_common::QuadrotorControlCommand hover() {
+  quadrotor_common::QuadrotorControlCommand command;
+  command.collective_thrust = 9.81;
+  return command;
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  The hover command keeps the state
+ */
+TEST(QuadrotorDynamicsTest, Hover) {
+  QuadrotorDynamics dynamics;
+  QuadrotorState state;
+  state.position = Eigen::Vector3d(1.0, 2.0, 3.0);
+  dynamics.setState(state);
+  integrate(dynamics, hover(), 2.0);
+
+  EXPECT_NEAR(0.0, (dynamics.state().position - state.position).norm(), 1e-12);
+  EXPECT_NEAR(0.0, dynamics.state().velocity.norm(), 1e-12);
+  EXPECT_NEAR(0.0, dynamics.state().orientation.angularDistance(state.orientation), 1e-12);
+}
+
+/**
+ *  @brief  Without thrust the quadrotor falls, the polynomial solution is integrated exactly
+ */
+TEST(QuadrotorDynamicsTest, FreeFall) {
+  QuadrotorDynamics dynamics;
+  QuadrotorState state;
+  state.velocity = Eigen::Vector3d(1.0, 0.0, 2.0);
+  dynamics.setState(state);
+  quadrotor_common::QuadrotorControlCommand command = hover();
+  command.collective_thrust = 0.0;
+  integrate(dynamics, command, 1.0);
+
+  EXPECT_NEAR(1.0, dynamics.state().position.x(), 1e-9);
+  EXPECT_NEAR(2.0 - 0.5 * 9.81, dynamics.state().position.z(), 1e-9);
+  EXPECT_NEAR(2.0 - 9.81, dynamics.state().velocity.z(), 1e-9);
+}
+
+/**
+ *  @brief  The rotor drag decelerates the level quadrotor exponentially, dx along x_B, dy along y_B
+ */
+TEST(QuadrotorDynamicsTest, RotorDrag) {
+  QuadrotorDynamicsParameters parameters;
+  parameters.rotor_drag = Eigen::Vector3d(0.5, 0.2, 0.0);
+  QuadrotorDynamics dynamics(parameters);
+  QuadrotorState state;
+  state.velocity = Eigen::Vector3d(2.0, 1.0, 0.0);
+  state.orientation = Eigen::AngleAxisd(0.5 * M_PI, Eigen::Vector3d::UnitZ());
+  dynamics.setState(state);
+  quadrotor_common::QuadrotorControlCommand command = hover();
+  command.orientation = state.orientation;
+  integrate(dynamics, command, 1.0);
+
+  //  x_W is along -y_B, y_W along x_B
+  EXPECT_NEAR(2.0 * std::exp(-0.2), dynamics.state().velocity.x(), 1e-9);
+  EXPECT_NEAR(1.0 * std::exp(-0.5), dynamics.state().velocity.y(), 1e-9);
+  EXPECT_NEAR(0.0, dynamics.state().velocity.z(), 1e-9);
+}
+
+/**
+ *  @brief  The bodyrates rotate the quadrotor, the attitude loop turns it onto the commanded orientation
+ */
+TEST(QuadrotorDynamicsTest, Attitude) {
+  QuadrotorDynamicsParameters parameters;
+  parameters.attitude_gain = 0.0;
+  QuadrotorDynamics dynamics(parameters);
+  QuadrotorState state;
+  state.bodyrates = Eigen::Vector3d(0.0, 0.0, 1.0);
+  dynamics.setState(state);
+  quadrotor_common::QuadrotorControlCommand command = hover();
+  command.bodyrates = state.bodyrates;
+  integrate(dynamics, command, 1.0);
+  EXPECT_NEAR(0.0, dynamics.state().orientation.angularDistance(
+      Eigen::Quaterniond(Eigen::AngleAxisd(1.0, Eigen::Vector3d::UnitZ()))), 1e-9);
+
+  dynamics.setParameters(QuadrotorDynamicsParameters());
+  dynamics.setState(QuadrotorState());
+  command.bodyrates.setZero();
+  command.orientation = Eigen::AngleAxisd(0.3, Eigen::Vector3d(1.0, 1.0, 0.0).normalized());
+  integrate(dynamics, command, 2.0);
+  EXPECT_NEAR(0.0, dynamics.state().orientation.angularDistance(command.orientation), 1e-6);
+  EXPECT_NEAR(0.0, dynamics.state().bodyrates.norm(), 1e-6);
+}
+
+} /*  namespace quadrotor_simulator  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_quadrotor_dynamics");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,187 @@
+/**
+ *  @file   test_quadrotor_plant.cpp
+ *  @brief  quadrotor's headless rigid body plant related functionality unit tests
+ *  @author thor
+ *  @date   16.12.2021
+ */
+#include "quadrotor_simulator/quadrotor_plant.h"
+
+//  std dependencies
+#include <cmath>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+//  quadrotor_simulator dependencies
+#include "quadrotor_simulator/closed_loop_simulation.h"
+
+namespace quadrotor_simulator {
+
+namespace {
+
+constexpr double kDt = 0.001;
+
+/**
+ *  @brief  Integrate the plant for the duration, holding the command
+ */
+void integrate(QuadrotorPlant& plant, const quadrotor_common::QuadrotorControlCommand& command, const double duration) {
+  const int steps = std::lround(duration / kDt);
+  for (int i = 0; i < steps; ++i) {
+    plant.step(command, kDt);
+  }
+}
+
+/**
+ *  @brief  The hover command, i.e. level and gravity compensating
+ */
+quadrotor_common::QuadrotorControlCommand hover() {
+  quadrotor_common::QuadrotorControlCommand command;
+  command.collective_thrust = 9.81;
+  return command;
+}
+
+/**
+ *  @brief  1m radius circle at 1 rad/s, heading fixed
+ */
+void circle(const double time, quadrotor_common::QuadrotorTrajectoryPoint& point) {
+  point = quadrotor_common::QuadrotorTrajectoryPoint();
+  const double c = std::cos(time), s = std::sin(time);
+  point.position = Eigen::Vector3d(c, s, 1.0);
+  point.velocity = Eigen::Vector3d(-s, c, 0.0);
+  point.acceleration = Eigen::Vector3d(-c, -s, 0.0);
+  point.jerk = Eigen::Vector3d(s, -c, 0.0);
+  point.snap = Eigen::Vector3d(c, s, 0.0);
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  The hover command keeps the state, the rotors at a quarter of the weight each
+ */
+TEST(QuadrotorPlantTest, Hover) {
+  QuadrotorPlant plant;
+  QuadrotorState state;
+  state.position = Eigen::Vector3d(1.0, 2.0, 3.0);
+  plant.setState(state);
+  integrate(plant, hover(), 2.0);
+
+  const double rotor_thrust = 0.25 * plant.parameters().mass * 9.81;
+  EXPECT_NEAR(0.0, (plant.state().position - state.position).norm(), 1e-12);
+  EXPECT_NEAR(0.0, plant.state().velocity.norm(), 1e-12);
+  EXPECT_NEAR(0.0, plant.state().bodyrates.norm(), 1e-12);
+  EXPECT_NEAR(0.0, plant.state().orientation.angularDistance(state.orientation), 1e-12);
+  EXPECT_NEAR(0.0, (plant.rotorThrusts() - QuadrotorPlant::RotorThrusts::Constant(rotor_thrust)).norm(), 1e-12);
+}
+
+/**
+ *  @brief  The rotor thrusts follow a thrust step with the first order lag, the vertical
+ *          velocity integrates the lagged thrust
+ */
+TEST(QuadrotorPlantTest, MotorLag) {
+  QuadrotorPlant plant;
+  plant.setState(QuadrotorState());
+  quadrotor_common::QuadrotorControlCommand command = hover();
+  command.collective_thrust = 11.81;
+  const double tau = plant.parameters().motor_time_constant;
+  const double mass = plant.parameters().mass;
+
+  integrate(plant, command, 0.05);
+  const double expected = 0.25 * mass * (9.81 + 2.0 * (1.0 - std::exp(-0.05 / tau)));
+  EXPECT_NEAR(expected, plant.rotorThrusts()(0), 1e-7);  //  Runge Kutta 4 error of the exponential
+  EXPECT_NEAR(0.0, (plant.rotorThrusts() - QuadrotorPlant::RotorThrusts::Constant(expected)).norm(), 1e-7);
+
+  integrate(plant, command, 0.95);
+  EXPECT_NEAR(0.25 * mass * 11.81, plant.rotorThrusts()(0), 1e-9);
+  EXPECT_NEAR(2.0 * (1.0 - tau), plant.state().velocity.z(), 1e-6);
+  EXPECT_NEAR(0.0, plant.state().velocity.head<2>().norm(), 1e-12);
+}
+
+/**
+ *  @brief  The rotor thrusts saturate, i.e. the quadrotor cannot exceed four times the maximum,
+ *          reached after the motor lag
+ */
+TEST(QuadrotorPlantTest, Saturation) {
+  QuadrotorPlant plant;
+  plant.setState(QuadrotorState());
+  quadrotor_common::QuadrotorControlCommand command = hover();
+  command.collective_thrust = 100.0;
+  integrate(plant, command, 1.0);
+
+  const QuadrotorPlantParameters& parameters = plant.parameters();
+  EXPECT_NEAR(parameters.max_rotor_thrust, plant.rotorThrusts()(0), 1e-9);
+  const double acceleration = 4.0 * parameters.max_rotor_thrust / parameters.mass - 9.81;
+  EXPECT_NEAR(acceleration * (1.0 - parameters.motor_time_constant), plant.state().velocity.z(), 1e-6);
+}
+
+/**
+ *  @brief  The rotor drag decelerates the level quadrotor exponentially, dx along x_B, dy along y_B
+ */
+TEST(QuadrotorPlantTest, RotorDrag) {
+  QuadrotorPlantParameters parameters;
+  parameters.rotor_drag = Eigen::Vector3d(0.5, 0.25, 0.0);
+  QuadrotorPlant plant(parameters);
+  QuadrotorState state;
+  state.velocity = Eigen::Vector3d(1.0, 2.0, 0.0);
+  plant.setState(state);
+  integrate(plant, hover(), 1.0);
+
+  EXPECT_NEAR(std::exp(-0.5), plant.state().velocity.x(), 1e-9);
+  EXPECT_NEAR(2.0 * std::exp(-0.25), plant.state().velocity.y(), 1e-9);
+  EXPECT_NEAR(0.0, plant.state().velocity.z(), 1e-9);
+}
+
+/**
+ *  @brief  The attitude loop turns the plant to the commanded orientation through the motors
+ */
+TEST(QuadrotorPlantTest, Attitude) {
+  QuadrotorPlant plant;
+  plant.setState(QuadrotorState());
+  quadrotor_common::QuadrotorControlCommand command = hover();
+  command.orientation = Eigen::Quaterniond(Eigen::AngleAxisd(0.3, Eigen::Vector3d(1.0, 1.0, 0.0).normalized()));
+  integrate(plant, command, 2.0);
+
+  EXPECT_NEAR(0.0, plant.state().orientation.angularDistance(command.orientation), 1e-6);
+  EXPECT_NEAR(0.0, plant.state().bodyrates.norm(), 1e-6);
+}
+
+/**
+ *  @brief  Integration test of the PositionController on the plant: a start off the circle is
+ *          corrected by the outer loop, and the circle is then tracked up to the lag of the
+ *          motors and the low level loops
+ */
+TEST(PlantSimulationTest, Circle) {
+  FlightParameters parameters;
+  parameters.duration = 10.0;
+  PlantSimulation simulation(circle, parameters);
+  QuadrotorState initial;
+  initial.position = Eigen::Vector3d(1.3, -0.2, 0.8);
+  initial.velocity = Eigen::Vector3d(0.3, 0.8, 0.0);
+  initial.orientation = Eigen::Quaterniond::FromTwoVectors(
+      Eigen::Vector3d::UnitZ(), Eigen::Vector3d(-1.0, 0.0, 9.81).normalized());
+
+  const FlightMetrics metrics = simulation.fly(QuadrotorPlantParameters(), initial);
+  EXPECT_FALSE(metrics.diverged);
+  EXPECT_EQ(10000u, metrics.ticks);
+  EXPECT_GE(metrics.max_position_error, (initial.position - Eigen::Vector3d(1.0, 0.0, 1.0)).norm() - 1e-12);
+  EXPECT_LT(metrics.max_position_error, 0.5);
+  EXPECT_LT(metrics.final_position_error, 0.02);
+}
+
+} /*  namespace quadrotor_simulator  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_quadrotor_plant");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
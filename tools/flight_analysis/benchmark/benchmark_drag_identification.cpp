@@ -0,0 +1,127 @@
+/**
+ *  @file   benchmark_drag_identification.cpp
+ *  @brief  quadrotor's batch rotor drag identification from recorded flights related functionality benchmarks
+ *  @author thor
+ *  @date   18.12.2021
+ */
+#include "flight_analysis/drag_identification.h"
+
+//  std dependencies
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+#include <unistd.h>
+
+namespace flight_analysis {
+
+namespace {
+
+typedef std::vector<quadrotor_io::FlightRecord, Eigen::aligned_allocator<quadrotor_io::FlightRecord>> FlightRecords;
+
+//  @brief  Number of records of a benchmark flight, i.e. about 16 seconds at 1 kHz, and of logs
+constexpr int kRecords = 1 << 14;
+constexpr int kLogs = 8;
+
+/**
+ *  @brief  A recorded flight along a circle
+ */
+const FlightRecords& flight() {
+  static const FlightRecords records = []() {
+    FlightRecords records(kRecords);
+    for (int i = 0; i < kRecords; ++i) {
+      const double phase = 0.002 * i;
+      quadrotor_io::FlightRecord& record = records[i];
+      record.tick = i;
+      record.reference_state = quadrotor_common::QuadrotorTrajectoryPoint();
+      record.state_estimate = quadrotor_common::QuadrotorStateEstimate();
+      record.state_estimate.position = Eigen::Vector3d(2.0 * std::cos(phase), 2.0 * std::sin(phase), 1.0);
+      record.state_estimate.velocity = Eigen::Vector3d(-4.0 * std::sin(phase), 4.0 * std::cos(phase), 0.0);
+      record.state_estimate.orientation = Eigen::AngleAxisd(0.4, Eigen::Vector3d(std::cos(phase), std::sin(phase), 0.0));
+      record.control_command = quadrotor_common::QuadrotorControlCommand();
+      record.control_command.collective_thrust = 10.6;
+    }
+    return records;
+  }();
+  return records;
+}
+
+/**
+ *  @brief  The flight recorded into kLogs logs, removed at exit
+ */
+const std::vector<std::string>& logs() {
+  static const struct Logs {
+    Logs() {
+      quadrotor_io::FlightRecorderParameters parameters;
+      parameters.capacity = 2 * kRecords;
+      for (int i = 0; i < kLogs; ++i) {
+        paths.push_back("/tmp/benchmark_drag_identification_" + std::to_string(::getpid()) + "_" +
+                        std::to_string(i) + ".qflr");
+        quadrotor_io::FlightRecorder recorder(parameters);
+        recorder.start(paths.back());
+        for (const quadrotor_io::FlightRecord& record : flight()) {
+          recorder.push(record.tick, record.state_estimate, record.reference_state, record.control_command);
+        }
+        recorder.stop();
+      }
+    }
+    ~Logs() {
+      for (const std::string& path : paths) {
+        std::remove(path.c_str());
+      }
+    }
+    std::vector<std::string> paths;
+  } logs;
+  return logs.paths;
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  DragIdentifier::accumulate() of the flight in memory, i.e. the cost of a sample
+ */
+static void BM_DragIdentifierAccumulate(benchmark::State& state) {
+  const FlightRecords& records = flight();
+  DragIdentifierParameters parameters;
+  parameters.control_period = 0.001;
+  DragIdentifier identifier(parameters);
+
+  for (auto _ : state) {
+    DragNormalEquations equations;
+    identifier.accumulate(records.data(), records.size(), equations);
+    benchmark::DoNotOptimize(&equations);
+  }
+  state.SetItemsProcessed(state.iterations() * records.size());
+}
+BENCHMARK(BM_DragIdentifierAccumulate);
+
+/**
+ *  @brief  DragIdentifier::identify() of the logs on 1, 2, 4, ... threads up to the number of
+ *          cores, from the page cache
+ */
+static void BM_DragIdentifierIdentify(benchmark::State& state) {
+  const std::vector<std::string>& paths = logs();
+  DragIdentifierParameters parameters;
+  parameters.num_threads = state.range(0);
+  parameters.control_period = 0.001;
+  DragIdentifier identifier(parameters);
+
+  for (auto _ : state) {
+    DragIdentification identification;
+    identifier.identify(paths, identification);
+    benchmark::DoNotOptimize(&identification);
+  }
+  state.SetItemsProcessed(state.iterations() * kLogs * kRecords);
+}
+BENCHMARK(BM_DragIdentifierIdentify)
+    ->RangeMultiplier(2)
+    ->Range(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} /*  namespace flight_analysis  */
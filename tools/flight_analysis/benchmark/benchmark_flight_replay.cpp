@@ -0,0 +1,73 @@
+/**
+ *  @file   benchmark_flight_replay.cpp
+ *  @brief  quadrotor's parallel offline replay of recorded flights related functionality benchmarks
+ *  @author thor
+ *  @date   14.12.2021
+ */
+#include "flight_analysis/flight_replay.h"
+
+//  std dependencies
+#include <cmath>
+#include <thread>
+#include <vector>
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+
+namespace flight_analysis {
+
+namespace {
+
+typedef std::vector<quadrotor_io::FlightRecord, Eigen::aligned_allocator<quadrotor_io::FlightRecord>> FlightRecords;
+
+//  @brief  Number of records of the benchmark flight, i.e. about 5 minutes at 1 kHz
+constexpr int kRecords = 1 << 18;
+
+/**
+ *  @brief  A recorded flight along a circle
+ */
+const FlightRecords& flight() {
+  static const FlightRecords records = []() {
+    FlightRecords records(kRecords);
+    for (int i = 0; i < kRecords; ++i) {
+      const double phase = 0.002 * i;
+      quadrotor_io::FlightRecord& record = records[i];
+      record.tick = i;
+      record.reference_state = quadrotor_common::QuadrotorTrajectoryPoint();
+      record.reference_state.position = Eigen::Vector3d(2.0 * std::cos(phase), 2.0 * std::sin(phase), 1.0);
+      record.reference_state.acceleration = -4.0 * Eigen::Vector3d(std::cos(phase), std::sin(phase), 0.0);
+      record.reference_state.heading = phase;
+      record.state_estimate = quadrotor_common::QuadrotorStateEstimate();
+      record.state_estimate.position = record.reference_state.position;
+      record.control_command = quadrotor_common::QuadrotorControlCommand();
+    }
+    return records;
+  }();
+  return records;
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  FlightReplay::replay() of the flight on 1, 2, 4, ... threads up to the number of cores
+ */
+static void BM_FlightReplay(benchmark::State& state) {
+  const FlightRecords& records = flight();
+  FlightReplayParameters parameters;
+  parameters.num_threads = state.range(0);
+  FlightReplay replay(parameters);
+
+  for (auto _ : state) {
+    ReplayReport report;
+    replay.replay(records.data(), records.size(), report);
+    benchmark::DoNotOptimize(&report);
+  }
+  state.SetItemsProcessed(state.iterations() * records.size());
+}
+BENCHMARK(BM_FlightReplay)
+    ->RangeMultiplier(2)
+    ->Range(1, std::max(1u, std::thread::hardware_concurrency()))
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} /*  namespace flight_analysis  */
@@ -0,0 +1,240 @@
+/**
+ *  @file   drag_identification.h
+ *  @brief  quadrotor's batch rotor drag identification from recorded flights related functionality declaration & definition
+ *  @author thor
+ *  @date   18.12.2021
+ */
+#ifndef FLIGHT_ANALYSIS_DRAG_IDENTIFICATION_H
+#define FLIGHT_ANALYSIS_DRAG_IDENTIFICATION_H
+
+//  std dependencies
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+
+//  position_controller dependencies
+#include "position_controller/rotor_drag_models.h"
+#include "position_controller/thread_pool.h"
+#include "reference_inputs/reference_inputs.h"
+
+//  quadrotor_io dependencies
+#include "quadrotor_io/flight_recorder.h"
+
+namespace flight_analysis {
+
+/**
+ *  @brief  Normal equations of the rotor drag regression, see RotorDragEstimator::regression()
+ *  @detail The body axes decouple, i.e. the normal equations of each axis are the scalar sums
+ *          of phi^2, phi*y and y^2, the latter for the residual. The sums of separate logs are
+ *          merged by adding them.
+ */
+struct DragNormalEquations {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  Eigen::Vector3d phi_phi = Eigen::Vector3d::Zero();
+  Eigen::Vector3d phi_y = Eigen::Vector3d::Zero();
+  Eigen::Vector3d y_y = Eigen::Vector3d::Zero();
+  std::uint64_t samples = 0;
+
+  void add(const Eigen::Vector3d& phi, const Eigen::Vector3d& y) {
+    phi_phi += phi.cwiseProduct(phi);
+    phi_y += phi.cwiseProduct(y);
+    y_y += y.cwiseProduct(y);
+    ++samples;
+  }
+
+  void merge(const DragNormalEquations& other);
+};  /*  struct DragNormalEquations  */
+
+/**
+ *  @brief  The identified rotor drag of a set of logs
+ */
+struct DragIdentification {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  //  @brief  The coefficients dx, dy, dz [1/s], their standard deviations and the rms residual
+  //          of every axis [m/s^2], zero for an unexcited axis
+  Eigen::Vector3d rotor_drag = Eigen::Vector3d::Zero();
+  Eigen::Vector3d standard_deviation = Eigen::Vector3d::Zero();
+  Eigen::Vector3d rms_residual = Eigen::Vector3d::Zero();
+
+  //  @brief  Logs and records read, samples taken, i.e. consecutive record pairs, and logs
+  //          which could not be opened
+  std::size_t logs = 0;
+  std::size_t failed_logs = 0;
+  std::uint64_t records = 0;
+  std::uint64_t samples = 0;
+
+  //  @brief  Wall time [s]
+  double seconds = 0.0;
+
+  //  @brief  The coefficients as the rotor drag constants of the reference inputs, clamped to
+  //          be non negative
+  position_controller::AnisotropicRotorDrag rotorDrag() const;
+  position_controller::ReferenceInputsParameters referenceInputsParameters() const;
+
+  //  @brief  Records read per second
+  double throughput() const { return seconds > 0.0 ? records / seconds : 0.0; }
+};  /*  struct DragIdentification  */
+
+/**
+ *  @brief  Parameters of the DragIdentifier
+ */
+struct DragIdentifierParameters {
+  //  @brief  Number of workers including the calling thread, and whether to pin them
+  int num_threads = 1;
+  bool pin_threads = false;
+
+  //  @brief  Control period of the recordings [s], i.e. the time between consecutive ticks
+  double control_period = 0.01;
+
+  //  @brief  Gravity [m/s^2], along -z_W
+  double gravity = 9.81;
+
+  //  @brief  Record pairs further apart are skipped, e.g. dropped records or separate flights
+  std::uint64_t max_tick_gap = 1;
+
+  //  @brief  Records streamed at once, unmapped from the process after, i.e. 37 MB resident
+  //          per worker, see quadrotor_io::FlightLog::release()
+  std::size_t window_records = 1 << 16;
+};  /*  struct DragIdentifierParameters  */
+
+/**
+ *  @brief  DragIdentifier class implementation
+ *  @detail Least squares identification of the rotor drag D = diag(dx, dy, dz) from recorded
+ *          flights (see quadrotor_io::FlightRecorder), e.g. weeks of logs, the offline
+ *          counterpart of the RotorDragEstimator: every pair of consecutive records is a
+ *          sample of the regression of RotorDragEstimator::regression(), with the collective
+ *          thrust commanded by the earlier record. The logs are spread across the workers of a
+ *          thread pool, each worker claiming the next log from a shared counter and streaming
+ *          it through its mapping into the log's own normal equations, window by window, each
+ *          window released from the process once done, i.e. the resident memory of the
+ *          process stays bounded by the windows of the workers however large the logs are.
+ *          The released pages stay in the page cache until the kernel reclaims them, as any
+ *          clean file page, i.e. a second identification of the same logs may be served from
+ *          it. The normal equations of the logs are reduced in the order of the logs and solved
+ *          once, i.e. the identification does not depend on the number of threads.
+ */
+class DragIdentifier {
+ public:
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  DragIdentifier's default constructor, called when an instance is created
+     */
+    explicit DragIdentifier(const DragIdentifierParameters& parameters = DragIdentifierParameters());
+
+    /**
+     *  @brief  DragIdentifier's default destructor, called when an instance is destroyed
+     */
+    ~DragIdentifier();
+
+    DragIdentifier(const DragIdentifier&) = delete;
+    DragIdentifier& operator=(const DragIdentifier&) = delete;
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Identify the rotor drag of the logs, logs which cannot be opened are skipped
+     *  @return boolean value where
+     *            + true  - Indicates all logs have been read
+     *            + false - Otherwise, see errors()
+     */
+    bool identify(const std::vector<std::string>& paths, DragIdentification& identification);
+
+    /**
+     *  @brief  Accumulate the samples of the n consecutive records into the normal equations
+     */
+    void accumulate(const quadrotor_io::FlightRecord* records, const std::size_t n, DragNormalEquations& equations) const;
+
+    /**
+     *  @brief  Solve the normal equations into the identification
+     */
+    static void solve(const DragNormalEquations& equations, DragIdentification& identification);
+
+    /**
+     *  @brief  Accessors
+     */
+    int numThreads() const { return thread_pool_.size(); }
+    const DragIdentifierParameters& parameters() const { return parameters_; }
+
+    //  @brief  One message per log which could not be opened by the last identify()
+    const std::vector<std::string>& errors() const { return errors_; }
+
+ private:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    //  @brief  The outcome of one log
+    struct Log {
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+      DragNormalEquations equations;
+      std::uint64_t records = 0;
+      std::string error;
+    };
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Stream the log at path into its outcome
+     */
+    void read(const std::string& path, Log& log) const;
+
+    /**
+     *  @brief  Accumulate the sample of the pair of consecutive records into the normal equations
+     */
+    void accumulatePair(
+        const quadrotor_io::FlightRecord& previous,
+        const quadrotor_io::FlightRecord& record,
+        DragNormalEquations& equations) const;
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    const DragIdentifierParameters parameters_;
+
+    //  @brief  The workers
+    position_controller::ThreadPool thread_pool_;
+
+    std::vector<std::string> errors_;
+
+};  /*  class DragIdentifier  */
+
+/**
+ *  @brief  Write the rotor drag coefficients of the reference inputs parameters as the line
+ *          "rotor_drag_coefficients: [dx, dy, dz]", i.e. a YAML mapping of one key
+ *  @return boolean value where
+ *            + true  - Indicates the file has been written
+ *            + false - Otherwise
+ */
+bool writeRotorDragCoefficients(const std::string& path, const position_controller::ReferenceInputsParameters& parameters);
+
+/**
+ *  @brief  Read the rotor drag coefficients written by writeRotorDragCoefficients() into the
+ *          reference inputs parameters, the other lines, e.g. comments or other keys, are ignored
+ *  @return boolean value where
+ *            + true  - Indicates the coefficients have been read
+ *            + false - Otherwise, i.e. the file could not be read or has no such line, the
+ *                      parameters are kept
+ */
+bool readRotorDragCoefficients(const std::string& path, position_controller::ReferenceInputsParameters& parameters);
+
+} /*  namespace flight_analysis  */
+
+#endif  /*  FLIGHT_ANALYSIS_DRAG_IDENTIFICATION_H  */
@@ -0,0 +1,221 @@
+/**
+ *  @file   flight_replay.h
+ *  @brief  quadrotor's parallel offline replay of recorded flights related functionality declaration & definition
+ *  @author thor
+ *  @date   14.12.2021
+ */
+#ifndef FLIGHT_ANALYSIS_FLIGHT_REPLAY_H
+#define FLIGHT_ANALYSIS_FLIGHT_REPLAY_H
+
+//  std dependencies
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+//  quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_control_command.h"
+#include "quadrotor_common/uninitialized.h"
+
+//  position_controller dependencies
+#include "position_controller/position_controller.h"
+#include "position_controller/thread_pool.h"
+
+//  quadrotor_io dependencies
+#include "quadrotor_io/flight_recorder.h"
+
+namespace flight_analysis {
+
+/**
+ *  @brief  Deviation of one control command field between the recording and the replay
+ */
+struct Deviation {
+  double max = 0.0;
+  double sum_squares = 0.0;
+  std::uint64_t count = 0;
+
+  //  @brief  The tick of the maximum deviation
+  std::uint64_t max_tick = 0;
+
+  void add(const double deviation, const std::uint64_t tick) {
+    if (deviation > max) {
+      max = deviation;
+      max_tick = tick;
+    }
+    sum_squares += deviation * deviation;
+    ++count;
+  }
+
+  void merge(const Deviation& other);
+
+  double rms() const;
+};  /*  struct Deviation  */
+
+/**
+ *  @brief  Report of a replay, accumulated over all replayed records
+ *  @detail The deviations are the norms of the differences of the recorded and the replayed
+ *          control command fields, the orientation's is the angle between both [rad].
+ */
+struct ReplayReport {
+  std::uint64_t records = 0;
+
+  Deviation orientation;
+  Deviation collective_thrust;
+  Deviation bodyrates;
+  Deviation angular_acceleration;
+
+  //  @brief  Wall time spent replaying [s]
+  double seconds = 0.0;
+
+  void merge(const ReplayReport& other);
+
+  //  @brief  Replayed records per second
+  double throughput() const { return seconds > 0.0 ? records / seconds : 0.0; }
+
+  //  @brief  The maximum deviation of all fields
+  double maxDeviation() const;
+};  /*  struct ReplayReport  */
+
+/**
+ *  @brief  Parameters of the FlightReplay
+ */
+struct FlightReplayParameters {
+  //  @brief  Number of workers including the calling thread
+  int num_threads = 1;
+
+  //  @brief  Records a worker takes at once, i.e. a few pages of the log
+  std::size_t chunk_records = 4096;
+
+  //  @brief  Pin worker i to core i, see ThreadPool
+  bool pin_threads = false;
+};  /*  struct FlightReplayParameters  */
+
+/**
+ *  @brief  FlightReplay_ class implementation
+ *  @detail Re-run recorded flights (see quadrotor_io::FlightRecorder) through the
+ *          PositionController_ of the current build, of the rotor drag model and coefficients
+ *          the flights were recorded with, and compare the recomputed control commands
+ *          with the recorded ones, e.g. as a regression check of controller changes.
+ *          A control tick depends on its state estimate and reference state only, so the
+ *          records of a log are sharded across the workers of a thread pool: the log is
+ *          mapped, not parsed, and every worker claims the next chunk of records from a shared
+ *          counter and replays it with its own controller, reset at the start of the chunk,
+ *          into the report of the chunk, each record copied into a buffer of the worker, see
+ *          quadrotor_io::FlightLog::read(). The chunk reports are merged in order once the log
+ *          is done, i.e. a replay is deterministic for a given chunk_records, whatever the
+ *          number of threads and the scheduling. The heading frame cache of the recording controller
+ *          was not reset at the chunk boundaries, so an unchanged controller reproduces the
+ *          recording up to the rounding errors of the cache, about 1e-11.
+ *  @tparam RotorDragModel - rotor drag model policy of the controller, see rotor_drag_models.h
+ */
+template <typename RotorDragModel>
+class FlightReplay_ {
+ public:
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  FlightReplay_'s default constructor, called when an instance is created
+     *  @param  parameters  - sharding of the records, see FlightReplayParameters
+     *  @param  rotor_drag  - rotor drag coefficients of the recording controller
+     */
+    explicit FlightReplay_(
+        const FlightReplayParameters& parameters = FlightReplayParameters(),
+        const RotorDragModel& rotor_drag = RotorDragModel());
+
+    /**
+     *  @brief  FlightReplay_'s default destructor, called when an instance is destroyed
+     */
+    ~FlightReplay_();
+
+    FlightReplay_(const FlightReplay_&) = delete;
+    FlightReplay_& operator=(const FlightReplay_&) = delete;
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Replay the flight log and merge the outcome into the report
+     *  @return boolean value where
+     *            + true  - Indicates the log has been replayed
+     *            + false - Otherwise, i.e. it could not be opened, see error()
+     */
+    bool replay(const std::string& path, ReplayReport& report);
+
+    /**
+     *  @brief  Replay the n records and merge the outcome into the report
+     */
+    void replay(const quadrotor_io::FlightRecord* records, const std::size_t n, ReplayReport& report);
+
+    /**
+     *  @brief  Accessors
+     */
+    int numThreads() const { return thread_pool_.size(); }
+    const RotorDragModel& rotorDrag() const { return rotor_drag_; }
+    const std::string& error() const { return error_; }
+
+ private:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    //  @brief  The state of one worker, padded against false sharing with its neighbours
+    struct Worker {
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+      explicit Worker(const RotorDragModel& rotor_drag)
+          : controller(rotor_drag), command(quadrotor_common::kUninitialized) {}
+
+      position_controller::PositionController_<RotorDragModel> controller;
+      quadrotor_common::QuadrotorControlCommand command;
+      char padding[64];
+    };
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Replay the n records in chunks across the workers and merge the outcome into the report
+     *  @tparam ReadRecord  - const FlightRecord& (std::size_t i, FlightRecord& buffer), the i-th
+     *                        record, e.g. copied into the worker's buffer
+     */
+    template <typename ReadRecord>
+    void replayChunks(const std::size_t n, const ReadRecord& read_record, ReplayReport& report);
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    //  @brief  Chunking of the records, the reports are merged per chunk
+    const FlightReplayParameters parameters_;
+
+    //  @brief  Rotor drag coefficients of the workers' controllers
+    const RotorDragModel rotor_drag_;
+
+    //  @brief  One worker state per thread
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    //  @brief  The workers
+    position_controller::ThreadPool thread_pool_;
+
+    //  @brief  The reason the last replay of a log failed
+    std::string error_;
+
+};  /*  class FlightReplay_  */
+
+extern template class FlightReplay_<position_controller::NoRotorDrag>;
+extern template class FlightReplay_<position_controller::IsotropicRotorDrag>;
+extern template class FlightReplay_<position_controller::AnisotropicRotorDrag>;
+
+//  @brief  Replay of flights recorded with the controller of the nominal dynamics
+typedef FlightReplay_<position_controller::NoRotorDrag> FlightReplay;
+
+} /*  namespace flight_analysis  */
+
+#endif  /*  FLIGHT_ANALYSIS_FLIGHT_REPLAY_H  */
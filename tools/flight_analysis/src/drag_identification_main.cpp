@@ -0,0 +1,95 @@
+/**
+ *  @file   drag_identification_main.cpp
+ *  @brief  quadrotor's batch rotor drag identification from recorded flights command line tool
+ *  @author thor
+ *  @date   18.12.2021
+ *  @detail Identifies the rotor drag coefficients dx, dy, dz of the flight logs by least squares
+ *          and prints them as the rotor_drag_coefficients of the ReferenceInputsParameters, e.g.
+ *            $ drag_identification --threads 16 --period 0.01 --output drag.yaml flight_2021-12-*.qflr
+ *          The output is read back with readRotorDragCoefficients(), e.g. by flight_replay
+ *          --rotor-drag-file drag.yaml.
+ *          Exits with 1 if a log could not be read or no sample has been taken.
+ */
+#include "flight_analysis/drag_identification.h"
+
+//  std dependencies
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ *  @brief  Print the usage
+ */
+int usage(const char* program) {
+  std::fprintf(stderr,
+               "usage: %s [--threads N] [--period SECONDS] [--max-tick-gap TICKS] [--window RECORDS]\n"
+               "          [--output PATH] LOG...\n",
+               program);
+  return 2;
+}
+
+}  /*  namespace  */
+
+/**
+ *
+ */
+int main(int argc, char** argv) {
+  flight_analysis::DragIdentifierParameters parameters;
+  parameters.num_threads = std::max(1u, std::thread::hardware_concurrency());
+  const char* output = nullptr;
+  std::vector<std::string> paths;
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      parameters.num_threads = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--period") == 0 && i + 1 < argc) {
+      parameters.control_period = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--max-tick-gap") == 0 && i + 1 < argc) {
+      parameters.max_tick_gap = std::max(1ULL, std::strtoull(argv[++i], nullptr, 10));
+    } else if (std::strcmp(argv[i], "--window") == 0 && i + 1 < argc) {
+      parameters.window_records = std::max(2L, std::atol(argv[++i]));
+    } else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+      output = argv[++i];
+    } else if (argv[i][0] == '-') {
+      return usage(argv[0]);
+    } else {
+      paths.push_back(argv[i]);
+    }
+  }
+  if (paths.empty() || !(parameters.control_period > 0.0)) {
+    return usage(argv[0]);
+  }
+
+  flight_analysis::DragIdentifier identifier(parameters);
+  flight_analysis::DragIdentification identification;
+  const bool success = identifier.identify(paths, identification);
+  for (const std::string& error : identifier.errors()) {
+    std::fprintf(stderr, "%s\n", error.c_str());
+  }
+
+  std::printf("%llu samples of %llu records of %zu logs on %d threads in %.3f s, %.3g records/s\n",
+              static_cast<unsigned long long>(identification.samples),
+              static_cast<unsigned long long>(identification.records), identification.logs,
+              identifier.numThreads(), identification.seconds, identification.throughput());
+  const char* const axes[] = {"dx", "dy", "dz"};
+  for (int i = 0; i < 3; ++i) {
+    std::printf("  %s %10.6f +- %-10.3g rms residual %.4g m/s^2\n", axes[i], identification.rotor_drag(i),
+                identification.standard_deviation(i), identification.rms_residual(i));
+  }
+
+  const position_controller::ReferenceInputsParameters reference_inputs_parameters =
+      identification.referenceInputsParameters();
+  const Eigen::Vector3d& d = reference_inputs_parameters.rotor_drag_coefficients;
+  std::printf("rotor_drag_coefficients: [%.6f, %.6f, %.6f]\n", d.x(), d.y(), d.z());
+  if (output != nullptr && !flight_analysis::writeRotorDragCoefficients(output, reference_inputs_parameters)) {
+    std::fprintf(stderr, "cannot write %s\n", output);
+    return 1;
+  }
+  return success && identification.samples > 0 ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+/**
+ *  @file   drag_identification.cpp
+ *  @brief  quadrotor's batch rotor drag identification from recorded flights related functionality implementation
+ *  @author thor
+ *  @date   18.12.2021
+ */
+#include "flight_analysis/drag_identification.h"
+
+//  std dependencies
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+//  position_controller dependencies
+#include "position_controller/rotor_drag_estimator.h"
+
+namespace flight_analysis {
+
+/**
+ *  @detail
+ */
+void DragNormalEquations::merge(const DragNormalEquations& other) {
+  phi_phi += other.phi_phi;
+  phi_y += other.phi_y;
+  y_y += other.y_y;
+  samples += other.samples;
+}
+
+/**
+ *  @detail
+ */
+position_controller::AnisotropicRotorDrag DragIdentification::rotorDrag() const {
+  const Eigen::Vector3d d = rotor_drag.cwiseMax(0.0);
+  return position_controller::AnisotropicRotorDrag(d.x(), d.y(), d.z());
+}
+
+/**
+ *  @detail
+ */
+position_controller::ReferenceInputsParameters DragIdentification::referenceInputsParameters() const {
+  position_controller::ReferenceInputsParameters parameters;
+  parameters.rotor_drag_coefficients = rotor_drag.cwiseMax(0.0);
+  return parameters;
+}
+
+/**
+ *  @detail DragIdentifier's default constructor definition
+ */
+DragIdentifier::DragIdentifier(const DragIdentifierParameters& parameters)
+    : parameters_(parameters),
+      thread_pool_(parameters.num_threads, parameters.pin_threads) {}
+
+/**
+ *  @detail DragIdentifier's default destructor definition
+ */
+DragIdentifier::~DragIdentifier() {}
+
+/**
+ *  @detail The logs are claimed one by one, i.e. large and small logs balance out as long as
+ *          there are more logs than workers. A worker accumulates into its stack and writes the
+ *          outcome of a log once, i.e. the workers do not share cache lines while streaming.
+ */
+bool DragIdentifier::identify(const std::vector<std::string>& paths, DragIdentification& identification) {
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::vector<Log, Eigen::aligned_allocator<Log>> logs(paths.size());
+  std::atomic<std::size_t> next(0);
+  thread_pool_.run([&](const int) {
+    for (std::size_t i = next.fetch_add(1); i < paths.size(); i = next.fetch_add(1)) {
+      read(paths[i], logs[i]);
+    }
+  });
+
+  DragNormalEquations equations;
+  identification = DragIdentification();
+  errors_.clear();
+  for (const Log& log : logs) {
+    equations.merge(log.equations);
+    identification.records += log.records;
+    if (!log.error.empty()) {
+      errors_.push_back(log.error);
+    }
+  }
+  identification.logs = logs.size();
+  identification.failed_logs = errors_.size();
+  solve(equations, identification);
+  identification.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return errors_.empty();
+}
+
+/**
+ *  @detail The records are copied into two alternating buffers, i.e. a window is released as
+ *          soon as its last record is read and the pair across windows is still taken.
+ */
+void DragIdentifier::read(const std::string& path, Log& log) const {
+  quadrotor_io::FlightLog flight_log;
+  if (!flight_log.open(path)) {
+    log.error = path + ": " + flight_log.error();
+    return;
+  }
+
+  DragNormalEquations equations;
+  quadrotor_io::FlightRecord records[2];
+  const std::size_t window = std::max<std::size_t>(parameters_.window_records, 1);
+  for (std::size_t begin = 0; begin < flight_log.size(); begin += window) {
+    const std::size_t end = std::min(flight_log.size(), begin + window);
+    for (std::size_t i = begin; i < end; ++i) {
+      flight_log.read(i, records[i & 1]);
+      if (i > 0) {
+        accumulatePair(records[(i - 1) & 1], records[i & 1], equations);
+      }
+    }
+    flight_log.release(begin, end - begin);
+  }
+  log.equations = equations;
+  log.records = flight_log.size();
+}
+
+/**
+ *  @detail
+ */
+void DragIdentifier::accumulate(
+    const quadrotor_io::FlightRecord* records,
+    const std::size_t n,
+    DragNormalEquations& equations) const {
+  for (std::size_t i = 1; i < n; ++i) {
+    accumulatePair(records[i - 1], records[i], equations);
+  }
+}
+
+/**
+ *  @detail Pairs with a non finite sample, e.g. of an estimator reset, are skipped.
+ */
+void DragIdentifier::accumulatePair(
+    const quadrotor_io::FlightRecord& previous,
+    const quadrotor_io::FlightRecord& record,
+    DragNormalEquations& equations) const {
+  if (record.tick <= previous.tick || record.tick - previous.tick > parameters_.max_tick_gap) {
+    return;
+  } //  dropped records, or another flight
+  Eigen::Vector3d phi, y;
+  position_controller::RotorDragEstimator::regression(
+      previous.state_estimate.velocity, previous.state_estimate.orientation, record.state_estimate,
+      previous.control_command.collective_thrust, (record.tick - previous.tick) * parameters_.control_period,
+      parameters_.gravity, phi, y);
+  if (phi.allFinite() && y.allFinite()) {
+    equations.add(phi, y);
+  }
+}
+
+/**
+ *  @detail Per axis d = sum(phi*y) / sum(phi^2), the residual sum of squares is
+ *          sum(y^2) - d*sum(phi*y) and the variance of d the residual variance over sum(phi^2).
+ */
+void DragIdentifier::solve(const DragNormalEquations& equations, DragIdentification& identification) {
+  identification.samples = equations.samples;
+  for (int i = 0; i < 3; ++i) {
+    if (!(equations.phi_phi(i) > 0.0) || equations.samples < 2) {
+      identification.rotor_drag(i) = 0.0;
+      identification.standard_deviation(i) = 0.0;
+      identification.rms_residual(i) = 0.0;
+      continue;
+    } //  not excited
+    const double d = equations.phi_y(i) / equations.phi_phi(i);
+    const double residual = std::max(0.0, equations.y_y(i) - d * equations.phi_y(i));
+    identification.rotor_drag(i) = d;
+    identification.rms_residual(i) = std::sqrt(residual / equations.samples);
+    identification.standard_deviation(i) = std::sqrt(residual / (equations.samples - 1) / equations.phi_phi(i));
+  }
+}
+
+/**
+ *  @detail
+ */
+bool writeRotorDragCoefficients(const std::string& path, const position_controller::ReferenceInputsParameters& parameters) {
+  std::FILE* const file = std::fopen(path.c_str(), "w");
+  if (file == nullptr) {
+    return false;
+  }
+  const Eigen::Vector3d& d = parameters.rotor_drag_coefficients;
+  const bool written = std::fprintf(file, "rotor_drag_coefficients: [%.9g, %.9g, %.9g]\n", d.x(), d.y(), d.z()) > 0;
+  return std::fclose(file) == 0 && written;
+}
+
+/**
+ *  @detail A line matches if it is the key followed by a flow sequence of three numbers, up to
+ *          white space, e.g. "rotor_drag_coefficients: [0.4, 0.3, 0.1]".
+ */
+bool readRotorDragCoefficients(const std::string& path, position_controller::ReferenceInputsParameters& parameters) {
+  std::FILE* const file = std::fopen(path.c_str(), "r");
+  if (file == nullptr) {
+    return false;
+  }
+  bool read = false;
+  char line[256];
+  while (!read && std::fgets(line, sizeof(line), file) != nullptr) {
+    double dx, dy, dz;
+    int end = -1;
+    if (std::sscanf(line, " rotor_drag_coefficients : [ %lf , %lf , %lf ]%n", &dx, &dy, &dz, &end) == 3 && end > 0) {
+      parameters.rotor_drag_coefficients = Eigen::Vector3d(dx, dy, dz);
+      read = true;
+    }
+  }
+  std::fclose(file);
+  return read;
+}
+
+} /*  namespace flight_analysis  */
@@ -0,0 +1,166 @@
+/**
+ *  @file   flight_replay.cpp
+ *  @brief  quadrotor's parallel offline replay of recorded flights related functionality implementation
+ *  @author thor
+ *  @date   14.12.2021
+ */
+#include "flight_analysis/flight_replay.h"
+
+//  std dependencies
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+
+namespace flight_analysis {
+
+/**
+ *  @detail
+ */
+void Deviation::merge(const Deviation& other) {
+  if (other.max > max) {
+    max = other.max;
+    max_tick = other.max_tick;
+  }
+  sum_squares += other.sum_squares;
+  count += other.count;
+}
+
+/**
+ *  @detail
+ */
+double Deviation::rms() const {
+  return count > 0 ? std::sqrt(sum_squares / count) : 0.0;
+}
+
+/**
+ *  @detail
+ */
+void ReplayReport::merge(const ReplayReport& other) {
+  records += other.records;
+  orientation.merge(other.orientation);
+  collective_thrust.merge(other.collective_thrust);
+  bodyrates.merge(other.bodyrates);
+  angular_acceleration.merge(other.angular_acceleration);
+  seconds += other.seconds;
+}
+
+/**
+ *  @detail
+ */
+double ReplayReport::maxDeviation() const {
+  return std::max({orientation.max, collective_thrust.max, bodyrates.max, angular_acceleration.max});
+}
+
+/**
+ *  @detail FlightReplay_'s default constructor definition
+ */
+template <typename RotorDragModel>
+FlightReplay_<RotorDragModel>::FlightReplay_(
+    const FlightReplayParameters& parameters,
+    const RotorDragModel& rotor_drag)
+    : parameters_(parameters),
+      rotor_drag_(rotor_drag),
+      thread_pool_(parameters.num_threads, parameters.pin_threads) {
+  workers_.reserve(thread_pool_.size());
+  for (int worker = 0; worker < thread_pool_.size(); ++worker) {
+    workers_.emplace_back(new Worker(rotor_drag_));
+  }
+}
+
+/**
+ *  @detail FlightReplay_'s default destructor definition
+ */
+template <typename RotorDragModel>
+FlightReplay_<RotorDragModel>::~FlightReplay_() {}
+
+/**
+ *  @detail
+ */
+template <typename RotorDragModel>
+bool FlightReplay_<RotorDragModel>::replay(const std::string& path, ReplayReport& report) {
+  error_.clear();
+  quadrotor_io::FlightLog log;
+  if (!log.open(path)) {
+    error_ = log.error();
+    return false;
+  }
+  replayChunks(
+      log.size(),
+      [&log](const std::size_t i, quadrotor_io::FlightRecord& buffer) -> const quadrotor_io::FlightRecord& {
+        log.read(i, buffer);
+        return buffer;
+      },
+      report);
+  return true;
+}
+
+/**
+ *  @detail The records are in memory, i.e. read in place.
+ */
+template <typename RotorDragModel>
+void FlightReplay_<RotorDragModel>::replay(
+    const quadrotor_io::FlightRecord* records, const std::size_t n, ReplayReport& report) {
+  replayChunks(
+      n,
+      [records](const std::size_t i, quadrotor_io::FlightRecord&) -> const quadrotor_io::FlightRecord& {
+        return records[i];
+      },
+      report);
+}
+
+/**
+ *  @detail The chunks are claimed dynamically, i.e. a worker slowed down by page faults or
+ *          preemption takes fewer of them, and each chunk is a contiguous run of the mapped
+ *          log, which keeps the kernel's read ahead sequential per worker. The controller is
+ *          reset at the start of every chunk and every chunk has its own report, merged in
+ *          chunk order, i.e. the report depends on the chunking only, not on the number of
+ *          threads or on which worker took which chunk. Each worker computes into its own
+ *          command, i.e. a replayed record does not construct, and stamp, a command.
+ *          The buffer a worker reads the records into is on its stack, i.e. of the record's
+ *          cache line alignment.
+ */
+template <typename RotorDragModel>
+template <typename ReadRecord>
+void FlightReplay_<RotorDragModel>::replayChunks(
+    const std::size_t n, const ReadRecord& read_record, ReplayReport& report) {
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  const std::size_t chunk = std::max<std::size_t>(parameters_.chunk_records, 1);
+  std::vector<ReplayReport> chunk_reports((n + chunk - 1) / chunk);
+  std::atomic<std::size_t> next(0);
+
+  thread_pool_.run([&](const int index) {
+    position_controller::PositionController_<RotorDragModel>& controller = workers_[index]->controller;
+    quadrotor_common::QuadrotorControlCommand& command = workers_[index]->command;
+    quadrotor_io::FlightRecord buffer;
+    for (std::size_t begin = next.fetch_add(chunk); begin < n; begin = next.fetch_add(chunk)) {
+      const std::size_t end = std::min(n, begin + chunk);
+      ReplayReport& chunk_report = chunk_reports[begin / chunk];
+      controller.reset();
+      for (std::size_t i = begin; i < end; ++i) {
+        const quadrotor_io::FlightRecord& record = read_record(i, buffer);
+        controller.run(record.state_estimate, record.reference_state, command);
+        const quadrotor_common::QuadrotorControlCommand& recorded = record.control_command;
+
+        chunk_report.orientation.add(command.orientation.angularDistance(recorded.orientation), record.tick);
+        chunk_report.collective_thrust.add(
+            std::abs(command.collective_thrust - recorded.collective_thrust), record.tick);
+        chunk_report.bodyrates.add((command.bodyrates - recorded.bodyrates).norm(), record.tick);
+        chunk_report.angular_acceleration.add(
+            (command.angular_acceleration - recorded.angular_acceleration).norm(), record.tick);
+      }
+      chunk_report.records = end - begin;
+    }
+  });
+
+  for (const ReplayReport& chunk_report : chunk_reports) {
+    report.merge(chunk_report);
+  }
+  report.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template class FlightReplay_<position_controller::NoRotorDrag>;
+template class FlightReplay_<position_controller::IsotropicRotorDrag>;
+template class FlightReplay_<position_controller::AnisotropicRotorDrag>;
+
+} /*  namespace flight_analysis  */
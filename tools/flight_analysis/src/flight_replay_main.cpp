@@ -0,0 +1,136 @@
+/**
+ *  @file   flight_replay_main.cpp
+ *  @brief  quadrotor's parallel offline replay of recorded flights command line tool
+ *  @author thor
+ *  @date   14.12.2021
+ *  @detail Replays the flight logs through the PositionController of this build and reports
+ *          the deviations from the recorded control commands, e.g.
+ *            $ flight_replay --threads 16 --tolerance 1e-9 flight_2021-12-14_*.qflr
+ *          Exits with 1 if a log could not be replayed or a deviation exceeds the tolerance,
+ *          1e-9 by default, i.e. usable as a regression check. Flights recorded with rotor
+ *          drag compensation are replayed with their coefficients, e.g.
+ *            $ flight_replay --rotor-drag 0.4 0.3 0.1 flight_2021-12-14_*.qflr
+ *          or with the coefficients written by drag_identification --output, e.g.
+ *            $ flight_replay --rotor-drag-file drag.yaml flight_2021-12-14_*.qflr
+ */
+#include "flight_analysis/flight_replay.h"
+#include "flight_analysis/drag_identification.h"
+
+//  std dependencies
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+//  3rd party dependencies
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/time.h>
+#endif
+
+namespace {
+
+/**
+ *  @brief  Print one deviation row of the report
+ */
+void printDeviation(const char* field, const flight_analysis::Deviation& deviation) {
+  std::printf("  %-24s max %-12.6g rms %-12.6g max at tick %llu\n", field, deviation.max, deviation.rms(),
+              static_cast<unsigned long long>(deviation.max_tick));
+}
+
+/**
+ *  @brief  Print the usage
+ */
+int usage(const char* program) {
+  std::fprintf(stderr, "usage: %s [--threads N] [--chunk RECORDS] [--tolerance DEVIATION] "
+                       "[--rotor-drag DX DY DZ | --rotor-drag-file PATH] LOG...\n", program);
+  return 2;
+}
+
+/**
+ *  @brief  Replay the logs, print the report and return the exit code
+ */
+template <typename RotorDragModel>
+int replayLogs(const flight_analysis::FlightReplayParameters& parameters, const RotorDragModel& rotor_drag,
+               const double tolerance, const std::vector<std::string>& paths) {
+  flight_analysis::FlightReplay_<RotorDragModel> replay(parameters, rotor_drag);
+  flight_analysis::ReplayReport total;
+  bool success = true;
+  for (const std::string& path : paths) {
+    flight_analysis::ReplayReport report;
+    if (!replay.replay(path, report)) {
+      std::fprintf(stderr, "%s: %s\n", path.c_str(), replay.error().c_str());
+      success = false;
+      continue;
+    }
+    std::printf("%s: %llu records, max deviation %g\n", path.c_str(),
+                static_cast<unsigned long long>(report.records), report.maxDeviation());
+    total.merge(report);
+  }
+
+  std::printf("replayed %llu records of %zu logs on %d threads in %.3f s, %.3g points/s\n",
+              static_cast<unsigned long long>(total.records), paths.size(), replay.numThreads(),
+              total.seconds, total.throughput());
+  printDeviation("orientation [rad]", total.orientation);
+  printDeviation("collective thrust", total.collective_thrust);
+  printDeviation("bodyrates", total.bodyrates);
+  printDeviation("angular acceleration", total.angular_acceleration);
+
+  success = success && total.maxDeviation() <= tolerance;
+  return success ? 0 : 1;
+}
+
+}  /*  namespace  */
+
+/**
+ *
+ */
+int main(int argc, char** argv) {
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  //  wall clock ros time for the RosClock stamps, no ros master required
+  ros::Time::init();
+#endif
+  flight_analysis::FlightReplayParameters parameters;
+  parameters.num_threads = std::max(1u, std::thread::hardware_concurrency());
+  double tolerance = 1e-9;
+  bool rotor_drag = false;
+  position_controller::AnisotropicRotorDrag rotor_drag_coefficients;
+  std::vector<std::string> paths;
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      parameters.num_threads = std::max(1, std::atoi(argv[++i]));
+    } else if (std::strcmp(argv[i], "--chunk") == 0 && i + 1 < argc) {
+      parameters.chunk_records = std::max(1L, std::atol(argv[++i]));
+    } else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+      tolerance = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--rotor-drag") == 0 && i + 3 < argc) {
+      rotor_drag = true;
+      for (int axis = 0; axis < 3; ++axis) {
+        rotor_drag_coefficients.d[axis] = std::atof(argv[++i]);
+      }
+    } else if (std::strcmp(argv[i], "--rotor-drag-file") == 0 && i + 1 < argc) {
+      position_controller::ReferenceInputsParameters reference_inputs_parameters;
+      if (!flight_analysis::readRotorDragCoefficients(argv[++i], reference_inputs_parameters)) {
+        std::fprintf(stderr, "%s: no rotor_drag_coefficients\n", argv[i]);
+        return 1;
+      }
+      rotor_drag = true;
+      rotor_drag_coefficients.d = reference_inputs_parameters.rotor_drag_coefficients;
+    } else if (argv[i][0] == '-') {
+      return usage(argv[0]);
+    } else {
+      paths.push_back(argv[i]);
+    }
+  }
+  if (paths.empty()) {
+    return usage(argv[0]);
+  }
+
+  if (rotor_drag) {
+    return replayLogs(parameters, rotor_drag_coefficients, tolerance, paths);
+  }
+  return replayLogs(parameters, position_controller::NoRotorDrag(), tolerance, paths);
+}
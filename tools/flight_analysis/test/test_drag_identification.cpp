@@ -0,0 +1,266 @@
+/**
+ *  @file   test_drag_identification.cpp
+ *  @brief  quadrotor's batch rotor drag identification from recorded flights related functionality unit tests
+ *  @author thor
+ *  @date   18.12.2021
+ */
+#include "flight_analysis/drag_identification.h"
+
+//  std dependencies
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#include <unistd.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+//  position_controller dependencies
+#include "position_controller/reference_inputs_solver.h"
+
+namespace flight_analysis {
+
+/**
+ *  @brief  Test fixture for testing the class DragIdentifier
+ *  @detail reference: https://google.github.io/googletest/primer.html
+ */
+class DragIdentificationTest : public ::testing::Test {
+ protected:
+
+  typedef std::vector<quadrotor_io::FlightRecord, Eigen::aligned_allocator<quadrotor_io::FlightRecord>> FlightRecords;
+
+      /////////////////////////////////////////////////////
+      ////////////  Constructors & Destructors  ///////////
+      /////////////////////////////////////////////////////
+
+  /**
+   *  @brief  DragIdentificationTest's default constructor, called for each test to perform
+   *          setup tasks, i.e. three recorded flights with the rotor drag (0.4, 0.3, 0.1)
+   */
+  DragIdentificationTest() {
+    for (int i = 0; i < 3; ++i) {
+      paths_.push_back("/tmp/test_drag_identification_" + std::to_string(::getpid()) + "_" + std::to_string(i) + ".qflr");
+    }
+    record(paths_[0], 0.0, 3000, 0.0);
+    record(paths_[1], 7.0, 2000, 0.0);
+    record(paths_[2], 13.0, 500, 0.0);
+  }
+
+  /**
+   *  @brief  DragIdentificationTest's default destructor, called for each test to remove the logs
+   */
+  ~DragIdentificationTest() override {
+    for (const std::string& path : paths_) {
+      std::remove(path.c_str());
+    }
+  }
+
+      ////////////////////////////////////////
+      ////////////  Class Methods  ///////////
+      ////////////////////////////////////////
+
+  /**
+   *  @brief  The reference state of a 2m radius circle at 1.5 rad/s, climbing and sinking 0.5m
+   *          at 3 rad/s, heading fixed, i.e. all body axes see the velocity
+   */
+  static void sample(const double t, quadrotor_common::QuadrotorTrajectoryPoint& point) {
+    const double w = 1.5, c = std::cos(w * t), s = std::sin(w * t);
+    const double cz = std::cos(2.0 * w * t), sz = std::sin(2.0 * w * t);
+    point.position = Eigen::Vector3d(2.0 * c, 2.0 * s, 1.0 + 0.5 * sz);
+    point.velocity = Eigen::Vector3d(-2.0 * w * s, 2.0 * w * c, w * cz);
+    point.acceleration = Eigen::Vector3d(-2.0 * w * w * c, -2.0 * w * w * s, -2.0 * w * w * sz);
+    point.jerk = Eigen::Vector3d(2.0 * w * w * w * s, -2.0 * w * w * w * c, -4.0 * w * w * w * cz);
+    point.snap = Eigen::Vector3d(2.0 * w * w * w * w * c, 2.0 * w * w * w * w * s, 8.0 * w * w * w * w * sz);
+  }
+
+  /**
+   *  @brief  The n records of the flight from time start at 100 Hz: the true state estimate of
+   *          every tick and the thrust held until the next tick, with white velocity noise
+   */
+  FlightRecords fly(const double start, const int n, const double velocity_noise) {
+    position_controller::ReferenceInputsSolver_<position_controller::AnisotropicRotorDrag> solver(
+        position_controller::AnisotropicRotorDrag(0.4, 0.3, 0.1));
+    std::mt19937_64 generator(n);
+    std::normal_distribution<double> normal(0.0, velocity_noise);
+    auto noise = [&]() { return velocity_noise > 0.0 ? normal(generator) : 0.0; };
+
+    FlightRecords records(n);
+    for (int k = 0; k < n; ++k) {
+      const double t = start + k * kPeriod_;
+      quadrotor_io::FlightRecord& record = records[k];
+      record.tick = k;
+      record.state_estimate = quadrotor_common::QuadrotorStateEstimate();
+      record.reference_state = quadrotor_common::QuadrotorTrajectoryPoint();
+      record.control_command = quadrotor_common::QuadrotorControlCommand();
+      sample(t, record.reference_state);
+      solver.solve(record.state_estimate, record.reference_state, record.control_command);
+      record.state_estimate.position = record.reference_state.position;
+      record.state_estimate.velocity = record.reference_state.velocity + Eigen::Vector3d::NullaryExpr(noise);
+      record.state_estimate.orientation = record.control_command.orientation;
+
+      quadrotor_common::QuadrotorTrajectoryPoint midpoint;
+      quadrotor_common::QuadrotorControlCommand command;
+      sample(t + 0.5 * kPeriod_, midpoint);
+      solver.solve(record.state_estimate, midpoint, command);
+      record.control_command.collective_thrust = command.collective_thrust;
+    }
+    return records;
+  }
+
+  /**
+   *  @brief  Record the flight into the log, the ring holds all of it, i.e. nothing is dropped
+   */
+  void record(const std::string& path, const double start, const int n, const double velocity_noise) {
+    quadrotor_io::FlightRecorderParameters parameters;
+    parameters.capacity = 1 << 15;
+    quadrotor_io::FlightRecorder recorder(parameters);
+    ASSERT_TRUE(recorder.start(path));
+    for (const quadrotor_io::FlightRecord& record : fly(start, n, velocity_noise)) {
+      ASSERT_TRUE(recorder.push(record.tick, record.state_estimate, record.reference_state, record.control_command));
+    }
+    recorder.stop();
+  }
+
+      ////////////////////////////////////////
+      ////////////  Class Members  ///////////
+      ////////////////////////////////////////
+
+  static constexpr double kPeriod_ = 0.01;
+
+  std::vector<std::string> paths_;
+};
+
+constexpr double DragIdentificationTest::kPeriod_;
+
+/**
+ *  @brief  The logs identify the rotor drag up to the sampling error, independently of the
+ *          number of threads and the window size
+ */
+TEST_F(DragIdentificationTest, Logs) {
+  DragIdentifierParameters parameters;
+  parameters.control_period = kPeriod_;
+  DragIdentifier identifier(parameters);
+  DragIdentification identification;
+  ASSERT_TRUE(identifier.identify(paths_, identification));
+
+  EXPECT_EQ(3u, identification.logs);
+  EXPECT_EQ(0u, identification.failed_logs);
+  EXPECT_EQ(5500u, identification.records);
+  EXPECT_EQ(5497u, identification.samples);
+  EXPECT_NEAR(0.4, identification.rotor_drag.x(), 1e-3);
+  EXPECT_NEAR(0.3, identification.rotor_drag.y(), 1e-3);
+  EXPECT_NEAR(0.1, identification.rotor_drag.z(), 1e-3);
+  EXPECT_LT(identification.rms_residual.maxCoeff(), 1e-2);
+  EXPECT_GT(identification.seconds, 0.0);
+
+  const position_controller::ReferenceInputsParameters reference_inputs = identification.referenceInputsParameters();
+  EXPECT_EQ(identification.rotor_drag, reference_inputs.rotor_drag_coefficients);
+  EXPECT_EQ(identification.rotor_drag, identification.rotorDrag().d);
+
+  parameters.num_threads = 3;
+  parameters.window_records = 100;
+  DragIdentifier parallel(parameters);
+  DragIdentification parallel_identification;
+  ASSERT_TRUE(parallel.identify(paths_, parallel_identification));
+  EXPECT_EQ(identification.samples, parallel_identification.samples);
+  EXPECT_EQ(identification.rotor_drag, parallel_identification.rotor_drag);
+  EXPECT_EQ(identification.standard_deviation, parallel_identification.standard_deviation);
+}
+
+/**
+ *  @brief  With white velocity noise the identification is within its standard deviation, i.e.
+ *          the attenuation by the noise in the regressor, see RotorDragEstimator, is negligible
+ */
+TEST_F(DragIdentificationTest, Noise) {
+  record(paths_[0], 0.0, 20000, 0.01);
+  DragIdentifierParameters parameters;
+  parameters.control_period = kPeriod_;
+  DragIdentifier identifier(parameters);
+  DragIdentification identification;
+  ASSERT_TRUE(identifier.identify({paths_[0]}, identification));
+
+  const Eigen::Vector3d expected(0.4, 0.3, 0.1);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_GT(identification.standard_deviation(i), 0.0);
+    EXPECT_NEAR(expected(i), identification.rotor_drag(i), 4.0 * identification.standard_deviation(i));
+  }
+}
+
+/**
+ *  @brief  Pairs of records further apart than the maximum tick gap are skipped, unreadable logs
+ *          are reported and do not contribute
+ */
+TEST_F(DragIdentificationTest, Gaps) {
+  FlightRecords records = fly(0.0, 100, 0.0);
+  for (std::size_t k = 50; k < records.size(); ++k) {
+    records[k].tick += 10;
+  }
+  DragIdentifierParameters parameters;
+  parameters.control_period = kPeriod_;
+  DragIdentifier identifier(parameters);
+  DragNormalEquations equations;
+  identifier.accumulate(records.data(), records.size(), equations);
+  EXPECT_EQ(98u, equations.samples);
+
+  DragIdentification identification;
+  EXPECT_FALSE(identifier.identify({paths_[2], paths_[2] + ".missing"}, identification));
+  EXPECT_EQ(2u, identification.logs);
+  EXPECT_EQ(1u, identification.failed_logs);
+  ASSERT_EQ(1u, identifier.errors().size());
+  EXPECT_NE(std::string::npos, identifier.errors()[0].find(".missing"));
+  EXPECT_EQ(499u, identification.samples);
+
+  DragIdentifier::solve(DragNormalEquations(), identification);
+  EXPECT_EQ(Eigen::Vector3d::Zero(), identification.rotor_drag);
+  EXPECT_EQ(Eigen::Vector3d::Zero(), identification.standard_deviation);
+}
+
+/**
+ *  @brief  The written rotor drag coefficients are read back into the reference inputs
+ *          parameters, files without them are rejected and keep the parameters
+ */
+TEST_F(DragIdentificationTest, CoefficientsFile) {
+  const std::string path = paths_[0] + ".yaml";
+  position_controller::ReferenceInputsParameters written;
+  written.rotor_drag_coefficients = Eigen::Vector3d(0.4, 0.3, 0.123456789);
+  ASSERT_TRUE(writeRotorDragCoefficients(path, written));
+
+  position_controller::ReferenceInputsParameters read;
+  ASSERT_TRUE(readRotorDragCoefficients(path, read));
+  EXPECT_EQ(written.rotor_drag_coefficients, read.rotor_drag_coefficients);
+
+  std::FILE* file = std::fopen(path.c_str(), "w");
+  std::fputs("# identified offline\nmass: 1.0\n  rotor_drag_coefficients : [ 0.5,0.25 , 0 ]\n", file);
+  std::fclose(file);
+  ASSERT_TRUE(readRotorDragCoefficients(path, read));
+  EXPECT_EQ(Eigen::Vector3d(0.5, 0.25, 0.0), read.rotor_drag_coefficients);
+
+  file = std::fopen(path.c_str(), "w");
+  std::fputs("rotor_drag_coefficients: [0.1, 0.2]\n", file);
+  std::fclose(file);
+  EXPECT_FALSE(readRotorDragCoefficients(path, read));
+  EXPECT_EQ(Eigen::Vector3d(0.5, 0.25, 0.0), read.rotor_drag_coefficients);
+  EXPECT_FALSE(readRotorDragCoefficients(path + ".missing", read));
+  std::remove(path.c_str());
+}
+
+} /*  namespace flight_analysis  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_drag_identification");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
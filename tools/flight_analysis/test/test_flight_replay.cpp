@@ -0,0 +1,231 @@
+/**
+ *  @file   test_flight_replay.cpp
+ *  @brief  quadrotor's parallel offline replay of recorded flights related functionality unit tests
+ *  @author thor
+ *  @date   14.12.2021
+ */
+#include "flight_analysis/flight_replay.h"
+
+//  std dependencies
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#include <unistd.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+namespace flight_analysis {
+
+/**
+ *  @brief  Test fixture for testing the class FlightReplay
+ *  @detail reference: https://google.github.io/googletest/primer.html
+ */
+class FlightReplayTest : public ::testing::Test {
+ protected:
+
+  typedef std::vector<quadrotor_io::FlightRecord, Eigen::aligned_allocator<quadrotor_io::FlightRecord>> FlightRecords;
+
+      /////////////////////////////////////////////////////
+      ////////////  Constructors & Destructors  ///////////
+      /////////////////////////////////////////////////////
+
+  /**
+   *  @brief  FlightReplayTest's default constructor, called for each test to perform setup
+   *          tasks, i.e. a recorded flight along a circle with a slightly off state estimate
+   */
+  FlightReplayTest()
+      : path_("/tmp/test_flight_replay_" + std::to_string(::getpid()) + ".qflr"),
+        records_(kRecords_) {
+    position_controller::PositionController controller;
+    for (int i = 0; i < kRecords_; ++i) {
+      const double phase = 0.002 * i;
+      quadrotor_io::FlightRecord& record = records_[i];
+      record.tick = i;
+      record.reference_state = quadrotor_common::QuadrotorTrajectoryPoint();
+      record.reference_state.position = Eigen::Vector3d(2.0 * std::cos(phase), 2.0 * std::sin(phase), 1.0);
+      record.reference_state.velocity = Eigen::Vector3d(-4.0 * std::sin(phase), 4.0 * std::cos(phase), 0.0);
+      record.reference_state.acceleration = -4.0 * Eigen::Vector3d(std::cos(phase), std::sin(phase), 0.0);
+      record.reference_state.jerk = -2.0 * record.reference_state.velocity;
+      record.reference_state.heading = phase;
+      record.reference_state.heading_rate = 2.0;
+      record.state_estimate = quadrotor_common::QuadrotorStateEstimate();
+      record.state_estimate.position = record.reference_state.position + Eigen::Vector3d::Constant(0.01);
+      record.state_estimate.velocity = record.reference_state.velocity;
+      record.state_estimate.orientation = Eigen::AngleAxisd(phase, Eigen::Vector3d::UnitZ());
+      record.control_command = controller.run(record.state_estimate, record.reference_state);
+    }
+  }
+
+  /**
+   *  @brief  FlightReplayTest's default destructor, called for each test to remove the log
+   */
+  ~FlightReplayTest() override {
+    std::remove(path_.c_str());
+  }
+
+      ////////////////////////////////////////
+      ////////////  Class Members  ///////////
+      ////////////////////////////////////////
+
+  static constexpr int kRecords_ = 10000;
+
+  const std::string path_;
+  FlightRecords records_;
+};
+
+constexpr int FlightReplayTest::kRecords_;
+
+/**
+ *  @brief  The unchanged controller reproduces the recorded commands, up to rounding
+ */
+TEST_F(FlightReplayTest, Reproduced) {
+  FlightReplayParameters parameters;
+  parameters.num_threads = 4;
+  parameters.chunk_records = 256;
+  FlightReplay replay(parameters);
+  EXPECT_EQ(4, replay.numThreads());
+
+  ReplayReport report;
+  replay.replay(records_.data(), records_.size(), report);
+  EXPECT_EQ(static_cast<std::uint64_t>(kRecords_), report.records);
+  EXPECT_NEAR(0.0, report.maxDeviation(), 1e-12);
+  EXPECT_EQ(static_cast<std::uint64_t>(kRecords_), report.bodyrates.count);
+  EXPECT_GT(report.seconds, 0.0);
+  EXPECT_GT(report.throughput(), 0.0);
+}
+
+/**
+ *  @brief  Deviations are reported per field, with their maximum, tick and rms, independently
+ *          of the number of threads
+ */
+TEST_F(FlightReplayTest, Deviations) {
+  records_[1234].control_command.collective_thrust += 0.5;
+  records_[5678].control_command.collective_thrust -= 0.25;
+  records_[4321].control_command.bodyrates.x() += 0.1;
+  records_[42].control_command.orientation =
+      records_[42].control_command.orientation * Eigen::AngleAxisd(0.2, Eigen::Vector3d::UnitX());
+
+  for (const int num_threads : {1, 3}) {
+    FlightReplayParameters parameters;
+    parameters.num_threads = num_threads;
+    parameters.chunk_records = 100;
+    FlightReplay replay(parameters);
+    ReplayReport report;
+    replay.replay(records_.data(), records_.size(), report);
+
+    EXPECT_NEAR(0.5, report.collective_thrust.max, 1e-12);
+    EXPECT_EQ(1234u, report.collective_thrust.max_tick);
+    EXPECT_NEAR(std::sqrt((0.25 + 0.0625) / kRecords_), report.collective_thrust.rms(), 1e-12);
+    EXPECT_NEAR(0.1, report.bodyrates.max, 1e-12);
+    EXPECT_EQ(4321u, report.bodyrates.max_tick);
+    EXPECT_NEAR(0.2, report.orientation.max, 1e-9);
+    EXPECT_EQ(42u, report.orientation.max_tick);
+    EXPECT_NEAR(0.0, report.angular_acceleration.max, 1e-12);
+    EXPECT_NEAR(0.5, report.maxDeviation(), 1e-12);
+  }
+}
+
+/**
+ *  @brief  The report is the same bit for bit on any number of threads, i.e. the controller
+ *          does not carry the heading frame of another chunk and the chunks are merged in order
+ */
+TEST_F(FlightReplayTest, Deterministic) {
+  FlightReplayParameters parameters;
+  parameters.chunk_records = 97;
+  FlightReplay single(parameters);
+  ReplayReport expected;
+  single.replay(records_.data(), records_.size(), expected);
+  ASSERT_GT(expected.orientation.sum_squares + expected.bodyrates.sum_squares, 0.0);  //  rounding only
+
+  for (const int num_threads : {2, 3, 4}) {
+    parameters.num_threads = num_threads;
+    FlightReplay replay(parameters);
+    for (int run = 0; run < 3; ++run) {
+      ReplayReport report;
+      replay.replay(records_.data(), records_.size(), report);
+      EXPECT_EQ(expected.records, report.records);
+      for (const auto& deviations :
+           {std::make_pair(&expected.orientation, &report.orientation),
+            std::make_pair(&expected.collective_thrust, &report.collective_thrust),
+            std::make_pair(&expected.bodyrates, &report.bodyrates),
+            std::make_pair(&expected.angular_acceleration, &report.angular_acceleration)}) {
+        EXPECT_EQ(deviations.first->max, deviations.second->max);
+        EXPECT_EQ(deviations.first->max_tick, deviations.second->max_tick);
+        EXPECT_EQ(deviations.first->sum_squares, deviations.second->sum_squares);
+        EXPECT_EQ(deviations.first->count, deviations.second->count);
+      }
+    }
+  }
+}
+
+/**
+ *  @brief  Flights recorded with rotor drag compensation are reproduced by the replay of the
+ *          same rotor drag coefficients only
+ */
+TEST_F(FlightReplayTest, RotorDrag) {
+  const position_controller::AnisotropicRotorDrag rotor_drag(0.4, 0.3, 0.1);
+  position_controller::PositionController_<position_controller::AnisotropicRotorDrag> controller(rotor_drag);
+  for (quadrotor_io::FlightRecord& record : records_) {
+    record.control_command = controller.run(record.state_estimate, record.reference_state);
+  }
+
+  FlightReplayParameters parameters;
+  parameters.num_threads = 2;
+  FlightReplay_<position_controller::AnisotropicRotorDrag> replay(parameters, rotor_drag);
+  EXPECT_EQ(rotor_drag.d, replay.rotorDrag().d);
+  ReplayReport report;
+  replay.replay(records_.data(), records_.size(), report);
+  EXPECT_EQ(static_cast<std::uint64_t>(kRecords_), report.records);
+  EXPECT_NEAR(0.0, report.maxDeviation(), 1e-12);
+
+  ReplayReport nominal;
+  FlightReplay(parameters).replay(records_.data(), records_.size(), nominal);
+  EXPECT_GT(nominal.maxDeviation(), 0.01);
+}
+
+/**
+ *  @brief  Recorded logs are replayed from disk and accumulated into one report
+ */
+TEST_F(FlightReplayTest, Logs) {
+  quadrotor_io::FlightRecorder recorder;
+  ASSERT_TRUE(recorder.start(path_));
+  for (const quadrotor_io::FlightRecord& record : records_) {
+    ASSERT_TRUE(recorder.push(record.tick, record.state_estimate, record.reference_state, record.control_command));
+  }
+  recorder.stop();
+
+  FlightReplayParameters parameters;
+  parameters.num_threads = 2;
+  FlightReplay replay(parameters);
+  ReplayReport report;
+  ASSERT_TRUE(replay.replay(path_, report)) << replay.error();
+  ASSERT_TRUE(replay.replay(path_, report)) << replay.error();
+  EXPECT_EQ(2u * kRecords_, report.records);
+  EXPECT_NEAR(0.0, report.maxDeviation(), 1e-12);
+
+  EXPECT_FALSE(replay.replay(path_ + ".missing", report));
+  EXPECT_FALSE(replay.error().empty());
+  EXPECT_EQ(2u * kRecords_, report.records);
+}
+
+} /*  namespace flight_analysis  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_flight_replay");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,56 @@
+/**
+ *  @file   benchmark_minimum_snap_generator.cpp
+ *  @brief  quadrotor's minimum snap trajectory generation related functionality benchmarks
+ *  @author thor
+ *  @date   10.12.2021
+ */
+#include "polynomial_trajectory/minimum_snap_generator.h"
+
+//  std dependencies
+#include <cmath>
+#include <vector>
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+
+namespace polynomial_trajectory {
+
+namespace {
+
+/**
+ *  @brief  Inspection route, i.e. a lawnmower pattern of 5 m legs with a heading along the legs
+ */
+MinimumSnapGenerator::Waypoints makeRoute(const int num_waypoints) {
+  MinimumSnapGenerator::Waypoints waypoints(num_waypoints);
+  for (int i = 0; i < num_waypoints; ++i) {
+    const int leg = i / 2;
+    const double x = 5.0 * ((leg + i % 2) % 2);
+    waypoints[i] << x, 2.0 * leg, 10.0 + std::sin(0.1 * i), (leg % 2) * M_PI;
+  }
+  return waypoints;
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  Minimum snap trajectory through the route, i.e. the block tridiagonal solve and
+ *          the coefficients of all segments
+ */
+static void BM_MinimumSnapGenerate(benchmark::State& state) {
+  const MinimumSnapGenerator::Waypoints waypoints = makeRoute(state.range(0));
+  const std::vector<double> durations = MinimumSnapGenerator::allocateDurations(waypoints, 2.0, 0.5);
+  MinimumSnapGenerator generator;
+  PolynomialTrajectory trajectory;
+
+  for (auto _ : state) {
+    const bool generated = generator.generate(waypoints, durations, trajectory);
+    benchmark::DoNotOptimize(generated);
+  }
+  state.SetItemsProcessed(state.iterations() * (state.range(0) - 1));
+  state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MinimumSnapGenerate)
+    ->RangeMultiplier(10)->Range(10, 10000)->Arg(5000)
+    ->Unit(benchmark::kMicrosecond)->Complexity(benchmark::oN);
+
+} /*  namespace polynomial_trajectory  */
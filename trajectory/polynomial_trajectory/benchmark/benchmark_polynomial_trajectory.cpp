@@ -0,0 +1,144 @@
+/**
+ *  @file   benchmark_polynomial_trajectory.cpp
+ *  @brief  quadrotor's piecewise polynomial trajectory related functionality benchmarks
+ *  @author thor
+ *  @date   09.12.2021
+ */
+#include "polynomial_trajectory/polynomial_trajectory.h"
+
+//  std dependencies
+#include <cmath>
+#include <random>
+#include <vector>
+
+//  3rd party dependencies
+#include <benchmark/benchmark.h>
+
+namespace polynomial_trajectory {
+
+namespace {
+
+//  @brief  Number of samples per benchmark iteration
+constexpr int kSamples = 1024;
+
+/**
+ *  @brief  Trajectory of random segments of 0.1 s each
+ */
+PolynomialTrajectory makeTrajectory(const int segments) {
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> coefficient(-1.0, 1.0);
+  PolynomialTrajectory trajectory;
+  trajectory.reserve(segments);
+  for (int i = 0; i < segments; ++i) {
+    trajectory.addSegment(0.1, PolynomialTrajectory::Coefficients::NullaryExpr(
+        [&]() { return coefficient(generator); }));
+  }
+  return trajectory;
+}
+
+/**
+ *  @brief  Random sample times over the whole trajectory
+ */
+std::vector<double> makeRandomTimes(const PolynomialTrajectory& trajectory) {
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> time(trajectory.startTime(), trajectory.endTime());
+  std::vector<double> times(kSamples);
+  for (double& t : times) {
+    t = time(generator);
+  }
+  return times;
+}
+
+/**
+ *  @brief  Hand written derivative chain, i.e. every derivative of every flat output from
+ *          its power series, the baseline of the Horner pass
+ */
+void sampleDerivativeChain(
+    const PolynomialTrajectory& trajectory, const double time,
+    quadrotor_common::QuadrotorTrajectoryPoint& point) {
+  const std::size_t segment = trajectory.findSegment(time);
+  const PolynomialTrajectory::Coefficients& c = trajectory.coefficients(segment);
+  const double tau = time - trajectory.segmentStartTime(segment);
+  double derivatives[PolynomialTrajectory::kDimensions][5] = {};
+  for (int d = 0; d < PolynomialTrajectory::kDimensions; ++d) {
+    for (int j = 0; j < 5; ++j) {
+      for (int k = j; k < PolynomialTrajectory::kCoefficients; ++k) {
+        double factor = 1.0;
+        for (int i = 0; i < j; ++i) {
+          factor *= k - i;
+        }
+        derivatives[d][j] += factor * c(d, k) * std::pow(tau, k - j);
+      }
+    }
+  }
+  for (int axis = 0; axis < 3; ++axis) {
+    point.position(axis) = derivatives[axis][0];
+    point.velocity(axis) = derivatives[axis][1];
+    point.acceleration(axis) = derivatives[axis][2];
+    point.jerk(axis) = derivatives[axis][3];
+    point.snap(axis) = derivatives[axis][4];
+  }
+  point.heading = derivatives[3][0];
+  point.heading_rate = derivatives[3][1];
+  point.heading_acceleration = derivatives[3][2];
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  Monotonic sampling with a cursor at 1 kHz, i.e. the control loop access pattern
+ */
+static void BM_SampleMonotonic(benchmark::State& state) {
+  const PolynomialTrajectory trajectory = makeTrajectory(state.range(0));
+  PolynomialTrajectory::Cursor cursor;
+  quadrotor_common::QuadrotorTrajectoryPoint point;
+  double time = 0.0;
+
+  for (auto _ : state) {
+    for (int i = 0; i < kSamples; ++i) {
+      trajectory.sample(time, cursor, point);
+      benchmark::DoNotOptimize(&point);
+      time = time < trajectory.endTime() ? time + 0.001 : 0.0;
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kSamples);
+}
+BENCHMARK(BM_SampleMonotonic)->Arg(10)->Arg(10000);
+
+/**
+ *  @brief  Random access sampling, i.e. with a binary search per sample
+ */
+static void BM_SampleRandom(benchmark::State& state) {
+  const PolynomialTrajectory trajectory = makeTrajectory(state.range(0));
+  const std::vector<double> times = makeRandomTimes(trajectory);
+  quadrotor_common::QuadrotorTrajectoryPoint point;
+
+  for (auto _ : state) {
+    for (const double time : times) {
+      trajectory.sample(time, point);
+      benchmark::DoNotOptimize(&point);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kSamples);
+}
+BENCHMARK(BM_SampleRandom)->Arg(10)->Arg(10000);
+
+/**
+ *  @brief  Random access sampling with the hand written derivative chain
+ */
+static void BM_SampleDerivativeChain(benchmark::State& state) {
+  const PolynomialTrajectory trajectory = makeTrajectory(state.range(0));
+  const std::vector<double> times = makeRandomTimes(trajectory);
+  quadrotor_common::QuadrotorTrajectoryPoint point;
+
+  for (auto _ : state) {
+    for (const double time : times) {
+      sampleDerivativeChain(trajectory, time, point);
+      benchmark::DoNotOptimize(&point);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kSamples);
+}
+BENCHMARK(BM_SampleDerivativeChain)->Arg(10)->Arg(10000);
+
+} /*  namespace polynomial_trajectory  */
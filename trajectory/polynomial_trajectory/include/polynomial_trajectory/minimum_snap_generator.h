@@ -0,0 +1,138 @@
+/**
+ *  @file   minimum_snap_generator.h
+ *  @brief  quadrotor's minimum snap trajectory generation related functionality declaration & definition
+ *  @author thor
+ *  @date   10.12.2021
+ */
+#ifndef POLYNOMIAL_TRAJECTORY_MINIMUM_SNAP_GENERATOR_H
+#define POLYNOMIAL_TRAJECTORY_MINIMUM_SNAP_GENERATOR_H
+
+//  std dependencies
+#include <vector>
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+#include <Eigen/StdVector>
+
+//  polynomial_trajectory dependencies
+#include "polynomial_trajectory/polynomial_trajectory.h"
+
+namespace polynomial_trajectory {
+
+/**
+ *  @brief  MinimumSnapGenerator class implementation
+ *  @detail Generate the PolynomialTrajectory through the given waypoints of x, y, z and heading,
+ *          with the given segment durations, minimizing the integral of the squared snap of
+ *          every flat output, i.e. the heading as well, which has to be unwrapped by the caller.
+ *          The minimizer is a degree 7 polynomial per segment, C^6 continuous at the inner
+ *          waypoints. Every segment is the Hermite interpolation of the position, velocity,
+ *          acceleration and jerk at its two waypoints, so that the unknowns are the velocity,
+ *          acceleration and jerk of the inner waypoints, and the continuity of the snap,
+ *          crackle and pop at the inner waypoints couples only neighbouring waypoints:
+ *          a block tridiagonal system with 3x3 blocks, solved by block forward elimination
+ *          and back substitution in O(n), for all four flat outputs at once. The generator
+ *          is meant to be reused, i.e. its workspace is only reallocated for longer routes.
+ */
+class MinimumSnapGenerator {
+ public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    //  @brief  Waypoint of x, y, z and heading
+    typedef Eigen::Matrix<double, PolynomialTrajectory::kDimensions, 1> Waypoint;
+    typedef std::vector<Waypoint, Eigen::aligned_allocator<Waypoint>> Waypoints;
+
+    //  @brief  Velocity, acceleration and jerk (rows) of x, y, z and heading (columns) at a waypoint
+    typedef Eigen::Matrix<double, 3, PolynomialTrajectory::kDimensions> Derivatives;
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  MinimumSnapGenerator's default constructor, called when an instance is created
+     */
+    MinimumSnapGenerator();
+
+    /**
+     *  @brief  MinimumSnapGenerator's default destructor, called when an instance is destroyed
+     */
+    ~MinimumSnapGenerator();
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Generate the minimum snap trajectory, at rest at the first and the last waypoint
+     *  @param  waypoints   - n + 1 waypoints, at least 2
+     *  @param  durations   - n positive segment durations [s]
+     *  @param  trajectory  - output trajectory, its segments are replaced and its start time kept
+     *  @return boolean value where
+     *            + true  - Indicates the trajectory has been generated
+     *            + false - Otherwise, i.e. invalid inputs, the trajectory is left empty
+     */
+    bool generate(
+        const Waypoints& waypoints,
+        const std::vector<double>& durations,
+        PolynomialTrajectory& trajectory);
+
+    /**
+     *  @brief  Generate the minimum snap trajectory with the given derivatives at the first and
+     *          the last waypoint, see generate()
+     */
+    bool generate(
+        const Waypoints& waypoints,
+        const std::vector<double>& durations,
+        const Derivatives& start_derivatives,
+        const Derivatives& end_derivatives,
+        PolynomialTrajectory& trajectory);
+
+    /**
+     *  @brief  Segment durations for a nominal speed along the straight lines between the waypoints
+     *  @param  waypoints     - n + 1 waypoints
+     *  @param  speed         - nominal speed [m/s]
+     *  @param  min_duration  - lower bound of the durations [s], e.g. for a heading only segment
+     *  @return n segment durations
+     */
+    static std::vector<double> allocateDurations(
+        const Waypoints& waypoints, const double speed, const double min_duration);
+
+ private:
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    typedef Eigen::Matrix<double, 8, 8> Matrix8;
+    typedef Eigen::Matrix<double, 3, 8> Matrix38;
+    typedef Eigen::Matrix3d Block;
+    typedef Eigen::Matrix<double, 3, PolynomialTrajectory::kDimensions> RhsBlock;
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    //  @brief  Normalized time Hermite basis, i.e. the coefficients of q(s) = p(T*s) for s in [0, 1]
+    //          from q, q', q'', q''' at s = 0 and s = 1
+    Matrix8 hermite_;
+
+    //  @brief  Snap, crackle and pop of q at s = 0 and s = 1 from the Hermite values
+    Matrix38 derivatives_start_;
+    Matrix38 derivatives_end_;
+
+    //  @brief  Workspace of the block elimination, one block per inner waypoint
+    std::vector<Block, Eigen::aligned_allocator<Block>> upper_;
+    std::vector<RhsBlock, Eigen::aligned_allocator<RhsBlock>> rhs_;
+
+    //  @brief  Workspace of the velocity, acceleration and jerk at all waypoints
+    std::vector<Derivatives, Eigen::aligned_allocator<Derivatives>> knots_;
+
+};  /*  class MinimumSnapGenerator  */
+
+} /*  namespace polynomial_trajectory  */
+
+#endif  /*  POLYNOMIAL_TRAJECTORY_MINIMUM_SNAP_GENERATOR_H  */
@@ -0,0 +1,238 @@
+/**
+ *  @file   polynomial_trajectory.h
+ *  @brief  quadrotor's piecewise polynomial trajectory related functionality declaration & definition
+ *  @author thor
+ *  @date   09.12.2021
+ */
+#ifndef POLYNOMIAL_TRAJECTORY_POLYNOMIAL_TRAJECTORY_H
+#define POLYNOMIAL_TRAJECTORY_POLYNOMIAL_TRAJECTORY_H
+
+//  std dependencies
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+//  3rd party dependencies
+#include <Eigen/Dense>
+#include <Eigen/StdVector>
+
+//  quadrotor_common dependencies
+#include "quadrotor_common/quadrotor_trajectory_point.h"
+
+namespace polynomial_trajectory {
+
+/**
+ *  @brief  PolynomialTrajectory class implementation
+ *  @detail Piecewise polynomial trajectory of the position x, y, z and the heading, i.e. the
+ *          flat outputs of the quadrotor. Every segment i spans [t_i, t_i+1) and holds one
+ *          polynomial of degree 7 per flat output in the local time tau = t - t_i, i.e.
+ *            p(tau) = c_0 + c_1*tau + ... + c_7*tau^7
+ *          which is enough for minimum snap trajectories, lower degrees have zero coefficients.
+ *          The coefficients of a segment are a 4x8 column major matrix, i.e. one column of
+ *          x, y, z, heading coefficients per power of tau, so that sample() evaluates all four
+ *          flat outputs and all their derivatives up to the snap in one vectorized Horner pass.
+ *          The segment of a time is found by binary search, O(log n), or from a Cursor, which
+ *          remembers the last segment and makes monotonic sampling O(1) amortized.
+ *          Times before the start or after the end are clamped to the first or last segment.
+ */
+class PolynomialTrajectory {
+ public:
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        ///////////////////////////////
+        ////////////  Types  //////////
+        ///////////////////////////////
+
+    //  @brief  Number of coefficients per flat output and segment, i.e. degree + 1
+    static constexpr int kCoefficients = 8;
+
+    //  @brief  Number of flat outputs, i.e. x, y, z and heading
+    static constexpr int kDimensions = 4;
+
+    //  @brief  Coefficients of a segment, column k holds the x, y, z, heading coefficients of tau^k
+    typedef Eigen::Matrix<double, kDimensions, kCoefficients> Coefficients;
+
+    typedef quadrotor_common::QuadrotorTrajectoryPoint TrajectoryPoint;
+
+    /**
+     *  @brief  Segment hint of a caller sampling monotonically, e.g. one per control loop
+     */
+    struct Cursor {
+      std::size_t segment = 0;
+    };  /*  struct Cursor  */
+
+        /////////////////////////////////////////////////////
+        ////////////  Constructors & Destructors  ///////////
+        /////////////////////////////////////////////////////
+
+    /**
+     *  @brief  PolynomialTrajectory's default constructor, called when an instance is created
+     *  @param  start_time  - start time t_0 of the first segment [s]
+     */
+    explicit PolynomialTrajectory(const double start_time = 0.0);
+
+    /**
+     *  @brief  PolynomialTrajectory's default destructor, called when an instance is destroyed
+     */
+    ~PolynomialTrajectory();
+
+        ////////////////////////////////////////
+        ////////////  Class Methods  ///////////
+        ////////////////////////////////////////
+
+    /**
+     *  @brief  Append a segment at the end of the trajectory
+     *  @param  duration      - segment duration [s]
+     *  @param  coefficients  - segment coefficients in the local time
+     *  @return boolean value where
+     *            + true  - Indicates the segment has been appended
+     *            + false - Otherwise, i.e. the duration is not positive
+     */
+    bool addSegment(const double duration, const Coefficients& coefficients);
+
+    /**
+     *  @brief  Reserve memory for the given number of segments
+     */
+    void reserve(const std::size_t segments);
+
+    /**
+     *  @brief  Remove all segments, keeping the start time
+     */
+    void clear();
+
+    /**
+     *  @brief  Accessors for the segments
+     */
+    std::size_t size() const { return coefficients_.size(); }
+    bool empty() const { return coefficients_.empty(); }
+    double startTime() const { return times_.front(); }
+    double endTime() const { return times_.back(); }
+    double duration() const { return endTime() - startTime(); }
+    double segmentStartTime(const std::size_t segment) const { return times_[segment]; }
+    double segmentDuration(const std::size_t segment) const { return times_[segment + 1] - times_[segment]; }
+    const Coefficients& coefficients(const std::size_t segment) const { return coefficients_[segment]; }
+
+    /**
+     *  @brief  Segment spanning the time, by binary search, the trajectory must not be empty
+     */
+    std::size_t findSegment(const double time) const;
+
+    /**
+     *  @brief  Segment spanning the time, starting from the cursor's segment and its successor,
+     *          by binary search otherwise, the trajectory must not be empty
+     */
+    std::size_t findSegment(const double time, Cursor& cursor) const;
+
+    /**
+     *  @brief  Sample the flat outputs and their derivatives, the trajectory must not be empty
+     *  @detail Writes the position, velocity, acceleration, jerk and snap, as well as the
+     *          heading, heading rate and heading acceleration, the other members of the
+     *          point, e.g. the orientation and bodyrates, are kept.
+     *  @param  time    - sample time [s]
+     *  @param  cursor  - segment hint, optional
+     *  @param  point   - output trajectory point
+     */
+    void sample(const double time, TrajectoryPoint& point) const;
+    void sample(const double time, Cursor& cursor, TrajectoryPoint& point) const;
+
+    /**
+     *  @brief  Sample n equidistant points time_0, time_0 + dt, ..., see sample()
+     */
+    void sample(const double time_0, const double dt, const std::size_t n, TrajectoryPoint* points) const;
+
+    /**
+     *  @brief  Evaluate a segment at the time, clamped to the segment, see sample()
+     */
+    void evaluate(const std::size_t segment, const double time, TrajectoryPoint& point) const;
+
+ private:
+
+        ////////////////////////////////////////
+        ////////////  Class Members  ///////////
+        ////////////////////////////////////////
+
+    //  @brief  The segment boundaries t_0, ..., t_n, i.e. size() + 1 times
+    std::vector<double> times_;
+
+    //  @brief  The segment coefficients
+    std::vector<Coefficients, Eigen::aligned_allocator<Coefficients>> coefficients_;
+
+};  /*  class PolynomialTrajectory  */
+
+/**
+ *  @detail The binary search runs over the inner boundaries t_1, ..., t_n-1, i.e. the number
+ *          of inner boundaries not after the time is the segment index.
+ */
+inline std::size_t PolynomialTrajectory::findSegment(const double time) const {
+  return std::upper_bound(times_.begin() + 1, times_.end() - 1, time) - (times_.begin() + 1);
+}
+
+/**
+ *  @detail
+ */
+inline std::size_t PolynomialTrajectory::findSegment(const double time, Cursor& cursor) const {
+  const std::size_t last = size() - 1;
+  std::size_t segment = std::min(cursor.segment, last);
+  if (time >= times_[segment] || segment == 0) {
+    if (segment == last || time < times_[segment + 1]) {
+      return segment;
+    } //  same segment
+    if (segment + 1 == last || time < times_[segment + 2]) {
+      cursor.segment = segment + 1;
+      return segment + 1;
+    } //  next segment
+  }
+  cursor.segment = findSegment(time);
+  return cursor.segment;
+}
+
+/**
+ *  @detail
+ */
+inline void PolynomialTrajectory::sample(const double time, TrajectoryPoint& point) const {
+  evaluate(findSegment(time), time, point);
+}
+
+/**
+ *  @detail
+ */
+inline void PolynomialTrajectory::sample(const double time, Cursor& cursor, TrajectoryPoint& point) const {
+  evaluate(findSegment(time, cursor), time, point);
+}
+
+/**
+ *  @detail Horner's scheme for the polynomial and its derivatives, i.e. after the pass
+ *          d_j = p^(j)(tau) / j!, all four flat outputs at once.
+ */
+inline void PolynomialTrajectory::evaluate(
+    const std::size_t segment, const double time, TrajectoryPoint& point) const {
+  typedef Eigen::Matrix<double, kDimensions, 1> Vector4;
+  const Coefficients& c = coefficients_[segment];
+  const double tau = std::min(std::max(time - times_[segment], 0.0), segmentDuration(segment));
+
+  Vector4 d0 = c.col(kCoefficients - 1);
+  Vector4 d1 = Vector4::Zero();
+  Vector4 d2 = Vector4::Zero();
+  Vector4 d3 = Vector4::Zero();
+  Vector4 d4 = Vector4::Zero();
+  for (int k = kCoefficients - 2; k >= 0; --k) {
+    d4 = d4 * tau + d3;
+    d3 = d3 * tau + d2;
+    d2 = d2 * tau + d1;
+    d1 = d1 * tau + d0;
+    d0 = d0 * tau + c.col(k);
+  }
+
+  point.position = d0.head<3>();
+  point.velocity = d1.head<3>();
+  point.acceleration = 2.0 * d2.head<3>();
+  point.jerk = 6.0 * d3.head<3>();
+  point.snap = 24.0 * d4.head<3>();
+  point.heading = d0(3);
+  point.heading_rate = d1(3);
+  point.heading_acceleration = 2.0 * d2(3);
+}
+
+} /*  namespace polynomial_trajectory  */
+
+#endif  /*  POLYNOMIAL_TRAJECTORY_POLYNOMIAL_TRAJECTORY_H  */
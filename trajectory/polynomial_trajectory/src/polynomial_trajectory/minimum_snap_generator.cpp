@@ -0,0 +1,195 @@
+/**
+ *  @file   minimum_snap_generator.cpp
+ *  @brief  quadrotor's minimum snap trajectory generation related functionality implementation
+ *  @author thor
+ *  @date   10.12.2021
+ */
+#include "polynomial_trajectory/minimum_snap_generator.h"
+
+//  std dependencies
+#include <algorithm>
+#include <cmath>
+
+namespace polynomial_trajectory {
+
+namespace {
+
+/**
+ *  @brief  k! / (k - d)!, i.e. the factor of the d-th derivative of s^k
+ */
+double fallingFactorial(const int k, const int d) {
+  double factor = 1.0;
+  for (int i = 0; i < d; ++i) {
+    factor *= k - i;
+  }
+  return factor;
+}
+
+}  /*  namespace  */
+
+/**
+ *  @detail The basis is constant in the normalized time, i.e. the segment duration only
+ *          scales the Hermite values and the coefficients, see generate().
+ */
+MinimumSnapGenerator::MinimumSnapGenerator() {
+  Matrix8 hermite_values = Matrix8::Zero();
+  for (int d = 0; d < 4; ++d) {
+    hermite_values(d, d) = fallingFactorial(d, d);
+    for (int k = d; k < 8; ++k) {
+      hermite_values(4 + d, k) = fallingFactorial(k, d);
+    }
+  } //  q^(d)(0) and q^(d)(1) from the coefficients
+  hermite_ = hermite_values.fullPivLu().inverse();
+
+  derivatives_start_.setZero();
+  derivatives_end_.setZero();
+  for (int r = 0; r < 3; ++r) {
+    const int d = 4 + r;
+    derivatives_start_.row(r) = fallingFactorial(d, d) * hermite_.row(d);
+    for (int k = d; k < 8; ++k) {
+      derivatives_end_.row(r) += fallingFactorial(k, d) * hermite_.row(k);
+    }
+  } //  snap, crackle and pop
+}
+
+/**
+ *  @detail MinimumSnapGenerator's default destructor definition
+ */
+MinimumSnapGenerator::~MinimumSnapGenerator() {}
+
+/**
+ *
+ */
+bool MinimumSnapGenerator::generate(
+    const Waypoints& waypoints,
+    const std::vector<double>& durations,
+    PolynomialTrajectory& trajectory) {
+  return generate(waypoints, durations, Derivatives::Zero(), Derivatives::Zero(), trajectory);
+}
+
+/**
+ *  @detail With the normalized Hermite values of segment i of duration T
+ *            h = [p_i, T*v_i, T^2*a_i, T^3*j_i, p_i+1, T*v_i+1, T^2*a_i+1, T^3*j_i+1]
+ *          its snap, crackle and pop at the start are derivatives_start_*h / T^(4, 5, 6) and
+ *          at the end derivatives_end_*h / T^(4, 5, 6). Their continuity at the inner waypoint i
+ *          reads A_i*u_i-1 + B_i*u_i + C_i*u_i+1 = d_i for the unknowns u = [v, a, j], with the
+ *          positions and the given boundary derivatives in d_i. Every row is scaled by the mean
+ *          duration of the two segments to the power of its derivative, i.e. the blocks are of
+ *          the same order for any durations.
+ */
+bool MinimumSnapGenerator::generate(
+    const Waypoints& waypoints,
+    const std::vector<double>& durations,
+    const Derivatives& start_derivatives,
+    const Derivatives& end_derivatives,
+    PolynomialTrajectory& trajectory) {
+  trajectory.clear();
+  const std::size_t n = durations.size();
+  if (waypoints.size() < 2 || waypoints.size() != n + 1) {
+    return false;
+  } //  invalid number of waypoints
+  for (const double duration : durations) {
+    if (!(duration > 0.0) || !std::isfinite(duration)) {
+      return false;
+    }
+  } //  invalid durations
+
+  knots_.resize(n + 1);
+  upper_.resize(n + 1);
+  rhs_.resize(n + 1);
+  knots_.front() = start_derivatives;
+  knots_.back() = end_derivatives;
+
+  //  forward elimination, i.e. B'_i = B_i - A_i*C'_i-1, C'_i = B'_i^-1*C_i, d'_i = B'_i^-1*(d_i - A_i*d'_i-1)
+  for (std::size_t i = 1; i < n; ++i) {
+    const double T_prev = durations[i - 1];
+    const double T_next = durations[i];
+    const double T_mean = 0.5 * (T_prev + T_next);
+    const Eigen::Vector3d powers_prev(T_prev, T_prev * T_prev, T_prev * T_prev * T_prev);
+    const Eigen::Vector3d powers_next(T_next, T_next * T_next, T_next * T_next * T_next);
+    const double ratio_prev = T_mean / T_prev;
+    const double ratio_next = T_mean / T_next;
+    double scale_prev = ratio_prev * ratio_prev * ratio_prev;
+    double scale_next = ratio_next * ratio_next * ratio_next;
+    Block A, B, C;
+    RhsBlock d;
+    for (int r = 0; r < 3; ++r) {
+      scale_prev *= ratio_prev;
+      scale_next *= ratio_next;
+      for (int c = 0; c < 3; ++c) {
+        const int m = 1 + c;
+        A(r, c) = scale_prev * derivatives_end_(r, m) * powers_prev(c);
+        B(r, c) = scale_prev * derivatives_end_(r, 4 + m) * powers_prev(c) -
+                  scale_next * derivatives_start_(r, m) * powers_next(c);
+        C(r, c) = -scale_next * derivatives_start_(r, 4 + m) * powers_next(c);
+      }
+      d.row(r) = -(scale_prev * (derivatives_end_(r, 0) * waypoints[i - 1] +
+                                 derivatives_end_(r, 4) * waypoints[i]) -
+                   scale_next * (derivatives_start_(r, 0) * waypoints[i] +
+                                 derivatives_start_(r, 4) * waypoints[i + 1])).transpose();
+    }
+    if (i == 1) {
+      d -= A * knots_.front();
+    } //  given start derivatives
+    else {
+      B -= A * upper_[i - 1];
+      d -= A * rhs_[i - 1];
+    }
+    if (i + 1 == n) {
+      d -= C * knots_.back();
+      C.setZero();
+    } //  given end derivatives
+
+    const Eigen::PartialPivLU<Block> lu(B);
+    upper_[i] = lu.solve(C);
+    rhs_[i] = lu.solve(d);
+  }
+
+  //  back substitution, i.e. u_i = d'_i - C'_i*u_i+1
+  for (std::size_t i = n - 1; i >= 1; --i) {
+    knots_[i] = rhs_[i];
+    if (i + 1 < n) {
+      knots_[i] -= upper_[i] * knots_[i + 1];
+    }
+  }
+
+  //  coefficients from the Hermite values
+  trajectory.reserve(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    const double T = durations[i];
+    const Eigen::Vector3d powers(T, T * T, T * T * T);
+    Eigen::Matrix<double, 8, PolynomialTrajectory::kDimensions> h;
+    h.row(0) = waypoints[i].transpose();
+    h.middleRows<3>(1) = powers.asDiagonal() * knots_[i];
+    h.row(4) = waypoints[i + 1].transpose();
+    h.middleRows<3>(5) = powers.asDiagonal() * knots_[i + 1];
+
+    Eigen::Matrix<double, 8, PolynomialTrajectory::kDimensions> coefficients = hermite_ * h;
+    double T_inverse_k = 1.0;
+    for (int k = 0; k < 8; ++k) {
+      coefficients.row(k) *= T_inverse_k;
+      T_inverse_k /= T;
+    } //  back to the local time, i.e. c_k = c_k(normalized) / T^k
+    if (!coefficients.allFinite()) {
+      trajectory.clear();
+      return false;
+    } //  singular system
+    trajectory.addSegment(T, coefficients.transpose());
+  }
+  return true;
+}
+
+/**
+ *
+ */
+std::vector<double> MinimumSnapGenerator::allocateDurations(
+    const Waypoints& waypoints, const double speed, const double min_duration) {
+  std::vector<double> durations;
+  for (std::size_t i = 1; i < waypoints.size(); ++i) {
+    const double distance = (waypoints[i].head<3>() - waypoints[i - 1].head<3>()).norm();
+    durations.push_back(speed > 0.0 ? std::max(distance / speed, min_duration) : min_duration);
+  }
+  return durations;
+}
+
+} /*  namespace polynomial_trajectory  */
@@ -0,0 +1,64 @@
+/**
+ *  @file   polynomial_trajectory.cpp
+ *  @brief  quadrotor's piecewise polynomial trajectory related functionality implementation
+ *  @author thor
+ *  @date   09.12.2021
+ */
+#include "polynomial_trajectory/polynomial_trajectory.h"
+
+namespace polynomial_trajectory {
+
+constexpr int PolynomialTrajectory::kCoefficients;
+constexpr int PolynomialTrajectory::kDimensions;
+
+/**
+ *  @detail PolynomialTrajectory's default constructor definition
+ */
+PolynomialTrajectory::PolynomialTrajectory(const double start_time)
+    : times_(1, start_time) {}
+
+/**
+ *  @detail PolynomialTrajectory's default destructor definition
+ */
+PolynomialTrajectory::~PolynomialTrajectory() {}
+
+/**
+ *
+ */
+bool PolynomialTrajectory::addSegment(const double duration, const Coefficients& coefficients) {
+  if (!(duration > 0.0)) {
+    return false;
+  } //  also rejects NaN
+  times_.push_back(times_.back() + duration);
+  coefficients_.push_back(coefficients);
+  return true;
+}
+
+/**
+ *
+ */
+void PolynomialTrajectory::reserve(const std::size_t segments) {
+  times_.reserve(segments + 1);
+  coefficients_.reserve(segments);
+}
+
+/**
+ *
+ */
+void PolynomialTrajectory::clear() {
+  times_.resize(1);
+  coefficients_.clear();
+}
+
+/**
+ *  @detail The cursor makes every segment lookup but the first one O(1).
+ */
+void PolynomialTrajectory::sample(
+    const double time_0, const double dt, const std::size_t n, TrajectoryPoint* points) const {
+  Cursor cursor;
+  for (std::size_t i = 0; i < n; ++i) {
+    sample(time_0 + i * dt, cursor, points[i]);
+  }
+}
+
+} /*  namespace polynomial_trajectory  */
@@ -0,0 +1,186 @@
+/**
+ *  @file   test_minimum_snap_generator.cpp
+ *  @brief  quadrotor's minimum snap trajectory generation related functionality unit tests
+ *  @author thor
+ *  @date   10.12.2021
+ */
+#include "polynomial_trajectory/minimum_snap_generator.h"
+
+//  std dependencies
+#include <random>
+#include <vector>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+namespace polynomial_trajectory {
+
+namespace {
+
+typedef MinimumSnapGenerator::Waypoints Waypoints;
+
+/**
+ *  @brief  Random waypoints and durations of a route
+ */
+void makeRoute(const int n, Waypoints& waypoints, std::vector<double>& durations) {
+  std::mt19937 generator(n);
+  std::uniform_real_distribution<double> position(-10.0, 10.0);
+  std::uniform_real_distribution<double> duration(0.2, 3.0);
+  waypoints.resize(n + 1);
+  durations.resize(n);
+  for (MinimumSnapGenerator::Waypoint& waypoint : waypoints) {
+    waypoint = MinimumSnapGenerator::Waypoint::NullaryExpr([&]() { return position(generator); });
+  }
+  for (double& T : durations) {
+    T = duration(generator);
+  }
+}
+
+/**
+ *  @brief  Dense reference solution of the minimum snap conditions for the raw coefficients of
+ *          one flat output, i.e. waypoint interpolation, C^6 continuity and rest at both ends
+ */
+Eigen::VectorXd solveDense(const Waypoints& waypoints, const std::vector<double>& durations, const int dim) {
+  const int n = static_cast<int>(durations.size());
+  Eigen::MatrixXd M = Eigen::MatrixXd::Zero(8 * n, 8 * n);
+  Eigen::VectorXd b = Eigen::VectorXd::Zero(8 * n);
+  auto derivativeRow = [](const double tau, const int d) {
+    Eigen::Matrix<double, 1, 8> row = Eigen::Matrix<double, 1, 8>::Zero();
+    for (int k = d; k < 8; ++k) {
+      double factor = 1.0;
+      for (int i = 0; i < d; ++i) {
+        factor *= k - i;
+      }
+      row(k) = factor * std::pow(tau, k - d);
+    }
+    return row;
+  };
+  int row = 0;
+  for (int i = 0; i < n; ++i) {
+    M.block<1, 8>(row, 8 * i) = derivativeRow(0.0, 0);
+    b(row++) = waypoints[i](dim);
+    M.block<1, 8>(row, 8 * i) = derivativeRow(durations[i], 0);
+    b(row++) = waypoints[i + 1](dim);
+  }
+  for (int i = 0; i + 1 < n; ++i) {
+    for (int d = 1; d <= 6; ++d) {
+      M.block<1, 8>(row, 8 * i) = derivativeRow(durations[i], d);
+      M.block<1, 8>(row++, 8 * (i + 1)) = -derivativeRow(0.0, d);
+    }
+  }
+  for (int d = 1; d <= 3; ++d) {
+    M.block<1, 8>(row++, 0) = derivativeRow(0.0, d);
+    M.block<1, 8>(row++, 8 * (n - 1)) = derivativeRow(durations[n - 1], d);
+  }
+  return M.fullPivLu().solve(b);
+}
+
+}  /*  namespace  */
+
+/**
+ *  @brief  Test case to check the banded solution against the dense one
+ */
+TEST(MinimumSnapGeneratorTest, DenseTest) {
+  MinimumSnapGenerator generator;
+  for (const int n : {1, 2, 3, 8}) {
+    Waypoints waypoints;
+    std::vector<double> durations;
+    makeRoute(n, waypoints, durations);
+    PolynomialTrajectory trajectory;
+    ASSERT_TRUE(generator.generate(waypoints, durations, trajectory));
+    ASSERT_EQ(static_cast<std::size_t>(n), trajectory.size());
+
+    for (int dim = 0; dim < PolynomialTrajectory::kDimensions; ++dim) {
+      const Eigen::VectorXd expected = solveDense(waypoints, durations, dim);
+      for (int i = 0; i < n; ++i) {
+        const Eigen::Matrix<double, 8, 1> coefficients = trajectory.coefficients(i).row(dim).transpose();
+        EXPECT_TRUE(coefficients.isApprox(expected.segment<8>(8 * i), 1e-6))
+            << "n " << n << " segment " << i << " dim " << dim;
+      }
+    }
+  }
+}
+
+/**
+ *  @brief  Test case to check the waypoints, the boundary derivatives and the continuity
+ *          up to the snap of a long route
+ */
+TEST(MinimumSnapGeneratorTest, LongRouteTest) {
+  constexpr int kSegments = 5000;
+  Waypoints waypoints;
+  std::vector<double> durations;
+  makeRoute(kSegments, waypoints, durations);
+  MinimumSnapGenerator::Derivatives start = MinimumSnapGenerator::Derivatives::Zero();
+  start.row(0) << 1.0, -1.0, 0.5, 0.1;  //  initial velocity
+
+  MinimumSnapGenerator generator;
+  PolynomialTrajectory trajectory(5.0);
+  ASSERT_TRUE(generator.generate(waypoints, durations, start, MinimumSnapGenerator::Derivatives::Zero(), trajectory));
+  ASSERT_EQ(static_cast<std::size_t>(kSegments), trajectory.size());
+  EXPECT_DOUBLE_EQ(5.0, trajectory.startTime());
+
+  quadrotor_common::QuadrotorTrajectoryPoint point, left, right;
+  trajectory.sample(trajectory.startTime(), point);
+  EXPECT_TRUE(point.velocity.isApprox(start.row(0).head<3>().transpose()));
+  EXPECT_NEAR(0.1, point.heading_rate, 1e-9);
+  EXPECT_NEAR(0.0, point.acceleration.norm(), 1e-9);
+  trajectory.sample(trajectory.endTime(), point);
+  EXPECT_TRUE(point.position.isApprox(waypoints.back().head<3>()));
+  EXPECT_NEAR(0.0, point.velocity.norm(), 1e-6);
+  EXPECT_NEAR(0.0, point.jerk.norm(), 1e-6);
+
+  for (std::size_t i = 1; i < trajectory.size(); i += 97) {
+    trajectory.evaluate(i - 1, trajectory.segmentStartTime(i), left);
+    trajectory.evaluate(i, trajectory.segmentStartTime(i), right);
+    EXPECT_NEAR(waypoints[i](0), right.position.x(), 1e-9);
+    EXPECT_NEAR(waypoints[i](3), right.heading, 1e-9);
+    EXPECT_LT((left.position - right.position).norm(), 1e-6);
+    EXPECT_LT((left.velocity - right.velocity).norm(), 1e-6);
+    EXPECT_LT((left.acceleration - right.acceleration).norm(), 1e-6);
+    EXPECT_LT((left.jerk - right.jerk).norm(), 1e-5);
+    EXPECT_LT((left.snap - right.snap).norm(), 1e-4 * (1.0 + right.snap.norm()));
+  }
+}
+
+/**
+ *  @brief  Test case to check the invalid inputs and the duration allocation
+ */
+TEST(MinimumSnapGeneratorTest, InvalidInputsTest) {
+  MinimumSnapGenerator generator;
+  PolynomialTrajectory trajectory;
+  Waypoints waypoints(3, MinimumSnapGenerator::Waypoint::Zero());
+  waypoints[1].x() = 3.0;
+  waypoints[2].x() = 3.0;
+  waypoints[2].y() = 4.0;
+
+  EXPECT_FALSE(generator.generate(Waypoints(1), {}, trajectory));
+  EXPECT_FALSE(generator.generate(waypoints, {1.0}, trajectory));
+  EXPECT_FALSE(generator.generate(waypoints, {1.0, 0.0}, trajectory));
+  EXPECT_TRUE(trajectory.empty());
+
+  const std::vector<double> durations = MinimumSnapGenerator::allocateDurations(waypoints, 2.0, 1.0);
+  ASSERT_EQ(2u, durations.size());
+  EXPECT_DOUBLE_EQ(1.5, durations[0]);
+  EXPECT_DOUBLE_EQ(2.0, durations[1]);
+  EXPECT_TRUE(generator.generate(waypoints, durations, trajectory));
+  EXPECT_NEAR(3.5, trajectory.duration(), 1e-12);
+}
+
+} /*  namespace polynomial_trajectory  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_minimum_snap_generator");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}
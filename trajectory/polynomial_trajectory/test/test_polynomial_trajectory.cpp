@@ -0,0 +1,202 @@
+/**
+ *  @file   test_polynomial_trajectory.cpp
+ *  @brief  quadrotor's piecewise polynomial trajectory related functionality unit tests
+ *  @author thor
+ *  @date   09.12.2021
+ */
+#include "polynomial_trajectory/polynomial_trajectory.h"
+
+//  std dependencies
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+//  3rd party dependencies
+#include <gtest/gtest.h>
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+#include <ros/ros.h>
+#endif
+
+namespace polynomial_trajectory {
+
+/**
+ *  @brief  Test fixture for testing the class PolynomialTrajectory
+ *  @detail reference: https://google.github.io/googletest/primer.html
+ */
+class PolynomialTrajectoryTest : public ::testing::Test {
+ protected:
+
+      /////////////////////////////////////////////////////
+      ////////////  Constructors & Destructors  ///////////
+      /////////////////////////////////////////////////////
+
+  /**
+   *  @brief  PolynomialTrajectoryTest's default constructor, called for each test
+   *          to perform setup tasks, i.e. a trajectory of random segments
+   */
+  PolynomialTrajectoryTest() : trajectory_(kStartTime_) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> coefficient(-1.0, 1.0);
+    std::uniform_real_distribution<double> duration(0.1, 2.0);
+    for (int i = 0; i < kSegments_; ++i) {
+      const PolynomialTrajectory::Coefficients coefficients =
+          PolynomialTrajectory::Coefficients::NullaryExpr([&]() { return coefficient(generator); });
+      EXPECT_TRUE(trajectory_.addSegment(duration(generator), coefficients));
+    }
+  }
+
+      ////////////////////////////////////////
+      ////////////  Class Methods  ///////////
+      ////////////////////////////////////////
+
+  /**
+   *  @brief  The j-th derivative of a polynomial, from its power series, i.e. without Horner's scheme
+   */
+  static double derivative(const Eigen::VectorXd& c, const double tau, const int j) {
+    double value = 0.0;
+    for (int k = j; k < c.size(); ++k) {
+      double factor = 1.0;
+      for (int i = 0; i < j; ++i) {
+        factor *= k - i;
+      }
+      value += factor * c(k) * std::pow(tau, k - j);
+    }
+    return value;
+  }
+
+      ////////////////////////////////////////
+      ////////////  Class Members  ///////////
+      ////////////////////////////////////////
+
+  static constexpr double kStartTime_ = 10.0;
+  static constexpr int kSegments_ = 100;
+
+  PolynomialTrajectory trajectory_;
+
+};  /*  class PolynomialTrajectoryTest  */
+
+constexpr double PolynomialTrajectoryTest::kStartTime_;
+constexpr int PolynomialTrajectoryTest::kSegments_;
+
+/**
+ *  @brief  Test case to check the segment boundaries and the rejected segments
+ */
+TEST_F(PolynomialTrajectoryTest, SegmentsTest) {
+  EXPECT_EQ(static_cast<std::size_t>(kSegments_), trajectory_.size());
+  EXPECT_DOUBLE_EQ(kStartTime_, trajectory_.startTime());
+  EXPECT_FALSE(trajectory_.addSegment(0.0, PolynomialTrajectory::Coefficients::Zero()));
+  EXPECT_FALSE(trajectory_.addSegment(std::numeric_limits<double>::quiet_NaN(),
+                                      PolynomialTrajectory::Coefficients::Zero()));
+  EXPECT_EQ(static_cast<std::size_t>(kSegments_), trajectory_.size());
+
+  double duration = 0.0;
+  for (std::size_t i = 0; i < trajectory_.size(); ++i) {
+    EXPECT_EQ(i, trajectory_.findSegment(trajectory_.segmentStartTime(i)));
+    EXPECT_EQ(i, trajectory_.findSegment(trajectory_.segmentStartTime(i) + 0.5 * trajectory_.segmentDuration(i)));
+    duration += trajectory_.segmentDuration(i);
+  }
+  EXPECT_NEAR(duration, trajectory_.duration(), 1e-9);
+  EXPECT_EQ(0u, trajectory_.findSegment(kStartTime_ - 1.0));
+  EXPECT_EQ(trajectory_.size() - 1, trajectory_.findSegment(trajectory_.endTime() + 1.0));
+
+  trajectory_.clear();
+  EXPECT_TRUE(trajectory_.empty());
+  EXPECT_DOUBLE_EQ(kStartTime_, trajectory_.endTime());
+}
+
+/**
+ *  @brief  Test case to check all sampled derivatives against the power series
+ */
+TEST_F(PolynomialTrajectoryTest, DerivativesTest) {
+  for (std::size_t i = 0; i < trajectory_.size(); i += 7) {
+    const PolynomialTrajectory::Coefficients& c = trajectory_.coefficients(i);
+    const double tau = 0.3 * trajectory_.segmentDuration(i);
+    quadrotor_common::QuadrotorTrajectoryPoint point;
+    trajectory_.sample(trajectory_.segmentStartTime(i) + tau, point);
+
+    for (int axis = 0; axis < 3; ++axis) {
+      const Eigen::VectorXd c_axis = c.row(axis).transpose();
+      EXPECT_NEAR(derivative(c_axis, tau, 0), point.position(axis), 1e-9);
+      EXPECT_NEAR(derivative(c_axis, tau, 1), point.velocity(axis), 1e-9);
+      EXPECT_NEAR(derivative(c_axis, tau, 2), point.acceleration(axis), 1e-9);
+      EXPECT_NEAR(derivative(c_axis, tau, 3), point.jerk(axis), 1e-9);
+      EXPECT_NEAR(derivative(c_axis, tau, 4), point.snap(axis), 1e-9);
+    }
+    const Eigen::VectorXd c_heading = c.row(3).transpose();
+    EXPECT_NEAR(derivative(c_heading, tau, 0), point.heading, 1e-9);
+    EXPECT_NEAR(derivative(c_heading, tau, 1), point.heading_rate, 1e-9);
+    EXPECT_NEAR(derivative(c_heading, tau, 2), point.heading_acceleration, 1e-9);
+    EXPECT_TRUE(point.orientation.coeffs().isApprox(Eigen::Quaterniond::Identity().coeffs()));
+  }
+}
+
+/**
+ *  @brief  Test case to check if the cursor finds the same segments as the binary search,
+ *          monotonic, backwards and for random times
+ */
+TEST_F(PolynomialTrajectoryTest, CursorTest) {
+  PolynomialTrajectory::Cursor cursor;
+  for (double time = kStartTime_ - 1.0; time < trajectory_.endTime() + 1.0; time += 0.01) {
+    EXPECT_EQ(trajectory_.findSegment(time), trajectory_.findSegment(time, cursor));
+  }
+  for (double time = trajectory_.endTime(); time > kStartTime_; time -= 0.37) {
+    EXPECT_EQ(trajectory_.findSegment(time), trajectory_.findSegment(time, cursor));
+  }
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> random_time(kStartTime_, trajectory_.endTime());
+  for (int i = 0; i < 1000; ++i) {
+    const double time = random_time(generator);
+    EXPECT_EQ(trajectory_.findSegment(time), trajectory_.findSegment(time, cursor));
+  }
+}
+
+/**
+ *  @brief  Test case to check the batch sampling, the clamping and the continuity of a
+ *          trajectory whose segments continue each other
+ */
+TEST_F(PolynomialTrajectoryTest, SampleTest) {
+  std::vector<quadrotor_common::QuadrotorTrajectoryPoint,
+              Eigen::aligned_allocator<quadrotor_common::QuadrotorTrajectoryPoint>> points(500);
+  trajectory_.sample(kStartTime_ - 0.5, 0.5, points.size(), points.data());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    quadrotor_common::QuadrotorTrajectoryPoint point;
+    trajectory_.sample(kStartTime_ - 0.5 + i * 0.5, point);
+    EXPECT_EQ(point.position, points[i].position);
+    EXPECT_EQ(point.snap, points[i].snap);
+  }
+  EXPECT_EQ(points[0].position, points[1].position);  //  clamped to the start
+  EXPECT_EQ(points[points.size() - 1].position, points[points.size() - 2].position);  //  clamped to the end
+
+  //  p(t) = t^2 as two segments, i.e. the second one shifted to its local time
+  PolynomialTrajectory parabola;
+  PolynomialTrajectory::Coefficients c = PolynomialTrajectory::Coefficients::Zero();
+  c.col(2).setOnes();
+  parabola.addSegment(1.0, c);
+  c.col(0).setOnes();
+  c.col(1).setConstant(2.0);
+  parabola.addSegment(1.0, c);
+  quadrotor_common::QuadrotorTrajectoryPoint point;
+  parabola.sample(1.5, point);
+  EXPECT_NEAR(2.25, point.position.x(), 1e-12);
+  EXPECT_NEAR(3.0, point.velocity.y(), 1e-12);
+  EXPECT_NEAR(2.0, point.acceleration.z(), 1e-12);
+  EXPECT_NEAR(3.0, point.heading_rate, 1e-12);
+  EXPECT_NEAR(0.0, point.jerk.norm(), 1e-12);
+}
+
+} /*  namespace polynomial_trajectory  */
+
+/**
+ *
+ */
+int main(int argc, char **argv) {
+  ::testing::InitGoogleTest(&argc, argv);
+
+#ifndef QUADROTOR_COMMON_WITHOUT_ROS
+  ros::init(argc, argv, "test_polynomial_trajectory");
+  ros::NodeHandle nh;
+#endif
+
+  return RUN_ALL_TESTS();
+}